@@ -21,8 +21,9 @@ Player::Player() :
 	audioSource(new AudioSourceComponent(this, ChannelSpatialization::Channel3D, "PlayerFeets")),
 	crosshairSprite(new SpriteRendererComponent()), ammoText(new TextRendererComponent())
 {
-	rigidbody->onRigidbodyDelete.registerObserver(this, Bind_0(&Player::onRigidbodyDeleted));
-	rigidbody->onCollisionRepulsed.registerObserver(this, Bind_1(&Player::onCollision));
+	rigidbody->onRigidbodyDelete.registerObserver(this, &Player::onRigidbodyDeleted);
+	rigidbody->onCollisionRepulsed.registerObserver(this, &Player::onCollision);
+	Locator::getPhysics().GetProjectilesHitEvent().registerObserver(this, &Player::onProjectilesHit);
 
 	audioSource->setOffset(Vector3{ 0.0f, -1.1f, 0.0f });
 	audioSource->setVolume(0.2f);
@@ -300,3 +301,17 @@ void Player::onCollision(const CollisionResponse& collisionResponse)
 		rigidbody->setGravityVelocity(Vector3::zero); //  cancel the jump velocity if hit a roof
 	}
 }
+
+void Player::onProjectilesHit(const std::vector<ProjectileHit>& hits)
+{
+	for (auto& hit : hits)
+	{
+		for (auto& bullet : bullets)
+		{
+			if (bullet->getProjectileId() != hit.projectileId) continue;
+
+			bullet->onProjectileHit(hit);
+			break;
+		}
+	}
+}
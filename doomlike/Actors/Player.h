@@ -36,6 +36,8 @@ public:
 
 	void onCollision(const CollisionResponse& collisionResponse);
 
+	void onProjectilesHit(const std::vector<ProjectileHit>& hits);
+
 	Vector3 getEyePosition() const;
 
 
@@ -8,10 +8,11 @@
 #include <ServiceLocator/locator.h>
 #include <ServiceLocator/physics.h>
 #include <Physics/ObjectChannels/collisionChannels.h>
+#include <Physics/collisionComponent.h>
 
 
 Bullet::Bullet(Vector3 spawnPos, Quaternion spawnRot, Vector3 direction_, float velocity_, float lifetime_) :
-	rigidbody(&Locator::getPhysics().CreateRigidbodyComponent(new RigidbodyComponent(new BoxAABBColComp(Box{ Vector3::zero, Vector3{0.05f, 0.05f, 0.05f} }, &object, true, "bullet", CollisionType::Solid, false), true)))
+	projectileId(Locator::getPhysics().CreateProjectile(spawnPos, direction_ * velocity_, 0.05f, lifetime_, CollisionChannels::GetRegisteredTestChannel("PlayerEntity")))
 {
 	lifetime = lifetime_;
 
@@ -25,21 +26,12 @@ Bullet::Bullet(Vector3 spawnPos, Quaternion spawnRot, Vector3 direction_, float
 	object.setScale(0.0002f); //  faut pas mettre l'unit en kilometre sur maya hein (genre il abuse du bail le frero la)
 
 	renderer.AddObject(&object);
-
-	rigidbody->onCollisionRepulsed.registerObserver(this, Bind_1(&Bullet::onBulletWallHit));
-	rigidbody->getAssociatedCollisionNonConst().onCollisionIntersect.registerObserver(this, Bind_1(&Bullet::onBulletEntityHit));
-	rigidbody->onRigidbodyDelete.registerObserver(this, Bind_0(&Bullet::onRigidbodyDeleted));
-
-	rigidbody->setTestChannels(CollisionChannels::GetRegisteredTestChannel("PlayerEntity"));
-
-	rigidbody->setVelocity(direction_ * velocity_);
-	rigidbody->setUseGravity(false);
 }
 
 
 void Bullet::destroy()
 {
-	if(rigidbody) delete rigidbody; //  this will properly remove the rigidbody from physics manager
+	if (!hasHit) Locator::getPhysics().RemoveProjectile(projectileId); //  does nothing if the projectile ran out of time
 
 	Renderer& renderer = Locator::getRenderer();
 
@@ -50,24 +42,21 @@ void Bullet::destroy()
 void Bullet::update(float dt)
 {
 	lifetime -= dt;
-}
 
-void Bullet::onBulletWallHit(const CollisionResponse& hitResponse)
-{
-	rigidbody->setVelocity(Vector3::zero);
-	rigidbody->setUseGravity(true);
-	rigidbody->onCollisionRepulsed.unregisterObserver(this);
+	if (hasHit) return;
+
+	Vector3 position;
+	if (Locator::getPhysics().GetProjectilePosition(projectileId, position)) object.setPosition(position);
 }
 
-void Bullet::onBulletEntityHit(RigidbodyComponent& hitBody)
+void Bullet::onProjectileHit(const ProjectileHit& hit)
 {
-	if (hitBody.getAssociatedCollision().getCollisionChannel() == "enemy")
+	//  the bullet stays stuck where it hit until the end of its lifetime
+	hasHit = true;
+	object.setPosition(hit.hitLocation);
+
+	if (hit.hitCollision && hit.hitCollision->getCollisionChannel() == "enemy")
 	{
 		lifetime = 0.0f;
 	}
 }
-
-void Bullet::onRigidbodyDeleted()
-{
-	rigidbody = nullptr;
-}
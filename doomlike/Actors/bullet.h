@@ -3,12 +3,10 @@
 #include <Rendering/Model/vertexArray.h>
 #include <Objects/object.h>
 #include <Rendering/material.h>
-#include <Physics/AABB/boxAABBColComp.h>
-#include <Physics/rigidbodyComponent.h>
-#include <Events/observer.h>
+#include <Physics/projectileSystem.h>
 
 
-class Bullet : private Observer
+class Bullet
 {
 public:
 	Bullet(Vector3 spawnPos, Quaternion spawnRot, Vector3 direction_, float velocity_, float lifetime_);
@@ -19,15 +17,16 @@ public:
 
 	bool isLTOver() { return lifetime <= 0.0f; }
 
-	void onBulletWallHit(const CollisionResponse& hitResponse);
-	void onBulletEntityHit(RigidbodyComponent& hitBody);
-	void onRigidbodyDeleted();
+	void onProjectileHit(const ProjectileHit& hit);
+
+	uint32_t getProjectileId() const { return projectileId; }
 
 private:
 	float lifetime{ 0.0f };
+	bool hasHit{ false };
 
 	Object object;
 
-	RigidbodyComponent* rigidbody;
+	uint32_t projectileId{ 0 };
 };
 
@@ -4,6 +4,7 @@
 #include <ServiceLocator/audio.h>
 #include <Physics/ObjectChannels/collisionChannels.h>
 #include <Assets/assetManager.h>
+#include <ECS/entityCommandBuffer.h>
 
 #include "Player.h"
 #include <doomlikeGame.h>
@@ -17,7 +18,8 @@ void Enemy::load()
 	addModel(&AssetManager::GetModel("enemy"));
 
 	rigidbody = &physics.CreateRigidbodyComponent(new RigidbodyComponent(new BoxAABBColComp(Box{Vector3::zero, Vector3{0.7f, 0.7f, 0.7f}}, this, false, "enemy"), true));
-	rigidbody->getAssociatedCollisionNonConst().onCollisionIntersect.registerObserver(this, Bind_1(&Enemy::onBodyIntersect));
+	rigidbody->getAssociatedCollisionNonConst().onCollisionIntersect.registerObserver(this, &Enemy::onBodyIntersect);
+	rigidbody->getAssociatedCollisionNonConst().onRaycastIntersect.registerObserver(this, &Enemy::onRaycastIntersect);
 	rigidbody->setTestChannels(CollisionChannels::GetRegisteredTestChannel("Enemy"));
 
 	rigidbody->setUseGravity(false);
@@ -27,13 +29,23 @@ void Enemy::load()
 	playerRef = static_cast<DoomlikeGame*>(GameplayStatics::GetGame())->getPlayer();
 }
 
-void Enemy::updateObject(float dt)
+void Enemy::updateAI(float dt)
 {
 	if (dead)
 	{
-		onDie.broadcast(this);
-		delete rigidbody;
-		GameplayStatics::GetActiveScene()->unregisterObject(this);
+		EnemyDeathEvent death_event;
+		death_event.enemy = this;
+		GetDeathEvents().push(death_event);
+
+		//  the scheduler is running the systems, the rigidbody and this enemy are removed at the sync point of the frame
+		//  (the level stops running this enemy when the death event is dispatched, before the sync point)
+		Scene* scene = GameplayStatics::GetActiveScene();
+		scene->getCommandBuffer().call([this, scene]()
+		{
+			delete rigidbody;
+			rigidbody = nullptr;
+			scene->unregisterObject(this);
+		});
 		return;
 	}
 
@@ -41,6 +53,9 @@ void Enemy::updateObject(float dt)
 
 	if (!playerRef) return;
 
+	//  cheap range test first, the line of sight raycast is only done when the player is close enough
+	if (Locator::getPhysics().OverlapSphere(getPosition(), range, playerInRange, { "player" }) == 0) return;
+
 	RaycastHitInfos out;
 	bool test_player = Locator::getPhysics().LineRaycast(getPosition(), playerRef->getEyePosition(), { "solid", "player" }, out, 0.0f);
 	if (!test_player) return;
@@ -53,20 +68,14 @@ void Enemy::updateObject(float dt)
 	rigidbody->setVelocity(Vector3::normalize(playerRef->getEyePosition() - getPosition()) * speed);
 }
 
-void Enemy::onBodyIntersect(RigidbodyComponent& other)
+FrameEventQueue<EnemyDeathEvent>& Enemy::GetDeathEvents()
 {
-	if (other.getAssociatedCollision().getCollisionChannel() == "bullet")
-	{
-		Locator::getLog().LogMessageToScreen("Doomlike: Enemy die from a bullet.", Color::white, 5.0f);
-		dead = true;
-		//  not safe to delete rigidbody here cause it's during the update physics step
-		//  might need a way to automate this with a pending system
-
+	return GameplayStatics::FrameEvents.declareEvent<EnemyDeathEvent>("Enemy death", FrameEventPoint::AfterSystems);
+}
 
-		//  play death sound
-		Locator::getAudio().InstantPlaySound3D(AssetManager::GetSound("enemydeath"), getPosition(), 0.15f);
-	}
-	else if (other.getAssociatedCollision().getCollisionChannel() == "player")
+void Enemy::onBodyIntersect(RigidbodyComponent& other)
+{
+	if (other.getAssociatedCollision().getCollisionChannel() == "player")
 	{
 		Locator::getLog().LogMessageToScreen("Doomlike: Player die from the enemy.", Color::white, 5.0f);
 		static_cast<DoomlikeGame*>(GameplayStatics::GetGame())->restartLevel();
@@ -74,4 +83,19 @@ void Enemy::onBodyIntersect(RigidbodyComponent& other)
 		//  play player death sound
 		Locator::getAudio().InstantPlaySound2D(AssetManager::GetSound("playerdeath"), 0.4f);
 	}
-}
\ No newline at end of file
+}
+
+void Enemy::onRaycastIntersect(RaycastType type, const Vector3& location)
+{
+	//  bullets are projectiles
+	if (type != RaycastType::RaycastTypeProjectile) return;
+	if (dead) return;
+
+	Locator::getLog().LogMessageToScreen("Doomlike: Enemy die from a bullet.", Color::white, 5.0f);
+	dead = true;
+	//  the rigidbody can't be deleted during the broadcast of its own collision event,
+	//  updateAI defers its deletion to the sync point with the command buffer
+
+	//  play death sound
+	Locator::getAudio().InstantPlaySound3D(AssetManager::GetSound("enemydeath"), getPosition(), 0.15f);
+}
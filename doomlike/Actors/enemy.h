@@ -3,26 +3,39 @@
 #include <Physics/AABB/boxAABBColComp.h>
 #include <Physics/rigidbodyComponent.h>
 
-#include <Events/event.h>
+#include <Events/frameEventBus.h>
 #include <Events/observer.h>
 
 class Player;
+class Enemy;
+
+
+/* Frame event pushed when an enemy dies, dispatched after the systems (the enemy is removed later in the frame). */
+struct EnemyDeathEvent
+{
+	Enemy* enemy{ nullptr };
+};
+
 
 class Enemy : public Object, public Observer
 {
 public:
 	void load() override;
 
-	void updateObject(float dt) override;
+	//  the enemies don't use the objects update, the level runs the AI of all of them in one system (on the main thread, the rigidbody moves the transform)
+	void updateAI(float dt);
 
-	Event<Enemy*> onDie;
+	//  queue of the enemies deaths, to register observers
+	static FrameEventQueue<EnemyDeathEvent>& GetDeathEvents();
 
 private:
 	void onBodyIntersect(RigidbodyComponent& other);
+	void onRaycastIntersect(RaycastType type, const Vector3& location);
 
 	RigidbodyComponent* rigidbody{ nullptr };
 
 	Player* playerRef{ nullptr };
+	std::vector<const CollisionComponent*> playerInRange; //  reused by the range query
 
 	float range{ 9.0f };
 	float speed{ 2.0f };
@@ -8,7 +8,7 @@ void Target::load()
 
 	collision = static_cast<BoxAABBColComp*>(&physics.CreateCollisionComponent(new BoxAABBColComp(Box::one, this, false, "solid")));
 	
-	collision->onRaycastIntersect.registerObserver(this, Bind_2(&Target::onIntersectedByRaycast));
+	collision->onRaycastIntersect.registerObserver(this, &Target::onIntersectedByRaycast);
 }
 
 void Target::onIntersectedByRaycast(RaycastType type, const Vector3& intersectionPoint)
@@ -5,7 +5,7 @@
 
 class BoxAABBColComp;
 
-class Target : public Object, private Observer
+class Target : public Object, public Observer
 {
 public:
 	void load() override;
@@ -20,7 +20,7 @@ void FloorObj::setup(Vector3 position, bool isWood, bool hasCollision)
 
 	setPosition(position);
 	if (hasCollision)
-		physics.CreateCollisionComponent(new BoxAABBColComp(Box{ Vector3{0.0f, -0.1f, 0.0f}, Vector3{0.5f, 0.1f, 0.5f} }, this, false, "solid"));
+		physics.CreateCollisionComponent(new BoxAABBColComp(Box{ Vector3{0.0f, -0.1f, 0.0f}, Vector3{0.5f, 0.1f, 0.5f} }, this, false, "solid")).setStatic(true);
 }
 
 
@@ -42,7 +42,7 @@ void Ceiling::setup(Vector3 position, bool hasCollision)
 	setPosition(position);
 	setRotation(Quaternion::fromEuler(0.0f, Maths::toRadians(180.0f), 0.0f));
 	if (hasCollision)
-		physics.CreateCollisionComponent(new BoxAABBColComp(Box{ Vector3{0.0f, 0.2f, 0.0f}, Vector3{0.5f, 0.2f, 0.5f} }, this, false, "solid"));
+		physics.CreateCollisionComponent(new BoxAABBColComp(Box{ Vector3{0.0f, 0.2f, 0.0f}, Vector3{0.5f, 0.2f, 0.5f} }, this, false, "solid")).setStatic(true);
 	//  ceiling collision a bit thicker cause otherwise player would be able to pass through it thanks to step mechanic
 	//  (might need to investigate this issue)
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <ServiceLocator/locator.h>
 #include <ServiceLocator/physics.h>
 #include <Physics/AABB/boxAABBColComp.h>
+#include <Physics/TriangleMesh/triangleMeshColComp.h>
 
 Lamp::Lamp(Vector3 position, bool isCeiling, Scene& sceneRef, float rand, bool startOff)
 {
@@ -23,7 +24,7 @@ void Lamp::setup(Vector3 position, bool isCeiling, Scene& sceneRef, float rand,
 		setPosition(position + Vector3{0.0f, -2.0f, 0.0f});
 		setScale(0.001f);
 
-		physics.CreateCollisionComponent(new BoxAABBColComp(Box{ Vector3{0.0f, 0.6f, 0.0f}, Vector3{0.5f, 0.5f, 0.5f} }, this, false, "solid", CollisionType::Solid, false, false));
+		physics.CreateCollisionComponent(new TriangleMeshColComp(AssetManager::GetCollisionMesh("chandelier"), this, false, "solid")).setStatic(true);
 
 		light.load(Color{ 227, 141, 2, 255 }, position + Vector3{ 0.0f, 0.7f, 0.0f }, 0.01f, 0.41f);
 		baseLightIntensity = 0.4f;
@@ -36,7 +37,7 @@ void Lamp::setup(Vector3 position, bool isCeiling, Scene& sceneRef, float rand,
 		setPosition(position + Vector3{ -2.58f, -1.23f, -1.52f });
 		setScale(0.012f);
 
-		physics.CreateCollisionComponent(new BoxAABBColComp(Box{ Vector3{2.58f, 1.87f, 1.52f}, Vector3{0.21f, 0.64f, 0.21f} }, this, false, "solid", CollisionType::Solid, false, false));
+		physics.CreateCollisionComponent(new BoxAABBColComp(Box{ Vector3{2.58f, 1.87f, 1.52f}, Vector3{0.21f, 0.64f, 0.21f} }, this, false, "solid", CollisionType::Solid, false, false)).setStatic(true);
 
 		light.load(Color{ 227, 141, 2, 255 }, position + Vector3{ 0.0f, 1.2f, 0.0f }, 0.01f, 0.23f);
 		baseLightIntensity = 0.22f;
@@ -51,7 +52,7 @@ void Lamp::setup(Vector3 position, bool isCeiling, Scene& sceneRef, float rand,
 	time = rand;
 }
 
-void Lamp::updateObject(float dt)
+void Lamp::updateFlicker(float dt)
 {
 	if (reverse)
 	{
@@ -17,9 +17,11 @@ public:
 	void load() override;
 	void setup(Vector3 position, bool isCeiling, Scene& sceneRef, float rand, bool startOff = false);
 
-	void updateObject(float dt) override;
 	void changeStatus(bool lightStatus);
 
+	//  the lamps don't use the objects update, the scene updates all of them in a system (it only changes the lamp and its light)
+	void updateFlicker(float dt);
+
 private:
 	PointLight light;
 
@@ -94,6 +96,7 @@ namespace LampsSetup
 
 		AssetManager::LoadMeshCollection("lamp", "doomlike/lamp/lamp.fbx");
 		AssetManager::LoadMeshCollection("chandelier", "doomlike/chandelier/chandelier.fbx");
+		AssetManager::LoadCollisionMesh("chandelier", "doomlike/chandelier/chandelier.fbx");
 
 		AssetManager::CreateMaterialCollection("lamp", { &AssetManager::GetMaterial("lamp"), &AssetManager::GetMaterial("flame") });
 		AssetManager::CreateMaterialCollection("chandelier", {
@@ -120,5 +123,7 @@ namespace LampsSetup
 		renderer.RemoveMaterial(&AssetManager::GetMaterial("chandelier_leather"));
 		renderer.RemoveMaterial(&AssetManager::GetMaterial("flame"));
 		renderer.RemoveMaterial(&AssetManager::GetMaterial("flame_off"));
+
+		AssetManager::DeleteCollisionMesh("chandelier");
 	}
 };
\ No newline at end of file
@@ -21,12 +21,13 @@ namespace Wall
 		WallObj() {}
 
 		//  scale is a Vector2 because it corresponds to the plane scale once put flat
-		WallObj(Vector3 position, Wall::FacingDirection facingDirection, Vector2 scale, bool hasCollision = true);
+		//  a wall that moves during the level must not have a static collision, its bounds would stay where it was baked
+		WallObj(Vector3 position, Wall::FacingDirection facingDirection, Vector2 scale, bool hasCollision = true, bool staticCollision = true);
 
 		void load() override;
 
 		//  scale is a Vector2 because it corresponds to the plane scale once put flat
-		void setup(Vector3 position, Wall::FacingDirection facingDirection, Vector2 scale, bool hasCollision = true);
+		void setup(Vector3 position, Wall::FacingDirection facingDirection, Vector2 scale, bool hasCollision = true, bool staticCollision = true);
 	};
 };
 
@@ -6,7 +6,9 @@
 void EnemyCount::addEnemy(Enemy* enemyToAdd)
 {
 	enemies.push_back(enemyToAdd);
-	enemyToAdd->onDie.registerObserver(this, Bind_1(&EnemyCount::onEnemyDie));
+
+	//  registering again only replaces the delegate, the count is registered once for all its enemies
+	Enemy::GetDeathEvents().onEvent.registerObserver(this, &EnemyCount::onEnemyDie);
 }
 
 void EnemyCount::addEnemies(std::vector<Enemy*> enemiesToAdd)
@@ -18,17 +20,18 @@ void EnemyCount::addEnemies(std::vector<Enemy*> enemiesToAdd)
 void EnemyCount::clearEnemies(bool clearEvent)
 {
 	enemies.clear();
+	Enemy::GetDeathEvents().onEvent.unregisterObserver(this);
 	if (clearEvent) onAllEnemiesDead.clearAllObservers();
 }
 
-void EnemyCount::onEnemyDie(Enemy* enemyDead)
+void EnemyCount::onEnemyDie(const EnemyDeathEvent& deathEvent)
 {
-	auto iter = std::find(enemies.begin(), enemies.end(), enemyDead);
-	if (iter != enemies.end())
-	{
-		std::iter_swap(iter, enemies.end() - 1);
-		enemies.pop_back();
-	}
+	//  the deaths of every enemy are received, only the counted ones matter
+	auto iter = std::find(enemies.begin(), enemies.end(), deathEvent.enemy);
+	if (iter == enemies.end()) return;
+
+	std::iter_swap(iter, enemies.end() - 1);
+	enemies.pop_back();
 
 	if (enemies.size() == 0)
 	{
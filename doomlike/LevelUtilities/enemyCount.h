@@ -23,7 +23,7 @@ private:
 	std::vector<Enemy*> enemies;
 
 
-	void onEnemyDie(Enemy* enemyDead);
+	void onEnemyDie(const EnemyDeathEvent& deathEvent);
 	void enemiesAllDead();
 };
 
@@ -11,7 +11,7 @@ void TriggerZone::setup(Vector3 position, Vector3 size)
 
 	setPosition(position);
 	triggerCol = &physics.CreateCollisionComponent(new BoxAABBColComp(Box{Vector3::zero, size * 0.5f}, this, false, "trigger_zone", CollisionType::Trigger, false, false));
-	triggerCol->onTriggerEnter.registerObserver(this, Bind_1(&TriggerZone::onTriggerZoneEnter));
+	triggerCol->onTriggerEnter.registerObserver(this, &TriggerZone::onTriggerZoneEnter);
 	disabled = false;
 }
 
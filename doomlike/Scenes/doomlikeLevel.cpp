@@ -0,0 +1,312 @@
+#include "doomlikeLevel.h"
+#include <Assets/sceneFileWriter.h>
+#include <ServiceLocator/locator.h>
+#include <Utils/defines.h>
+#include <Utils/elapsedTime.h>
+
+#include <algorithm>
+#include <chrono>
+
+
+namespace
+{
+	//  objects or markers created by an activation step of a level file
+	const int INSTANTIATION_STEP_SIZE = 32;
+}
+
+
+DoomlikeLevel::DoomlikeLevel(const std::string& levelName_) : levelName(levelName_)
+{
+}
+
+std::string DoomlikeLevel::getLevelFilePath() const
+{
+	return RESOURCES_PATH + "doomlike/level_" + levelName + SCENE_FILE_EXTENSION;
+}
+
+void DoomlikeLevel::preloadScene()
+{
+	preloadedFile.reset();
+	preloadError.clear();
+	if (!useLevelFile) return;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	//  the preload can run on a worker thread, the error is logged by the load on the main thread
+	std::unique_ptr<SceneFile> file(new SceneFile());
+	if (!file->load(getLevelFilePath()))
+	{
+		preloadError = file->getLastError();
+		return;
+	}
+
+	lastFileLoadTime = GetElapsedMilliseconds(start);
+	preloadedFile = std::move(file);
+}
+
+void DoomlikeLevel::loadScene()
+{
+	//  the level is created by activation steps, a streamed level spreads them on several frames
+	lastBuildTime = 0.0;
+
+	if (!preloadError.empty())
+	{
+		Log& log = Locator::getLog();
+		log.LogMessage_Category(preloadError, LogCategory::Error);
+		log.LogMessage_Category("Doomlike: The file of the level '" + levelName + "' can't be loaded, the level is built from its code.", LogCategory::Warning);
+		preloadError.clear();
+	}
+
+	levelFile = std::move(preloadedFile);
+	if (levelFile) loadFromFile();
+	else addBuildStep([this]() { buildLevel(); });
+
+	addActivationStep([this]()
+	{
+		registerLevelSystems();
+		setupLevel();
+	});
+}
+
+void DoomlikeLevel::unloadScene()
+{
+	unloadLevel();
+	Enemy::GetDeathEvents().onEvent.unregisterObserver(this);
+
+	//  the scene removed the objects and lights from the renderer and the collisions from the physics, the instances of the file can go
+	levelFile.reset();
+
+	decorObjects.clear();
+	decorLights.clear();
+	markers.clear();
+	namedObjects.clear();
+	triggerZones.clear();
+	lamps.clear();
+	enemies.clear();
+}
+
+bool DoomlikeLevel::exportLevel()
+{
+	if (!isActivated() || levelFile)
+	{
+		Locator::getLog().LogMessage_Category("Doomlike: The level '" + levelName + "' must be loaded from its code to be exported.", LogCategory::Warning);
+		return false;
+	}
+
+	SceneFileWriter writer;
+	writer.setClearColor(Locator::getRenderer().GetClearColor());
+
+	for (auto& decor_object : decorObjects)
+	{
+		writer.captureObject(*decor_object.first, decor_object.second);
+	}
+
+	for (auto decor_light : decorLights)
+	{
+		writer.captureLight(*decor_light);
+	}
+
+	for (auto& trigger_zone : triggerZones)
+	{
+		writer.addTriggerZone(trigger_zone.name, trigger_zone.position, trigger_zone.size);
+	}
+
+	for (auto& marker : markers)
+	{
+		writer.addMarker(marker.name, marker.type, marker.position, Quaternion::identity, marker.params);
+	}
+
+	const std::string file_path = getLevelFilePath();
+	if (!writer.write(file_path)) return false;
+
+	Locator::getLog().LogMessage_Category("Doomlike: Exported the level '" + levelName + "' in " + file_path + " (" + std::to_string(decorObjects.size()) + " objects, " +
+		std::to_string(decorLights.size()) + " lights, " + std::to_string(triggerZones.size()) + " trigger zones, " + std::to_string(markers.size()) + " markers).", LogCategory::Info);
+	return true;
+}
+
+
+Object& DoomlikeLevel::addDecor(Object* object, const std::string& name)
+{
+	decorObjects.emplace_back(object, name);
+	if (!name.empty()) namedObjects.emplace_back(name, object);
+	return registerObject(object);
+}
+
+void DoomlikeLevel::addDecorLight(Light* light)
+{
+	decorLights.push_back(light);
+	registerLight(light);
+}
+
+void DoomlikeLevel::addLamp(const std::string& name, Vector3 position, bool isCeiling, float rand, bool startOff)
+{
+	addMarker(name, "lamp", position, { isCeiling ? 1.0f : 0.0f, rand, startOff ? 1.0f : 0.0f });
+}
+
+void DoomlikeLevel::addEnemy(const std::string& name, Vector3 position)
+{
+	addMarker(name, "enemy", position);
+}
+
+void DoomlikeLevel::addTriggerZone(const std::string& name, Vector3 position, Vector3 size)
+{
+	createTriggerZone(name, position, size);
+}
+
+void DoomlikeLevel::setSpawn(Vector3 position)
+{
+	addMarker("", "spawn", position);
+}
+
+Object* DoomlikeLevel::getNamedObject(const std::string& name) const
+{
+	for (auto& named_object : namedObjects)
+	{
+		if (named_object.first == name) return named_object.second;
+	}
+
+	return levelFile ? levelFile->findObject(name) : nullptr;
+}
+
+Enemy& DoomlikeLevel::spawnEnemy(Vector3 position)
+{
+	Enemy* enemy = static_cast<Enemy*>(&registerObject(new Enemy()));
+	enemy->setPosition(position);
+	enemies.push_back(enemy);
+	return *enemy;
+}
+
+TriggerZone* DoomlikeLevel::getTriggerZone(const std::string& name) const
+{
+	for (auto& trigger_zone : triggerZones)
+	{
+		if (trigger_zone.name == name) return trigger_zone.zone.get();
+	}
+
+	return nullptr;
+}
+
+
+void DoomlikeLevel::registerLevelSystems()
+{
+	//  the lamps only change themselves and their light, whichever level they are in
+	if (!lamps.empty())
+	{
+		registerSystem("Lamps flicker", SystemAccess().write<Lamp>().write<PointLight>(), [this](float dt)
+		{
+			for (Lamp* lamp : lamps)
+			{
+				lamp->updateFlicker(dt);
+			}
+		});
+	}
+
+	//  the enemies move their rigidbody and query the physics, whose query buffers are shared: they run one after the other on the main thread,
+	//  in one system for all of them so that a death doesn't change the systems graph
+	registerSystem("Enemies AI", SystemAccess().write<Physics>().write<Enemy>().onMainThread(), [this](float dt)
+	{
+		for (Enemy* enemy : enemies)
+		{
+			enemy->updateAI(dt);
+		}
+	});
+	Enemy::GetDeathEvents().onEvent.registerObserver(this, &DoomlikeLevel::onEnemyDeath);
+}
+
+void DoomlikeLevel::onEnemyDeath(const EnemyDeathEvent& deathEvent)
+{
+	//  dispatched after the systems, the enemy is removed from the scene at the sync point that follows
+	auto iter = std::find(enemies.begin(), enemies.end(), deathEvent.enemy);
+	if (iter != enemies.end()) enemies.erase(iter);
+}
+
+void DoomlikeLevel::addMarker(const std::string& name, const std::string& type, Vector3 position, const std::vector<float>& params)
+{
+	markers.push_back(LevelMarker{ name, type, position, params });
+	spawnMarker(name, type, position, params.data(), static_cast<int>(params.size()));
+}
+
+void DoomlikeLevel::spawnMarker(const std::string& name, const std::string& type, Vector3 position, const float* params, int paramsCount)
+{
+	auto param = [params, paramsCount](int index) { return index < paramsCount ? params[index] : 0.0f; };
+
+	Object* object = nullptr;
+	if (type == "lamp")
+	{
+		Lamp* lamp = static_cast<Lamp*>(&registerObject(new Lamp(position, param(0) != 0.0f, *this, param(1), param(2) != 0.0f)));
+		lamps.push_back(lamp);
+		object = lamp;
+	}
+	else if (type == "enemy")
+	{
+		object = &spawnEnemy(position);
+	}
+	else if (type == "spawn")
+	{
+		spawnPosition = position;
+	}
+	else
+	{
+		Locator::getLog().LogMessage_Category("Doomlike: The level '" + levelName + "' has a marker of unknown type '" + type + "'.", LogCategory::Warning);
+	}
+
+	if (object && !name.empty()) namedObjects.emplace_back(name, object);
+}
+
+void DoomlikeLevel::createTriggerZone(const std::string& name, Vector3 position, Vector3 size)
+{
+	LevelTriggerZone trigger_zone;
+	trigger_zone.name = name;
+	trigger_zone.position = position;
+	trigger_zone.size = size;
+	trigger_zone.zone.reset(new TriggerZone());
+	trigger_zone.zone->setup(position, size);
+	triggerZones.push_back(std::move(trigger_zone));
+}
+
+void DoomlikeLevel::loadFromFile()
+{
+	addBuildStep([this]() { levelFile->beginInstantiation(); });
+
+	const int objects_count = levelFile->getObjects().size();
+	for (int first = 0; first < objects_count; first += INSTANTIATION_STEP_SIZE)
+	{
+		addBuildStep([this, first]() { levelFile->instantiateObjects(*this, first, INSTANTIATION_STEP_SIZE); });
+	}
+
+	addBuildStep([this]()
+	{
+		levelFile->instantiateLights(*this);
+
+		const SceneFileArray<SceneFileTriggerZone>& file_zones = levelFile->getTriggerZones();
+		for (int i = 0; i < file_zones.size(); i++)
+		{
+			createTriggerZone(file_zones[i].name.get(), SceneFile::ToVector3(file_zones[i].position), SceneFile::ToVector3(file_zones[i].size));
+		}
+	});
+
+	const int markers_count = levelFile->getMarkers().size();
+	for (int first = 0; first < markers_count; first += INSTANTIATION_STEP_SIZE)
+	{
+		addBuildStep([this, first, markers_count]()
+		{
+			const SceneFileArray<SceneFileMarker>& file_markers = levelFile->getMarkers();
+			const int end = std::min(first + INSTANTIATION_STEP_SIZE, markers_count);
+			for (int i = first; i < end; i++)
+			{
+				const SceneFileMarker& marker = file_markers[i];
+				spawnMarker(marker.name.get(), marker.type.get(), SceneFile::ToVector3(marker.position), marker.params, sizeof(marker.params) / sizeof(float));
+			}
+		});
+	}
+}
+
+void DoomlikeLevel::addBuildStep(std::function<void()> step)
+{
+	addActivationStep([this, step]()
+	{
+		const auto start = std::chrono::steady_clock::now();
+		step();
+		lastBuildTime += GetElapsedMilliseconds(start);
+	});
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <Events/observer.h>
+#include <Core/scene.h>
+#include <GameLogic/playerSpawnPoint.h>
+#include <Assets/sceneFile.h>
+
+#include <Objects/object.h>
+#include <Objects/Lights/light.h>
+
+#include <Decor/lamps.h>
+#include <Actors/enemy.h>
+#include <LevelUtilities/triggerZone.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/** Doomlike Level
+* Base of the levels that are cooked in a scene file. The decor (objects, collisions and static lights) and the gameplay markers
+* (lamps, enemies, trigger zones, spawn point) come from the level file when it exists, or from the code of the level otherwise.
+* The code version is the source: exporting a level built from its code writes its file.
+*/
+class DoomlikeLevel : public Scene, public Observer, public PlayerSpawnPoint
+{
+public:
+	DoomlikeLevel(const std::string& levelName_);
+
+	/**
+	* Write the level file from the level built from its code, the level must be the loaded scene.
+	* @return	True if the file has been written.
+	*/
+	bool exportLevel();
+
+	//  the level is built from its code when false or when its file can't be loaded, the file is kept cooked either way
+	inline void setUseLevelFile(bool value) { useLevelFile = value; }
+	inline bool isLoadedFromFile() const { return levelFile != nullptr; }
+
+	inline const std::string& getLevelName() const { return levelName; }
+	std::string getLevelFilePath() const;
+
+	//  duration of the last load of the level file (map and fix up), and of the last creation of the level (instantiation or code, the sum of its activation steps)
+	inline double getLastFileLoadTime() const { return lastFileLoadTime; }
+	inline double getLastBuildTime() const { return lastBuildTime; }
+
+protected:
+	void preloadScene() override;
+	void loadScene() override;
+	void unloadScene() override;
+
+	//  code version of the level: the decor and the gameplay markers
+	virtual void buildLevel() = 0;
+
+	//  gameplay of the level, once the decor and the markers are there (whether they come from the file or the code)
+	virtual void setupLevel() = 0;
+	virtual void unloadLevel() {}
+
+
+	//  helpers of the code version, what they add is written in the level file
+	Object& addDecor(Object* object, const std::string& name = "");
+	void addDecorLight(Light* light);
+	void addLamp(const std::string& name, Vector3 position, bool isCeiling, float rand, bool startOff = false);
+	void addEnemy(const std::string& name, Vector3 position);
+	void addTriggerZone(const std::string& name, Vector3 position, Vector3 size);
+	void setSpawn(Vector3 position);
+
+	//  create an enemy during the game, it is run by the enemies system of the level
+	Enemy& spawnEnemy(Vector3 position);
+
+	Object* getNamedObject(const std::string& name) const;
+	TriggerZone* getTriggerZone(const std::string& name) const;
+	inline const std::vector<Lamp*>& getLamps() const { return lamps; }
+	inline const std::vector<Enemy*>& getEnemies() const { return enemies; }
+
+private:
+	struct LevelMarker
+	{
+		std::string name;
+		std::string type;
+		Vector3 position{ Vector3::zero };
+		std::vector<float> params;
+	};
+
+	struct LevelTriggerZone
+	{
+		std::string name;
+		Vector3 position{ Vector3::zero };
+		Vector3 size{ Vector3::zero };
+		std::unique_ptr<TriggerZone> zone;
+	};
+
+	void addMarker(const std::string& name, const std::string& type, Vector3 position, const std::vector<float>& params = {});
+	void spawnMarker(const std::string& name, const std::string& type, Vector3 position, const float* params, int paramsCount);
+	void createTriggerZone(const std::string& name, Vector3 position, Vector3 size);
+	//  systems of the gameplay markers, registered once the level is created so that they are in every level
+	void registerLevelSystems();
+	void onEnemyDeath(const EnemyDeathEvent& deathEvent);
+	//  queue the instantiation of the level file in activation steps of a few objects or markers
+	void loadFromFile();
+	//  queue an activation step that creates a part of the level, its duration is added to the build time
+	void addBuildStep(std::function<void()> step);
+
+	std::string levelName;
+	bool useLevelFile{ true };
+
+	std::unique_ptr<SceneFile> levelFile; //  file the level has been loaded from, null if it was built from its code
+	std::unique_ptr<SceneFile> preloadedFile; //  loaded by the preload, the level can still be active while it runs
+	std::string preloadError; //  why the preload couldn't load the file, logged by the load
+
+	double lastFileLoadTime{ 0.0 };
+	double lastBuildTime{ 0.0 };
+
+	//  decor of the code version, to export it
+	std::vector<std::pair<Object*, std::string>> decorObjects;
+	std::vector<Light*> decorLights;
+	std::vector<LevelMarker> markers;
+
+	std::vector<std::pair<std::string, Object*>> namedObjects;
+	std::vector<LevelTriggerZone> triggerZones;
+	std::vector<Lamp*> lamps;
+	std::vector<Enemy*> enemies;
+};
@@ -12,65 +12,76 @@ using Wall::WallObj;
 using Stairs::StairsObj;
 
 
-DoomlikeLevelAdvanced::DoomlikeLevelAdvanced()
+DoomlikeLevelAdvanced::DoomlikeLevelAdvanced() : DoomlikeLevel("advanced")
 {
 }
 
-void DoomlikeLevelAdvanced::loadScene()
+void DoomlikeLevelAdvanced::buildLevel()
 {
 	Renderer& renderer = Locator::getRenderer();
 
 	renderer.SetClearColor(Color{ 50, 75, 75, 255 });
 
 	//  floors, ceilings, walls and stairs
-	registerObject(new FloorObj(Vector3{ 0.0f, 0.0f, 0.0f }, false)).setScale(Vector3{ 20.0f, 1.0f, 20.0f });
-	registerObject(new FloorObj(Vector3{ 0.0f, 7.0f, 0.0f }, true)).setScale(Vector3{ 2.5f, 1.0f, 2.5f });
-	registerObject(new Ceiling(Vector3{ 0.0f, 10.0f, 0.0f })).setScale(Vector3{ 20.0f, 1.0f, 20.0f });
-
-	registerObject(new WallObj(Vector3{   0.0f, 3.5f, -1.25f }, Wall::FacingDirection::FacingNegativeZ, Vector2{ 2.5f, 7.0f }));
-	registerObject(new WallObj(Vector3{  1.25f, 3.5f,   0.0f }, Wall::FacingDirection::FacingPositiveX, Vector2{ 2.5f, 7.0f }));
-	registerObject(new WallObj(Vector3{ -1.25f, 3.5f,   0.0f }, Wall::FacingDirection::FacingNegativeX, Vector2{ 2.5f, 7.0f }));
-	registerObject(new WallObj(Vector3{   0.0f, 3.5f,  1.25f }, Wall::FacingDirection::FacingPositiveZ, Vector2{ 2.5f, 7.0f }));
-
-	registerObject(new WallObj(Vector3{   0.0f, 5.0f,  10.0f }, Wall::FacingDirection::FacingNegativeZ, Vector2{ 20.0f, 10.0f }));
-	registerObject(new WallObj(Vector3{ -10.0f, 5.0f,   0.0f }, Wall::FacingDirection::FacingPositiveX, Vector2{ 20.0f, 10.0f }));
-	registerObject(new WallObj(Vector3{  10.0f, 5.0f,   0.0f }, Wall::FacingDirection::FacingNegativeX, Vector2{ 20.0f, 10.0f }));
-	registerObject(new WallObj(Vector3{   0.0f, 5.0f, -10.0f }, Wall::FacingDirection::FacingPositiveZ, Vector2{ 20.0f, 10.0f }));
+	addDecor(new FloorObj(Vector3{ 0.0f, 0.0f, 0.0f }, false)).setScale(Vector3{ 20.0f, 1.0f, 20.0f });
+	addDecor(new FloorObj(Vector3{ 0.0f, 7.0f, 0.0f }, true)).setScale(Vector3{ 2.5f, 1.0f, 2.5f });
+	addDecor(new Ceiling(Vector3{ 0.0f, 10.0f, 0.0f })).setScale(Vector3{ 20.0f, 1.0f, 20.0f });
+
+	addDecor(new WallObj(Vector3{   0.0f, 3.5f, -1.25f }, Wall::FacingDirection::FacingNegativeZ, Vector2{ 2.5f, 7.0f }));
+	addDecor(new WallObj(Vector3{  1.25f, 3.5f,   0.0f }, Wall::FacingDirection::FacingPositiveX, Vector2{ 2.5f, 7.0f }));
+	addDecor(new WallObj(Vector3{ -1.25f, 3.5f,   0.0f }, Wall::FacingDirection::FacingNegativeX, Vector2{ 2.5f, 7.0f }));
+	addDecor(new WallObj(Vector3{   0.0f, 3.5f,  1.25f }, Wall::FacingDirection::FacingPositiveZ, Vector2{ 2.5f, 7.0f }));
+
+	addDecor(new WallObj(Vector3{   0.0f, 5.0f,  10.0f }, Wall::FacingDirection::FacingNegativeZ, Vector2{ 20.0f, 10.0f }));
+	addDecor(new WallObj(Vector3{ -10.0f, 5.0f,   0.0f }, Wall::FacingDirection::FacingPositiveX, Vector2{ 20.0f, 10.0f }));
+	addDecor(new WallObj(Vector3{  10.0f, 5.0f,   0.0f }, Wall::FacingDirection::FacingNegativeX, Vector2{ 20.0f, 10.0f }));
+	addDecor(new WallObj(Vector3{   0.0f, 5.0f, -10.0f }, Wall::FacingDirection::FacingPositiveZ, Vector2{ 20.0f, 10.0f }));
 	
 
 	//  decor - dynamic lights
-	ceilLamp1 = static_cast<Lamp*>(&registerObject(new Lamp(Vector3{ -8.0f, 10.0f, -8.0f }, true, *this, 0.12f, true)));
-	ceilLamp2 = static_cast<Lamp*>(&registerObject(new Lamp(Vector3{  8.0f, 10.0f, -8.0f }, true, *this, 0.37f, true)));
-	ceilLamp3 = static_cast<Lamp*>(&registerObject(new Lamp(Vector3{ -8.0f, 10.0f,  8.0f }, true, *this, 0.56f, true)));
-	ceilLamp4 = static_cast<Lamp*>(&registerObject(new Lamp(Vector3{  8.0f, 10.0f,  8.0f }, true, *this, 0.81f, true)));
-	ceilLamp5 = static_cast<Lamp*>(&registerObject(new Lamp(Vector3{ -8.0f, 10.0f,  0.0f }, true, *this, 0.25f, true)));
-	ceilLamp6 = static_cast<Lamp*>(&registerObject(new Lamp(Vector3{  8.0f, 10.0f,  0.0f }, true, *this, 0.43f, true)));
-	ceilLamp7 = static_cast<Lamp*>(&registerObject(new Lamp(Vector3{  0.0f, 10.0f, -8.0f }, true, *this, 0.72f, true)));
-	ceilLamp8 = static_cast<Lamp*>(&registerObject(new Lamp(Vector3{  0.0f, 10.0f,  8.0f }, true, *this, 0.97f, true)));
-	floorLamp = static_cast<Lamp*>(&registerObject(new Lamp(Vector3{  6.0f,  0.0f,  0.0f }, false, *this, 0.85f, false)));
-
-
-	//  elevator
-	elevator.addModel(&AssetManager::GetModel("crate"));
-	registerObject(&elevator);
-	elevator.setup(Vector3{ 2.5f, 0.1f, 0.0f }, Vector3{ 2.5f, 6.9f, 0.0f }, 4.0f, 2.0f);
-	elevator.pause();
+	addLamp("", Vector3{ -8.0f, 10.0f, -8.0f }, true, 0.12f, true);
+	addLamp("", Vector3{  8.0f, 10.0f, -8.0f }, true, 0.37f, true);
+	addLamp("", Vector3{ -8.0f, 10.0f,  8.0f }, true, 0.56f, true);
+	addLamp("", Vector3{  8.0f, 10.0f,  8.0f }, true, 0.81f, true);
+	addLamp("", Vector3{ -8.0f, 10.0f,  0.0f }, true, 0.25f, true);
+	addLamp("", Vector3{  8.0f, 10.0f,  0.0f }, true, 0.43f, true);
+	addLamp("", Vector3{  0.0f, 10.0f, -8.0f }, true, 0.72f, true);
+	addLamp("", Vector3{  0.0f, 10.0f,  8.0f }, true, 0.97f, true);
+	addLamp("floor_lamp", Vector3{ 6.0f, 0.0f, 0.0f }, false, 0.85f, false);
 
 
 	//  trigger zones
-	elevatorUpZone.setup(Vector3{ 2.5f, 1.0f, 0.0f }, Vector3{ 0.3f, 0.3f, 0.3f });
-	elevatorUpZone.onPlayerEnter.registerObserver(this, Bind_0(&DoomlikeLevelAdvanced::onPlayerEnterElevatorUpZone));
-	enemySpawnZone.setup(Vector3{ 0.0f, 7.5f, 0.0f }, Vector3{ 0.2f, 0.2f, 0.2f });
-	enemySpawnZone.onPlayerEnter.registerObserver(this, Bind_0(&DoomlikeLevelAdvanced::onPlayerEnterEnemySpawnZone));
+	addTriggerZone("elevator_up", Vector3{ 2.5f, 1.0f, 0.0f }, Vector3{ 0.3f, 0.3f, 0.3f });
+	addTriggerZone("enemy_spawn", Vector3{ 0.0f, 7.5f, 0.0f }, Vector3{ 0.2f, 0.2f, 0.2f });
 
 
 	//  static lights
 	globalLight.load(Color{ 255, 238, 209, 255 }, Vector3::unitY, 0.15f, 0.0f);
-	registerLight(&globalLight);
+	addDecorLight(&globalLight);
 
 
 	//  spawn point
-	spawnPosition = Vector3{ 9.0f, 0.0f, 0.0f };
+	setSpawn(Vector3{ 9.0f, 0.0f, 0.0f });
+}
+
+void DoomlikeLevelAdvanced::setupLevel()
+{
+	floorLamp = static_cast<Lamp*>(getNamedObject("floor_lamp"));
+
+
+	//  elevator, it moves so it isn't in the level file
+	elevator.addModel(&AssetManager::GetModel("crate"));
+	registerObject(&elevator);
+	elevator.setup(Vector3{ 2.5f, 0.1f, 0.0f }, Vector3{ 2.5f, 6.9f, 0.0f }, 4.0f, 2.0f);
+	elevator.pause();
+	elevatorTimer = 0.0f;
+
+
+	//  trigger zones
+	elevatorUpZone = getTriggerZone("elevator_up");
+	if (elevatorUpZone) elevatorUpZone->onPlayerEnter.registerObserver(this, &DoomlikeLevelAdvanced::onPlayerEnterElevatorUpZone);
+	enemySpawnZone = getTriggerZone("enemy_spawn");
+	if (enemySpawnZone) enemySpawnZone->onPlayerEnter.registerObserver(this, &DoomlikeLevelAdvanced::onPlayerEnterEnemySpawnZone);
 }
 
 void DoomlikeLevelAdvanced::updateScene(float dt)
@@ -83,34 +94,32 @@ void DoomlikeLevelAdvanced::updateScene(float dt)
 	}
 }
 
-void DoomlikeLevelAdvanced::unloadScene()
+void DoomlikeLevelAdvanced::unloadLevel()
 {
+	floorLamp = nullptr;
+	elevatorUpZone = nullptr;
+	enemySpawnZone = nullptr;
 }
 
 void DoomlikeLevelAdvanced::onPlayerEnterElevatorUpZone()
 {
-	elevatorUpZone.onPlayerEnter.unregisterObserver(this);
-	elevatorUpZone.disableZone();
+	elevatorUpZone->onPlayerEnter.unregisterObserver(this);
+	elevatorUpZone->disableZone();
 	elevatorTimer = 0.1f;
 }
 
 void DoomlikeLevelAdvanced::onPlayerEnterEnemySpawnZone()
 {
-	enemySpawnZone.onPlayerEnter.unregisterObserver(this);
-	enemySpawnZone.disableZone();
-
-	ceilLamp1->changeStatus(true);
-	ceilLamp2->changeStatus(true);
-	ceilLamp3->changeStatus(true);
-	ceilLamp4->changeStatus(true);
-	ceilLamp5->changeStatus(true);
-	ceilLamp6->changeStatus(true);
-	ceilLamp7->changeStatus(true);
-	ceilLamp8->changeStatus(true);
-	floorLamp->changeStatus(false);
-
-	registerObject(new Enemy()).setPosition(Vector3{ -5.0f, 7.5f, -5.0f });
-	registerObject(new Enemy()).setPosition(Vector3{ -5.0f, 7.5f,  5.0f });
-	registerObject(new Enemy()).setPosition(Vector3{  5.0f, 7.5f, -5.0f });
-	registerObject(new Enemy()).setPosition(Vector3{  5.0f, 7.5f,  5.0f });
+	enemySpawnZone->onPlayerEnter.unregisterObserver(this);
+	enemySpawnZone->disableZone();
+
+	for (Lamp* lamp : getLamps())
+	{
+		lamp->changeStatus(lamp != floorLamp);
+	}
+
+	spawnEnemy(Vector3{ -5.0f, 7.5f, -5.0f });
+	spawnEnemy(Vector3{ -5.0f, 7.5f,  5.0f });
+	spawnEnemy(Vector3{  5.0f, 7.5f, -5.0f });
+	spawnEnemy(Vector3{  5.0f, 7.5f,  5.0f });
 }
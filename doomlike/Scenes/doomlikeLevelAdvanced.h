@@ -1,7 +1,5 @@
 #pragma once
-#include <Events/observer.h>
-#include <Core/scene.h>
-#include <GameLogic/playerSpawnPoint.h>
+#include "doomlikeLevel.h"
 
 #include <Objects/object.h>
 #include <Objects/Lights/directionalLight.h>
@@ -16,7 +14,7 @@
 #include <LevelUtilities/triggerZone.h>
 
 
-class DoomlikeLevelAdvanced : public Scene, public Observer, public PlayerSpawnPoint
+class DoomlikeLevelAdvanced : public DoomlikeLevel
 {
 public:
 	DoomlikeLevelAdvanced();
@@ -25,29 +23,22 @@ public:
 
 
 protected:
-	void loadScene() override;
+	void buildLevel() override;
+	void setupLevel() override;
 
-	void unloadScene() override;
+	void unloadLevel() override;
 
 
 private:
 	//  static lights
 	DirectionalLight globalLight;
 
-	//  dynamic lights
-	Lamp* ceilLamp1;
-	Lamp* ceilLamp2;
-	Lamp* ceilLamp3;
-	Lamp* ceilLamp4;
-	Lamp* ceilLamp5;
-	Lamp* ceilLamp6;
-	Lamp* ceilLamp7;
-	Lamp* ceilLamp8;
-	Lamp* floorLamp;
+	//  dynamic lights, the ceiling lamps are the other lamps of the level
+	Lamp* floorLamp{ nullptr };
 
 	//  level utilities
-	TriggerZone elevatorUpZone;
-	TriggerZone enemySpawnZone;
+	TriggerZone* elevatorUpZone{ nullptr };
+	TriggerZone* enemySpawnZone{ nullptr };
 
 	//  objects
 	MovingPlatform elevator;
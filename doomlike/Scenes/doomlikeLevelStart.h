@@ -1,7 +1,5 @@
 #pragma once
-#include <Events/observer.h>
-#include <Core/scene.h>
-#include <GameLogic/playerSpawnPoint.h>
+#include "doomlikeLevel.h"
 
 #include <Objects/object.h>
 #include <Objects/Lights/directionalLight.h>
@@ -16,7 +14,7 @@
 #include <LevelUtilities/triggerZone.h>
 
 
-class DoomlikeLevelStart : public Scene, public Observer, public PlayerSpawnPoint
+class DoomlikeLevelStart : public DoomlikeLevel
 {
 public:
 	DoomlikeLevelStart();
@@ -25,9 +23,10 @@ public:
 
 
 protected:
-	void loadScene() override;
+	void buildLevel() override;
+	void setupLevel() override;
 
-	void unloadScene() override;
+	void unloadLevel() override;
 
 
 private:
@@ -36,9 +35,9 @@ private:
 
 	//  level utilities
 	EnemyCount enemyCount;
-	TriggerZone endLevelZone;
+	TriggerZone* endLevelZone{ nullptr };
 
-	Object* endLevelWall;
+	Object* endLevelWall{ nullptr };
 
 	void onEnemiesDead();
 	void onPlayerEnterEndLevelZone();
@@ -153,7 +153,7 @@ void DoomlikeGame::loadGameAssets()
 
 	//  object channels
 	CollisionChannels::RegisterTestChannel("PlayerEntity", { "solid", "enemy", "trigger_zone" }); //  for player and player bullets
-	CollisionChannels::RegisterTestChannel("Enemy", { "solid", "player", "bullet" });
+	CollisionChannels::RegisterTestChannel("Enemy", { "solid", "player" });
 
 
 	log.LogMessage_Category("Doomlike: Finished loading doomlike assets in " + std::to_string(glfwGetTime() - full_load_time) + " seconds.", LogCategory::Info);
@@ -164,7 +164,23 @@ void DoomlikeGame::loadGame()
 	player.setup(1.5f, 7.0f, 7.0f, 0.3f);
 	Locator::getRenderer().SetCamera(&player.getCamera());
 
-	loadLevel(2);
+	//  the start level can be given by its index or its name
+	const std::string& start_level = getStartLevel();
+	const std::string levels_names[4]{ "test", "debug", "start", "advanced" };
+	int start_level_index = 2;
+	if (!start_level.empty())
+	{
+		int found_index = -1;
+		for (int i = 0; i < 4; i++)
+		{
+			if (start_level == std::to_string(i) || start_level == levels_names[i]) found_index = i;
+		}
+
+		if (found_index >= 0) start_level_index = found_index;
+		else Locator::getLog().LogMessage_Category("Doomlike: Unknown start level '" + start_level + "', the game starts in the 'start' level.", LogCategory::Warning);
+	}
+
+	loadLevel(start_level_index, false);
 }
 
 
@@ -197,6 +213,16 @@ void DoomlikeGame::updateGame(float dt)
 	{
 		loadLevel(3);
 	}
+
+	if (Input::IsKeyPressed(GLFW_KEY_KP_8))
+	{
+		benchmarkLevelsLoad(20);
+	}
+
+	if (Input::IsKeyPressed(GLFW_KEY_KP_9))
+	{
+		exportLevels();
+	}
 }
 
 void DoomlikeGame::restartLevel()
@@ -216,28 +242,95 @@ void DoomlikeGame::changeLevel(int levelIndex)
 	mustRestartLevel = true;
 }
 
-void DoomlikeGame::loadLevel(int index)
+void DoomlikeGame::loadLevel(int index, bool streamed)
 {
-	currentLevel = index;
+	Scene* level_scene = nullptr;
+	PlayerSpawnPoint* level_spawn_point = nullptr;
 	switch (index)
 	{
 	case 0:
-		loadScene(&testScene);
-		player.respawn(testScene);
+		level_scene = &testScene;
+		level_spawn_point = &testScene;
 		break;
 	case 1:
-		loadScene(&levelDebugScene);
-		player.respawn(levelDebugScene);
+		level_scene = &levelDebugScene;
+		level_spawn_point = &levelDebugScene;
 		break;
 	case 2:
-		loadScene(&levelStartScene);
-		player.respawn(levelStartScene);
+		level_scene = &levelStartScene;
+		level_spawn_point = &levelStartScene;
 		break;
 	case 3:
-		loadScene(&levelAdvancedScene);
-		player.respawn(levelAdvancedScene);
+		level_scene = &levelAdvancedScene;
+		level_spawn_point = &levelAdvancedScene;
 		break;
+	default:
+		return;
+	}
+
+	currentLevel = index;
+
+	if (!streamed)
+	{
+		loadScene(level_scene);
+		player.respawn(*level_spawn_point);
+		return;
+	}
+
+	streamScene(level_scene, [this, level_spawn_point]() { player.respawn(*level_spawn_point); });
+}
+
+void DoomlikeGame::exportLevels()
+{
+	for (DoomlikeLevel* level : { static_cast<DoomlikeLevel*>(&levelStartScene), static_cast<DoomlikeLevel*>(&levelAdvancedScene) })
+	{
+		level->setUseLevelFile(false);
+		loadScene(level);
+		level->exportLevel();
+		level->setUseLevelFile(true);
+	}
+
+	loadLevel(currentLevel, false);
+}
+
+void DoomlikeGame::benchmarkLevelsLoad(int iterations)
+{
+	Log& log = Locator::getLog();
+
+	for (DoomlikeLevel* level : { static_cast<DoomlikeLevel*>(&levelStartScene), static_cast<DoomlikeLevel*>(&levelAdvancedScene) })
+	{
+		for (bool use_level_file : { false, true })
+		{
+			level->setUseLevelFile(use_level_file);
+
+			//  the first load warms up the allocators and the file cache
+			loadScene(level);
+			if (level->isLoadedFromFile() != use_level_file)
+			{
+				log.LogMessage_Category("Doomlike: The level '" + level->getLevelName() + "' has no file to benchmark, export the levels first.", LogCategory::Warning);
+				continue;
+			}
+
+			double file_load_time = 0.0;
+			double build_time = 0.0;
+			for (int i = 0; i < iterations; i++)
+			{
+				loadScene(level);
+				if (use_level_file) file_load_time += level->getLastFileLoadTime();
+				build_time += level->getLastBuildTime();
+			}
+
+			file_load_time /= iterations;
+			build_time /= iterations;
+			log.LogMessage_Category("Doomlike: Level '" + level->getLevelName() + "' from its " + (use_level_file ? "file" : "code") + ": " +
+				std::to_string(file_load_time) + " ms to load the file, " + std::to_string(build_time) + " ms to build the level, " +
+				std::to_string(file_load_time + build_time) + " ms in total (average of " + std::to_string(iterations) + " loads).", LogCategory::Info);
+		}
+
+		level->setUseLevelFile(true);
 	}
+
+	loadLevel(currentLevel, false);
 }
 
 Camera& DoomlikeGame::getActiveCamera()
@@ -29,7 +29,14 @@ protected:
 	void unloadGame() override;
 
 private:
-	void loadLevel(int index);
+	//  a streamed level is loaded while the current one keeps playing, the player respawns once it is activated
+	void loadLevel(int index, bool streamed = true);
+
+	//  cook the files of the levels from their code, then reload the current level
+	void exportLevels();
+
+	//  compare the load times of the levels from their files and from their code
+	void benchmarkLevelsLoad(int iterations);
 
 	//  scenes
 	TestFpsScene testScene;
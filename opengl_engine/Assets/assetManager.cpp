@@ -11,6 +11,7 @@ std::unordered_map<std::string, std::unique_ptr<Texture>> AssetManager::textures
 std::unordered_map<std::string, std::unique_ptr<VertexArray>> AssetManager::vertexArrays;
 std::unordered_map<std::string, std::unique_ptr<Mesh>> AssetManager::meshesSingle;
 std::unordered_map<std::string, std::unique_ptr<MeshCollection>> AssetManager::meshesCollection;
+std::unordered_map<std::string, std::unique_ptr<TriangleMeshBVH>> AssetManager::collisionMeshes;
 std::unordered_map<std::string, std::unique_ptr<Model>> AssetManager::models;
 std::unordered_map<std::string, std::unique_ptr<Shader>> AssetManager::shaders;
 std::unordered_map<std::string, std::unique_ptr<Material>> AssetManager::materials;
@@ -192,6 +193,74 @@ void AssetManager::DeleteMeshCollection(const std::string& name)
 
 
 
+// --------------------------------------------------------------
+//            Collision Meshes
+// --------------------------------------------------------------
+
+void AssetManager::LoadCollisionMesh(const std::string& name, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+	if (collisionMeshes.find(name) != collisionMeshes.end())
+	{
+		Locator::getLog().LogMessage_Category("Asset Manager: Tried to load a collision mesh with a name that already exists. Name is " + name + ".", LogCategory::Error);
+		return;
+	}
+
+	collisionMeshes.emplace(name, std::make_unique<TriangleMeshBVH>(vertices, indices));
+}
+
+void AssetManager::LoadCollisionMesh(const std::string& name, const std::string& filepath)
+{
+	if (collisionMeshes.find(name) != collisionMeshes.end())
+	{
+		Locator::getLog().LogMessage_Category("Asset Manager: Tried to load a collision mesh with a name that already exists. Name is " + name + ".", LogCategory::Error);
+		return;
+	}
+
+	collisionMeshes.emplace(name, std::make_unique<TriangleMeshBVH>());
+	TriangleMeshBVH& collision_mesh = *collisionMeshes[name];
+
+	std::vector<LoadMeshData> meshes_datas = AssetMesh::LoadMeshCollection(filepath);
+	for (auto& mesh_data : meshes_datas)
+	{
+		collision_mesh.addMesh(mesh_data.vertices, mesh_data.indices);
+	}
+	collision_mesh.build();
+}
+
+TriangleMeshBVH& AssetManager::GetCollisionMesh(const std::string& name)
+{
+	if (collisionMeshes.find(name) == collisionMeshes.end())
+	{
+		Locator::getLog().LogMessage_Category("Asset Manager: Tried to get a collision mesh with a name that doesn't exists. Name is " + name + ".", LogCategory::Error);
+		return *collisionMeshes["null_collision_mesh"];
+	}
+
+	return *collisionMeshes[name];
+}
+
+std::string AssetManager::GetCollisionMeshName(const TriangleMeshBVH& collisionMesh)
+{
+	for (auto& stored_mesh : collisionMeshes)
+	{
+		if (stored_mesh.second.get() == &collisionMesh) return stored_mesh.first;
+	}
+
+	return "";
+}
+
+void AssetManager::DeleteCollisionMesh(const std::string& name)
+{
+	if (collisionMeshes.find(name) == collisionMeshes.end())
+	{
+		Locator::getLog().LogMessage_Category("Asset Manager: Tried to delete a collision mesh with a name that doesn't exists. Name is " + name + ".", LogCategory::Error);
+		return;
+	}
+
+	collisionMeshes.erase(name);
+}
+
+
+
 // --------------------------------------------------------------
 //            Models
 // --------------------------------------------------------------
@@ -219,6 +288,16 @@ Model& AssetManager::GetModel(const std::string& name)
 	return *models[name];
 }
 
+std::string AssetManager::GetModelName(const Model& model)
+{
+	for (auto& stored_model : models)
+	{
+		if (stored_model.second.get() == &model) return stored_model.first;
+	}
+
+	return "";
+}
+
 void AssetManager::DeleteModel(const std::string& name)
 {
 	if (models.find(name) == models.end())
@@ -465,6 +544,7 @@ void AssetManager::LoadNullAssets()
 	vertexArrays.emplace("null_vertexarray", std::make_unique<VertexArray>());
 	meshesSingle.emplace("null_mesh", std::make_unique<Mesh>());
 	meshesCollection.emplace("null_collection", std::make_unique<MeshCollection>());
+	collisionMeshes.emplace("null_collision_mesh", std::make_unique<TriangleMeshBVH>());
 	models.emplace("null_model", std::make_unique<Model>());
 	shaders.emplace("null_shader", std::make_unique<Shader>());
 	materials.emplace("null_material", std::make_unique<Material>(GetShader("null_shader")));
@@ -6,6 +6,7 @@
 #include <Rendering/Model/model.h>
 #include <Rendering/Text/font.h>
 #include <Audio/audioSound.h>
+#include <Physics/TriangleMesh/triangleMeshBVH.h>
 
 #include <unordered_map>
 #include <string>
@@ -128,6 +129,49 @@ public:
 
 
 
+// -----------------------------------------------------------------------------
+//                 Collision Meshes
+// -----------------------------------------------------------------------------
+
+	/**
+	* Build a collision mesh (the triangles and their BVH used by triangle mesh collisions) from handcoded vertices and stores it.
+	* @param	name		The name you want to give to this collision mesh in the asset storage.
+	* @param	vertices	The vertices of the mesh.
+	* @param	indices		The indices of the mesh.
+	*/
+	static void LoadCollisionMesh(const std::string& name, const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices = {});
+
+	/**
+	* Build a collision mesh from file and stores it.
+	* Every mesh of the file is added to the collision mesh, like a mesh collection.
+	* @param	name		The name you want to give to this collision mesh in the asset storage.
+	* @param	filepath	The path to the mesh file to read.
+	*/
+	static void LoadCollisionMesh(const std::string& name, const std::string& filepath);
+
+	/**
+	* Retrieve a collision mesh from the asset storage.
+	* @param	name	The name of the collision mesh you want to retrieve.
+	* @return			The collision mesh with corresponding name (if it exists).
+	*/
+	static TriangleMeshBVH& GetCollisionMesh(const std::string& name);
+
+	/**
+	* Retrieve the name a collision mesh is stored with, by searching all the collision meshes.
+	* @param	collisionMesh	The collision mesh you want the name of.
+	* @return					The name of the collision mesh, empty if it isn't in the asset storage.
+	*/
+	static std::string GetCollisionMeshName(const TriangleMeshBVH& collisionMesh);
+
+	/**
+	* Delete a collision mesh from the asset storage.
+	* The triangle mesh collisions that use it must have been deleted before.
+	* @param	name	The name of the collision mesh you want to delete.
+	*/
+	static void DeleteCollisionMesh(const std::string& name);
+
+
+
 // -----------------------------------------------------------------------------
 //                 Models
 // -----------------------------------------------------------------------------
@@ -146,6 +190,13 @@ public:
 	*/
 	static Model& GetModel(const std::string& name);
 
+	/**
+	* Retrieve the name a model is stored with, by searching all the models.
+	* @param	model	The model you want the name of.
+	* @return			The name of the model, empty if it isn't in the asset storage.
+	*/
+	static std::string GetModelName(const Model& model);
+
 	/**
 	* Delete a model from the asset storage.
 	* @param	name	The name of the model you want to delete.
@@ -318,6 +369,7 @@ private:
 	static std::unordered_map<std::string, std::unique_ptr<VertexArray>> vertexArrays;
 	static std::unordered_map<std::string, std::unique_ptr<Mesh>> meshesSingle;
 	static std::unordered_map<std::string, std::unique_ptr<MeshCollection>> meshesCollection;
+	static std::unordered_map<std::string, std::unique_ptr<TriangleMeshBVH>> collisionMeshes;
 	static std::unordered_map<std::string, std::unique_ptr<Model>> models;
 	static std::unordered_map<std::string, std::unique_ptr<Shader>> shaders;
 	static std::unordered_map<std::string, std::unique_ptr<Material>> materials;
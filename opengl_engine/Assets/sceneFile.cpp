@@ -0,0 +1,346 @@
+#include "sceneFile.h"
+#include "assetManager.h"
+#include <Core/scene.h>
+#include <Objects/object.h>
+#include <Objects/Lights/directionalLight.h>
+#include <Objects/Lights/pointLight.h>
+#include <Objects/Lights/spotLight.h>
+#include <Physics/AABB/boxAABBColComp.h>
+#include <Physics/OBB/orientedBoxColComp.h>
+#include <Physics/TriangleMesh/triangleMeshColComp.h>
+#include <ServiceLocator/locator.h>
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace
+{
+	bool IsRangeInFile(uint64_t offset, uint64_t count, uint64_t itemSize, uint64_t fileSize)
+	{
+		if (offset % 8 != 0 || offset > fileSize) return false;
+		return count * itemSize <= fileSize - offset;
+	}
+
+	//  checks of the fixed up pointers: a valid file only references itself
+	struct MappedRange
+	{
+		uintptr_t begin;
+		uintptr_t end;
+
+		//  the string starts in the file and its null character is in the file too
+		bool containsString(const SceneFileString& string) const
+		{
+			const uintptr_t first = static_cast<uintptr_t>(string.value);
+			if (first < begin || first >= end) return false;
+			return std::memchr(string.get(), 0, end - first) != nullptr;
+		}
+
+		//  an empty array has no items, its pointer isn't relocated
+		template<typename T>
+		bool containsArray(const SceneFileArray<T>& array) const
+		{
+			if (array.count == 0) return true;
+
+			const uintptr_t first = static_cast<uintptr_t>(array.items.value);
+			if (first < begin || first >= end || (first - begin) % 8 != 0) return false;
+			return array.count <= (end - first) / sizeof(T);
+		}
+	};
+
+	CollisionComponent* CreateCollision(const SceneFileCollider& fileCollider, Object& object)
+	{
+		const Box box{ SceneFile::ToVector3(fileCollider.boxCenter), SceneFile::ToVector3(fileCollider.boxHalfExtents) };
+		const CollisionType collision_type = static_cast<CollisionType>(fileCollider.type);
+		const std::string channel = fileCollider.channel.get();
+
+		switch (static_cast<CollisionShape>(fileCollider.shape))
+		{
+		case CollisionShape::BoxAABB:
+			return new BoxAABBColComp(box, &object, false, channel, collision_type,
+				(fileCollider.flags & SceneFileColliderFlags::ScaleBoxSizeWithTransform) != 0, (fileCollider.flags & SceneFileColliderFlags::MoveBoxCenterWithObjectScale) != 0);
+
+		case CollisionShape::OrientedBox:
+			return new OrientedBoxColComp(box, &object, false, channel, collision_type);
+
+		case CollisionShape::TriangleMesh:
+			return new TriangleMeshColComp(AssetManager::GetCollisionMesh(fileCollider.collisionMesh.get()), &object, false, channel, collision_type);
+
+		default:
+			return nullptr;
+		}
+	}
+}
+
+
+SceneFile::SceneFile()
+{
+}
+
+SceneFile::~SceneFile()
+{
+	release();
+}
+
+bool SceneFile::load(const std::string& filePath)
+{
+	release();
+	lastError.clear();
+
+	if (!file.open(filePath))
+	{
+		lastError = "Scene File: Unable to map the file " + filePath + ".";
+		return false;
+	}
+
+	header = reinterpret_cast<SceneFileHeader*>(file.getData());
+	if (!validate() || !fixUpPointers() || !validatePointers())
+	{
+		lastError = "Scene File: The file " + filePath + " isn't a valid scene file of this version.";
+		header = nullptr;
+		file.close();
+		return false;
+	}
+
+	loadedPath = filePath;
+	return true;
+}
+
+void SceneFile::instantiate(Scene& scene)
+{
+	if (!beginInstantiation()) return;
+
+	instantiateObjects(scene, 0, header->objects.size());
+	instantiateLights(scene);
+}
+
+bool SceneFile::beginInstantiation()
+{
+	if (!header)
+	{
+		Locator::getLog().LogMessage_Category("Scene File: Tried to instantiate a scene file that isn't loaded.", LogCategory::Error);
+		return false;
+	}
+
+	Locator::getRenderer().SetClearColor(getClearColor());
+
+	objects.reset(new Object[header->objects.size()]);
+
+	const SceneFileArray<SceneFileLight>& file_lights = header->lights;
+	int lights_counts[4]{ 0, 0, 0, 0 };
+	for (int i = 0; i < file_lights.size(); i++)
+	{
+		if (file_lights[i].type < 4) lights_counts[file_lights[i].type]++;
+	}
+
+	directionalLights.reset(new DirectionalLight[lights_counts[EDirectionalLight]]);
+	pointLights.reset(new PointLight[lights_counts[EPointLight]]);
+	spotLights.reset(new SpotLight[lights_counts[ESpotLight]]);
+	return true;
+}
+
+void SceneFile::instantiateObjects(Scene& scene, int first, int count)
+{
+	if (!header || !objects)
+	{
+		Locator::getLog().LogMessage_Category("Scene File: Tried to instantiate the objects of a scene file before beginning its instantiation.", LogCategory::Error);
+		return;
+	}
+
+	Physics& physics = Locator::getPhysics();
+
+	const SceneFileArray<SceneFileObject>& file_objects = header->objects;
+	const int end = std::min(first + count, file_objects.size());
+	for (int i = std::max(first, 0); i < end; i++)
+	{
+		const SceneFileObject& file_object = file_objects[i];
+		Object& object = objects[i];
+
+		object.setPosition(ToVector3(file_object.position));
+		object.setRotation(ToQuaternion(file_object.rotation));
+		object.setScale(ToVector3(file_object.scale));
+
+		for (int j = 0; j < file_object.models.size(); j++)
+		{
+			object.addModel(&AssetManager::GetModel(file_object.models[j].get()));
+		}
+
+		for (int j = 0; j < file_object.colliders.size(); j++)
+		{
+			const SceneFileCollider& file_collider = file_object.colliders[j];
+			CollisionComponent* collision = CreateCollision(file_collider, object);
+			if (!collision)
+			{
+				Locator::getLog().LogMessage_Category("Scene File: A collision of the file " + loadedPath + " has an unknown shape, it is skipped.", LogCategory::Warning);
+				continue;
+			}
+
+			physics.CreateCollisionComponent(collision).setStatic((file_collider.flags & SceneFileColliderFlags::StaticCollider) != 0);
+		}
+
+		scene.registerObject(&object);
+	}
+}
+
+void SceneFile::instantiateLights(Scene& scene)
+{
+	if (!header || !directionalLights || !pointLights || !spotLights)
+	{
+		Locator::getLog().LogMessage_Category("Scene File: Tried to instantiate the lights of a scene file before beginning its instantiation.", LogCategory::Error);
+		return;
+	}
+
+	//  lights, in one array by type
+	const SceneFileArray<SceneFileLight>& file_lights = header->lights;
+	int lights_indices[4]{ 0, 0, 0, 0 };
+	for (int i = 0; i < file_lights.size(); i++)
+	{
+		const SceneFileLight& file_light = file_lights[i];
+		const Color color{ file_light.color[0], file_light.color[1], file_light.color[2], file_light.color[3] };
+
+		Light* light = nullptr;
+		switch (file_light.type)
+		{
+		case EDirectionalLight:
+		{
+			DirectionalLight& directional_light = directionalLights[lights_indices[EDirectionalLight]++];
+			directional_light.load(color, ToVector3(file_light.direction), file_light.ambientStrength, file_light.diffuseStrength);
+			light = &directional_light;
+			break;
+		}
+
+		case EPointLight:
+		{
+			PointLight& point_light = pointLights[lights_indices[EPointLight]++];
+			point_light.load(color, ToVector3(file_light.position), file_light.ambientStrength, file_light.diffuseStrength,
+				file_light.constant, file_light.linear, file_light.quadratic);
+			point_light.setUseDiffColorToSpecColor((file_light.flags & SceneFileLightFlags::UseDiffColorToSpecColor) != 0);
+			light = &point_light;
+			break;
+		}
+
+		case ESpotLight:
+		{
+			SpotLight& spot_light = spotLights[lights_indices[ESpotLight]++];
+			spot_light.load(color, ToVector3(file_light.position), ToVector3(file_light.direction), file_light.ambientStrength, file_light.diffuseStrength,
+				file_light.cutOff, file_light.outerCutOff, file_light.constant, file_light.linear, file_light.quadratic);
+			light = &spot_light;
+			break;
+		}
+
+		default:
+			Locator::getLog().LogMessage_Category("Scene File: A light of the file " + loadedPath + " has an unknown type, it is skipped.", LogCategory::Warning);
+			continue;
+		}
+
+		if (file_light.flags & SceneFileLightFlags::LightOff) light->turnOff();
+		scene.registerLight(light);
+	}
+}
+
+void SceneFile::release()
+{
+	objects.reset();
+	directionalLights.reset();
+	pointLights.reset();
+	spotLights.reset();
+
+	header = nullptr;
+	file.close();
+	loadedPath.clear();
+}
+
+Object* SceneFile::findObject(const std::string& name) const
+{
+	if (!header || !objects) return nullptr;
+
+	const SceneFileArray<SceneFileObject>& file_objects = header->objects;
+	for (int i = 0; i < file_objects.size(); i++)
+	{
+		if (name == file_objects[i].name.get()) return &objects[i];
+	}
+
+	return nullptr;
+}
+
+Color SceneFile::getClearColor() const
+{
+	if (!header) return Color::black;
+	return Color{ header->clearColor[0], header->clearColor[1], header->clearColor[2], header->clearColor[3] };
+}
+
+
+bool SceneFile::validate() const
+{
+	const uint64_t file_size = file.getSize();
+	if (file_size < sizeof(SceneFileHeader)) return false;
+	if (!std::equal(header->magic, header->magic + sizeof(SCENE_FILE_MAGIC), SCENE_FILE_MAGIC) || header->version != SCENE_FILE_VERSION) return false;
+
+	if (header->fileSize != file_size) return false;
+
+	//  the arrays and strings are checked once their pointers are fixed up
+	return IsRangeInFile(header->relocationsOffset, header->relocationsCount, sizeof(uint64_t), file_size);
+}
+
+bool SceneFile::fixUpPointers()
+{
+	unsigned char* data = file.getData();
+	const uint64_t file_size = file.getSize();
+
+	//  writing the pointers only touches the pages that have some, the others stay shared with the file
+	const uint64_t* relocations = reinterpret_cast<const uint64_t*>(data + header->relocationsOffset);
+	for (uint32_t i = 0; i < header->relocationsCount; i++)
+	{
+		const uint64_t relocation = relocations[i];
+		if (relocation % 8 != 0 || relocation > file_size - sizeof(uint64_t)) return false;
+
+		uint64_t& pointer = *reinterpret_cast<uint64_t*>(data + relocation);
+		if (pointer >= file_size) return false;
+
+		pointer = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(data + pointer));
+	}
+
+	return true;
+}
+
+bool SceneFile::validatePointers() const
+{
+	//  a pointer without relocation is still an offset, and a relocated pointer can still be in the middle of anything: every array
+	//  and string the instantiation reads is checked against the mapped file
+	const uintptr_t data = reinterpret_cast<uintptr_t>(file.getData());
+	const MappedRange range{ data, data + static_cast<uintptr_t>(file.getSize()) };
+
+	if (!range.containsArray(header->objects) || !range.containsArray(header->lights) ||
+		!range.containsArray(header->triggerZones) || !range.containsArray(header->markers)) return false;
+
+	for (int i = 0; i < header->objects.size(); i++)
+	{
+		const SceneFileObject& file_object = header->objects[i];
+		if (!range.containsString(file_object.name)) return false;
+
+		if (!range.containsArray(file_object.models)) return false;
+		for (int j = 0; j < file_object.models.size(); j++)
+		{
+			if (!range.containsString(file_object.models[j])) return false;
+		}
+
+		if (!range.containsArray(file_object.colliders)) return false;
+		for (int j = 0; j < file_object.colliders.size(); j++)
+		{
+			const SceneFileCollider& file_collider = file_object.colliders[j];
+			if (!range.containsString(file_collider.channel) || !range.containsString(file_collider.collisionMesh)) return false;
+		}
+	}
+
+	for (int i = 0; i < header->triggerZones.size(); i++)
+	{
+		if (!range.containsString(header->triggerZones[i].name)) return false;
+	}
+
+	for (int i = 0; i < header->markers.size(); i++)
+	{
+		if (!range.containsString(header->markers[i].name) || !range.containsString(header->markers[i].type)) return false;
+	}
+
+	return true;
+}
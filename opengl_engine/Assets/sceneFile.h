@@ -0,0 +1,247 @@
+#pragma once
+#include <Utils/mappedFile.h>
+#include <Utils/color.h>
+#include <Maths/vector3.h>
+#include <Maths/quaternion.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class Scene;
+class Object;
+class DirectionalLight;
+class PointLight;
+class SpotLight;
+
+
+// ============================================================================
+//  ---------------- Cooked scene file layout --------------------------------
+// ============================================================================
+
+//  the layout is the same in the file and in memory: the records only hold fixed size values, 8 bytes aligned,
+//  and every reference is a 64 bits offset from the start of the file, turned into a pointer by the relocation table when the file is loaded
+
+const char SCENE_FILE_MAGIC[4] = { 'C', 'Y', 'S', 'C' };
+const uint32_t SCENE_FILE_VERSION = 1;
+const std::string SCENE_FILE_EXTENSION{ ".cyscene" };
+
+
+/** Scene File Pointer
+* Offset in the file until the file is loaded, then a pointer in the mapped file (64 bits either way).
+*/
+template<typename T>
+struct SceneFilePointer
+{
+	uint64_t value{ 0 };
+
+	inline const T* get() const { return reinterpret_cast<const T*>(static_cast<uintptr_t>(value)); }
+};
+
+template<typename T>
+struct SceneFileArray
+{
+	SceneFilePointer<T> items;
+	uint32_t count{ 0 };
+	uint32_t padding{ 0 };
+
+	inline const T& operator[](int index) const { return items.get()[index]; }
+	inline int size() const { return static_cast<int>(count); }
+};
+
+//  null terminated string of the strings table, the assets are referenced by the name they are stored with in the asset manager
+using SceneFileString = SceneFilePointer<char>;
+
+
+enum SceneFileColliderFlags : uint8_t
+{
+	StaticCollider = 1 << 0,
+	ScaleBoxSizeWithTransform = 1 << 1,
+	MoveBoxCenterWithObjectScale = 1 << 2
+};
+
+enum SceneFileLightFlags : uint8_t
+{
+	LightOff = 1 << 0,
+	UseDiffColorToSpecColor = 1 << 1
+};
+
+
+struct SceneFileCollider
+{
+	SceneFileString channel;
+	SceneFileString collisionMesh; //  triangle mesh collisions only
+	float boxCenter[3];
+	float boxHalfExtents[3];
+	uint8_t shape; //  CollisionShape
+	uint8_t type; //  CollisionType
+	uint8_t flags; //  SceneFileColliderFlags
+	uint8_t padding[5];
+};
+
+struct SceneFileObject
+{
+	SceneFileString name; //  empty for the objects the gameplay doesn't need to find
+	SceneFileArray<SceneFileString> models;
+	SceneFileArray<SceneFileCollider> colliders;
+	float position[3];
+	float rotation[4]; //  quaternion x, y, z, w
+	float scale[3];
+};
+
+struct SceneFileLight
+{
+	uint8_t type; //  LightType
+	uint8_t flags; //  SceneFileLightFlags
+	uint8_t color[4];
+	uint8_t padding[2];
+	float position[3];
+	float direction[3];
+	float ambientStrength;
+	float diffuseStrength;
+	float constant;
+	float linear;
+	float quadratic;
+	float cutOff;
+	float outerCutOff;
+	float padding2;
+};
+
+struct SceneFileTriggerZone
+{
+	SceneFileString name;
+	float position[3];
+	float size[3];
+};
+
+//  a gameplay object the engine doesn't know about (spawn point, enemy...), created by the game from its type and parameters
+struct SceneFileMarker
+{
+	SceneFileString name;
+	SceneFileString type;
+	float position[3];
+	float rotation[4];
+	float params[4];
+	float padding;
+};
+
+struct SceneFileHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint64_t fileSize;
+
+	SceneFileArray<SceneFileObject> objects;
+	SceneFileArray<SceneFileLight> lights;
+	SceneFileArray<SceneFileTriggerZone> triggerZones;
+	SceneFileArray<SceneFileMarker> markers;
+
+	//  offsets of every pointer of the file, the table itself holds plain offsets
+	uint64_t relocationsOffset;
+	uint32_t relocationsCount;
+
+	uint8_t clearColor[4];
+};
+
+static_assert(sizeof(SceneFileCollider) == 48, "Scene File: the collider record layout changed, the version must be increased.");
+static_assert(sizeof(SceneFileObject) == 80, "Scene File: the object record layout changed, the version must be increased.");
+static_assert(sizeof(SceneFileLight) == 64, "Scene File: the light record layout changed, the version must be increased.");
+static_assert(sizeof(SceneFileTriggerZone) == 32, "Scene File: the trigger zone record layout changed, the version must be increased.");
+static_assert(sizeof(SceneFileMarker) == 64, "Scene File: the marker record layout changed, the version must be increased.");
+static_assert(sizeof(SceneFileHeader) == 96, "Scene File: the header layout changed, the version must be increased.");
+
+
+
+/** Scene File
+* A cooked scene (objects with their models and collisions, lights, trigger zones and gameplay markers) loaded from a flat binary file.
+* The file is mapped in memory and its pointers are fixed in place, so loading it is one mapping and one pass on the relocations,
+* and instantiating it allocates the objects and lights in one array of each type instead of one allocation per object.
+* The files are written by the Scene File Writer.
+*/
+class SceneFile
+{
+public:
+	SceneFile();
+	~SceneFile();
+	SceneFile(const SceneFile&) = delete;
+	SceneFile& operator=(const SceneFile&) = delete;
+
+	/**
+	* Map a scene file and fix up its pointers, the file loaded before is released. Doesn't use any engine service (not even the log),
+	* so it can run on a worker thread (from the preload of a scene). The reason of a failure is kept for the caller to log it.
+	* @param	filePath	Path of the scene file.
+	* @return				False if the file can't be mapped or isn't a valid scene file of this version.
+	*/
+	bool load(const std::string& filePath);
+
+	//  reason of the last failed load, empty if the last load succeeded
+	inline const std::string& getLastError() const { return lastError; }
+
+	/**
+	* Create the objects, collisions and lights of the loaded file and register them in a scene, on the main thread (from the load of the scene).
+	* The clear color of the file is given to the renderer.
+	* @param	scene	Scene the objects and lights are registered in.
+	*/
+	void instantiate(Scene& scene);
+
+	/**
+	* First part of an instantiation split in several steps (to spread it on several frames): allocate the objects and lights
+	* of the loaded file and give its clear color to the renderer. The objects and lights are then created by instantiateObjects and instantiateLights.
+	* @return	False if no file is loaded.
+	*/
+	bool beginInstantiation();
+
+	/**
+	* Create a range of the objects of the loaded file with their models and collisions and register them in a scene, after beginInstantiation.
+	* @param	scene	Scene the objects are registered in.
+	* @param	first	Index of the first object to create.
+	* @param	count	Number of objects to create, the range is clamped to the objects of the file.
+	*/
+	void instantiateObjects(Scene& scene, int first, int count);
+
+	/**
+	* Create the lights of the loaded file and register them in a scene, after beginInstantiation.
+	* @param	scene	Scene the lights are registered in.
+	*/
+	void instantiateLights(Scene& scene);
+
+	/**
+	* Unmap the file and delete what was instantiated. The scene they were registered in must have been unloaded before.
+	*/
+	void release();
+
+	inline bool isLoaded() const { return header != nullptr; }
+	inline const std::string& getLoadedPath() const { return loadedPath; }
+
+	/**
+	* Find an instantiated object by the name it was given in the file.
+	* @param	name	Name of the object.
+	* @return			The object, null if no object of the file has this name.
+	*/
+	Object* findObject(const std::string& name) const;
+
+	Color getClearColor() const;
+
+	inline const SceneFileArray<SceneFileObject>& getObjects() const { return header->objects; }
+	inline const SceneFileArray<SceneFileLight>& getLights() const { return header->lights; }
+	inline const SceneFileArray<SceneFileTriggerZone>& getTriggerZones() const { return header->triggerZones; }
+	inline const SceneFileArray<SceneFileMarker>& getMarkers() const { return header->markers; }
+
+	static Vector3 ToVector3(const float values[3]) { return Vector3{ values[0], values[1], values[2] }; }
+	static Quaternion ToQuaternion(const float values[4]) { return Quaternion{ values[0], values[1], values[2], values[3] }; }
+
+private:
+	bool validate() const;
+	bool fixUpPointers();
+	bool validatePointers() const;
+
+	MappedFile file;
+	SceneFileHeader* header{ nullptr };
+	std::string loadedPath;
+	std::string lastError;
+
+	std::unique_ptr<Object[]> objects;
+	std::unique_ptr<DirectionalLight[]> directionalLights;
+	std::unique_ptr<PointLight[]> pointLights;
+	std::unique_ptr<SpotLight[]> spotLights;
+};
@@ -0,0 +1,350 @@
+#include "sceneFileWriter.h"
+#include "assetManager.h"
+#include <Objects/object.h>
+#include <Objects/Lights/directionalLight.h>
+#include <Objects/Lights/pointLight.h>
+#include <Objects/Lights/spotLight.h>
+#include <Physics/AABB/boxAABBColComp.h>
+#include <Physics/OBB/orientedBoxColComp.h>
+#include <Physics/TriangleMesh/triangleMeshColComp.h>
+#include <ServiceLocator/locator.h>
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <utility>
+
+
+namespace
+{
+	void CopyVector3(const Vector3& value, float outValues[3])
+	{
+		outValues[0] = value.x;
+		outValues[1] = value.y;
+		outValues[2] = value.z;
+	}
+
+	void CopyQuaternion(const Quaternion& value, float outValues[4])
+	{
+		outValues[0] = value.x;
+		outValues[1] = value.y;
+		outValues[2] = value.z;
+		outValues[3] = value.w;
+	}
+
+	void CopyColor(const Color& value, uint8_t outValues[4])
+	{
+		outValues[0] = static_cast<uint8_t>(value.r);
+		outValues[1] = static_cast<uint8_t>(value.g);
+		outValues[2] = static_cast<uint8_t>(value.b);
+		outValues[3] = static_cast<uint8_t>(value.a);
+	}
+
+
+	/** Scene File Builder
+	* Bytes of a scene file being laid out, with the offsets of the pointers it holds and the strings to add at its end.
+	* Only offsets are kept while building, the bytes move each time the file grows.
+	*/
+	class SceneFileBuilder
+	{
+	public:
+		uint64_t allocate(size_t size, size_t alignment = 8)
+		{
+			const uint64_t offset = (bytes.size() + alignment - 1) & ~static_cast<uint64_t>(alignment - 1);
+			bytes.resize(static_cast<size_t>(offset + size), 0);
+			return offset;
+		}
+
+		//  the array field is left empty (without relocation) if the array has no item
+		void setArray(uint64_t arrayOffset, uint64_t itemsOffset, size_t count)
+		{
+			SceneFileArray<char>& array = *reinterpret_cast<SceneFileArray<char>*>(bytes.data() + arrayOffset);
+			array.count = static_cast<uint32_t>(count);
+			if (count == 0) return;
+
+			array.items.value = itemsOffset;
+			relocations.push_back(arrayOffset + offsetof(SceneFileArray<char>, items));
+		}
+
+		void setString(uint64_t stringOffset, const std::string& value)
+		{
+			strings.emplace_back(stringOffset, value);
+			relocations.push_back(stringOffset);
+		}
+
+		//  the relocation table then the strings table, which must stay at the end of the file
+		void finish(SceneFileHeader& header)
+		{
+			header.relocationsCount = static_cast<uint32_t>(relocations.size());
+			header.relocationsOffset = allocate(sizeof(uint64_t) * relocations.size());
+			std::memcpy(bytes.data() + header.relocationsOffset, relocations.data(), sizeof(uint64_t) * relocations.size());
+
+			std::unordered_map<std::string, uint64_t> strings_offsets;
+			strings_offsets[""] = allocate(1, 1);
+			for (auto& string : strings)
+			{
+				auto iter = strings_offsets.find(string.second);
+				if (iter == strings_offsets.end())
+				{
+					const uint64_t string_offset = allocate(string.second.size() + 1, 1);
+					std::memcpy(bytes.data() + string_offset, string.second.c_str(), string.second.size() + 1);
+					iter = strings_offsets.emplace(string.second, string_offset).first;
+				}
+
+				*reinterpret_cast<uint64_t*>(bytes.data() + string.first) = iter->second;
+			}
+
+			header.fileSize = bytes.size();
+		}
+
+		inline unsigned char* data() { return bytes.data(); }
+		inline size_t size() const { return bytes.size(); }
+
+	private:
+		std::vector<unsigned char> bytes;
+		std::vector<uint64_t> relocations;
+		std::vector<std::pair<uint64_t, std::string>> strings; //  offset of the string pointer, value
+	};
+}
+
+
+void SceneFileWriter::captureObject(const Object& object, const std::string& name)
+{
+	StagedObject staged;
+	staged.name = name;
+	CopyVector3(object.getPosition(), staged.record.position);
+	CopyQuaternion(object.getRotation(), staged.record.rotation);
+	CopyVector3(object.getScale(), staged.record.scale);
+
+	for (auto model : object.getModels())
+	{
+		const std::string model_name = AssetManager::GetModelName(*model);
+		if (model_name.empty())
+		{
+			Locator::getLog().LogMessage_Category("Scene File Writer: A model of an object isn't in the asset manager, it can't be written.", LogCategory::Warning);
+			continue;
+		}
+		staged.models.push_back(model_name);
+	}
+
+	std::vector<const CollisionComponent*> collisions;
+	Locator::getPhysics().GetObjectCollisions(object, collisions);
+	for (auto collision : collisions)
+	{
+		if (collision->usedByRigidbody()) continue;
+
+		StagedCollider collider;
+		collider.channel = collision->getCollisionChannel();
+		collider.record.shape = static_cast<uint8_t>(collision->getCollisionShape());
+		collider.record.type = static_cast<uint8_t>(collision->getCollisionType());
+		if (collision->isStatic()) collider.record.flags |= SceneFileColliderFlags::StaticCollider;
+
+		Box box{ Box::zero };
+		switch (collision->getCollisionShape())
+		{
+		case CollisionShape::BoxAABB:
+		{
+			const BoxAABBColComp* box_collision = static_cast<const BoxAABBColComp*>(collision);
+			box = box_collision->getBox();
+			if (box_collision->getScaleBoxSizeWithTransform()) collider.record.flags |= SceneFileColliderFlags::ScaleBoxSizeWithTransform;
+			if (box_collision->getMoveBoxCenterWithObjectScale()) collider.record.flags |= SceneFileColliderFlags::MoveBoxCenterWithObjectScale;
+			break;
+		}
+
+		case CollisionShape::OrientedBox:
+			box = static_cast<const OrientedBoxColComp*>(collision)->getBox();
+			break;
+
+		case CollisionShape::TriangleMesh:
+		{
+			const TriangleMeshBVH* triangle_mesh = static_cast<const TriangleMeshColComp*>(collision)->getTriangleMesh();
+			if (triangle_mesh) collider.collisionMesh = AssetManager::GetCollisionMeshName(*triangle_mesh);
+			if (collider.collisionMesh.empty())
+			{
+				Locator::getLog().LogMessage_Category("Scene File Writer: The collision mesh of a triangle mesh collision isn't in the asset manager, it can't be written.", LogCategory::Warning);
+				continue;
+			}
+			break;
+		}
+
+		default:
+			continue;
+		}
+
+		CopyVector3(box.getCenterPoint(), collider.record.boxCenter);
+		CopyVector3(box.getHalfExtents(), collider.record.boxHalfExtents);
+		staged.colliders.push_back(collider);
+	}
+
+	objects.push_back(staged);
+}
+
+void SceneFileWriter::captureLight(Light& light)
+{
+	SceneFileLight record{};
+	record.type = static_cast<uint8_t>(light.getLightType());
+	if (light.isOff()) record.flags |= SceneFileLightFlags::LightOff;
+	CopyColor(light.getColor(), record.color);
+	record.ambientStrength = light.getAmbientStrength();
+	record.diffuseStrength = light.getDiffuseStrength();
+
+	switch (light.getLightType())
+	{
+	case EDirectionalLight:
+		CopyVector3(static_cast<DirectionalLight&>(light).getDirection(), record.direction);
+		break;
+
+	case EPointLight:
+	{
+		PointLight& point_light = static_cast<PointLight&>(light);
+		CopyVector3(point_light.getPosition(), record.position);
+		record.constant = point_light.getConstant();
+		record.linear = point_light.getLinear();
+		record.quadratic = point_light.getQuadratic();
+		if (point_light.getUseDiffColorToSpecColor()) record.flags |= SceneFileLightFlags::UseDiffColorToSpecColor;
+		break;
+	}
+
+	case ESpotLight:
+	{
+		SpotLight& spot_light = static_cast<SpotLight&>(light);
+		CopyVector3(spot_light.getPosition(), record.position);
+		CopyVector3(spot_light.getDirection(), record.direction);
+		record.cutOff = spot_light.getCutOff();
+		record.outerCutOff = spot_light.getOuterCutOff();
+		record.constant = spot_light.getConstant();
+		record.linear = spot_light.getLinear();
+		record.quadratic = spot_light.getQuadratic();
+		break;
+	}
+
+	default:
+		Locator::getLog().LogMessage_Category("Scene File Writer: Tried to capture a light that isn't loaded.", LogCategory::Warning);
+		return;
+	}
+
+	lights.push_back(record);
+}
+
+void SceneFileWriter::addTriggerZone(const std::string& name, const Vector3& position, const Vector3& size)
+{
+	StagedTriggerZone staged;
+	staged.name = name;
+	CopyVector3(position, staged.record.position);
+	CopyVector3(size, staged.record.size);
+	triggerZones.push_back(staged);
+}
+
+void SceneFileWriter::addMarker(const std::string& name, const std::string& type, const Vector3& position, const Quaternion& rotation, const std::vector<float>& params)
+{
+	StagedMarker staged;
+	staged.name = name;
+	staged.type = type;
+	CopyVector3(position, staged.record.position);
+	CopyQuaternion(rotation, staged.record.rotation);
+
+	const size_t max_params = sizeof(staged.record.params) / sizeof(float);
+	if (params.size() > max_params)
+	{
+		Locator::getLog().LogMessage_Category("Scene File Writer: A '" + type + "' marker has more than " + std::to_string(max_params) + " parameters, the others are dropped.", LogCategory::Warning);
+	}
+	for (size_t i = 0; i < params.size() && i < max_params; i++)
+	{
+		staged.record.params[i] = params[i];
+	}
+
+	markers.push_back(staged);
+}
+
+bool SceneFileWriter::write(const std::string& filePath) const
+{
+	SceneFileBuilder builder;
+
+	//  the header and the arrays of records first, then the arrays of each object
+	const uint64_t header_offset = builder.allocate(sizeof(SceneFileHeader));
+	const uint64_t objects_offset = builder.allocate(sizeof(SceneFileObject) * objects.size());
+	const uint64_t lights_offset = builder.allocate(sizeof(SceneFileLight) * lights.size());
+	const uint64_t trigger_zones_offset = builder.allocate(sizeof(SceneFileTriggerZone) * triggerZones.size());
+	const uint64_t markers_offset = builder.allocate(sizeof(SceneFileMarker) * markers.size());
+
+	for (size_t i = 0; i < objects.size(); i++)
+	{
+		const StagedObject& staged = objects[i];
+		const uint64_t object_offset = objects_offset + i * sizeof(SceneFileObject);
+		std::memcpy(builder.data() + object_offset, &staged.record, sizeof(SceneFileObject));
+		builder.setString(object_offset + offsetof(SceneFileObject, name), staged.name);
+
+		const uint64_t models_offset = builder.allocate(sizeof(SceneFileString) * staged.models.size());
+		for (size_t j = 0; j < staged.models.size(); j++)
+		{
+			builder.setString(models_offset + j * sizeof(SceneFileString), staged.models[j]);
+		}
+		builder.setArray(object_offset + offsetof(SceneFileObject, models), models_offset, staged.models.size());
+
+		const uint64_t colliders_offset = builder.allocate(sizeof(SceneFileCollider) * staged.colliders.size());
+		for (size_t j = 0; j < staged.colliders.size(); j++)
+		{
+			const uint64_t collider_offset = colliders_offset + j * sizeof(SceneFileCollider);
+			std::memcpy(builder.data() + collider_offset, &staged.colliders[j].record, sizeof(SceneFileCollider));
+			builder.setString(collider_offset + offsetof(SceneFileCollider, channel), staged.colliders[j].channel);
+			builder.setString(collider_offset + offsetof(SceneFileCollider, collisionMesh), staged.colliders[j].collisionMesh);
+		}
+		builder.setArray(object_offset + offsetof(SceneFileObject, colliders), colliders_offset, staged.colliders.size());
+	}
+
+	if (!lights.empty()) std::memcpy(builder.data() + lights_offset, lights.data(), sizeof(SceneFileLight) * lights.size());
+
+	for (size_t i = 0; i < triggerZones.size(); i++)
+	{
+		const uint64_t zone_offset = trigger_zones_offset + i * sizeof(SceneFileTriggerZone);
+		std::memcpy(builder.data() + zone_offset, &triggerZones[i].record, sizeof(SceneFileTriggerZone));
+		builder.setString(zone_offset + offsetof(SceneFileTriggerZone, name), triggerZones[i].name);
+	}
+
+	for (size_t i = 0; i < markers.size(); i++)
+	{
+		const uint64_t marker_offset = markers_offset + i * sizeof(SceneFileMarker);
+		std::memcpy(builder.data() + marker_offset, &markers[i].record, sizeof(SceneFileMarker));
+		builder.setString(marker_offset + offsetof(SceneFileMarker, name), markers[i].name);
+		builder.setString(marker_offset + offsetof(SceneFileMarker, type), markers[i].type);
+	}
+
+	builder.setArray(header_offset + offsetof(SceneFileHeader, objects), objects_offset, objects.size());
+	builder.setArray(header_offset + offsetof(SceneFileHeader, lights), lights_offset, lights.size());
+	builder.setArray(header_offset + offsetof(SceneFileHeader, triggerZones), trigger_zones_offset, triggerZones.size());
+	builder.setArray(header_offset + offsetof(SceneFileHeader, markers), markers_offset, markers.size());
+
+	SceneFileHeader header = *reinterpret_cast<SceneFileHeader*>(builder.data() + header_offset);
+	std::memcpy(header.magic, SCENE_FILE_MAGIC, sizeof(SCENE_FILE_MAGIC));
+	header.version = SCENE_FILE_VERSION;
+	CopyColor(clearColor, header.clearColor);
+	builder.finish(header);
+	std::memcpy(builder.data() + header_offset, &header, sizeof(SceneFileHeader));
+
+
+	std::ofstream stream(filePath, std::ios::binary);
+	if (!stream.is_open())
+	{
+		Locator::getLog().LogMessage_Category("Scene File Writer: Unable to open the file " + filePath + " to write the scene.", LogCategory::Error);
+		return false;
+	}
+
+	stream.write(reinterpret_cast<const char*>(builder.data()), builder.size());
+	if (!stream)
+	{
+		Locator::getLog().LogMessage_Category("Scene File Writer: Failed to write the scene in the file " + filePath + ".", LogCategory::Error);
+		return false;
+	}
+
+	return true;
+}
+
+void SceneFileWriter::clear()
+{
+	clearColor = Color::black;
+	objects.clear();
+	lights.clear();
+	triggerZones.clear();
+	markers.clear();
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "sceneFile.h"
+
+#include <string>
+#include <vector>
+
+class Object;
+class Light;
+
+
+/** Scene File Writer
+* Cooks a scene file: the objects and lights are captured from a loaded scene (transforms, models, collisions and light values),
+* the trigger zones and markers are given by the game. The models and collision meshes are written with their names in the asset manager.
+*/
+class SceneFileWriter
+{
+public:
+	inline void setClearColor(Color clearColor_) { clearColor = clearColor_; }
+
+	/**
+	* Capture an object: its transform, its models and the collisions associated to it (not the ones of its rigidbodies).
+	* The models and collision meshes that aren't in the asset manager are skipped with a warning.
+	* @param	object	Object to capture.
+	* @param	name	Name to find the object with once the file is instantiated, empty if the gameplay doesn't need it.
+	*/
+	void captureObject(const Object& object, const std::string& name = "");
+
+	/**
+	* Capture a light with its current values.
+	* @param	light	Light to capture.
+	*/
+	void captureLight(Light& light);
+
+	void addTriggerZone(const std::string& name, const Vector3& position, const Vector3& size);
+
+	/**
+	* Add a gameplay marker, the game creates what it stands for when it loads the file.
+	* @param	name		Name of the marker, empty if the gameplay doesn't need to find it.
+	* @param	type		Type of the marker, known by the game.
+	* @param	position	Position of the marker.
+	* @param	rotation	Rotation of the marker.
+	* @param	params		Parameters of the marker, their meaning depends on its type.
+	*/
+	void addMarker(const std::string& name, const std::string& type, const Vector3& position, const Quaternion& rotation, const std::vector<float>& params = {});
+
+	/**
+	* Lay out everything that was added in the flat layout of the scene files and save it.
+	* @param	filePath	Path of the file to write.
+	* @return				True if the file has been written.
+	*/
+	bool write(const std::string& filePath) const;
+
+	void clear();
+
+private:
+	struct StagedCollider
+	{
+		SceneFileCollider record{};
+		std::string channel;
+		std::string collisionMesh;
+	};
+
+	struct StagedObject
+	{
+		SceneFileObject record{};
+		std::string name;
+		std::vector<std::string> models;
+		std::vector<StagedCollider> colliders;
+	};
+
+	struct StagedTriggerZone
+	{
+		SceneFileTriggerZone record{};
+		std::string name;
+	};
+
+	struct StagedMarker
+	{
+		SceneFileMarker record{};
+		std::string name;
+		std::string type;
+	};
+
+	Color clearColor{ Color::black };
+	std::vector<StagedObject> objects;
+	std::vector<SceneFileLight> lights;
+	std::vector<StagedTriggerZone> triggerZones;
+	std::vector<StagedMarker> markers;
+};
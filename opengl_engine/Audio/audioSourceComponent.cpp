@@ -15,7 +15,7 @@ AudioSourceComponent::AudioSourceComponent(Object* objectToAssociate, ChannelSpa
 
 	if (sourceSpatialization == ChannelSpatialization::Channel3D)
 	{
-		associatedObject->onTransformUpdated.registerObserver(this, Bind_0(&AudioSourceComponent::onAssociatedObjectMoved));
+		associatedObject->onTransformUpdated.registerObserver(this, &AudioSourceComponent::onAssociatedObjectMoved);
 	}
 }
 
@@ -23,7 +23,7 @@ AudioSourceComponent::AudioSourceComponent(const AudioSourceComponent& other) :
 {
 	if (sourceSpatialization == ChannelSpatialization::Channel3D)
 	{
-		associatedObject->onTransformUpdated.registerObserver(this, Bind_0(&AudioSourceComponent::onAssociatedObjectMoved));
+		associatedObject->onTransformUpdated.registerObserver(this, &AudioSourceComponent::onAssociatedObjectMoved);
 	}
 }
 
@@ -35,7 +35,7 @@ AudioSourceComponent::AudioSourceComponent(const AudioSourceComponent& other) :
 
 	if (sourceSpatialization == ChannelSpatialization::Channel3D)
 	{
-		associatedObject->onTransformUpdated.registerObserver(this, Bind_0(&AudioSourceComponent::onAssociatedObjectMoved));
+		associatedObject->onTransformUpdated.registerObserver(this, &AudioSourceComponent::onAssociatedObjectMoved);
 	}
 
 	return *this;
@@ -5,17 +5,51 @@
 #include <Inputs/input.h>
 #include <ServiceLocator/locator.h>
 #include <Physics/physicsManager.h>
+#include <Physics/physicsBenchmarks.h>
+#include <ECS/ecsBenchmarks.h>
+#include <Events/eventBenchmarks.h>
+#include "jobSystemBenchmarks.h"
 #include <GameplayStatics/gameplayStatics.h>
+#include <Maths/Maths.h>
+#include <Utils/allocationCounter.h>
+#include <Utils/frameArena.h>
+#include <atomic>
+#include <csignal>
+#include <iomanip>
 #include <iostream>
+#include <thread>
+
+
+namespace
+{
+	//  set when the process is interrupted, so that an endless headless run still closes properly
+	std::atomic<bool> HeadlessInterrupted{ false };
+
+	void OnHeadlessInterrupt(int signal)
+	{
+		HeadlessInterrupted.store(true);
+	}
+
+	const char* SUBSYSTEMS_NAMES[static_cast<int>(EngineSubsystem::Count)]
+	{
+		"Physics", "Game", "Scene", "Systems", "Sync", "Rendering", "Audio", "Log", "Events"
+	};
+}
 
 
 Engine::Engine()
 {
 }
 
+Engine::Engine(const EngineSettings& settings_) : settings(settings_)
+{
+}
+
 
 bool Engine::initialize(int wndw_width, int wndw_height, std::string wndw_name, bool wndw_capturemouse)
 {
+	const auto initialization_start = std::chrono::high_resolution_clock::now();
+
 	std::cout << "Initializing...\n\n\n";
 
 	std::cout << "==================================================" << std::endl;
@@ -28,54 +62,63 @@ bool Engine::initialize(int wndw_width, int wndw_height, std::string wndw_name,
 	std::cout << "==================================================" << std::endl << std::endl << std::endl;
 
 
-	//  create window and initialize glfw
-	std::cout << "Initializing window...";
-	window.createWindow(wndw_width, wndw_height, wndw_name, wndw_capturemouse);
-
-	GLFWwindow* gl_window = window.getGLFWwindow();
-	if (gl_window == NULL)
+	//  the headless engine has no window, the game still gets the size it would have had
+	if (settings.headless)
 	{
-		std::cout << std::endl << "Failed to create GLFW window" << std::endl;
-		glfwTerminate();
-		return false;
+		std::cout << "Headless engine, no window.\n";
+		GameplayStatics::SetWindowSize(Vector2Int{ wndw_width, wndw_height });
 	}
+	else
+	{
+		//  create window and initialize glfw
+		std::cout << "Initializing window...";
+		window.createWindow(wndw_width, wndw_height, wndw_name, wndw_capturemouse);
 
-	GameplayStatics::SetWindowSize(Vector2Int{ window.getWidth(), window.getHeigth() });
-	std::cout << " Done.\n";
+		GLFWwindow* gl_window = window.getGLFWwindow();
+		if (gl_window == NULL)
+		{
+			std::cout << std::endl << "Failed to create GLFW window" << std::endl;
+			glfwTerminate();
+			return false;
+		}
 
+		GameplayStatics::SetWindowSize(Vector2Int{ window.getWidth(), window.getHeigth() });
+		std::cout << " Done.\n";
 
-	glfwSetWindowUserPointer(gl_window, this);
 
-	glfwSetFramebufferSizeCallback(gl_window, [](GLFWwindow* window, int width, int height)
-		{
-			auto self = static_cast<Engine*>(glfwGetWindowUserPointer(window));
-			self->windowResize(window, width, height);
-		}
-	); //  link window resize callback function
+		glfwSetWindowUserPointer(gl_window, this);
 
-	glfwSetCursorPosCallback(gl_window, [](GLFWwindow* window, double xpos, double ypos)
-		{
-			Input::ProcessMouse(window, xpos, ypos);
-		}
-	); //  link mouse pos callback function
+		glfwSetFramebufferSizeCallback(gl_window, [](GLFWwindow* window, int width, int height)
+			{
+				auto self = static_cast<Engine*>(glfwGetWindowUserPointer(window));
+				self->windowResize(window, width, height);
+			}
+		); //  link window resize callback function
 
-	glfwSetScrollCallback(gl_window, [](GLFWwindow* window, double xoffset, double yoffset)
-		{
-			Input::ProcessScroll(window, xoffset, yoffset);
-		}
-	); //  link mouse scroll callback function
+		glfwSetCursorPosCallback(gl_window, [](GLFWwindow* window, double xpos, double ypos)
+			{
+				Input::ProcessMouse(window, xpos, ypos);
+			}
+		); //  link mouse pos callback function
 
-	glfwSetKeyCallback(gl_window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
-		{
-			Input::ProcessKeyboard(window, key, scancode, action, mods);
-		}
-	); //  link keyboard callback function
+		glfwSetScrollCallback(gl_window, [](GLFWwindow* window, double xoffset, double yoffset)
+			{
+				Input::ProcessScroll(window, xoffset, yoffset);
+			}
+		); //  link mouse scroll callback function
 
-	glfwSetMouseButtonCallback(gl_window, [](GLFWwindow* window, int button, int action, int mods)
-		{
-			Input::ProcessMouseButton(window, button, action, mods);
-		}
-	); //  link mouse button callback function
+		glfwSetKeyCallback(gl_window, [](GLFWwindow* window, int key, int scancode, int action, int mods)
+			{
+				Input::ProcessKeyboard(window, key, scancode, action, mods);
+			}
+		); //  link keyboard callback function
+
+		glfwSetMouseButtonCallback(gl_window, [](GLFWwindow* window, int button, int action, int mods)
+			{
+				Input::ProcessMouseButton(window, button, action, mods);
+			}
+		); //  link mouse button callback function
+	}
 
 
 	//  initialize service locator
@@ -92,20 +135,37 @@ bool Engine::initialize(int wndw_width, int wndw_height, std::string wndw_name,
 	std::cout << " Done.\n";
 
 
-	//  create renderer
-	std::cout << "Initializing renderer...";
-	renderer = new RendererOpenGL();
-	Locator::provideRenderer(renderer);
-	renderer->initializeRenderer(Color::black, Vector2Int{ window.getWidth(), window.getHeigth() });
+	//  create job system, the main thread also runs jobs while it waits for them so it doesn't need a worker
+	std::cout << "Initializing job system...";
+	jobSystem = new JobSystem();
+	Locator::provideJobs(jobSystem);
+	jobSystem->Start(Maths::max(static_cast<int>(std::thread::hardware_concurrency()) - 1, 0));
+	std::cout << " Done.\n";
+
+
+	//  create the frame arenas, one per thread of the job system
+	std::cout << "Initializing frame arenas...";
+	FrameArena::Initialize(jobSystem->GetThreadsCount());
 	std::cout << " Done.\n";
 
 
+	//  create renderer, the headless engine keeps the null renderer of the locator
+	if (!settings.headless)
+	{
+		std::cout << "Initializing renderer...";
+		renderer = new RendererOpenGL();
+		Locator::provideRenderer(renderer);
+		renderer->initializeRenderer(Color::black, Vector2Int{ window.getWidth(), window.getHeigth() }, window.getGLFWwindow());
+		std::cout << " Done.\n";
+	}
+
+
 	//  set freecam values
 	freecam.setSpeed(4.0f);
 
 
 	//  initialize GLAD
-	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	if (!settings.headless && !gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
 	{
 		std::cout << std::endl << "Failed to initialize GLAD" << std::endl;
 		return false;
@@ -123,11 +183,24 @@ bool Engine::initialize(int wndw_width, int wndw_height, std::string wndw_name,
 	physics.InitialisePhysics();
 	std::cout << " Done.\n";
 
-	//  initialize audio manager
-	std::cout << "Initializing audio...";
-	audio = new AudioManager();
-	Locator::provideAudio(audio);
-	audio->Initialize(100.0f);
+	//  initialize audio manager, the headless engine keeps the null audio of the locator
+	if (!settings.headless)
+	{
+		std::cout << "Initializing audio...";
+		audio = new AudioManager();
+		Locator::provideAudio(audio);
+		audio->Initialize(100.0f);
+		std::cout << " Done.\n";
+	}
+
+	//  declare the frame events of the engine
+	std::cout << "Initializing frame events...";
+	GameplayStatics::GetScreenResizeEvents();
+	std::cout << " Done.\n";
+
+	//  initialize system scheduler
+	std::cout << "Initializing system scheduler...";
+	GameplayStatics::SetSystemScheduler(&systemScheduler);
 	std::cout << " Done.\n";
 
 
@@ -143,19 +216,53 @@ bool Engine::initialize(int wndw_width, int wndw_height, std::string wndw_name,
 	std::cout << " Done.\n";
 
 
-	//  intialize debug fps text
-	fpsText = new TextRendererComponent();
-	fpsText->setTextDatas("FPS: 0", AssetManager::GetFont("arial_64"), Vector2::one, Vector2::one, Vector2{ -20.0f, -20.0f }, Vector2{ 0.5f }, 0.0f, Color::white);
-	fpsText->setEnabled(false);
+	//  debug view and OpenGL state, only for the windowed engine
+	if (!settings.headless)
+	{
+		//  intialize debug fps text
+		fpsText = new TextRendererComponent();
+		fpsText->setTextDatas("FPS: 0", AssetManager::GetFont("arial_64"), Vector2::one, Vector2::one, Vector2{ -20.0f, -20.0f }, Vector2{ 0.5f }, 0.0f, Color::white);
+		fpsText->setEnabled(false);
+
+		//  intialize debug physics text
+		physicsText = new TextRendererComponent();
+		physicsText->setTextDatas("Rigidbodies: 0 awake / 0 asleep", AssetManager::GetFont("arial_64"), Vector2::one, Vector2::one, Vector2{ -20.0f, -60.0f }, Vector2{ 0.5f }, 0.0f, Color::white);
+		physicsText->setEnabled(false);
 
+		//  intialize debug systems text
+		systemsText = new TextRendererComponent();
+		systemsText->setTextDatas("Systems: 0", AssetManager::GetFont("arial_64"), Vector2::one, Vector2::one, Vector2{ -20.0f, -100.0f }, Vector2{ 0.5f }, 0.0f, Color::white);
+		systemsText->setEnabled(false);
 
-	//  configure global OpenGL properties
-	glEnable(GL_DEPTH_TEST);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		//  intialize debug memory text
+		memoryText = new TextRendererComponent();
+		memoryText->setTextDatas("Allocations: 0 per frame", AssetManager::GetFont("arial_64"), Vector2::one, Vector2::one, Vector2{ -20.0f, -140.0f }, Vector2{ 0.5f }, 0.0f, Color::white);
+		memoryText->setEnabled(false);
 
+		//  intialize debug frame times texts
+		frameTimesText = new TextRendererComponent();
+		frameTimesText->setTextDatas("Frame times: 0 frames", AssetManager::GetFont("arial_64"), Vector2::one, Vector2::one, Vector2{ -20.0f, -180.0f }, Vector2{ 0.5f }, 0.0f, Color::white);
+		frameTimesText->setEnabled(false);
 
-	std::cout << "\nEngine initialization: " << glfwGetTime() << " seconds.\n";
+		frameHistogramText = new TextRendererComponent();
+		frameHistogramText->setTextDatas("Histogram:", AssetManager::GetFont("arial_64"), Vector2::one, Vector2::one, Vector2{ -20.0f, -220.0f }, Vector2{ 0.5f }, 0.0f, Color::white);
+		frameHistogramText->setEnabled(false);
+
+
+		//  configure frame pacing, the vertical sync is set on the context before the render thread takes it
+		renderer->setSwapInterval(settings.swapInterval);
+		frameLimiter.setFrameCap(settings.frameCap);
+
+
+		//  configure global OpenGL properties
+		glEnable(GL_DEPTH_TEST);
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+
+
+	const std::chrono::duration<double> initialization_time = std::chrono::high_resolution_clock::now() - initialization_start;
+	std::cout << "\nEngine initialization: " << initialization_time.count() << " seconds.\n";
 
 	std::cout << "\nCy-Engine is ready to run.\n\n\n";
 
@@ -166,11 +273,24 @@ bool Engine::initialize(int wndw_width, int wndw_height, std::string wndw_name,
 
 void Engine::run()
 {
+	if (settings.headless)
+	{
+		runHeadless();
+		releaseServices();
+		return;
+	}
+
+	//  the render thread takes the OpenGL context, every asset is loaded at this point
+	if (settings.renderLatency > 0) glfwMakeContextCurrent(nullptr);
+	renderer->startRenderThread(settings.renderLatency);
+	frameLimiter.setFrameCap(frameLimiter.getFrameCap()); //  the cap paces the frames from now
+
 	//  main loop
 	while (!glfwWindowShouldClose(window.getGLFWwindow()))
 	{
 		//  time logic part
 		// -----------------
+		const auto frame_start = std::chrono::high_resolution_clock::now();
 		double current_frame = glfwGetTime();
 		deltaTime = static_cast<float>(current_frame - lastFrame);
 		lastFrame = current_frame;
@@ -185,24 +305,21 @@ void Engine::run()
 		// -------------
 		engineUpdate(window.getGLFWwindow());
 
+		startFrame();
 
 		if (!gamePaused || (gamePaused && oneFrame))
 		{
-			Locator::getPhysics().UpdatePhysics(deltaTime);
-
-			if (game)
-			{
-				game->updateGame(deltaTime);
-				game->updateScene(deltaTime);
-			}
-
+			updateSimulation();
 			oneFrame = false;
 		}
 
 
-		//  rendering part
+		//  rendering part (the frame is drawn by the render thread while the next one is simulated)
 		// ----------------
-		renderer->draw();
+		auto time = std::chrono::high_resolution_clock::now();
+		renderer->submitFrame();
+		time = timeSubsystem(EngineSubsystem::Rendering, time);
+		double wait_time = renderer->getLastSubmitWaitTime();
 
 
 		//  audio part
@@ -210,36 +327,193 @@ void Engine::run()
 		const Camera& current_cam = renderer->GetCamera();
 		audio->UpdateListener(current_cam.getPosition(), current_cam.getUp(), current_cam.getForward());
 		audio->Update();
+		timeSubsystem(EngineSubsystem::Audio, time);
+
 
-		
 		//  log part
 		// ----------
-		log->updateScreenLogs(deltaTime);
+		endFrame();
 
 
-		//  events and buffer swap part
-		// -----------------------------
-		glfwSwapBuffers(window.getGLFWwindow());
+		//  events part
+		// -------------
 		glfwPollEvents();
+
+
+		//  frame pacing part
+		// -------------------
+		wait_time += frameLimiter.waitNextFrame();
+		const double frame_time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - frame_start).count();
+		frameTimeStats.addFrame(static_cast<float>(frame_time), static_cast<float>(wait_time));
 	}
 
+	renderer->stopRenderThread();
+	glfwMakeContextCurrent(window.getGLFWwindow());
+
+	releaseServices();
+}
+
+void Engine::runHeadless()
+{
+	//  every tick simulates the same time, whether the ticks are paced or not, so that two runs with the same settings are the same
+	deltaTime = 1.0f / static_cast<float>(settings.tickRate);
+	const auto tick_duration = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(1.0 / settings.tickRate));
+
+	HeadlessInterrupted.store(false);
+	auto previous_handler = std::signal(SIGINT, OnHeadlessInterrupt);
+
+	std::cout << "Headless run: " << (settings.ticksCount > 0 ? std::to_string(settings.ticksCount) : std::string("endless")) << " ticks at " << settings.tickRate <<
+		" ticks per second" << (settings.unlockedTickRate ? " (unlocked)" : "") << ".\n";
+
+	const auto run_start = std::chrono::high_resolution_clock::now();
+	auto next_tick = run_start;
+	int ticks = 0;
+	while ((settings.ticksCount == 0 || ticks < settings.ticksCount) && !HeadlessInterrupted.load())
+	{
+		startFrame();
+		updateSimulation();
+		endFrame();
+		ticks++;
+
+		if (!settings.unlockedTickRate)
+		{
+			//  a tick that took too long isn't caught up, the next ones keep their pace from now
+			next_tick += tick_duration;
+			const auto now = std::chrono::high_resolution_clock::now();
+			if (next_tick < now) next_tick = now;
+			else std::this_thread::sleep_until(next_tick);
+		}
+	}
+
+	std::signal(SIGINT, previous_handler);
+
+	const std::chrono::duration<double> run_time = std::chrono::high_resolution_clock::now() - run_start;
+	const double simulated_time = ticks * static_cast<double>(deltaTime);
+	std::cout << "\nHeadless run: " << ticks << " ticks in " << run_time.count() << " seconds (" << (run_time.count() > 0.0 ? ticks / run_time.count() : 0.0) <<
+		" ticks per second, " << simulated_time << " simulated seconds).\n";
+}
+
+
+void Engine::startFrame()
+{
+	//  run the jobs that other threads gave to the main thread (like the calls to GLFW)
+	jobSystem->ProcessMainThreadJobs();
+
+	const auto time = std::chrono::high_resolution_clock::now();
+	GameplayStatics::FrameEvents.dispatch(FrameEventPoint::FrameStart);
+	timeSubsystem(EngineSubsystem::Events, time);
+}
+
+void Engine::updateSimulation()
+{
+	auto time = std::chrono::high_resolution_clock::now();
+
+	Locator::getPhysics().UpdatePhysics(deltaTime);
+	time = timeSubsystem(EngineSubsystem::Physics, time);
+
+	GameplayStatics::FrameEvents.dispatch(FrameEventPoint::AfterPhysics);
+	time = timeSubsystem(EngineSubsystem::Events, time);
+
+	if (!game) return;
+
+	game->updateGame(deltaTime);
+	time = timeSubsystem(EngineSubsystem::Game, time);
+
+	game->updateScene(deltaTime);
+	time = timeSubsystem(EngineSubsystem::Scene, time);
+
+	systemScheduler.run(deltaTime);
+	time = timeSubsystem(EngineSubsystem::Systems, time);
+
+	GameplayStatics::FrameEvents.dispatch(FrameEventPoint::AfterSystems);
+	time = timeSubsystem(EngineSubsystem::Events, time);
+
+	//  the entities created, destroyed or changed during the physics callbacks and the updates are applied here
+	game->syncEntities();
+	timeSubsystem(EngineSubsystem::Sync, time);
+}
+
+void Engine::endFrame()
+{
+	auto time = std::chrono::high_resolution_clock::now();
+
+	log->updateScreenLogs(deltaTime);
+	time = timeSubsystem(EngineSubsystem::Log, time);
+
+	GameplayStatics::FrameEvents.dispatch(FrameEventPoint::FrameEnd);
+	timeSubsystem(EngineSubsystem::Events, time);
+
+	//  the transient datas of the frame before are dropped, the ones of this frame stay valid during the next one
+	FrameArena::EndFrame();
+
+	for (int i = 0; i < static_cast<int>(EngineSubsystem::Count); i++)
+	{
+		subsystemsTotalTimes[i] += subsystemsFrameTimes[i];
+		if (subsystemsFrameTimes[i] > subsystemsMaxTimes[i]) subsystemsMaxTimes[i] = subsystemsFrameTimes[i];
+		subsystemsFrameTimes[i] = 0.0;
+	}
+	framesCount++;
+}
+
+void Engine::releaseServices()
+{
 	//  close engine
 	unloadGame();
-	audio->Quit();
+	GameplayStatics::SetSystemScheduler(nullptr);
+	jobSystem->Stop();
+	FrameArena::Release();
+	Locator::provideJobs(nullptr);
+	delete jobSystem;
+	if (audio) audio->Quit();
+
+	printSubsystemsTimes();
+
+	Locator::provideLog(nullptr);
 	delete log;
 }
 
 
+std::chrono::high_resolution_clock::time_point Engine::timeSubsystem(EngineSubsystem subsystem, std::chrono::high_resolution_clock::time_point start)
+{
+	const auto end = std::chrono::high_resolution_clock::now();
+	subsystemsFrameTimes[static_cast<int>(subsystem)] += std::chrono::duration<double, std::milli>(end - start).count();
+	return end;
+}
+
+void Engine::printSubsystemsTimes() const
+{
+	if (framesCount == 0) return;
+
+	double frames_time = 0.0;
+	for (int i = 0; i < static_cast<int>(EngineSubsystem::Count); i++)
+	{
+		frames_time += subsystemsTotalTimes[i];
+	}
+
+	std::cout << "\nSubsystems times on " << framesCount << " frames (ms):\n";
+	std::cout << std::left << std::setw(12) << "Subsystem" << std::right << std::setw(12) << "Total" << std::setw(12) << "Average" << std::setw(12) << "Max" << std::setw(10) << "Share" << "\n";
+	for (int i = 0; i < static_cast<int>(EngineSubsystem::Count); i++)
+	{
+		const double share = frames_time > 0.0 ? subsystemsTotalTimes[i] / frames_time * 100.0 : 0.0;
+		std::cout << std::left << std::setw(12) << SUBSYSTEMS_NAMES[i] << std::right << std::fixed << std::setprecision(3) <<
+			std::setw(12) << subsystemsTotalTimes[i] << std::setw(12) << subsystemsTotalTimes[i] / framesCount << std::setw(12) << subsystemsMaxTimes[i] <<
+			std::setprecision(1) << std::setw(9) << share << "%\n";
+	}
+	std::cout << std::defaultfloat << std::setprecision(6);
+}
+
+
 void Engine::close()
 {
 	//  properly clear GLFW before closing app
-	glfwTerminate();
+	if (!settings.headless) glfwTerminate();
 }
 
 void Engine::loadGame(std::weak_ptr<Game> game_)
 {
 	game = game_.lock();
 	GameplayStatics::SetCurrentGame(game.get());
+	game->setStartLevel(settings.level);
 	game->load();
 }
 
@@ -332,8 +606,80 @@ void Engine::engineUpdate(GLFWwindow* glWindow)
 		if (frameTimeCounter >= 1.0f)
 		{
 			frameTimeCounter -= 1.0f;
-			fpsText->setText("FPS: " + std::to_string(frameCounter));
+			fpsText->setText("FPS: " + std::to_string(frameCounter) + " (render " + std::to_string(renderer->getLastRenderTime()) + " ms)");
+			const uint64_t frames_count = static_cast<uint64_t>(frameCounter);
 			frameCounter = 0;
+
+			Physics& physics = Locator::getPhysics();
+			physicsText->setText("Rigidbodies: " + std::to_string(physics.GetAwakeRigidbodiesCount()) + " awake / " + std::to_string(physics.GetAsleepRigidbodiesCount()) + " asleep");
+
+			systemsText->setText("Systems: " + std::to_string(systemScheduler.getSystemsCount()) + " on " + std::to_string(Locator::getJobs().GetThreadsCount()) + " threads, " +
+				std::to_string(systemScheduler.getLastRunTime()) + " ms (parallelism x" + std::to_string(systemScheduler.getLastParallelism()) + ")");
+
+			//  heap allocations of all the threads, averaged on the frames of the last second
+			const uint64_t allocations_count = AllocationCounter::GetAllocationsCount();
+			const std::string allocations_text = AllocationCounter::IsEnabled() ? std::to_string((allocations_count - frameAllocationsCounter) / frames_count) + " per frame" : "not counted";
+			memoryText->setText("Allocations: " + allocations_text + ", frame arenas: " +
+				std::to_string(FrameArena::GetLastFrameUsedBytes() / 1024) + " / " + std::to_string(FrameArena::GetCapacity() / 1024) + " KB");
+			frameAllocationsCounter = allocations_count;
+
+			//  distribution of the last frame times, the spikes that the fps hide
+			const FrameTimeSummary frame_times = frameTimeStats.computeSummary();
+			frameTimesText->setText(frame_times.toStatsText());
+			frameHistogramText->setText(frame_times.toHistogramText());
+		}
+
+		//  log the timeline of the last frame systems when f6 is pressed
+		if (Input::IsKeyPressed(GLFW_KEY_F6))
+		{
+			log->LogMessage_Category("Debug: Systems timeline of the last frame (" + std::to_string(systemScheduler.getLastRunTime()) + " ms)", LogCategory::Info);
+			for (auto& line : systemScheduler.getTimelineText())
+			{
+				log->LogMessage_Category(line, LogCategory::Info);
+			}
+		}
+
+		//  run the events benchmark when f4 is pressed
+		if (Input::IsKeyPressed(GLFW_KEY_F4))
+		{
+			EventBenchmarks::BroadcastBenchmark();
+		}
+
+		//  run the job system stress test and scaling benchmark when f5 is pressed (debug view only, it freezes the game for a few seconds)
+		if (Input::IsKeyPressed(GLFW_KEY_F5))
+		{
+			JobSystemBenchmarks::StressTest();
+			JobSystemBenchmarks::ScalingBenchmark();
+		}
+
+		//  run the ecs benchmark when f7 is pressed, the physics benchmarks when f8, f9, f10 or f12 is pressed (debug view only, it freezes the game for a few seconds)
+		if (Input::IsKeyPressed(GLFW_KEY_F7))
+		{
+			EcsBenchmarks::ComponentLookupBenchmark();
+		}
+		if (Input::IsKeyPressed(GLFW_KEY_F8))
+		{
+			PhysicsBenchmarks::TriangleMeshBenchmark();
+		}
+		if (Input::IsKeyPressed(GLFW_KEY_F9))
+		{
+			PhysicsBenchmarks::StaticGridBenchmark();
+		}
+		if (Input::IsKeyPressed(GLFW_KEY_F10))
+		{
+			PhysicsBenchmarks::StackedBoxesBenchmark();
+		}
+		if (Input::IsKeyPressed(GLFW_KEY_F12))
+		{
+			PhysicsBenchmarks::RecordingReplayBenchmark(PHYSICS_RECORDING_FILE);
+		}
+
+		//  start or stop the physics recording when f11 is pressed, the recording can then be replayed with f12
+		if (Input::IsKeyPressed(GLFW_KEY_F11))
+		{
+			Physics& physics = Locator::getPhysics();
+			if (physics.IsRecording()) physics.StopRecording(PHYSICS_RECORDING_FILE);
+			else physics.StartRecording();
 		}
 	}
 }
@@ -387,6 +733,12 @@ void Engine::enableDebugView()
 	log->LogMessage_Category("Debug: Debug mode view enabled", LogCategory::Info);
 	renderer->drawDebugMode = true;
 	fpsText->setEnabled(true);
+	physicsText->setEnabled(true);
+	systemsText->setEnabled(true);
+	memoryText->setEnabled(true);
+	frameTimesText->setEnabled(true);
+	frameHistogramText->setEnabled(true);
+	frameAllocationsCounter = AllocationCounter::GetAllocationsCount();
 }
 
 void Engine::disableDebugView()
@@ -395,17 +747,25 @@ void Engine::disableDebugView()
 	log->LogMessage_Category("Debug: Debug mode view disabled", LogCategory::Info);
 	renderer->drawDebugMode = false;
 	fpsText->setEnabled(false);
+	physicsText->setEnabled(false);
+	systemsText->setEnabled(false);
+	memoryText->setEnabled(false);
+	frameTimesText->setEnabled(false);
+	frameHistogramText->setEnabled(false);
 }
 
 
 //  window resize callback functions
 void Engine::windowResize(GLFWwindow* glWindow, int width, int height)
 {
-	glViewport(0, 0, width, height); //  resize OpenGL viewport when GLFW is resized
 	window.changeSize(width, height);
 
 	Vector2Int window_size(width, height);
 	renderer->setWindowSize(window_size);
 	GameplayStatics::SetWindowSize(window_size);
-	GameplayStatics::OnScrenResize.broadcast(window_size);
+
+	//  the huds are placed at the start of the next frame, once for all the sizes of the resize
+	ScreenResizeEvent resize_event;
+	resize_event.windowSize = window_size;
+	GameplayStatics::FrameEvents.push(resize_event);
 }
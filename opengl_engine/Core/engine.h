@@ -2,6 +2,10 @@
 
 #include "game.h"
 #include "window.h"
+#include "engineSettings.h"
+#include "systemScheduler.h"
+#include "jobSystem.h"
+#include "frameLimiter.h"
 #include <Rendering/rendererOpenGL.h>
 #include <Rendering/camera.h>
 #include <Rendering/texture.h>
@@ -12,18 +16,43 @@
 
 #include <Log/logManager.h>
 
+#include <Utils/frameTimeStats.h>
+
 #include <Maths/matrix4.h>
 #include <Maths/vector3.h>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 
+
+/** Engine Subsystem
+* Parts of the engine frame that are timed, their total and worst times are printed when the engine closes.
+*/
+enum class EngineSubsystem : uint8_t
+{
+	Physics,
+	Game,
+	Scene,
+	Systems,
+	Sync,
+	Rendering,
+	Audio,
+	Log,
+	Events,
+
+	Count
+};
+
+
 class Engine
 {
 public:
 	Engine();
+	explicit Engine(const EngineSettings& settings_);
 	Engine(const Engine&) = delete;
 	Engine& operator=(const Engine&) = delete;
 
@@ -40,6 +69,9 @@ public:
 	void windowResize(GLFWwindow* glWindow, int width, int height);
 
 private:
+	//  settings
+	EngineSettings settings;
+
 	//  game
 	std::shared_ptr<Game> game;
 
@@ -55,18 +87,50 @@ private:
 	//  log manager
 	LogManager* log{ nullptr };
 
+	//  job system, provided to the Locator as the jobs service
+	JobSystem* jobSystem{ nullptr };
+
+	//  systems of the game and scenes, run in parallel when their accesses allow it
+	SystemScheduler systemScheduler;
+
 	//  freecam
 	Camera freecam;
 
 	//  debug text
 	TextRendererComponent* fpsText{ nullptr };
+	TextRendererComponent* physicsText{ nullptr };
+	TextRendererComponent* systemsText{ nullptr };
+	TextRendererComponent* memoryText{ nullptr };
+	TextRendererComponent* frameTimesText{ nullptr };
+	TextRendererComponent* frameHistogramText{ nullptr };
 	int frameCounter = 0;
 	float frameTimeCounter = 0.0f;
+	uint64_t frameAllocationsCounter = 0; //  heap allocations count at the start of the fps counter second
 
 	//  time
 	float deltaTime = 0.0f;
 	double lastFrame = 0.0f;
 
+	//  frame rate cap of the windowed engine, and the frame times of the last frames for the debug view
+	FrameLimiter frameLimiter;
+	FrameTimeStats frameTimeStats;
+
+	//  subsystems times in milliseconds, of the current frame and of all the frames
+	double subsystemsFrameTimes[static_cast<int>(EngineSubsystem::Count)]{ 0.0 };
+	double subsystemsTotalTimes[static_cast<int>(EngineSubsystem::Count)]{ 0.0 };
+	double subsystemsMaxTimes[static_cast<int>(EngineSubsystem::Count)]{ 0.0 };
+	uint64_t framesCount{ 0 };
+	std::chrono::high_resolution_clock::time_point timeSubsystem(EngineSubsystem subsystem, std::chrono::high_resolution_clock::time_point start);
+	void printSubsystemsTimes() const;
+
+	//  parts of the frame shared by the windowed and the headless engine
+	void startFrame();
+	void updateSimulation();
+	void endFrame();
+	void releaseServices();
+
+	void runHeadless();
+
 	//  pause, freecam and debug view
 	bool gamePaused{ false };
 	bool oneFrame{ false };
@@ -0,0 +1,78 @@
+#include "engineSettings.h"
+#include <iostream>
+
+
+namespace
+{
+	bool ReadPositiveInt(const std::string& text, int& outValue)
+	{
+		try
+		{
+			size_t read_chars = 0;
+			const int value = std::stoi(text, &read_chars);
+			if (read_chars != text.size() || value < 0) return false;
+
+			outValue = value;
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+}
+
+
+EngineSettings EngineSettings::FromCommandLine(int argc, char* argv[])
+{
+	EngineSettings settings;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+		const bool has_value = i + 1 < argc;
+
+		if (argument == "--headless")
+		{
+			settings.headless = true;
+		}
+		else if (argument == "--unlocked")
+		{
+			settings.unlockedTickRate = true;
+		}
+		else if (argument == "--ticks" && has_value)
+		{
+			if (!ReadPositiveInt(argv[++i], settings.ticksCount)) std::cout << "Engine settings: Invalid ticks count '" << argv[i] << "' is ignored.\n";
+		}
+		else if (argument == "--tickrate" && has_value)
+		{
+			int tick_rate = 0;
+			if (ReadPositiveInt(argv[++i], tick_rate) && tick_rate > 0) settings.tickRate = tick_rate;
+			else std::cout << "Engine settings: Invalid tick rate '" << argv[i] << "', " << settings.tickRate << " ticks per second are used.\n";
+		}
+		else if (argument == "--renderlatency" && has_value)
+		{
+			int render_latency = 0;
+			if (ReadPositiveInt(argv[++i], render_latency) && render_latency <= 2) settings.renderLatency = render_latency;
+			else std::cout << "Engine settings: Invalid render latency '" << argv[i] << "', " << settings.renderLatency << " frame is used.\n";
+		}
+		else if (argument == "--swapinterval" && has_value)
+		{
+			if (!ReadPositiveInt(argv[++i], settings.swapInterval)) std::cout << "Engine settings: Invalid swap interval '" << argv[i] << "' is ignored.\n";
+		}
+		else if (argument == "--framecap" && has_value)
+		{
+			if (!ReadPositiveInt(argv[++i], settings.frameCap)) std::cout << "Engine settings: Invalid frame cap '" << argv[i] << "' is ignored.\n";
+		}
+		else if (argument == "--level" && has_value)
+		{
+			settings.level = argv[++i];
+		}
+		else
+		{
+			std::cout << "Engine settings: Unknown argument '" << argument << "' is ignored.\n";
+		}
+	}
+
+	return settings;
+}
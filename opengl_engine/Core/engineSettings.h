@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+
+
+/** Engine Settings
+* How the engine runs, given to the engine before its initialization (usually parsed from the command line).
+* The headless engine doesn't create any window nor rendering context, the renderer and the audio are the null services of the Locator,
+* it only runs the game logic (the game and scenes updates, the physics, the systems and the logs) for the simulation servers and the benchmarks.
+*/
+struct EngineSettings
+{
+	bool headless{ false };
+	int ticksCount{ 0 }; //  ticks to run before closing in headless, 0 runs until the process is interrupted
+	int tickRate{ 60 }; //  ticks per second in headless, the delta time of a tick is always 1 / tickRate
+	bool unlockedTickRate{ false }; //  in headless, the ticks run one after the other without waiting for their time
+	std::string level; //  level to start the game in, empty for the default level of the game
+	int renderLatency{ 1 }; //  frames the render thread can be late on the game thread (1 or 2), 0 draws the frames on the game thread
+	int swapInterval{ 1 }; //  screen updates to wait for before a buffer swap, 0 unlocks the frame rate from the vertical sync
+	int frameCap{ 0 }; //  max frames per second of the windowed engine, 0 for no cap
+
+	/**
+	* Read the settings from the arguments of the program: --headless, --ticks <count>, --tickrate <ticks per second>, --unlocked, --level <name or index>,
+	* --renderlatency <0, 1 or 2>, --swapinterval <screen updates>, --framecap <frames per second>.
+	* @param	argc	Number of arguments (the program name included).
+	* @param	argv	Arguments.
+	* @return			The settings, the default values are kept for the missing or invalid arguments.
+	*/
+	static EngineSettings FromCommandLine(int argc, char* argv[]);
+};
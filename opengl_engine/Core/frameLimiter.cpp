@@ -0,0 +1,40 @@
+#include "frameLimiter.h"
+
+#include <thread>
+
+
+void FrameLimiter::setFrameCap(int framesPerSecond)
+{
+	frameCap = framesPerSecond > 0 ? framesPerSecond : 0;
+	frameDuration = frameCap > 0 ?
+		std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<double>(1.0 / frameCap)) :
+		std::chrono::high_resolution_clock::duration{ 0 };
+	nextFrame = std::chrono::high_resolution_clock::now() + frameDuration;
+}
+
+double FrameLimiter::waitNextFrame()
+{
+	if (frameCap == 0) return 0.0;
+
+	const auto wait_start = std::chrono::high_resolution_clock::now();
+	if (nextFrame <= wait_start)
+	{
+		//  the frame is late, the next one starts its time now
+		nextFrame = wait_start + frameDuration;
+		return 0.0;
+	}
+
+	const int spin_margin = SPIN_MARGIN_MS;
+	const auto sleep_end = nextFrame - std::chrono::milliseconds(spin_margin);
+	if (sleep_end > wait_start) std::this_thread::sleep_until(sleep_end);
+
+	auto now = std::chrono::high_resolution_clock::now();
+	while (now < nextFrame)
+	{
+		std::this_thread::yield();
+		now = std::chrono::high_resolution_clock::now();
+	}
+
+	nextFrame += frameDuration;
+	return std::chrono::duration<double, std::milli>(now - wait_start).count();
+}
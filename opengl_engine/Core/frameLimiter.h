@@ -0,0 +1,33 @@
+#pragma once
+#include <chrono>
+
+
+/** Frame Limiter
+* Caps the frame rate of the main loop: it waits at the end of a frame until the time of the next one.
+* The wait sleeps until a little before the target (the system sleep is only precise to a millisecond or so), then spins to reach it.
+* A frame that took longer than its time isn't caught up, the next frames keep their pace from its end.
+*/
+class FrameLimiter
+{
+public:
+	//  part of the wait that spins instead of sleeping, in milliseconds
+	static const int SPIN_MARGIN_MS{ 2 };
+
+	/**
+	* Set the frame rate cap.
+	* @param	framesPerSecond		Max frames per second, 0 removes the cap.
+	*/
+	void setFrameCap(int framesPerSecond);
+	inline int getFrameCap() const { return frameCap; }
+
+	/**
+	* Wait until the time of the next frame, does nothing without cap.
+	* @return	Time waited in milliseconds.
+	*/
+	double waitNextFrame();
+
+private:
+	int frameCap{ 0 };
+	std::chrono::high_resolution_clock::duration frameDuration{ 0 };
+	std::chrono::high_resolution_clock::time_point nextFrame;
+};
@@ -11,6 +11,7 @@ void Game::load()
 
 void Game::unload()
 {
+	cancelStreaming();
 	unloadActiveScene(false);
 
 	unloadGame();
@@ -18,9 +19,17 @@ void Game::unload()
 
 void Game::updateScene(float dt)
 {
+	updateStreaming();
+
 	if (activeScene) activeScene->update(dt);
 }
 
+void Game::syncEntities()
+{
+	updateEntities();
+	if (activeScene) activeScene->syncEntities();
+}
+
 Camera& Game::getActiveCamera()
 {
 	if (activeScene) return activeScene->getCamera();
@@ -35,6 +44,7 @@ bool Game::hasActiveScene()
 
 void Game::loadScene(Scene* scene)
 {
+	cancelStreaming();
 	unloadActiveScene(true);
 	activeScene = scene;
 	GameplayStatics::SetCurrentScene(activeScene);
@@ -48,3 +58,49 @@ void Game::unloadActiveScene(bool loadNewScene)
 
 	if (!loadNewScene) GameplayStatics::SetCurrentScene(nullptr);
 }
+
+
+void Game::streamScene(Scene* scene, std::function<void()> onActivated)
+{
+	cancelStreaming();
+
+	streamingScene = scene;
+	onStreamingActivated = std::move(onActivated);
+	Locator::getJobs().Run([scene]() { scene->preload(); }, &streamingPreload);
+}
+
+void Game::updateStreaming()
+{
+	if (!streamingScene) return;
+
+	if (!streamingActivation)
+	{
+		if (!streamingPreload.isDone()) return;
+
+		unloadActiveScene(true);
+		activeScene = streamingScene;
+		GameplayStatics::SetCurrentScene(activeScene);
+		streamingActivation = true;
+	}
+
+	if (!activeScene->activate(streamingBudgetMs)) return;
+
+	streamingScene = nullptr;
+	streamingActivation = false;
+
+	std::function<void()> on_activated = std::move(onStreamingActivated);
+	onStreamingActivated = nullptr;
+	if (on_activated) on_activated();
+}
+
+void Game::cancelStreaming()
+{
+	if (!streamingScene) return;
+
+	//  the preload job uses the scene, a scene cut during its activation stays active until the next load unloads it
+	Locator::getJobs().Wait(streamingPreload);
+
+	streamingScene = nullptr;
+	streamingActivation = false;
+	onStreamingActivated = nullptr;
+}
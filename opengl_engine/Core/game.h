@@ -1,7 +1,11 @@
 #pragma once
 #include <ECS/entityContainer.h>
+#include <ServiceLocator/jobs.h>
 #include "scene.h"
 
+#include <functional>
+#include <string>
+
 class Camera;
 
 class Game : EntityContainer
@@ -15,10 +19,24 @@ public:
 	virtual void updateGame(float dt) = 0; //  updateGame come before updateScene during a frame
 	void updateScene(float dt);
 
+	//  sync point of the frame: apply the structural changes recorded by the game then by the active scene
+	void syncEntities();
+
+	using EntityContainer::getCommandBuffer;
+
 	virtual Camera& getActiveCamera();
 
 	bool hasActiveScene();
 
+	//  a scene is being preloaded or activated by a streamed load
+	bool isStreamingScene() const { return streamingScene != nullptr; }
+
+	//  time the activation of a streamed scene can take each frame, in milliseconds
+	void setStreamingBudget(double budgetMs) { streamingBudgetMs = budgetMs; }
+
+	//  level to start the game in (given by the engine settings), empty for the default level of the game
+	void setStartLevel(const std::string& level) { startLevel = level; }
+
 protected:
 	virtual void loadGameAssets() = 0;
 	virtual void loadGame() = 0;
@@ -28,8 +46,29 @@ protected:
 	void loadScene(Scene* scene);
 	void unloadActiveScene(bool loadNewScene);
 
+	/**
+	* Load a scene in two phases so that the transition doesn't freeze the game: the scene is preloaded by a job while the active scene keeps playing,
+	* then it replaces the active scene and is activated on the main thread within the streaming budget of each frame.
+	* A new load (streamed or not) cancels the streamed load in progress.
+	* @param	scene			Scene to load.
+	* @param	onActivated		(optionnal) Called on the main thread once the scene is fully activated.
+	*/
+	void streamScene(Scene* scene, std::function<void()> onActivated = nullptr);
+
 	Scene* activeScene{ nullptr };
 
+	const std::string& getStartLevel() const { return startLevel; }
+
 private:
 	Camera gamedefaultsNocam; //  camera to return if there is no active scene
+	std::string startLevel;
+
+	//  streamed load
+	Scene* streamingScene{ nullptr };
+	bool streamingActivation{ false }; //  the preload is done, the streaming scene is the active scene
+	JobCounter streamingPreload;
+	std::function<void()> onStreamingActivated;
+	double streamingBudgetMs{ 2.0 };
+	void updateStreaming();
+	void cancelStreaming();
 };
\ No newline at end of file
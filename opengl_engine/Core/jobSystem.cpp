@@ -0,0 +1,469 @@
+#include "jobSystem.h"
+#include <ServiceLocator/locator.h>
+
+
+namespace
+{
+	//  job system and index of the worker running on this thread
+	thread_local JobSystem* CurrentJobSystem = nullptr;
+	thread_local int CurrentThreadIndex = -1;
+
+	//  number of searches an idle worker does before going to sleep
+	const int IDLE_SPINS = 64;
+}
+
+
+// ===============================================
+//  ---------------- Job Deque ------------------
+// ===============================================
+
+bool JobSystem::JobDeque::push(Job* job)
+{
+	const int64_t b = bottom.load(std::memory_order_relaxed);
+	const int64_t t = top.load(std::memory_order_acquire);
+	if (b - t >= CAPACITY) return false;
+
+	buffer[b & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+	bottom.store(b + 1, std::memory_order_release);
+	return true;
+}
+
+JobSystem::Job* JobSystem::JobDeque::pop()
+{
+	//  reserve the last job before looking at the top, a thief can only take it by winning the race on the top
+	const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(b, std::memory_order_seq_cst);
+	int64_t t = top.load(std::memory_order_seq_cst);
+
+	if (t > b)
+	{
+		//  empty
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = buffer[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (t == b)
+	{
+		//  last job, the thieves may want it too
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) job = nullptr;
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+JobSystem::Job* JobSystem::JobDeque::steal()
+{
+	int64_t t = top.load(std::memory_order_seq_cst);
+	const int64_t b = bottom.load(std::memory_order_seq_cst);
+	if (t >= b) return nullptr;
+
+	Job* job = buffer[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return nullptr; //  lost the race against the owner or another thief
+	return job;
+}
+
+bool JobSystem::JobDeque::isEmpty() const
+{
+	return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+}
+
+
+
+// ===============================================
+//  ----------------- Job Pool ------------------
+// ===============================================
+
+JobSystem::JobPool::JobPool()
+{
+	for (Job& job : jobs)
+	{
+		job.pooled = true;
+	}
+}
+
+JobSystem::Job* JobSystem::JobPool::take()
+{
+	//  the jobs are mostly given back in the order they were taken, a job still in use means the pool is exhausted around it
+	Job& job = jobs[next];
+	next = (next + 1) & (CAPACITY - 1);
+	if (job.inUse.load(std::memory_order_acquire)) return nullptr;
+
+	job.inUse.store(true, std::memory_order_relaxed);
+	return &job;
+}
+
+
+
+// ===============================================
+//  ---------------- Job System -----------------
+// ===============================================
+
+JobSystem::JobSystem()
+{
+	mainThreadId = std::this_thread::get_id();
+}
+
+JobSystem::~JobSystem()
+{
+	Stop();
+}
+
+void JobSystem::Start(int workersCount)
+{
+	Stop();
+
+	mainThreadId = std::this_thread::get_id();
+	deques.clear();
+	pools.clear();
+	for (int i = 0; i <= workersCount; i++)
+	{
+		deques.emplace_back(new JobDeque());
+		pools.emplace_back(new JobPool());
+	}
+
+	stopping = false;
+	started = true;
+	for (int i = 0; i < workersCount; i++)
+	{
+		workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+	}
+}
+
+void JobSystem::Stop()
+{
+	if (!started) return;
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	sleepCondition.notify_all();
+
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+	workers.clear();
+
+	//  run what is left on this thread, the jobs created from now on run right away
+	started = false;
+	bool found_job = true;
+	while (found_job)
+	{
+		found_job = false;
+		for (auto& deque : deques)
+		{
+			while (Job* job = deque->steal())
+			{
+				execute(job);
+				found_job = true;
+			}
+		}
+		while (Job* job = popInjectedJob())
+		{
+			execute(job);
+			found_job = true;
+		}
+		while (Job* job = popMainThreadJob())
+		{
+			execute(job);
+			found_job = true;
+		}
+	}
+	deques.clear();
+	pools.clear();
+}
+
+
+void JobSystem::Run(JobFunction job, JobCounter* counter)
+{
+	if (counter) counter->pendingJobs.fetch_add(1, std::memory_order_relaxed);
+	submit(std::move(job), counter);
+}
+
+void JobSystem::RunAfter(JobCounter& dependency, JobFunction job, JobCounter* counter)
+{
+	if (counter) counter->pendingJobs.fetch_add(1, std::memory_order_relaxed);
+
+	{
+		//  the last job of the dependency takes the continuations under this lock, so it can't be missed
+		std::lock_guard<std::mutex> lock(dependency.mutex);
+		if (dependency.pendingJobs.load(std::memory_order_acquire) > 0)
+		{
+			JobCounter::Continuation continuation;
+			continuation.job = std::move(job);
+			continuation.counter = counter;
+			dependency.continuations.push_back(std::move(continuation));
+			return;
+		}
+	}
+
+	submit(std::move(job), counter);
+}
+
+void JobSystem::RunOnMainThread(JobFunction job, JobCounter* counter)
+{
+	if (counter) counter->pendingJobs.fetch_add(1, std::memory_order_relaxed);
+
+	if (!started && GetCurrentThreadIndex() == 0)
+	{
+		job();
+		finishJob(counter);
+		return;
+	}
+
+	Job* new_job = createJob(std::move(job), counter);
+	std::lock_guard<std::mutex> lock(mainThreadMutex);
+	mainThreadJobs.push_back(new_job);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+	const int thread = GetCurrentThreadIndex();
+	while (!counter.isDone())
+	{
+		//  help instead of blocking, the jobs of the counter may be in this thread's own deque
+		if (Job* job = findJob(thread)) execute(job);
+		else std::this_thread::yield();
+	}
+
+	//  the last job may still be inside the counter's lock, the counter must not be destroyed before it leaves
+	std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+void JobSystem::ParallelFor(int count, const std::function<void(int)>& job, int minChunkSize)
+{
+	if (count <= 0) return;
+
+	const int min_chunk = minChunkSize > 1 ? minChunkSize : 1;
+	if (workers.empty() || count <= min_chunk || GetCurrentThreadIndex() < 0)
+	{
+		for (int i = 0; i < count; i++) job(i);
+		return;
+	}
+
+	//  the range is only split when another thread may take it, the grain keeps the splits from going down to single indices
+	int grain = count / (GetThreadsCount() * 8);
+	if (grain < min_chunk) grain = min_chunk;
+
+	JobCounter counter;
+	runRange(0, count, grain, job, counter);
+	Wait(counter);
+}
+
+void JobSystem::ProcessMainThreadJobs()
+{
+	if (GetCurrentThreadIndex() != 0)
+	{
+		Locator::getLog().LogMessage_Category("Job System: The main thread jobs can only be processed by the main thread.", LogCategory::Error);
+		return;
+	}
+
+	while (Job* job = popMainThreadJob())
+	{
+		execute(job);
+	}
+}
+
+int JobSystem::GetCurrentThreadIndex()
+{
+	if (CurrentJobSystem == this) return CurrentThreadIndex;
+	if (std::this_thread::get_id() == mainThreadId) return 0;
+	return -1;
+}
+
+
+void JobSystem::workerLoop(int thread)
+{
+	CurrentJobSystem = this;
+	CurrentThreadIndex = thread;
+
+	int idle_spins = 0;
+	while (!stopping.load(std::memory_order_acquire))
+	{
+		const unsigned int signal = workSignal.load(std::memory_order_seq_cst);
+
+		if (Job* job = findJob(thread))
+		{
+			execute(job);
+			idle_spins = 0;
+			continue;
+		}
+
+		if (idle_spins < IDLE_SPINS)
+		{
+			idle_spins++;
+			std::this_thread::yield();
+			continue;
+		}
+
+		//  nothing to steal for a while, sleep until a job is submitted
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+		sleepCondition.wait(lock, [this, signal] { return stopping.load(std::memory_order_acquire) || workSignal.load(std::memory_order_seq_cst) != signal; });
+		sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+		idle_spins = 0;
+	}
+
+	CurrentJobSystem = nullptr;
+	CurrentThreadIndex = -1;
+}
+
+void JobSystem::submit(JobFunction function, JobCounter* counter)
+{
+	if (!started)
+	{
+		function();
+		finishJob(counter);
+		return;
+	}
+
+	Job* job = createJob(std::move(function), counter);
+	const int thread = GetCurrentThreadIndex();
+	if (thread < 0 || !deques[thread]->push(job))
+	{
+		std::lock_guard<std::mutex> lock(injectedMutex);
+		injectedJobs.push_back(job);
+	}
+
+	wakeWorker();
+}
+
+JobSystem::Job* JobSystem::createJob(JobFunction function, JobCounter* counter)
+{
+	const int thread = GetCurrentThreadIndex();
+	Job* job = nullptr;
+	if (started && thread >= 0) job = pools[thread]->take();
+	if (!job) job = new Job(); //  thread outside of the job system or exhausted pool
+
+	job->function = std::move(function);
+	job->counter = counter;
+	return job;
+}
+
+void JobSystem::releaseJob(Job* job)
+{
+	if (!job->pooled)
+	{
+		delete job;
+		return;
+	}
+
+	//  the captures are destroyed before the owner thread can take the job again
+	job->function.reset();
+	job->inUse.store(false, std::memory_order_release);
+}
+
+void JobSystem::execute(Job* job)
+{
+	job->function();
+	JobCounter* counter = job->counter;
+	releaseJob(job);
+
+	finishJob(counter);
+}
+
+void JobSystem::finishJob(JobCounter* counter)
+{
+	if (!counter) return;
+
+	std::vector<JobCounter::Continuation> ready_jobs;
+	{
+		std::lock_guard<std::mutex> lock(counter->mutex);
+		if (counter->pendingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1) ready_jobs.swap(counter->continuations);
+	}
+
+	//  the counter may be destroyed from here, the continuations were moved out of it
+	for (auto& continuation : ready_jobs)
+	{
+		submit(std::move(continuation.job), continuation.counter);
+	}
+}
+
+
+JobSystem::Job* JobSystem::findJob(int thread)
+{
+	if (thread == 0)
+	{
+		if (Job* job = popMainThreadJob()) return job;
+	}
+
+	if (!started) return nullptr;
+
+	if (thread >= 0)
+	{
+		if (Job* job = deques[thread]->pop()) return job;
+	}
+
+	if (Job* job = popInjectedJob()) return job;
+
+	//  steal the oldest job of another thread, starting after this one so that the thieves spread over the deques
+	const int threads_count = static_cast<int>(deques.size());
+	const int first = thread >= 0 ? thread : 0;
+	for (int offset = 1; offset <= threads_count; offset++)
+	{
+		const int victim = (first + offset) % threads_count;
+		if (victim == thread) continue;
+
+		if (Job* job = deques[victim]->steal()) return job;
+	}
+
+	return nullptr;
+}
+
+JobSystem::Job* JobSystem::popMainThreadJob()
+{
+	std::lock_guard<std::mutex> lock(mainThreadMutex);
+	if (mainThreadJobs.empty()) return nullptr;
+
+	Job* job = mainThreadJobs.back();
+	mainThreadJobs.pop_back();
+	return job;
+}
+
+JobSystem::Job* JobSystem::popInjectedJob()
+{
+	std::lock_guard<std::mutex> lock(injectedMutex);
+	if (injectedJobs.empty()) return nullptr;
+
+	Job* job = injectedJobs.front();
+	injectedJobs.pop_front();
+	return job;
+}
+
+void JobSystem::wakeWorker()
+{
+	workSignal.fetch_add(1, std::memory_order_seq_cst);
+
+	//  the lock makes sure a worker that is about to sleep either sees the new signal or gets the notification
+	if (sleepingWorkers.load(std::memory_order_seq_cst) > 0)
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		sleepCondition.notify_one();
+	}
+}
+
+
+void JobSystem::runRange(int begin, int end, int grain, const std::function<void(int)>& job, JobCounter& counter)
+{
+	const int thread = GetCurrentThreadIndex();
+	while (end - begin > grain)
+	{
+		if (thread >= 0 && deques[thread]->isEmpty())
+		{
+			//  nothing left for the thieves, give them the second half
+			const int middle = begin + (end - begin) / 2;
+			Run([this, middle, end, grain, &job, &counter]() { runRange(middle, end, grain, job, counter); }, &counter);
+			end = middle;
+		}
+		else
+		{
+			//  the last split wasn't taken yet, keep working alone
+			for (int i = begin; i < begin + grain; i++) job(i);
+			begin += grain;
+		}
+	}
+
+	for (int i = begin; i < end; i++) job(i);
+}
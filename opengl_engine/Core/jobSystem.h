@@ -0,0 +1,132 @@
+#pragma once
+#include <ServiceLocator/jobs.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/** Job System
+* Jobs service of the engine: persistent worker threads that run small jobs, with one work-stealing deque per thread.
+* A thread pushes and pops the jobs it creates at the back of its own deque (the last created job is still in cache),
+* the idle threads steal the oldest jobs at the front of the others' deques. The workers sleep when there is nothing to steal.
+* The main thread is the thread index 0, it runs jobs while it waits for a counter and is the only one to run the main thread jobs.
+* The jobs are taken from a pool owned by the creating thread, a job is only allocated when that pool is exhausted.
+* A job system that isn't started runs every job right away on the calling thread.
+*/
+class JobSystem : public Jobs
+{
+public:
+	JobSystem();
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/**
+	* Start the worker threads, the calling thread becomes the main thread of the job system.
+	* @param	workersCount	Number of worker threads to create (the main thread is not counted).
+	*/
+	void Start(int workersCount);
+
+	/**
+	* Stop and join the worker threads, the jobs left are run on the calling thread.
+	*/
+	void Stop();
+
+	void Run(JobFunction job, JobCounter* counter = nullptr) override;
+	void RunAfter(JobCounter& dependency, JobFunction job, JobCounter* counter = nullptr) override;
+	void RunOnMainThread(JobFunction job, JobCounter* counter = nullptr) override;
+	void Wait(JobCounter& counter) override;
+	void ParallelFor(int count, const std::function<void(int)>& job, int minChunkSize = 1) override;
+	void ProcessMainThreadJobs() override;
+
+	int GetThreadsCount() override { return static_cast<int>(workers.size()) + 1; }
+	int GetCurrentThreadIndex() override;
+
+	inline bool isStarted() const { return started; }
+
+private:
+	struct Job
+	{
+		JobFunction function;
+		JobCounter* counter{ nullptr };
+
+		std::atomic<bool> inUse{ false };
+		bool pooled{ false }; //  given back to its pool once run, deleted otherwise
+	};
+
+	/** Job Pool
+	* Ring of jobs owned by a thread: only the owner takes jobs from it, the thread that runs a job gives it back.
+	*/
+	class JobPool
+	{
+	public:
+		JobPool();
+		Job* take();
+
+	private:
+		static const int CAPACITY = 1024; //  power of two
+		Job jobs[CAPACITY];
+		int next{ 0 };
+	};
+
+	/** Job Deque
+	* Chase-Lev deque: the owner thread pushes and pops at the bottom without lock, the other threads steal at the top.
+	*/
+	class JobDeque
+	{
+	public:
+		bool push(Job* job);
+		Job* pop();
+		Job* steal();
+		bool isEmpty() const;
+
+	private:
+		static const int64_t CAPACITY = 4096; //  power of two, the jobs that don't fit go to the injected queue
+		std::atomic<Job*> buffer[CAPACITY];
+		std::atomic<int64_t> top{ 0 };
+		std::atomic<int64_t> bottom{ 0 };
+	};
+
+	void workerLoop(int thread);
+
+	//  push a job whose counter is already incremented
+	void submit(JobFunction function, JobCounter* counter);
+	Job* createJob(JobFunction function, JobCounter* counter);
+	void releaseJob(Job* job);
+	void execute(Job* job);
+	void finishJob(JobCounter* counter);
+
+	Job* findJob(int thread);
+	Job* popMainThreadJob();
+	Job* popInjectedJob();
+	void wakeWorker();
+
+	void runRange(int begin, int end, int grain, const std::function<void(int)>& job, JobCounter& counter);
+
+	std::vector<std::thread> workers;
+	std::vector<std::unique_ptr<JobDeque>> deques; //  one per thread, the main thread is the first
+	std::vector<std::unique_ptr<JobPool>> pools; //  one per thread, same order as the deques
+	std::thread::id mainThreadId;
+	bool started{ false };
+
+	//  jobs pushed by threads outside of the job system, or when a deque is full
+	std::mutex injectedMutex;
+	std::deque<Job*> injectedJobs;
+
+	std::mutex mainThreadMutex;
+	std::vector<Job*> mainThreadJobs;
+
+	//  sleep of the idle workers: a worker only sleeps if no job was submitted since it started to search
+	std::atomic<unsigned int> workSignal{ 0 };
+	std::atomic<int> sleepingWorkers{ 0 };
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+	std::atomic<bool> stopping{ false };
+};
@@ -0,0 +1,214 @@
+#include "jobSystemBenchmarks.h"
+#include "jobSystem.h"
+#include <ServiceLocator/locator.h>
+#include <Utils/elapsedTime.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+	int GetHardwareThreadsCount()
+	{
+		const int hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+		return hardware_threads > 0 ? hardware_threads : 1;
+	}
+
+	void LogErrors(const std::string& testName, int errorsCount)
+	{
+		if (errorsCount == 0) return;
+
+		Locator::getLog().LogMessage_Category("Job Benchmark: Stress test " + testName + " failed " + std::to_string(errorsCount) + " times.", LogCategory::Warning);
+	}
+}
+
+
+void JobSystemBenchmarks::StressTest(int roundsCount)
+{
+	//  at least a few workers, so that the stealing is tested even on small machines
+	const int workers_count = GetHardwareThreadsCount() - 1 > 3 ? GetHardwareThreadsCount() - 1 : 3;
+	JobSystem jobs;
+	jobs.Start(workers_count);
+
+	const std::thread::id main_thread_id = std::this_thread::get_id();
+	const int nested_count = 64;
+	const int chains_count = 32;
+	const int chain_length = 100;
+	const int main_thread_jobs_count = 256;
+	const int elements_count = 1000000;
+
+	int nested_errors = 0, chain_errors = 0, main_thread_errors = 0, parallel_for_errors = 0;
+	long long jobs_count = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (int round = 0; round < roundsCount; round++)
+	{
+		//  nested jobs: each job creates jobs and waits for them, the waiting threads run the other jobs meanwhile
+		{
+			std::atomic<int> leaves{ 0 };
+			JobCounter counter;
+			for (int i = 0; i < nested_count; i++)
+			{
+				jobs.Run([&jobs, &leaves, nested_count]()
+					{
+						JobCounter children;
+						for (int j = 0; j < nested_count; j++)
+						{
+							jobs.Run([&leaves]() { leaves.fetch_add(1, std::memory_order_relaxed); }, &children);
+						}
+						jobs.Wait(children);
+					}, &counter);
+			}
+			jobs.Wait(counter);
+
+			if (leaves.load() != nested_count * nested_count) nested_errors++;
+			jobs_count += nested_count + nested_count * nested_count;
+		}
+
+		//  chains: each link runs after the previous one, it must see the steps of all the previous links
+		{
+			std::unique_ptr<JobCounter[]> counters(new JobCounter[chains_count * chain_length]);
+			std::vector<int> steps(chains_count, 0);
+			std::atomic<int> errors{ 0 };
+
+			for (int chain = 0; chain < chains_count; chain++)
+			{
+				for (int link = 0; link < chain_length; link++)
+				{
+					auto link_job = [&steps, &errors, chain, link]()
+					{
+						if (steps[chain] != link) errors.fetch_add(1);
+						steps[chain]++;
+					};
+
+					JobCounter& counter = counters[chain * chain_length + link];
+					if (link == 0) jobs.Run(link_job, &counter);
+					else jobs.RunAfter(counters[chain * chain_length + link - 1], link_job, &counter);
+				}
+			}
+			for (int chain = 0; chain < chains_count; chain++)
+			{
+				jobs.Wait(counters[chain * chain_length + chain_length - 1]);
+				if (steps[chain] != chain_length) errors.fetch_add(1);
+			}
+
+			chain_errors += errors.load();
+			jobs_count += chains_count * chain_length;
+		}
+
+		//  main thread jobs given by the workers, they must only run on the main thread
+		{
+			std::atomic<int> errors{ 0 };
+			std::atomic<int> runs{ 0 };
+			JobCounter counter;
+			for (int i = 0; i < main_thread_jobs_count; i++)
+			{
+				jobs.Run([&jobs, &errors, &runs, &counter, main_thread_id]()
+					{
+						jobs.RunOnMainThread([&jobs, &errors, &runs, main_thread_id]()
+							{
+								if (std::this_thread::get_id() != main_thread_id || jobs.GetCurrentThreadIndex() != 0) errors.fetch_add(1);
+								runs.fetch_add(1);
+							}, &counter);
+					}, &counter);
+			}
+			jobs.Wait(counter);
+
+			main_thread_errors += errors.load() + (runs.load() != main_thread_jobs_count ? 1 : 0);
+			jobs_count += main_thread_jobs_count * 2;
+		}
+
+		//  parallel for: every index must be visited once, also from a parallel for inside a parallel for
+		{
+			std::vector<int> visits(elements_count, 0);
+			jobs.ParallelFor(elements_count, [&visits](int index) { visits[index]++; }, round % 2 == 0 ? 1 : 1000);
+
+			const int outer_count = 16;
+			const int inner_count = elements_count / outer_count;
+			jobs.ParallelFor(outer_count, [&jobs, &visits, inner_count](int outer)
+				{
+					jobs.ParallelFor(inner_count, [&visits, outer, inner_count](int inner) { visits[outer * inner_count + inner]++; });
+				});
+
+			for (int i = 0; i < elements_count; i++)
+			{
+				if (visits[i] != 2) parallel_for_errors++;
+			}
+		}
+	}
+	const double time = GetElapsedMilliseconds(start);
+
+	jobs.Stop();
+
+	LogErrors("nested jobs", nested_errors);
+	LogErrors("chains", chain_errors);
+	LogErrors("main thread jobs", main_thread_errors);
+	LogErrors("parallel for", parallel_for_errors);
+
+	const int errors_count = nested_errors + chain_errors + main_thread_errors + parallel_for_errors;
+	Locator::getLog().LogMessage_Category("Job Benchmark: Stress test " + std::string(errors_count == 0 ? "passed" : "failed") + " on " + std::to_string(workers_count + 1) +
+		" threads | " + std::to_string(roundsCount) + " rounds, " + std::to_string(jobs_count) + " jobs and " + std::to_string(roundsCount * 2) + " parallel for in " + std::to_string(time) + " ms",
+		errors_count == 0 ? LogCategory::Info : LogCategory::Warning);
+}
+
+void JobSystemBenchmarks::ScalingBenchmark(int elementsCount, int smallJobsCount)
+{
+	Log& log = Locator::getLog();
+	const int repeats_count = 10;
+
+	std::vector<float> values(elementsCount, 0.0f);
+	double single_thread_for_time = 0.0, single_thread_jobs_time = 0.0;
+
+	const int max_threads = GetHardwareThreadsCount();
+	for (int threads = 1; threads <= max_threads; threads++)
+	{
+		JobSystem jobs;
+		jobs.Start(threads - 1);
+
+		//  parallel for with a few math functions per index
+		auto start = std::chrono::steady_clock::now();
+		for (int repeat = 0; repeat < repeats_count; repeat++)
+		{
+			jobs.ParallelFor(elementsCount, [&values, repeat](int index)
+				{
+					const float x = static_cast<float>(index + repeat) * 0.001f;
+					values[index] = std::sqrt(x) * std::sin(x) + std::cos(x);
+				});
+		}
+		const double for_time = GetElapsedMilliseconds(start) / repeats_count;
+
+		//  small jobs, measures the cost of the job system itself
+		std::atomic<int> done_jobs{ 0 };
+		start = std::chrono::steady_clock::now();
+		{
+			JobCounter counter;
+			for (int i = 0; i < smallJobsCount; i++)
+			{
+				jobs.Run([&done_jobs]() { done_jobs.fetch_add(1, std::memory_order_relaxed); }, &counter);
+			}
+			jobs.Wait(counter);
+		}
+		const double jobs_time = GetElapsedMilliseconds(start);
+
+		jobs.Stop();
+
+		if (threads == 1)
+		{
+			single_thread_for_time = for_time;
+			single_thread_jobs_time = jobs_time;
+		}
+
+		log.LogMessage_Category("Job Benchmark: " + std::to_string(threads) + " threads | parallel for of " + std::to_string(elementsCount) + ": " + std::to_string(for_time) +
+			" ms (x" + std::to_string(for_time > 0.0 ? single_thread_for_time / for_time : 0.0) + ") | " + std::to_string(smallJobsCount) + " small jobs: " + std::to_string(jobs_time) +
+			" ms (" + std::to_string(smallJobsCount > 0 ? jobs_time * 1000000.0 / smallJobsCount : 0.0) + " ns/job, x" + std::to_string(jobs_time > 0.0 ? single_thread_jobs_time / jobs_time : 0.0) + ")", LogCategory::Info);
+
+		if (done_jobs.load() != smallJobsCount)
+			log.LogMessage_Category("Job Benchmark: " + std::to_string(smallJobsCount - done_jobs.load()) + " small jobs didn't run.", LogCategory::Warning);
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+
+/** Job System Benchmarks
+* Debug functions that check and measure the job system and log the results.
+* They use their own job systems, so they can run at any time (the engine runs them from the debug view).
+*/
+class JobSystemBenchmarks
+{
+public:
+	/**
+	* Run nested jobs, chains of jobs that run after each other, main thread jobs given by the workers and parallel for loops,
+	* then check that every job ran once, in the right order and on the right thread. Logs a warning for each error found.
+	* @param	roundsCount		Number of times the whole test is run.
+	*/
+	static void StressTest(int roundsCount = 20);
+
+	/**
+	* Measure a parallel for loop and a lot of small jobs with 1 to N threads (N being the hardware threads), and log the speedup of each threads count.
+	* @param	elementsCount		Number of indices of the parallel for loop.
+	* @param	smallJobsCount		Number of small jobs.
+	*/
+	static void ScalingBenchmark(int elementsCount = 4000000, int smallJobsCount = 100000);
+};
@@ -2,15 +2,55 @@
 #include <ServiceLocator/locator.h>
 #include <Objects/object.h>
 #include <Objects/Lights/light.h>
+#include <GameplayStatics/gameplayStatics.h>
+
 #include <algorithm>
+#include <chrono>
+#include <limits>
 
 void Scene::load() 
 { 
-	loadScene();
+	preload();
+	activate(std::numeric_limits<double>::max());
+}
+
+void Scene::preload()
+{
+	preloadScene();
+}
+
+bool Scene::activate(double budgetMs)
+{
+	if (activated) return true;
+
+	const auto start = std::chrono::high_resolution_clock::now();
+
+	if (!loaded)
+	{
+		loadScene();
+		loaded = true;
+	}
+
+	while (nextActivationStep < static_cast<int>(activationSteps.size()))
+	{
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+		if (elapsed.count() >= budgetMs) return false;
+
+		activationSteps[nextActivationStep]();
+		nextActivationStep++;
+	}
+
+	activationSteps.clear();
+	nextActivationStep = 0;
+	activated = true;
+	return true;
 }
 
 void Scene::unload(bool exitGame)
 {
+	//  the objects used by the commands that have not been applied yet might be deleted with the scene
+	discardCommands();
+
 	//  TODO: remove this when a proper integrations of collisions as components is done
 	Locator::getPhysics().ClearAllCollisions(exitGame);
 
@@ -28,11 +68,30 @@ void Scene::unload(bool exitGame)
 	}
 	sceneregisteredLights.clear();
 
+	SystemScheduler* scheduler = GameplayStatics::GetSystemScheduler();
+	for (int system_id : sceneregisteredSystems)
+	{
+		if (scheduler) scheduler->removeSystem(system_id);
+	}
+	sceneregisteredSystems.clear();
+
+	//  a scene unloaded during its activation drops the steps that didn't run (the steps of an active scene come from a new preload)
+	if (!activated)
+	{
+		activationSteps.clear();
+		nextActivationStep = 0;
+	}
+	loaded = false;
+	activated = false;
+
 	unloadScene();
 }
 
 void Scene::update(float dt)
 {
+	//  a streamed scene isn't updated until all its parts are there
+	if (!activated) return;
+
 	if (firstFrame)
 	{
 		firstFrame = false;
@@ -41,12 +100,18 @@ void Scene::update(float dt)
 
 	updateScene(dt);
 
-	for (auto object : sceneregisteredObjects)
+	//  by index, an object can unregister itself during its update (the last object then takes its place and is updated next frame)
+	for (int i = 0; i < sceneregisteredObjects.size(); i++)
 	{
-		object->updateObject(dt);
+		sceneregisteredObjects[i]->updateObject(dt);
 	}
 }
 
+void Scene::syncEntities()
+{
+	updateEntities();
+}
+
 Camera& Scene::getCamera() 
 { 
 	return *currentCam; 
@@ -54,23 +119,23 @@ Camera& Scene::getCamera()
 
 Object& Scene::registerObject(Object* object)
 {
-	sceneregisteredObjects.push_back(object);
+	object->sceneHandle = sceneregisteredObjects.insert(object);
 	object->load();
 	Locator::getRenderer().AddObject(object);
-	return *sceneregisteredObjects.back();
+	return *object;
 }
 
 Light& Scene::registerLight(Light* light)
 {
-	sceneregisteredLights.push_back(light);
+	light->sceneHandle = sceneregisteredLights.insert(light);
 	Locator::getRenderer().AddLight(light);
-	return *sceneregisteredLights.back();
+	return *light;
 }
 
 void Scene::unregisterObject(Object* object)
 {
-	auto iter = std::find(sceneregisteredObjects.begin(), sceneregisteredObjects.end(), object);
-	if (iter == sceneregisteredObjects.end())
+	Object** registered_object = sceneregisteredObjects.get(object->sceneHandle);
+	if (!registered_object || *registered_object != object)
 	{
 		Locator::getLog().LogMessage_Category("Scene: Tried to unregister a scene object that was not registered.", LogCategory::Error);
 		return;
@@ -78,13 +143,14 @@ void Scene::unregisterObject(Object* object)
 
 	Locator::getRenderer().RemoveObject(object);
 
-	sceneregisteredObjects.erase(iter);
+	sceneregisteredObjects.remove(object->sceneHandle);
+	object->sceneHandle = SlotHandle{};
 }
 
 void Scene::unregisterLight(Light* light)
 {
-	auto iter = std::find(sceneregisteredLights.begin(), sceneregisteredLights.end(), light);
-	if (iter == sceneregisteredLights.end())
+	Light** registered_light = sceneregisteredLights.get(light->sceneHandle);
+	if (!registered_light || *registered_light != light)
 	{
 		Locator::getLog().LogMessage_Category("Scene: Tried to unregister a scene light that was not registered.", LogCategory::Error);
 		return;
@@ -92,5 +158,36 @@ void Scene::unregisterLight(Light* light)
 
 	Locator::getRenderer().RemoveLight(light);
 
-	sceneregisteredLights.erase(iter);
+	sceneregisteredLights.remove(light->sceneHandle);
+	light->sceneHandle = SlotHandle{};
+}
+
+int Scene::registerSystem(const std::string& name, const SystemAccess& access, std::function<void(float)> update)
+{
+	SystemScheduler* scheduler = GameplayStatics::GetSystemScheduler();
+	if (!scheduler) return -1;
+
+	const int system_id = scheduler->addSystem(name, access, std::move(update));
+	sceneregisteredSystems.push_back(system_id);
+	return system_id;
+}
+
+void Scene::addActivationStep(std::function<void()> step)
+{
+	activationSteps.push_back(std::move(step));
+}
+
+void Scene::unregisterSystem(int systemId)
+{
+	auto iter = std::find(sceneregisteredSystems.begin(), sceneregisteredSystems.end(), systemId);
+	if (iter == sceneregisteredSystems.end())
+	{
+		Locator::getLog().LogMessage_Category("Scene: Tried to unregister a scene system that was not registered.", LogCategory::Error);
+		return;
+	}
+
+	SystemScheduler* scheduler = GameplayStatics::GetSystemScheduler();
+	if (scheduler) scheduler->removeSystem(systemId);
+
+	sceneregisteredSystems.erase(iter);
 }
@@ -1,7 +1,11 @@
 #pragma once
 #include <ECS/entityContainer.h>
 #include <Rendering/camera.h>
+#include "systemScheduler.h"
+#include <Utils/slotMap.h>
 
+#include <functional>
+#include <string>
 #include <vector>
 
 class Object;
@@ -16,10 +20,33 @@ public:
 	void load();
 	void unload(bool exitGame);
 
+	/* Preload
+	* First phase of a streamed load, run by a job on any thread while the game keeps playing the active scene.
+	*/
+	void preload();
+
+	/* Activate
+	* Second phase of a streamed load, on the main thread: loads the scene then runs its activation steps until the time budget is spent.
+	* Called every frame until the scene is activated, a step is never cut so the budget can be exceeded by the last step of a frame.
+	* @param	budgetMs	Time the activation can take this frame in milliseconds.
+	* @return				True once the scene is fully activated.
+	*/
+	bool activate(double budgetMs);
+
+	bool isActivated() const { return activated; }
+
 	void update(float dt);
 	
 	virtual void updateScene(float dt) = 0;
 
+	/* Sync Entities
+	* Apply the structural changes recorded in the command buffers of this scene during the frame.
+	* Called by the game once the physics and every object have been updated.
+	*/
+	void syncEntities();
+
+	using EntityContainer::getCommandBuffer;
+
 	Camera& getCamera();
 
 	/* Register Object
@@ -46,15 +73,50 @@ public:
 	*/
 	void unregisterLight(Light* light);
 
+	/* Register System
+	* Register a system in the engine system scheduler, it runs every frame after the scene update,
+	* at the same time as the other systems it doesn't conflict with.
+	* Will properly remove this system at scene unloading.
+	*/
+	int registerSystem(const std::string& name, const SystemAccess& access, std::function<void(float)> update);
+
+	/* Add Activation Step
+	* Add a part of the scene load that runs on the main thread after loadScene, each frame of the activation runs the steps that fit in its budget.
+	* Called from preloadScene or loadScene to spread a heavy load (GPU uploads, registration of many objects) on several frames.
+	*/
+	void addActivationStep(std::function<void()> step);
+
+	/* Unregister System
+	* Remove a system of this scene from the engine system scheduler.
+	*/
+	void unregisterSystem(int systemId);
+
+	//  objects and lights registered in this scene, in no particular order
+	inline const std::vector<Object*>& getRegisteredObjects() const { return sceneregisteredObjects.getValues(); }
+	inline const std::vector<Light*>& getRegisteredLights() const { return sceneregisteredLights.getValues(); }
+
 protected:
+	/* Preload Scene
+	* Part of the load that doesn't need the main thread (reading and decoding files, building static data), empty by default.
+	* It can run on a worker thread while this scene is still active (restarting a level): it must not use the renderer, the physics,
+	* the registration functions, nor change what the scene uses during its update.
+	*/
+	virtual void preloadScene() {}
 	virtual void loadScene() = 0;
 	virtual void unloadScene() = 0;
 
 	Camera* currentCam{ nullptr };
 
 private:
-	std::vector<Object*> sceneregisteredObjects;
-	std::vector<Light*> sceneregisteredLights;
+	SlotMap<Object*> sceneregisteredObjects;
+	SlotMap<Light*> sceneregisteredLights;
+	std::vector<int> sceneregisteredSystems;
 
 	bool firstFrame{ true };
+
+	//  streamed load
+	bool loaded{ false };
+	bool activated{ false };
+	std::vector<std::function<void()>> activationSteps;
+	int nextActivationStep{ 0 };
 };
\ No newline at end of file
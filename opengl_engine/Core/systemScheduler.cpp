@@ -0,0 +1,190 @@
+#include "systemScheduler.h"
+#include <ServiceLocator/locator.h>
+
+#include <algorithm>
+
+
+void SystemAccess::addType(ComponentMask& mask, int typeId)
+{
+	if (typeId < 0 || typeId >= MAX_COMPONENT_TYPES)
+	{
+		writesEverything = true;
+		return;
+	}
+
+	mask.set(typeId);
+}
+
+bool SystemAccess::conflictsWith(const SystemAccess& other) const
+{
+	if (writesEverything || other.writesEverything) return true;
+
+	return writes.intersects(other.writes) || writes.intersects(other.reads) || reads.intersects(other.writes);
+}
+
+
+
+int SystemScheduler::addSystem(const std::string& name, const SystemAccess& access, std::function<void(float)> update)
+{
+	System system;
+	system.id = nextSystemId++;
+	system.name = name;
+	system.access = access;
+	system.update = std::move(update);
+	systems.push_back(std::move(system));
+
+	graphDirty = true;
+	return systems.back().id;
+}
+
+void SystemScheduler::removeSystem(int systemId)
+{
+	//  erased and not swapped, the registration order is the order of the conflicting systems
+	auto iter = std::find_if(systems.begin(), systems.end(), [systemId](const System& system) { return system.id == systemId; });
+	if (iter == systems.end())
+	{
+		Locator::getLog().LogMessage_Category("System Scheduler: Tried to remove a system that doesn't exist.", LogCategory::Error);
+		return;
+	}
+
+	systems.erase(iter);
+	graphDirty = true;
+}
+
+
+void SystemScheduler::buildGraph()
+{
+	const int systems_count = getSystemsCount();
+
+	successors.assign(systems_count, std::vector<int>());
+	predecessorsCount.assign(systems_count, 0);
+	rootSystems.clear();
+
+	//  a system waits for every system registered before it that it conflicts with
+	for (int system = 0; system < systems_count; system++)
+	{
+		for (int previous = 0; previous < system; previous++)
+		{
+			if (!systems[system].access.conflictsWith(systems[previous].access)) continue;
+
+			successors[previous].push_back(system);
+			predecessorsCount[system]++;
+		}
+
+		if (predecessorsCount[system] == 0) rootSystems.push_back(system);
+	}
+
+	pendingPredecessors.reset(new std::atomic<int>[systems_count > 0 ? systems_count : 1]);
+
+	timeline.assign(systems_count, SystemTimelineEntry());
+	for (int system = 0; system < systems_count; system++)
+	{
+		timeline[system].name = systems[system].name;
+	}
+
+	graphDirty = false;
+}
+
+void SystemScheduler::run(float dt)
+{
+	if (graphDirty) buildGraph();
+
+	Jobs& jobs = Locator::getJobs();
+	lastThreadsCount = jobs.GetThreadsCount();
+
+	runStart = std::chrono::steady_clock::now();
+	lastRunTime = 0.0;
+	if (systems.empty()) return;
+
+	runDeltaTime = dt;
+	for (int system = 0; system < getSystemsCount(); system++)
+	{
+		pendingPredecessors[system] = predecessorsCount[system];
+	}
+
+	//  the counter stays pending until the last system, a system gives its successors to the jobs before it finishes
+	JobCounter counter;
+	for (int system : rootSystems)
+	{
+		submitSystem(system, counter);
+	}
+	jobs.Wait(counter);
+
+	lastRunTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStart).count();
+}
+
+float SystemScheduler::getLastParallelism() const
+{
+	if (lastRunTime <= 0.0) return 1.0f;
+
+	double systems_time = 0.0;
+	for (auto& entry : timeline)
+	{
+		systems_time += entry.end - entry.start;
+	}
+	return static_cast<float>(systems_time / lastRunTime);
+}
+
+std::vector<std::string> SystemScheduler::getTimelineText(int width) const
+{
+	std::vector<std::string> lines;
+	if (timeline.empty() || lastRunTime <= 0.0 || width <= 0) return lines;
+
+	const int threads_count = lastThreadsCount;
+	std::vector<std::string> rows(threads_count, std::string(width, '.'));
+	for (int system = 0; system < timeline.size(); system++)
+	{
+		const SystemTimelineEntry& entry = timeline[system];
+		if (entry.thread < 0 || entry.thread >= threads_count) continue;
+
+		const int first = std::min(static_cast<int>(entry.start / lastRunTime * width), width - 1);
+		const int last = std::max(std::min(static_cast<int>(entry.end / lastRunTime * width), width - 1), first);
+		for (int column = first; column <= last; column++)
+		{
+			rows[entry.thread][column] = static_cast<char>('A' + system % 26);
+		}
+	}
+
+	for (int thread = 0; thread < threads_count; thread++)
+	{
+		lines.push_back((thread == 0 ? std::string("main     |") : "worker " + std::to_string(thread) + (thread < 10 ? " |" : "|")) + rows[thread] + "|");
+	}
+	for (int system = 0; system < timeline.size(); system++)
+	{
+		lines.push_back(std::string(1, static_cast<char>('A' + system % 26)) + ": " + timeline[system].name + " " + std::to_string(timeline[system].end - timeline[system].start) + " ms");
+	}
+
+	return lines;
+}
+
+
+void SystemScheduler::submitSystem(int system, JobCounter& counter)
+{
+	Jobs& jobs = Locator::getJobs();
+	if (systems[system].access.isOnMainThread())
+	{
+		jobs.RunOnMainThread([this, system, &counter]() { runSystem(system, counter); }, &counter);
+	}
+	else
+	{
+		jobs.Run([this, system, &counter]() { runSystem(system, counter); }, &counter);
+	}
+}
+
+void SystemScheduler::runSystem(int system, JobCounter& counter)
+{
+	const int thread = Locator::getJobs().GetCurrentThreadIndex();
+
+	SystemTimelineEntry& entry = timeline[system];
+	entry.thread = thread > 0 ? thread : 0;
+	entry.start = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStart).count();
+
+	systems[system].update(runDeltaTime);
+
+	entry.end = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - runStart).count();
+
+	for (int successor : successors[system])
+	{
+		if (pendingPredecessors[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) submitSystem(successor, counter);
+	}
+}
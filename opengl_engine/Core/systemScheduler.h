@@ -0,0 +1,148 @@
+#pragma once
+#include <ECS/componentTypeId.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class JobCounter;
+
+
+/** System Access
+* Components and resources (any type: a component class, a service, a game class) that a system reads and writes.
+* Two systems conflict if one of them writes a type that the other reads or writes, conflicting systems never run at the same time.
+*/
+class SystemAccess
+{
+public:
+	template<typename T>
+	SystemAccess& read()
+	{
+		addType(reads, ComponentTypeId::Get<T>());
+		return *this;
+	}
+
+	template<typename T>
+	SystemAccess& write()
+	{
+		addType(writes, ComponentTypeId::Get<T>());
+		return *this;
+	}
+
+	//  the system makes calls that are only allowed on the main thread (like the calls to GLFW)
+	SystemAccess& onMainThread()
+	{
+		mainThread = true;
+		return *this;
+	}
+
+	bool conflictsWith(const SystemAccess& other) const;
+
+	inline bool isOnMainThread() const { return mainThread; }
+
+private:
+	void addType(ComponentMask& mask, int typeId);
+
+	ComponentMask reads;
+	ComponentMask writes;
+	bool mainThread{ false };
+	bool writesEverything{ false }; //  a type that doesn't fit in the masks, conflicts with every system
+};
+
+
+/** System Timeline Entry
+* When and on which thread a system ran during the last frame, in milliseconds from the start of the frame systems.
+*/
+struct SystemTimelineEntry
+{
+	std::string name;
+	int thread{ 0 }; //  index in the job system, 0 is the main thread
+	double start{ 0.0 };
+	double end{ 0.0 };
+};
+
+
+/** System Scheduler
+* Runs the registered systems of a frame as jobs of the jobs service.
+* The systems are ordered by a dependency graph built from their accesses: a system waits for every conflicting system registered before it,
+* the others can run at the same time. A system is given to the jobs service as soon as its last predecessor finishes.
+* The calling thread works while it waits for the systems, so with the null jobs service the systems simply run one after the other.
+*/
+class SystemScheduler
+{
+public:
+	SystemScheduler() = default;
+	SystemScheduler(const SystemScheduler&) = delete;
+	SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+	/**
+	* Register a system, it runs every frame until it is removed.
+	* @param	name	Name of the system, for the timeline.
+	* @param	access	Types the system reads and writes.
+	* @param	update	Function called with the delta time.
+	* @return			Id of the system, to remove it.
+	*/
+	int addSystem(const std::string& name, const SystemAccess& access, std::function<void(float)> update);
+
+	/**
+	* Remove a system, must not be called by a system while the scheduler runs.
+	*/
+	void removeSystem(int systemId);
+
+	/**
+	* Run every system once and wait for all of them to finish.
+	* @param	dt	Delta time given to the systems.
+	*/
+	void run(float dt);
+
+	inline int getSystemsCount() const { return static_cast<int>(systems.size()); }
+
+	//  when and where each system ran during the last run
+	inline const std::vector<SystemTimelineEntry>& getTimeline() const { return timeline; }
+	inline double getLastRunTime() const { return lastRunTime; }
+
+	//  total time of the systems divided by the time of the run, 1 if they all ran one after the other
+	float getLastParallelism() const;
+
+	/**
+	* Draw the timeline of the last run as text, one line per thread (each system is drawn with a letter, followed by the legend).
+	* @param	width	Number of characters used for the duration of the run.
+	* @return			Lines of the timeline.
+	*/
+	std::vector<std::string> getTimelineText(int width = 64) const;
+
+private:
+	struct System
+	{
+		int id{ 0 };
+		std::string name;
+		SystemAccess access;
+		std::function<void(float)> update;
+	};
+
+	void buildGraph();
+
+	void submitSystem(int system, JobCounter& counter);
+	void runSystem(int system, JobCounter& counter);
+
+	std::vector<System> systems;
+	int nextSystemId{ 0 };
+
+	//  dependency graph, built again when the systems change
+	bool graphDirty{ true };
+	std::vector<std::vector<int>> successors;
+	std::vector<int> predecessorsCount;
+	std::vector<int> rootSystems;
+
+	//  state of the current run
+	std::unique_ptr<std::atomic<int>[]> pendingPredecessors;
+	float runDeltaTime{ 0.0f };
+	std::chrono::steady_clock::time_point runStart;
+
+	std::vector<SystemTimelineEntry> timeline;
+	double lastRunTime{ 0.0 };
+	int lastThreadsCount{ 1 };
+};
@@ -0,0 +1,290 @@
+#include "archetypeStorage.h"
+#include <ServiceLocator/locator.h>
+
+#include <algorithm>
+#include <mutex>
+
+
+namespace
+{
+	std::vector<ComponentTypeInfo>& GetTypesRegistry()
+	{
+		static std::vector<ComponentTypeInfo> registry;
+		return registry;
+	}
+
+	std::mutex& GetTypesRegistryMutex()
+	{
+		static std::mutex registry_mutex;
+		return registry_mutex;
+	}
+}
+
+
+ComponentTypeInfo ComponentTypeInfo::Register(ComponentTypeInfo info)
+{
+	std::lock_guard<std::mutex> lock(GetTypesRegistryMutex());
+
+	std::vector<ComponentTypeInfo>& registry = GetTypesRegistry();
+	if (registry.size() <= info.id) registry.resize(info.id + 1);
+	registry[info.id] = info;
+	return info;
+}
+
+ComponentTypeInfo ComponentTypeInfo::GetById(int id)
+{
+	std::lock_guard<std::mutex> lock(GetTypesRegistryMutex());
+	return GetTypesRegistry()[id];
+}
+
+
+
+Archetype::Archetype(const std::vector<int>& signature_) : signature(signature_)
+{
+	size_t row_bytes = 0;
+	size_t alignment_padding = 0;
+	for (int type_id : signature)
+	{
+		const ComponentTypeInfo type = ComponentTypeInfo::GetById(type_id);
+		types.push_back(type);
+		if (type_id < MAX_COMPONENT_TYPES) mask.set(type_id);
+		row_bytes += type.size;
+		alignment_padding += type.alignment;
+	}
+
+	//  as many rows as fit in a chunk once every column is aligned, at least one for the big components
+	chunkCapacity = row_bytes > 0 ? static_cast<int>((CHUNK_BYTES - (alignment_padding < CHUNK_BYTES ? alignment_padding : CHUNK_BYTES)) / row_bytes) : 0;
+	chunkCapacity = std::max(chunkCapacity, 1);
+
+	size_t offset = 0;
+	for (auto& type : types)
+	{
+		offset = (offset + type.alignment - 1) / type.alignment * type.alignment;
+		columnsOffsets.push_back(offset);
+		offset += type.size * chunkCapacity;
+	}
+	chunkBytes = std::max<size_t>(offset, 1);
+}
+
+Archetype::~Archetype()
+{
+	for (int chunk = 0; chunk < getChunksCount(); chunk++)
+	{
+		for (int column = 0; column < types.size(); column++)
+		{
+			for (int row = 0; row < getChunkEntitiesCount(chunk); row++)
+			{
+				types[column].destroy(getComponent(column, chunk, row));
+			}
+		}
+	}
+}
+
+int Archetype::getColumn(int typeId) const
+{
+	if (typeId < MAX_COMPONENT_TYPES) return mask.test(typeId) ? ComponentTypeId::GetRank(mask, typeId) : -1;
+
+	auto iter = std::lower_bound(signature.begin(), signature.end(), typeId);
+	if (iter == signature.end() || *iter != typeId) return -1;
+
+	return static_cast<int>(iter - signature.begin());
+}
+
+void Archetype::addRow(EntityId entity, int& outChunk, int& outRow)
+{
+	if (chunks.empty() || chunks.back().entities.size() >= chunkCapacity)
+	{
+		Chunk chunk;
+		chunk.data.reset(new unsigned char[chunkBytes]);
+		chunk.entities.reserve(chunkCapacity);
+		chunks.push_back(std::move(chunk));
+	}
+
+	Chunk& last_chunk = chunks.back();
+	outChunk = getChunksCount() - 1;
+	outRow = static_cast<int>(last_chunk.entities.size());
+	last_chunk.entities.push_back(entity);
+	entitiesCount++;
+}
+
+EntityId Archetype::removeRow(int chunk, int row, bool destroyComponents)
+{
+	if (destroyComponents)
+	{
+		for (int column = 0; column < types.size(); column++)
+		{
+			types[column].destroy(getComponent(column, chunk, row));
+		}
+	}
+
+	const int last_chunk = getChunksCount() - 1;
+	const int last_row = getChunkEntitiesCount(last_chunk) - 1;
+	EntityId moved_entity = INVALID_ENTITY;
+
+	//  fill the hole with the last row to keep the columns packed
+	if (chunk != last_chunk || row != last_row)
+	{
+		for (int column = 0; column < types.size(); column++)
+		{
+			void* last_component = getComponent(column, last_chunk, last_row);
+			types[column].moveConstruct(getComponent(column, chunk, row), last_component);
+			types[column].destroy(last_component);
+		}
+		moved_entity = chunks[last_chunk].entities[last_row];
+		chunks[chunk].entities[row] = moved_entity;
+	}
+
+	chunks[last_chunk].entities.pop_back();
+	if (chunks[last_chunk].entities.empty()) chunks.pop_back();
+	entitiesCount--;
+
+	return moved_entity;
+}
+
+
+
+ArchetypeStorage::~ArchetypeStorage()
+{
+	//  the archetypes destroy the components they still have
+	archetypes.clear();
+}
+
+EntityId ArchetypeStorage::createEntity()
+{
+	EntityId entity;
+	if (!freeIds.empty())
+	{
+		entity = freeIds.back();
+		freeIds.pop_back();
+	}
+	else
+	{
+		entity = static_cast<EntityId>(records.size());
+		records.emplace_back();
+	}
+
+	records[entity] = EntityRecord{};
+	records[entity].alive = true;
+	return entity;
+}
+
+void ArchetypeStorage::destroyEntity(EntityId entity)
+{
+	if (!isAlive(entity))
+	{
+		Locator::getLog().LogMessage_Category("Archetype Storage: Tried to destroy an entity that doesn't exist.", LogCategory::Error);
+		return;
+	}
+
+	EntityRecord& record = records[entity];
+	if (record.archetype)
+	{
+		const EntityId moved_entity = record.archetype->removeRow(record.chunk, record.row, true);
+		if (moved_entity != INVALID_ENTITY)
+		{
+			records[moved_entity].chunk = record.chunk;
+			records[moved_entity].row = record.row;
+		}
+	}
+
+	record = EntityRecord{};
+	freeIds.push_back(entity);
+}
+
+bool ArchetypeStorage::isAlive(EntityId entity) const
+{
+	return entity < records.size() && records[entity].alive;
+}
+
+
+Archetype* ArchetypeStorage::findOrCreateArchetype(const std::vector<int>& signature)
+{
+	if (signature.empty()) return nullptr;
+
+	auto iter = archetypes.find(signature);
+	if (iter != archetypes.end()) return iter->second.get();
+
+	Archetype* archetype = new Archetype(signature);
+	archetypes.emplace(signature, std::unique_ptr<Archetype>(archetype));
+	return archetype;
+}
+
+Archetype* ArchetypeStorage::getArchetypeWith(Archetype* from, int typeId)
+{
+	if (from)
+	{
+		auto edge = from->addEdges.find(typeId);
+		if (edge != from->addEdges.end()) return edge->second;
+	}
+
+	std::vector<int> signature = from ? from->getSignature() : std::vector<int>{};
+	signature.insert(std::lower_bound(signature.begin(), signature.end(), typeId), typeId);
+
+	Archetype* archetype = findOrCreateArchetype(signature);
+	if (from) from->addEdges[typeId] = archetype;
+	return archetype;
+}
+
+Archetype* ArchetypeStorage::getArchetypeWithout(Archetype* from, int typeId)
+{
+	auto edge = from->removeEdges.find(typeId);
+	if (edge != from->removeEdges.end()) return edge->second;
+
+	std::vector<int> signature = from->getSignature();
+	signature.erase(std::lower_bound(signature.begin(), signature.end(), typeId));
+
+	Archetype* archetype = findOrCreateArchetype(signature);
+	from->removeEdges[typeId] = archetype;
+	return archetype;
+}
+
+void* ArchetypeStorage::moveEntity(EntityId entity, Archetype* destination, int addedTypeId)
+{
+	EntityRecord& record = records[entity];
+	Archetype* source = record.archetype;
+
+	int new_chunk = 0, new_row = 0;
+	if (destination) destination->addRow(entity, new_chunk, new_row);
+
+	//  move the components that the destination also has, destroy the removed one
+	if (source)
+	{
+		for (int column = 0; column < source->types.size(); column++)
+		{
+			void* component = source->getComponent(column, record.chunk, record.row);
+			const int new_column = destination ? destination->getColumn(source->signature[column]) : -1;
+			if (new_column >= 0)
+			{
+				source->types[column].moveConstruct(destination->getComponent(new_column, new_chunk, new_row), component);
+			}
+			source->types[column].destroy(component);
+		}
+
+		const EntityId moved_entity = source->removeRow(record.chunk, record.row, false);
+		if (moved_entity != INVALID_ENTITY)
+		{
+			records[moved_entity].chunk = record.chunk;
+			records[moved_entity].row = record.row;
+		}
+	}
+
+	record.archetype = destination;
+	record.chunk = new_chunk;
+	record.row = new_row;
+
+	if (!destination || addedTypeId < 0) return nullptr;
+	return destination->getComponent(destination->getColumn(addedTypeId), new_chunk, new_row);
+}
+
+void* ArchetypeStorage::findComponent(EntityId entity, int typeId) const
+{
+	if (!isAlive(entity)) return nullptr;
+
+	const EntityRecord& record = records[entity];
+	if (!record.archetype) return nullptr;
+
+	const int column = record.archetype->getColumn(typeId);
+	if (column < 0) return nullptr;
+
+	return record.archetype->getComponent(column, record.chunk, record.row);
+}
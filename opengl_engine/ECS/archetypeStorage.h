@@ -0,0 +1,332 @@
+#pragma once
+#include "componentTypeId.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using EntityId = uint32_t;
+const EntityId INVALID_ENTITY{ 0xFFFFFFFF };
+
+
+/** Component Type Info
+* Id, size and type-erased functions of a component type stored in the archetype columns.
+*/
+struct ComponentTypeInfo
+{
+	int id{ -1 };
+	size_t size{ 0 };
+	size_t alignment{ 0 };
+	void(*moveConstruct)(void* destination, void* source) { nullptr };
+	void(*destroy)(void* component) { nullptr };
+
+	template<typename T>
+	static const ComponentTypeInfo& Get();
+
+	static ComponentTypeInfo GetById(int id);
+
+private:
+	static ComponentTypeInfo Register(ComponentTypeInfo info);
+};
+
+
+
+/** Archetype
+* Storage of all the entities that have the exact same set of components (the signature).
+* The components are stored in chunks of about 16 KB, each chunk has one contiguous column per component type,
+* so iterating a component type is a linear walk in memory. The rows are always packed: removing a row moves the last one in its place.
+*/
+class Archetype
+{
+public:
+	Archetype(const std::vector<int>& signature);
+	~Archetype();
+
+	Archetype(const Archetype&) = delete;
+	Archetype& operator=(const Archetype&) = delete;
+
+	inline const std::vector<int>& getSignature() const { return signature; }
+	inline const ComponentMask& getMask() const { return mask; }
+	inline int getEntitiesCount() const { return entitiesCount; }
+	inline int getChunksCount() const { return static_cast<int>(chunks.size()); }
+	inline int getChunkCapacity() const { return chunkCapacity; }
+	inline int getChunkEntitiesCount(int chunk) const { return static_cast<int>(chunks[chunk].entities.size()); }
+	inline const EntityId* getChunkEntities(int chunk) const { return chunks[chunk].entities.data(); }
+
+	//  column of a component type in this archetype, -1 if the archetype doesn't have this type
+	int getColumn(int typeId) const;
+
+	inline void* getColumnData(int column, int chunk) const { return chunks[chunk].data.get() + columnsOffsets[column]; }
+	inline void* getComponent(int column, int chunk, int row) const { return static_cast<unsigned char*>(getColumnData(column, chunk)) + types[column].size * row; }
+
+	/**
+	* Add a row at the end of the archetype, its components are not constructed.
+	* @param	entity		Entity that uses this row.
+	* @param	outChunk	Chunk of the row. [OUT]
+	* @param	outRow		Row in the chunk. [OUT]
+	*/
+	void addRow(EntityId entity, int& outChunk, int& outRow);
+
+	/**
+	* Remove a row, the last row of the archetype is moved in its place.
+	* @param	chunk				Chunk of the row.
+	* @param	row					Row in the chunk.
+	* @param	destroyComponents	Destroy the components of the row (false if they have already been moved or destroyed).
+	* @return						Entity that has been moved in this row, INVALID_ENTITY if it was the last row.
+	*/
+	EntityId removeRow(int chunk, int row, bool destroyComponents);
+
+private:
+	friend class ArchetypeStorage;
+
+	struct Chunk
+	{
+		std::unique_ptr<unsigned char[]> data;
+		std::vector<EntityId> entities;
+	};
+
+	std::vector<int> signature; //  sorted type ids
+	ComponentMask mask;
+	std::vector<ComponentTypeInfo> types;
+	std::vector<size_t> columnsOffsets;
+	size_t chunkBytes{ 0 };
+	int chunkCapacity{ 0 };
+
+	std::vector<Chunk> chunks;
+	int entitiesCount{ 0 };
+
+	//  archetypes reached by adding or removing a type, filled as they are used
+	std::unordered_map<int, Archetype*> addEdges;
+	std::unordered_map<int, Archetype*> removeEdges;
+
+	static const size_t CHUNK_BYTES{ 16 * 1024 };
+};
+
+
+
+template<typename... Ts>
+class ArchetypeView;
+
+/** Archetype Storage
+* Entities and their data components, grouped by archetypes.
+* The components can be any movable type (they are moved when their entity changes of archetype), the pointers
+* to them are only valid until the next structural change (create, destroy, add or remove component) of the storage.
+* Use views to iterate the entities that have a set of components.
+*/
+class ArchetypeStorage
+{
+public:
+	ArchetypeStorage() {}
+	~ArchetypeStorage();
+
+	ArchetypeStorage(const ArchetypeStorage&) = delete;
+	ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+	EntityId createEntity();
+	void destroyEntity(EntityId entity);
+	bool isAlive(EntityId entity) const;
+
+	/**
+	* Add a component to an entity, which moves it to the archetype that has this component.
+	* @param	entity	Entity to add the component to.
+	* @param	args	Arguments given to the component constructor.
+	* @return			The added component (the existing one if the entity already has a component of this type).
+	*/
+	template<typename T, typename... Args>
+	T& addComponent(EntityId entity, Args&&... args);
+
+	template<typename T>
+	void removeComponent(EntityId entity);
+
+	template<typename T>
+	bool hasComponent(EntityId entity) const;
+
+	//  nullptr if the entity doesn't have a component of this type
+	template<typename T>
+	T* getComponent(EntityId entity) const;
+
+	/**
+	* Get a view on every entity that has all the given component types (and maybe others).
+	* The storage must not be structurally changed while iterating the view.
+	*/
+	template<typename... Ts>
+	ArchetypeView<Ts...> view();
+
+	inline int getEntitiesCount() const { return static_cast<int>(records.size() - freeIds.size()); }
+	inline int getArchetypesCount() const { return static_cast<int>(archetypes.size()); }
+
+private:
+	struct EntityRecord
+	{
+		Archetype* archetype{ nullptr }; //  nullptr while the entity has no component
+		int chunk{ 0 };
+		int row{ 0 };
+		bool alive{ false };
+	};
+
+	Archetype* findOrCreateArchetype(const std::vector<int>& signature);
+	Archetype* getArchetypeWith(Archetype* from, int typeId);
+	Archetype* getArchetypeWithout(Archetype* from, int typeId);
+
+	//  move the components of an entity to another archetype, returns the slot of the added type (not constructed) if there is one
+	void* moveEntity(EntityId entity, Archetype* destination, int addedTypeId);
+
+	void* findComponent(EntityId entity, int typeId) const;
+
+	std::vector<EntityRecord> records;
+	std::vector<EntityId> freeIds;
+	std::map<std::vector<int>, std::unique_ptr<Archetype>> archetypes;
+};
+
+
+
+/** Archetype View
+* Archetypes of a storage that have all the components of a view, iterated chunk by chunk.
+*/
+template<typename... Ts>
+class ArchetypeView
+{
+public:
+	ArchetypeView(std::vector<Archetype*> matchingArchetypes) : archetypes(std::move(matchingArchetypes)) {}
+
+	/**
+	* Call a function on every chunk of the view.
+	* @param	func	Called with the entities count of the chunk, the entities array and one array per component type: func(int count, const EntityId* entities, Ts*... components)
+	*/
+	template<typename Func>
+	void eachChunk(Func func) const;
+
+	/**
+	* Call a function on every entity of the view.
+	* @param	func	Called with the entity and its components: func(EntityId entity, Ts&... components)
+	*/
+	template<typename Func>
+	void each(Func func) const;
+
+	int count() const;
+
+private:
+	template<typename Func, size_t... Indices>
+	static void CallOnChunk(Func& func, const Archetype& archetype, const int* columns, int chunk, std::index_sequence<Indices...>)
+	{
+		func(archetype.getChunkEntitiesCount(chunk), archetype.getChunkEntities(chunk), static_cast<Ts*>(archetype.getColumnData(columns[Indices], chunk))...);
+	}
+
+	std::vector<Archetype*> archetypes;
+};
+
+
+
+
+template<typename T>
+const ComponentTypeInfo& ComponentTypeInfo::Get()
+{
+	static_assert(alignof(T) <= alignof(std::max_align_t), "Archetype Storage: over-aligned component types are not supported.");
+	static_assert(std::is_move_constructible<T>::value, "Archetype Storage: component types must be move constructible.");
+
+	static const ComponentTypeInfo type_info = Register(ComponentTypeInfo
+	{
+		ComponentTypeId::Get<T>(), sizeof(T), alignof(T),
+		[](void* destination, void* source) { new (destination) T(std::move(*static_cast<T*>(source))); },
+		[](void* component) { static_cast<T*>(component)->~T(); }
+	});
+	return type_info;
+}
+
+
+template<typename T, typename... Args>
+T& ArchetypeStorage::addComponent(EntityId entity, Args&&... args)
+{
+	const int type_id = ComponentTypeInfo::Get<T>().id;
+	if (void* existing = findComponent(entity, type_id)) return *static_cast<T*>(existing);
+
+	void* slot = moveEntity(entity, getArchetypeWith(records[entity].archetype, type_id), type_id);
+	return *new (slot) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void ArchetypeStorage::removeComponent(EntityId entity)
+{
+	const int type_id = ComponentTypeInfo::Get<T>().id;
+	if (!findComponent(entity, type_id)) return;
+
+	moveEntity(entity, getArchetypeWithout(records[entity].archetype, type_id), -1);
+}
+
+template<typename T>
+bool ArchetypeStorage::hasComponent(EntityId entity) const
+{
+	return findComponent(entity, ComponentTypeInfo::Get<T>().id) != nullptr;
+}
+
+template<typename T>
+T* ArchetypeStorage::getComponent(EntityId entity) const
+{
+	return static_cast<T*>(findComponent(entity, ComponentTypeInfo::Get<T>().id));
+}
+
+template<typename... Ts>
+ArchetypeView<Ts...> ArchetypeStorage::view()
+{
+	static_assert(sizeof...(Ts) > 0, "Archetype Storage: a view needs at least one component type.");
+
+	const int types_ids[] = { ComponentTypeInfo::Get<Ts>().id... };
+	ComponentMask view_mask;
+	for (int type_id : types_ids)
+	{
+		if (type_id >= MAX_COMPONENT_TYPES) return ArchetypeView<Ts...>(std::vector<Archetype*>());
+		view_mask.set(type_id);
+	}
+
+	std::vector<Archetype*> matching_archetypes;
+	for (auto& archetype : archetypes)
+	{
+		if (archetype.second->getMask().contains(view_mask)) matching_archetypes.push_back(archetype.second.get());
+	}
+
+	return ArchetypeView<Ts...>(std::move(matching_archetypes));
+}
+
+
+template<typename... Ts>
+template<typename Func>
+void ArchetypeView<Ts...>::eachChunk(Func func) const
+{
+	for (Archetype* archetype : archetypes)
+	{
+		const int columns[] = { archetype->getColumn(ComponentTypeInfo::Get<Ts>().id)... };
+		for (int chunk = 0; chunk < archetype->getChunksCount(); chunk++)
+		{
+			CallOnChunk(func, *archetype, columns, chunk, std::index_sequence_for<Ts...>{});
+		}
+	}
+}
+
+template<typename... Ts>
+template<typename Func>
+void ArchetypeView<Ts...>::each(Func func) const
+{
+	eachChunk([&func](int count, const EntityId* entities, Ts*... components)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			func(entities[i], components[i]...);
+		}
+	});
+}
+
+template<typename... Ts>
+int ArchetypeView<Ts...>::count() const
+{
+	int entities_count = 0;
+	for (Archetype* archetype : archetypes)
+	{
+		entities_count += archetype->getEntitiesCount();
+	}
+	return entities_count;
+}
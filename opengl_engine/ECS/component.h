@@ -6,7 +6,7 @@ class Component
 {
 public:
 	Component();
-	~Component();
+	virtual ~Component();
 
 	Component(const Component&) = delete;
 	Component& operator=(const Component&) = delete;
@@ -14,6 +14,9 @@ public:
 	/** Get the Entity that owns this component. */
 	Entity* getOwner() const;
 
+	/** Get the id of the exact class of this component (see ComponentTypeId). */
+	inline int getComponentTypeId() const { return componentTypeId; }
+
 	/** Called after the component has been created. */
 	virtual void init() {};
 
@@ -25,6 +28,7 @@ protected:
 
 private:
 	Entity* owner{ nullptr };
+	int componentTypeId{ -1 };
 
 	bool componentRegistered{ false };
 
@@ -0,0 +1,28 @@
+#include "componentTypeId.h"
+#include <ServiceLocator/locator.h>
+
+#include <atomic>
+
+
+namespace
+{
+	std::atomic<int> typesCount{ 0 };
+}
+
+
+int ComponentTypeId::GetTypesCount()
+{
+	return typesCount.load();
+}
+
+int ComponentTypeId::Next()
+{
+	const int type_id = typesCount.fetch_add(1);
+	if (type_id == MAX_COMPONENT_TYPES)
+	{
+		Locator::getLog().LogMessage_Category("Component Type Id: More than " + std::to_string(MAX_COMPONENT_TYPES) +
+			" component types are used, the next ones can't be found in the entities and archetypes masks.", LogCategory::Error);
+	}
+
+	return type_id;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <bitset>
+#include <cstdint>
+
+const int MAX_COMPONENT_TYPES{ 256 };
+
+
+/** Component Mask
+* Set of component type ids, one bit per type.
+*/
+class ComponentMask
+{
+public:
+	inline bool test(int typeId) const { return (words[typeId / 64] >> (typeId % 64)) & 1; }
+	inline void set(int typeId) { words[typeId / 64] |= uint64_t{ 1 } << (typeId % 64); }
+	inline void reset(int typeId) { words[typeId / 64] &= ~(uint64_t{ 1 } << (typeId % 64)); }
+	void reset();
+
+	//  does this mask have all the types of another mask?
+	bool contains(const ComponentMask& other) const;
+
+	//  does this mask have at least one type of another mask?
+	bool intersects(const ComponentMask& other) const;
+
+	//  number of types of this mask that have a lower id than a type
+	int countBelow(int typeId) const;
+
+private:
+	static const int WORDS_COUNT{ MAX_COMPONENT_TYPES / 64 };
+	uint64_t words[WORDS_COUNT]{};
+};
+
+
+/** Component Type Id
+* Dense id of each component type (polymorphic and data components share the same ids), given the first time the type is used.
+* Entities and archetypes keep a mask of the ids they have, so testing a type is a single bit test and finding it
+* in an array sorted by type id is a popcount (the rank of its bit in the mask), without any RTTI.
+*/
+class ComponentTypeId
+{
+public:
+	template<typename T>
+	static int Get()
+	{
+		static const int type_id = Next();
+		return type_id;
+	}
+
+	static int GetTypesCount();
+
+	inline static bool IsInMask(const ComponentMask& mask, int typeId)
+	{
+		return typeId >= 0 && typeId < MAX_COMPONENT_TYPES && mask.test(typeId);
+	}
+
+	//  index of a type in an array sorted by type id that has all the types of the mask
+	inline static int GetRank(const ComponentMask& mask, int typeId)
+	{
+		return mask.countBelow(typeId);
+	}
+
+private:
+	static int Next();
+};
+
+
+
+inline void ComponentMask::reset()
+{
+	for (int i = 0; i < WORDS_COUNT; i++)
+	{
+		words[i] = 0;
+	}
+}
+
+inline bool ComponentMask::contains(const ComponentMask& other) const
+{
+	for (int i = 0; i < WORDS_COUNT; i++)
+	{
+		if ((words[i] & other.words[i]) != other.words[i]) return false;
+	}
+	return true;
+}
+
+inline bool ComponentMask::intersects(const ComponentMask& other) const
+{
+	for (int i = 0; i < WORDS_COUNT; i++)
+	{
+		if (words[i] & other.words[i]) return true;
+	}
+	return false;
+}
+
+inline int ComponentMask::countBelow(int typeId) const
+{
+	const int word = typeId / 64;
+	int count = static_cast<int>(std::bitset<64>(words[word] & ((uint64_t{ 1 } << (typeId % 64)) - 1)).count());
+	for (int i = 0; i < word; i++)
+	{
+		count += static_cast<int>(std::bitset<64>(words[i]).count());
+	}
+	return count;
+}
@@ -0,0 +1,104 @@
+#include "ecsBenchmarks.h"
+#include "entity.h"
+#include "entityContainer.h"
+#include <ServiceLocator/locator.h>
+#include <Utils/elapsedTime.h>
+
+#include <chrono>
+#include <utility>
+
+
+namespace
+{
+	template<int N>
+	class BenchmarkComponent : public Component
+	{
+	public:
+		int value{ N };
+
+	protected:
+		void registerComponent() override {}
+		void unregisterComponent() override {}
+	};
+
+	//  a class that none of the benchmark entities has
+	using MissingComponent = BenchmarkComponent<-1>;
+
+	template<size_t... Indices>
+	void AddComponents(Entity& entity, std::index_sequence<Indices...>)
+	{
+		const int unused[] = { (entity.addComponentByClass<BenchmarkComponent<static_cast<int>(Indices)>>(), 0)... };
+		(void)unused;
+	}
+
+	//  the lookup that the entities did before the type ids
+	template<class T>
+	T* FindByDynamicCast(const std::vector<Component*>& components)
+	{
+		for (Component* component : components)
+		{
+			T* component_as_t = dynamic_cast<T*>(component);
+			if (component_as_t) return component_as_t;
+		}
+		return nullptr;
+	}
+
+	template<int ComponentsCount>
+	void RunLookups(int lookupsCount)
+	{
+		using LastComponent = BenchmarkComponent<ComponentsCount - 1>;
+
+		EntityContainer container;
+		Entity& entity = *container.createEntity();
+		AddComponents(entity, std::make_index_sequence<ComponentsCount>{});
+		const std::vector<Component*> components = entity.getAllComponents();
+
+		//  the sums stop the compiler from removing the lookups
+		long long cast_sum = 0, id_sum = 0;
+		int cast_misses = 0, id_misses = 0;
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < lookupsCount; i++)
+		{
+			cast_sum += FindByDynamicCast<LastComponent>(components)->value;
+		}
+		const double cast_time = GetElapsedMilliseconds(start);
+
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < lookupsCount; i++)
+		{
+			id_sum += entity.getComponent<LastComponent>()->value;
+		}
+		const double id_time = GetElapsedMilliseconds(start);
+
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < lookupsCount; i++)
+		{
+			if (!FindByDynamicCast<MissingComponent>(components)) cast_misses++;
+		}
+		const double cast_miss_time = GetElapsedMilliseconds(start);
+
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < lookupsCount; i++)
+		{
+			if (!entity.hasComponent<MissingComponent>()) id_misses++;
+		}
+		const double id_miss_time = GetElapsedMilliseconds(start);
+
+		Log& log = Locator::getLog();
+		log.LogMessage_Category("ECS Benchmark: Entity with " + std::to_string(ComponentsCount) + " components x" + std::to_string(lookupsCount) +
+			" | found: dynamic cast " + std::to_string(cast_time) + " ms, type id " + std::to_string(id_time) + " ms (x" + std::to_string(id_time > 0.0 ? cast_time / id_time : 0.0) +
+			") | missing: dynamic cast " + std::to_string(cast_miss_time) + " ms, type id " + std::to_string(id_miss_time) + " ms (x" + std::to_string(id_miss_time > 0.0 ? cast_miss_time / id_miss_time : 0.0) + ")", LogCategory::Info);
+
+		if (cast_sum != id_sum || cast_misses != id_misses)
+			log.LogMessage_Category("ECS Benchmark: Lookups results differ between the dynamic cast and the type id.", LogCategory::Warning);
+	}
+}
+
+
+void EcsBenchmarks::ComponentLookupBenchmark(int lookupsCount)
+{
+	RunLookups<1>(lookupsCount);
+	RunLookups<8>(lookupsCount);
+	RunLookups<32>(lookupsCount);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+
+/** ECS Benchmarks
+* Debug functions that measure the entities and components on generated entities and log the timings.
+* They use their own entities, so they can run at any time (the engine runs them from the debug view).
+*/
+class EcsBenchmarks
+{
+public:
+	/**
+	* Compare the component lookups by type id to the dynamic cast scan of the components, on entities with 1, 8 and 32 components.
+	* Measures the lookups of the last added component (the worst case of the scan) and of a component the entity doesn't have.
+	* @param	lookupsCount	Number of lookups of each type.
+	*/
+	static void ComponentLookupBenchmark(int lookupsCount = 1000000);
+};
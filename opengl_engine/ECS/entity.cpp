@@ -1,19 +1,23 @@
 #include "entity.h"
+#include "entityContainer.h"
+#include "entityCommandBuffer.h"
 #include <algorithm>
 
-Entity::Entity() : Transform()
+Entity::Entity(EntityContainer& container_) : Transform(), container(container_), componentsStorage(container_.componentsStorage)
 {
+	storageId = componentsStorage.createEntity();
 }
 
 Entity::~Entity()
 {
 	clearComponents();
+	componentsStorage.destroyEntity(storageId);
 }
 
 void Entity::destroyEntity()
 {
 	//  at the end of the frame, the scene this entity is on will delete this entity
-	entityDestoyed = true;
+	container.getCommandBuffer().destroyEntity(this);
 }
 
 void Entity::removeComponent(Component* component)
@@ -22,8 +26,9 @@ void Entity::removeComponent(Component* component)
 	if (iter != components.end())
 	{
 		(*iter)->unregisterComponent();
-		delete *iter;
 		components.erase(iter);
+		unindexComponent(component);
+		delete component;
 	}
 }
 
@@ -35,4 +40,38 @@ void Entity::clearComponents()
 		delete component;
 	}
 	components.clear();
+
+	componentsMask.reset();
+	indexedComponents.clear();
+}
+
+void Entity::indexComponent(Component* component)
+{
+	const int type_id = component->getComponentTypeId();
+	if (type_id < 0 || type_id >= MAX_COMPONENT_TYPES || componentsMask.test(type_id)) return;
+
+	indexedComponents.insert(indexedComponents.begin() + ComponentTypeId::GetRank(componentsMask, type_id), component);
+	componentsMask.set(type_id);
+}
+
+void Entity::unindexComponent(Component* component)
+{
+	const int type_id = component->getComponentTypeId();
+	if (!ComponentTypeId::IsInMask(componentsMask, type_id)) return;
+
+	const int rank = ComponentTypeId::GetRank(componentsMask, type_id);
+	if (indexedComponents[rank] != component) return;
+
+	indexedComponents.erase(indexedComponents.begin() + rank);
+	componentsMask.reset(type_id);
+
+	//  another component of the same class takes its place
+	for (Component* other_component : components)
+	{
+		if (other_component->getComponentTypeId() == type_id)
+		{
+			indexComponent(other_component);
+			break;
+		}
+	}
 }
\ No newline at end of file
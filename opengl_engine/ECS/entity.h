@@ -1,23 +1,34 @@
 #pragma once
 #include <Objects/transform.h>
 #include "component.h"
+#include "archetypeStorage.h"
+#include "componentTypeId.h"
 #include <ServiceLocator/locator.h>
 #include <vector>
 
+class EntityContainer;
+
+/** Entity
+* Façade over an entity of an archetype storage, that also owns polymorphic components.
+* Polymorphic components (derived from Component) are allocated one by one and indexed by their type id,
+* data components (any other movable type) are stored in the contiguous columns of the storage and can be iterated with EntityContainer::view.
+*/
 class Entity : public Transform
 {
 public:
-	Entity();
+	Entity(EntityContainer& container);
 	~Entity();
 
 	Entity(const Entity&) = delete;
 	Entity& operator=(const Entity&) = delete;
 
 	/**
-	* Destroy an entity and all of its components.
+	* Destroy an entity and all of its components at the sync point of the frame (recorded in the command buffer of the calling thread).
 	*/
 	void destroyEntity();
 
+	inline bool isEntityDestroyed() const { return entityDestoyed; }
+
 	/**
 	* Create a component attached to this entity.
 	* @return	The created component.
@@ -27,21 +38,47 @@ public:
 		addComponentByClass()
 	{
 		components.emplace_back(new T());
+		components.back()->componentTypeId = ComponentTypeId::Get<T>();
 		components.back()->setOwner(this);
+		indexComponent(components.back());
 		components.back()->registerComponent();
 
 		return static_cast<T*>(components.back());
 	}
 
+	/**
+	* Get the component of this exact class (not a derived class) in this entity's components, in constant time.
+	* @return	The first component of this class, nullptr if this entity doesn't have one.
+	*/
+	template<class T>
+	std::enable_if_t<std::is_base_of<Component, T>::value, T*>
+		getComponent() const
+	{
+		const int type_id = ComponentTypeId::Get<T>();
+		if (!ComponentTypeId::IsInMask(componentsMask, type_id)) return nullptr;
+
+		return static_cast<T*>(indexedComponents[ComponentTypeId::GetRank(componentsMask, type_id)]);
+	}
+
+	template<class T>
+	std::enable_if_t<std::is_base_of<Component, T>::value, bool>
+		hasComponent() const
+	{
+		return ComponentTypeId::IsInMask(componentsMask, ComponentTypeId::Get<T>());
+	}
+
 
 	/**
 	* Get a component of given class in this entity's components.
+	* Components of this exact class are found in constant time, the components of derived classes need a dynamic cast on every component.
 	* @return	The first component of given class found, nullptr if no component of given class has been found.
 	*/
 	template<class T>
 	std::enable_if_t<std::is_base_of<Component, T>::value, T*>
 		getComponentByClass()
 	{
+		if (T* component = getComponent<T>()) return component;
+
 		for (Component* component : components)
 		{
 			T* component_as_t = dynamic_cast<T*>(component);
@@ -92,11 +129,65 @@ public:
 	*/
 	void removeComponent(Component* component);
 
+
+	/**
+	* Add a data component to this entity, stored in the archetype columns of the entity container.
+	* The reference is only valid until the next component added or removed in the container.
+	* @param	args	Arguments given to the component constructor.
+	* @return	The added component (the existing one if this entity already has a component of this type).
+	*/
+	template<class T, typename... Args>
+	std::enable_if_t<!std::is_base_of<Component, T>::value, T&>
+		addComponent(Args&&... args)
+	{
+		return componentsStorage.addComponent<T>(storageId, std::forward<Args>(args)...);
+	}
+
+	/**
+	* Get a data component of this entity.
+	* @return	The component of given type, nullptr if this entity doesn't have one.
+	*/
+	template<class T>
+	std::enable_if_t<!std::is_base_of<Component, T>::value, T*>
+		getComponent()
+	{
+		return componentsStorage.getComponent<T>(storageId);
+	}
+
+	template<class T>
+	std::enable_if_t<!std::is_base_of<Component, T>::value, bool>
+		hasComponent() const
+	{
+		return componentsStorage.hasComponent<T>(storageId);
+	}
+
+	template<class T>
+	std::enable_if_t<!std::is_base_of<Component, T>::value>
+		removeComponent()
+	{
+		componentsStorage.removeComponent<T>(storageId);
+	}
+
+	inline EntityId getStorageId() const { return storageId; }
+
 private:
+	friend class EntityContainer;
+
 	std::vector<Component*> components;
 
+	//  first component of each class, sorted by type id (the index of a class is the rank of its bit in the mask)
+	ComponentMask componentsMask;
+	std::vector<Component*> indexedComponents;
+
+	EntityContainer& container;
+	ArchetypeStorage& componentsStorage;
+	EntityId storageId{ INVALID_ENTITY };
+
 	bool entityDestoyed{ false };
 
 
 	void clearComponents();
+
+	void indexComponent(Component* component);
+	void unindexComponent(Component* component);
 };
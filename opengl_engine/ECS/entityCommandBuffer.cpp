@@ -0,0 +1,96 @@
+#include "entityCommandBuffer.h"
+
+
+EntityCommandBuffer::~EntityCommandBuffer()
+{
+	clear();
+}
+
+void EntityCommandBuffer::destroyEntity(Entity* entity)
+{
+	addCommand(&ExecuteDestroyEntity, nullptr, entity, nullptr);
+}
+
+void EntityCommandBuffer::removeComponent(Entity* entity, Component* component)
+{
+	addCommand(&ExecuteRemoveComponent, nullptr, entity, component);
+}
+
+
+void EntityCommandBuffer::playback(EntityContainer& container)
+{
+	//  by index and by copy, a command can record other commands in this buffer
+	for (int i = 0; i < commands.size(); i++)
+	{
+		const Command command = commands[i];
+
+		//  the commands recorded after the destruction of their entity are ignored
+		if (command.entity && command.entity->isEntityDestroyed()) continue;
+
+		command.execute(container, command.entity, command.payload);
+	}
+
+	clear();
+}
+
+void EntityCommandBuffer::clear()
+{
+	for (auto& command : commands)
+	{
+		if (command.destroyPayload) command.destroyPayload(command.payload);
+	}
+	commands.clear();
+
+	//  the blocks are kept for the next commands
+	currentBlock = 0;
+	currentBlockOffset = 0;
+}
+
+
+void* EntityCommandBuffer::allocateBytes(size_t size, size_t alignment)
+{
+	while (currentBlock < blocks.size())
+	{
+		const size_t offset = (currentBlockOffset + alignment - 1) / alignment * alignment;
+		if (offset + size <= blocks[currentBlock].size)
+		{
+			currentBlockOffset = offset + size;
+			return blocks[currentBlock].data.get() + offset;
+		}
+
+		currentBlock++;
+		currentBlockOffset = 0;
+	}
+
+	//  no space left in the blocks, the arguments bigger than a block get their own block
+	Block block;
+	block.size = size > BLOCK_BYTES ? size : BLOCK_BYTES;
+	block.data.reset(new unsigned char[block.size]);
+	blocks.push_back(std::move(block));
+
+	currentBlock = static_cast<int>(blocks.size()) - 1;
+	currentBlockOffset = size;
+	return blocks.back().data.get();
+}
+
+void EntityCommandBuffer::addCommand(void(*execute)(EntityContainer&, Entity*, void*), void(*destroyPayload)(void*), Entity* entity, void* payload)
+{
+	Command command;
+	command.execute = execute;
+	command.destroyPayload = destroyPayload;
+	command.entity = entity;
+	command.payload = payload;
+	commands.push_back(command);
+}
+
+
+void EntityCommandBuffer::ExecuteDestroyEntity(EntityContainer& container, Entity* entity, void* payload)
+{
+	//  the entity is deleted with the other destroyed entities once all the commands are applied
+	container.markEntityDestroyed(entity);
+}
+
+void EntityCommandBuffer::ExecuteRemoveComponent(EntityContainer& container, Entity* entity, void* payload)
+{
+	entity->removeComponent(static_cast<Component*>(payload));
+}
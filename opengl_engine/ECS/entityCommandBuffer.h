@@ -0,0 +1,178 @@
+#pragma once
+#include "entity.h"
+#include "entityContainer.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/** Entity Command Buffer
+* Structural changes of an entity container (create, destroy, add or remove component) recorded to be applied later,
+* at the sync point of the frame, so they never invalidate an iteration on the entities, their components or the scene objects.
+* The commands and their arguments are stored in blocks that are kept between frames, recording doesn't allocate once the blocks are warm.
+* A buffer must only be used by one thread, use EntityContainer::getCommandBuffer to get the buffer of the calling thread.
+*/
+class EntityCommandBuffer
+{
+public:
+	EntityCommandBuffer() {}
+	~EntityCommandBuffer();
+
+	EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+	EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+	/**
+	* Create an entity at the sync point.
+	* @param	init	Called with the created entity: init(Entity& entity)
+	*/
+	template<typename Func>
+	void createEntity(Func init);
+
+	/**
+	* Destroy an entity and all of its components at the sync point.
+	* The commands recorded after this one on the same entity are ignored.
+	*/
+	void destroyEntity(Entity* entity);
+
+	/**
+	* Add a data component to an entity at the sync point.
+	* @param	entity	Entity to add the component to.
+	* @param	args	Arguments given to the component constructor, copied in the buffer.
+	*/
+	template<class T, typename... Args>
+	std::enable_if_t<!std::is_base_of<Component, T>::value>
+		addComponent(Entity* entity, Args&&... args);
+
+	/**
+	* Add a polymorphic component to an entity at the sync point.
+	* @param	entity	Entity to add the component to.
+	* @param	init	Called with the created component: init(T& component)
+	*/
+	template<class T, typename Func>
+	std::enable_if_t<std::is_base_of<Component, T>::value>
+		addComponentByClass(Entity* entity, Func init);
+
+	template<class T>
+	std::enable_if_t<!std::is_base_of<Component, T>::value>
+		removeComponent(Entity* entity);
+
+	void removeComponent(Entity* entity, Component* component);
+
+	/**
+	* Call a function at the sync point, for the structural changes that are not made on entities (like unregistering a scene object).
+	* @param	func	Function called with no argument, copied in the buffer.
+	*/
+	template<typename Func>
+	void call(Func func);
+
+	inline int getCommandsCount() const { return static_cast<int>(commands.size()); }
+	inline bool isEmpty() const { return commands.empty(); }
+
+	/**
+	* Apply all the commands in the order they were recorded, then clear the buffer.
+	* The commands recorded while playing back are applied too.
+	* @param	container	Container the entities are created in.
+	*/
+	void playback(EntityContainer& container);
+
+	/**
+	* Remove all the commands without applying them.
+	*/
+	void clear();
+
+private:
+	struct Command
+	{
+		void(*execute)(EntityContainer& container, Entity* entity, void* payload) { nullptr };
+		void(*destroyPayload)(void* payload) { nullptr };
+		Entity* entity{ nullptr };
+		void* payload{ nullptr };
+	};
+
+	struct Block
+	{
+		std::unique_ptr<unsigned char[]> data;
+		size_t size{ 0 };
+	};
+
+	//  construct the arguments of a command in the blocks, they never move until the buffer is cleared
+	template<typename P, typename... Args>
+	P* allocatePayload(Args&&... args);
+	void* allocateBytes(size_t size, size_t alignment);
+
+	void addCommand(void(*execute)(EntityContainer&, Entity*, void*), void(*destroyPayload)(void*), Entity* entity, void* payload);
+
+	template<typename P>
+	static void DestroyPayload(void* payload) { static_cast<P*>(payload)->~P(); }
+
+	std::vector<Command> commands;
+	std::vector<Block> blocks;
+	int currentBlock{ 0 };
+	size_t currentBlockOffset{ 0 };
+
+	static const size_t BLOCK_BYTES{ 4096 };
+
+	static void ExecuteDestroyEntity(EntityContainer& container, Entity* entity, void* payload);
+	static void ExecuteRemoveComponent(EntityContainer& container, Entity* entity, void* payload);
+};
+
+
+template<typename Func>
+void EntityCommandBuffer::createEntity(Func init)
+{
+	addCommand([](EntityContainer& container, Entity*, void* payload)
+	{
+		(*static_cast<Func*>(payload))(*container.createEntity());
+	}, &DestroyPayload<Func>, nullptr, allocatePayload<Func>(std::move(init)));
+}
+
+template<class T, typename... Args>
+std::enable_if_t<!std::is_base_of<Component, T>::value>
+	EntityCommandBuffer::addComponent(Entity* entity, Args&&... args)
+{
+	addCommand([](EntityContainer&, Entity* target, void* payload)
+	{
+		target->addComponent<T>(std::move(*static_cast<T*>(payload)));
+	}, &DestroyPayload<T>, entity, allocatePayload<T>(std::forward<Args>(args)...));
+}
+
+template<class T, typename Func>
+std::enable_if_t<std::is_base_of<Component, T>::value>
+	EntityCommandBuffer::addComponentByClass(Entity* entity, Func init)
+{
+	addCommand([](EntityContainer&, Entity* target, void* payload)
+	{
+		(*static_cast<Func*>(payload))(*target->addComponentByClass<T>());
+	}, &DestroyPayload<Func>, entity, allocatePayload<Func>(std::move(init)));
+}
+
+template<class T>
+std::enable_if_t<!std::is_base_of<Component, T>::value>
+	EntityCommandBuffer::removeComponent(Entity* entity)
+{
+	addCommand([](EntityContainer&, Entity* target, void*)
+	{
+		target->removeComponent<T>();
+	}, nullptr, entity, nullptr);
+}
+
+template<typename Func>
+void EntityCommandBuffer::call(Func func)
+{
+	addCommand([](EntityContainer&, Entity*, void* payload)
+	{
+		(*static_cast<Func*>(payload))();
+	}, &DestroyPayload<Func>, nullptr, allocatePayload<Func>(std::move(func)));
+}
+
+
+template<typename P, typename... Args>
+P* EntityCommandBuffer::allocatePayload(Args&&... args)
+{
+	static_assert(alignof(P) <= alignof(std::max_align_t), "Entity Command Buffer: over-aligned command arguments are not supported.");
+
+	return new (allocateBytes(sizeof(P), alignof(P))) P(std::forward<Args>(args)...);
+}
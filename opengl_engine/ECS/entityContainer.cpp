@@ -1,15 +1,118 @@
 #include "entityContainer.h"
 #include "entity.h"
+#include "entityCommandBuffer.h"
+
+#include <atomic>
+
+
+namespace
+{
+	std::atomic<uint64_t> containersCount{ 0 };
+
+	//  last buffers used by the thread, so getting the buffer of a thread doesn't lock the container mutex every time
+	struct CachedCommandBuffer
+	{
+		uint64_t containerSerial{ 0 };
+		EntityCommandBuffer* buffer{ nullptr };
+	};
+	const int CACHED_BUFFERS_COUNT{ 4 };
+	thread_local CachedCommandBuffer cachedBuffers[CACHED_BUFFERS_COUNT];
+	thread_local int nextCachedBuffer{ 0 };
+}
+
+
+EntityContainer::EntityContainer() : containerSerial(++containersCount)
+{
+}
+
+EntityContainer::~EntityContainer()
+{
+	discardCommands();
+	clearEntities();
+}
 
 Entity* EntityContainer::createEntity()
 {
-	entities.push_back(new Entity());
+	entities.push_back(new Entity(*this));
 	return entities.back();
 }
 
+EntityCommandBuffer& EntityContainer::getCommandBuffer()
+{
+	for (int i = 0; i < CACHED_BUFFERS_COUNT; i++)
+	{
+		if (cachedBuffers[i].containerSerial == containerSerial) return *cachedBuffers[i].buffer;
+	}
+
+	std::lock_guard<std::mutex> lock(commandBuffersMutex);
+
+	const std::thread::id thread_id = std::this_thread::get_id();
+	EntityCommandBuffer* buffer = nullptr;
+	for (int i = 0; i < commandBuffersThreads.size(); i++)
+	{
+		if (commandBuffersThreads[i] == thread_id)
+		{
+			buffer = commandBuffers[i].get();
+			break;
+		}
+	}
+
+	if (!buffer)
+	{
+		commandBuffers.emplace_back(new EntityCommandBuffer());
+		commandBuffersThreads.push_back(thread_id);
+		buffer = commandBuffers.back().get();
+	}
+
+	CachedCommandBuffer& cached_buffer = cachedBuffers[nextCachedBuffer];
+	cached_buffer.containerSerial = containerSerial;
+	cached_buffer.buffer = buffer;
+	nextCachedBuffer = (nextCachedBuffer + 1) % CACHED_BUFFERS_COUNT;
+
+	return *buffer;
+}
+
 void EntityContainer::updateEntities()
 {
-	//  delete destroyed entities
+	//  the commands can record other commands (in the buffer of this thread), play back until every buffer is empty
+	bool commands_played = true;
+	while (commands_played)
+	{
+		commands_played = false;
+		for (auto& buffer : commandBuffers)
+		{
+			if (buffer->isEmpty()) continue;
+
+			buffer->playback(*this);
+			commands_played = true;
+		}
+	}
+
+	if (destroyedEntitiesCount == 0) return;
+
+	//  delete destroyed entities, in a single pass that keeps the other entities packed
+	int kept_count = 0;
+	for (int i = 0; i < entities.size(); i++)
+	{
+		if (entities[i]->entityDestoyed)
+		{
+			delete entities[i];
+			continue;
+		}
+
+		entities[kept_count] = entities[i];
+		kept_count++;
+	}
+	entities.resize(kept_count);
+	destroyedEntitiesCount = 0;
+}
+
+void EntityContainer::discardCommands()
+{
+	for (auto& buffer : commandBuffers)
+	{
+		buffer->clear();
+	}
 }
 
 void EntityContainer::clearEntities()
@@ -19,4 +122,13 @@ void EntityContainer::clearEntities()
 		delete entity;
 	}
 	entities.clear();
+	destroyedEntitiesCount = 0;
+}
+
+void EntityContainer::markEntityDestroyed(Entity* entity)
+{
+	if (entity->entityDestoyed) return;
+
+	entity->entityDestoyed = true;
+	destroyedEntitiesCount++;
 }
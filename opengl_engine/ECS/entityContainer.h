@@ -1,20 +1,65 @@
 #pragma once
+#include "archetypeStorage.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 class Entity;
+class EntityCommandBuffer;
 
 class EntityContainer
 {
 public:
-	virtual ~EntityContainer() {}
+	EntityContainer();
+	virtual ~EntityContainer();
 
 	Entity* createEntity();
-	
+
+	/**
+	* Get a view on the entities of this container that have all the given data components.
+	* Components must not be added or removed while iterating the view, record them in a command buffer instead.
+	*/
+	template<typename... Ts>
+	ArchetypeView<Ts...> view() { return componentsStorage.view<Ts...>(); }
+
+	/**
+	* Get the command buffer of the calling thread for this container, each thread records in its own buffer.
+	* The commands are applied at the sync point of the frame (see updateEntities).
+	* @return	The command buffer of the calling thread.
+	*/
+	EntityCommandBuffer& getCommandBuffer();
+
+	inline int getEntitiesCount() const { return static_cast<int>(entities.size()); }
+
+protected:
+	/**
+	* Sync point: apply the commands of every thread buffer, then delete the destroyed entities all at once.
+	* Must be called when no other thread records commands for this container.
+	*/
+	void updateEntities();
+
+	/**
+	* Remove the recorded commands without applying them (when the objects they use are about to be deleted).
+	*/
+	void discardCommands();
+
+	void clearEntities();
+
 private:
+	ArchetypeStorage componentsStorage;
 	std::vector<Entity*> entities;
+	int destroyedEntitiesCount{ 0 };
+
+	//  one buffer per thread that recorded commands, in the order the threads first recorded
+	std::vector<std::unique_ptr<EntityCommandBuffer>> commandBuffers;
+	std::vector<std::thread::id> commandBuffersThreads;
+	std::mutex commandBuffersMutex;
+	uint64_t containerSerial{ 0 }; //  unique for every container, used by the per thread cache of the buffers
 
+	friend class Entity;
+	friend class EntityCommandBuffer;
 	friend class Engine;
-	void updateEntities();
-	void clearEntities();
+	void markEntityDestroyed(Entity* entity);
 };
-
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <tuple>
+#include <utility>
+
+
+/** Delegate
+* Callable bound to a member function and its instance (or to a free function), stored inline without any allocation.
+* The bound function can take fewer parameters than the delegate, it receives the first ones.
+* A delegate is trivially copyable, copying it is copying a few pointers.
+*/
+template<typename ...Parameters>
+class Delegate
+{
+public:
+	Delegate() = default;
+
+	template<class T, typename ...MethodParameters>
+	static Delegate FromMethod(T* instance, void(T::*method)(MethodParameters...))
+	{
+		using Data = MethodData<T, void(T::*)(MethodParameters...)>;
+		static_assert(sizeof...(MethodParameters) <= sizeof...(Parameters), "Delegate: the method takes more parameters than the delegate gives.");
+		static_assert(sizeof(Data) <= STORAGE_BYTES, "Delegate: the member function pointer doesn't fit in the delegate storage.");
+		static_assert(alignof(Data) <= alignof(void*), "Delegate: the member function pointer is over-aligned for the delegate storage.");
+
+		Delegate delegate;
+		new (delegate.storage) Data{ instance, method };
+		delegate.stub = &CallMethod<Data, sizeof...(MethodParameters)>;
+		return delegate;
+	}
+
+	template<typename ...FunctionParameters>
+	static Delegate FromFunction(void(*function)(FunctionParameters...))
+	{
+		using Data = FunctionData<void(*)(FunctionParameters...)>;
+		static_assert(sizeof...(FunctionParameters) <= sizeof...(Parameters), "Delegate: the function takes more parameters than the delegate gives.");
+
+		Delegate delegate;
+		new (delegate.storage) Data{ function };
+		delegate.stub = &CallFunction<Data, sizeof...(FunctionParameters)>;
+		return delegate;
+	}
+
+	inline void operator()(Parameters... parameters) const { stub(storage, parameters...); }
+
+	inline bool isBound() const { return stub != nullptr; }
+
+private:
+	static const size_t STORAGE_BYTES = 3 * sizeof(void*); //  an instance and the biggest member function pointers (multiple inheritance)
+
+	template<class T, class Method>
+	struct MethodData
+	{
+		T* instance;
+		Method method;
+	};
+
+	template<class Function>
+	struct FunctionData
+	{
+		Function function;
+	};
+
+	template<class Data, size_t ArgumentsCount>
+	static void CallMethod(const void* storage, Parameters... parameters)
+	{
+		//  copied before the call, the delegate can be moved by what the method does (like registering an observer to the same event)
+		const Data data = *static_cast<const Data*>(storage);
+		CallMethodWith(data, std::make_index_sequence<ArgumentsCount>{}, std::forward_as_tuple(parameters...));
+	}
+
+	template<class Data, size_t ...Indices, class Arguments>
+	static void CallMethodWith(const Data& data, std::index_sequence<Indices...>, Arguments&& arguments)
+	{
+		(data.instance->*data.method)(std::get<Indices>(arguments)...);
+	}
+
+	template<class Data, size_t ArgumentsCount>
+	static void CallFunction(const void* storage, Parameters... parameters)
+	{
+		const Data data = *static_cast<const Data*>(storage);
+		CallFunctionWith(data, std::make_index_sequence<ArgumentsCount>{}, std::forward_as_tuple(parameters...));
+	}
+
+	template<class Data, size_t ...Indices, class Arguments>
+	static void CallFunctionWith(const Data& data, std::index_sequence<Indices...>, Arguments&& arguments)
+	{
+		data.function(std::get<Indices>(arguments)...);
+	}
+
+	alignas(void*) unsigned char storage[STORAGE_BYTES];
+	void(*stub)(const void*, Parameters...){ nullptr };
+};
@@ -1,73 +1,112 @@
 #pragma once
 #include "observer.h"
-#include <unordered_map>
-#include <vector>
-#include <functional>
+#include "delegate.h"
+#include <Utils/smallVector.h>
 
 
+/** Event
+* List of observers called when the event is broadcasted, in their registration order.
+* The observers are stored in a small vector of delegates: broadcasting never allocates, only registering more observers than the inline storage does.
+* Observers can be registered and unregistered during a broadcast: the unregistered ones aren't called anymore, the registered ones are called from the next broadcast.
+*/
 template<typename ...Parameters>
 class Event
 {
 public:
-	using Function = std::function<void(Parameters...)>;
+	using EventDelegate = Delegate<Parameters...>;
 
-	void registerObserver(Observer* observer, Function broadcastFunction)
+	//  register a member function of the observer, it can take fewer parameters than the event gives
+	template<class T, class MethodClass, typename ...MethodParameters>
+	void registerObserver(T* observer, void(MethodClass::*method)(MethodParameters...))
 	{
-		observers[observer] = broadcastFunction;
+		registerObserver(observer, EventDelegate::FromMethod(static_cast<MethodClass*>(observer), method));
 	}
 
-	void unregisterObserver(Observer* observer)
+	//  an observer is registered once, registering it again replaces its delegate
+	void registerObserver(Observer* observer, EventDelegate delegate)
 	{
-		if (inBroadcast)
+		for (auto& subscriber : subscribers)
 		{
-			pendingObservers.push_back(observer);
+			if (subscriber.observer != observer) continue;
+
+			subscriber.delegate = delegate;
+			return;
 		}
-		else
+
+		Subscriber subscriber;
+		subscriber.observer = observer;
+		subscriber.delegate = delegate;
+		subscribers.push_back(subscriber);
+	}
+
+	void unregisterObserver(Observer* observer)
+	{
+		for (int i = 0; i < subscribers.size(); i++)
 		{
-			auto iter = observers.find(observer);
-			if (iter == observers.end()) return;
+			if (subscribers[i].observer != observer) continue;
 
-			observers.erase(iter);
+			if (broadcastDepth > 0)
+			{
+				//  the broadcast iterates by index, the subscriber is erased once it ends
+				subscribers[i].observer = nullptr;
+				hasRemovedSubscribers = true;
+			}
+			else
+			{
+				subscribers.eraseAt(i);
+			}
+			return;
 		}
 	}
 
 	void clearAllObservers()
 	{
-		if (inBroadcast)
+		if (broadcastDepth > 0)
 		{
-			for (auto observer : observers)
+			for (auto& subscriber : subscribers)
 			{
-				pendingObservers.push_back(observer.first);
+				subscriber.observer = nullptr;
 			}
+			hasRemovedSubscribers = true;
 		}
 		else
 		{
-			observers.clear();
+			subscribers.clear();
 		}
 	}
 
+	inline int getObserversCount() const { return subscribers.size(); }
+
 
 	void broadcast(Parameters ...parameters)
 	{
-		inBroadcast = true;
-		for (auto observer : observers)
-		{
-			observer.second(parameters...);
-		}
-		inBroadcast = false;
+		broadcastDepth++;
 
-		if (pendingObservers.empty()) return;
-		for (auto pending_observer : pendingObservers)
+		//  the observers registered by this broadcast wait for the next one
+		const int subscribers_count = subscribers.size();
+		for (int i = 0; i < subscribers_count; i++)
 		{
-			unregisterObserver(pending_observer);
+			const Subscriber& subscriber = subscribers[i];
+			if (subscriber.observer) subscriber.delegate(parameters...);
 		}
-		pendingObservers.clear();
+
+		broadcastDepth--;
+		if (broadcastDepth > 0 || !hasRemovedSubscribers) return;
+
+		subscribers.removeIf([](const Subscriber& subscriber) { return subscriber.observer == nullptr; });
+		hasRemovedSubscribers = false;
 	}
 
 
 private:
-	std::unordered_map<Observer*, Function> observers;
-    std::vector<Observer*> pendingObservers;
+	struct Subscriber
+	{
+		Observer* observer{ nullptr }; //  null once unregistered during a broadcast
+		EventDelegate delegate;
+	};
+
+	SmallVector<Subscriber, 1> subscribers; //  most events have a single observer
 
-	bool inBroadcast{ false };
-};
\ No newline at end of file
+	int broadcastDepth{ 0 };
+	bool hasRemovedSubscribers{ false };
+};
@@ -0,0 +1,111 @@
+#include "eventBenchmarks.h"
+#include "event.h"
+#include <Maths/vector3.h>
+#include <Utils/allocationCounter.h>
+#include <ServiceLocator/locator.h>
+#include <Utils/elapsedTime.h>
+
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+
+namespace
+{
+	//  the events before the delegates: a map of std::function made with std::bind, copied for each call of the broadcast
+	template<typename ...Parameters>
+	class StdFunctionEvent
+	{
+	public:
+		void registerObserver(Observer* observer, std::function<void(Parameters...)> broadcastFunction)
+		{
+			observers[observer] = broadcastFunction;
+		}
+
+		void broadcast(Parameters ...parameters)
+		{
+			for (auto observer : observers)
+			{
+				observer.second(parameters...);
+			}
+		}
+
+	private:
+		std::unordered_map<Observer*, std::function<void(Parameters...)>> observers;
+	};
+
+	class BenchmarkObserver : public Observer
+	{
+	public:
+		void onEvent(int value, const Vector3& location)
+		{
+			sum += value + static_cast<int>(location.x);
+		}
+
+		long long sum{ 0 };
+	};
+
+	void RunBroadcasts(int observersCount, int broadcastsCount)
+	{
+		std::vector<BenchmarkObserver> function_observers(observersCount);
+		std::vector<BenchmarkObserver> delegate_observers(observersCount);
+
+		StdFunctionEvent<int, const Vector3&> function_event;
+		Event<int, const Vector3&> delegate_event;
+		for (int i = 0; i < observersCount; i++)
+		{
+			BenchmarkObserver* observer = &function_observers[i];
+			function_event.registerObserver(observer, std::bind(&BenchmarkObserver::onEvent, observer, std::placeholders::_1, std::placeholders::_2));
+			delegate_event.registerObserver(&delegate_observers[i], &BenchmarkObserver::onEvent);
+		}
+
+		const Vector3 location{ 1.0f, 2.0f, 3.0f };
+
+		uint64_t allocations = AllocationCounter::GetThreadAllocationsCount();
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < broadcastsCount; i++)
+		{
+			function_event.broadcast(i, location);
+		}
+		const double function_time = GetElapsedMilliseconds(start);
+		const uint64_t function_allocations = AllocationCounter::GetThreadAllocationsCount() - allocations;
+
+		allocations = AllocationCounter::GetThreadAllocationsCount();
+		start = std::chrono::steady_clock::now();
+		for (int i = 0; i < broadcastsCount; i++)
+		{
+			delegate_event.broadcast(i, location);
+		}
+		const double delegate_time = GetElapsedMilliseconds(start);
+		const uint64_t delegate_allocations = AllocationCounter::GetThreadAllocationsCount() - allocations;
+
+		//  the sums stop the compiler from removing the calls
+		long long function_sum = 0, delegate_sum = 0;
+		for (int i = 0; i < observersCount; i++)
+		{
+			function_sum += function_observers[i].sum;
+			delegate_sum += delegate_observers[i].sum;
+		}
+
+		Log& log = Locator::getLog();
+		log.LogMessage_Category("Event Benchmark: " + std::to_string(observersCount) + " observers x" + std::to_string(broadcastsCount) +
+			" broadcasts | std::function map: " + std::to_string(function_time) + " ms, " + std::to_string(function_allocations) + " allocations | delegates: " +
+			std::to_string(delegate_time) + " ms, " + std::to_string(delegate_allocations) + " allocations (x" + std::to_string(delegate_time > 0.0 ? function_time / delegate_time : 0.0) + ")", LogCategory::Info);
+
+		if (!AllocationCounter::IsEnabled())
+			log.LogMessage_Category("Event Benchmark: The allocations are not counted, the engine wasn't compiled with ENGINE_COUNT_ALLOCATIONS.", LogCategory::Warning);
+		else if (delegate_allocations > 0)
+			log.LogMessage_Category("Event Benchmark: The delegates broadcasts allocated " + std::to_string(delegate_allocations) + " times.", LogCategory::Warning);
+		if (function_sum != delegate_sum)
+			log.LogMessage_Category("Event Benchmark: Broadcasts results differ between the std::function map and the delegates.", LogCategory::Warning);
+	}
+}
+
+
+void EventBenchmarks::BroadcastBenchmark(int broadcastsCount)
+{
+	RunBroadcasts(1, broadcastsCount);
+	RunBroadcasts(4, broadcastsCount);
+	RunBroadcasts(16, broadcastsCount);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+
+/** Event Benchmarks
+* Debug functions that measure the events on generated observers and log the timings and the allocations.
+* They use their own events, so they can run at any time (the engine runs them from the debug view).
+*/
+class EventBenchmarks
+{
+public:
+	/**
+	* Compare the broadcasts of the delegates events to the std::function map that the events used before, with 1, 4 and 16 observers.
+	* Counts the heap allocations of the broadcasts, and warns if the delegates events allocated.
+	* @param	broadcastsCount		Number of broadcasts of each event.
+	*/
+	static void BroadcastBenchmark(int broadcastsCount = 1000000);
+};
@@ -0,0 +1,25 @@
+#include "frameEventBus.h"
+
+
+void FrameEventBus::dispatch(FrameEventPoint point)
+{
+	const int undeclared_count = undeclaredCount.exchange(0, std::memory_order_relaxed);
+	if (undeclared_count > 0)
+	{
+		Locator::getLog().LogMessage_Category("Frame Event Bus: " + std::to_string(undeclared_count) + " events of types that weren't declared were dropped.", LogCategory::Error);
+	}
+
+	//  by index, an observer can declare a new queue for this point (it is dispatched from the next frame)
+	std::vector<FrameEventQueueBase*>& point_queues = pointsQueues[static_cast<int>(point)];
+	const int queues_count = static_cast<int>(point_queues.size());
+	for (int i = 0; i < queues_count; i++)
+	{
+		point_queues[i]->dispatch();
+	}
+}
+
+int FrameEventBus::NextTypeIndex()
+{
+	static std::atomic<int> types_count{ 0 };
+	return types_count.fetch_add(1);
+}
@@ -0,0 +1,297 @@
+#pragma once
+#include "event.h"
+#include <ServiceLocator/locator.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/** Frame Event Point
+* Points of the engine frame where the frame events are dispatched.
+*/
+enum class FrameEventPoint : uint8_t
+{
+	FrameStart,		//  before the physics, also when the game is paused (window and inputs events)
+	AfterPhysics,	//  after the physics step, before the game and scene updates
+	AfterSystems,	//  after the systems, before the entities changes are applied (the entities of the events are still alive)
+	FrameEnd,		//  after the rendering, also when the game is paused
+
+	Count
+};
+
+enum class FrameEventCoalescing : uint8_t
+{
+	None,		//  every event pushed during the frame is dispatched
+	KeepLast	//  only the last event pushed during the frame is dispatched (like the window size)
+};
+
+
+/** Frame Event Queue Base
+* Untyped part of a frame event queue, for the bus to dispatch all the queues of a point.
+*/
+class FrameEventQueueBase
+{
+public:
+	FrameEventQueueBase(const std::string& name_, FrameEventPoint point_) : name(name_), point(point_) {}
+	virtual ~FrameEventQueueBase() {}
+
+	virtual void dispatch() = 0;
+
+	inline const std::string& getName() const { return name; }
+	inline FrameEventPoint getPoint() const { return point; }
+
+	//  events lost because the ring was full when they were pushed, since the last dispatch
+	inline int getDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+
+protected:
+	std::string name;
+	FrameEventPoint point;
+	std::atomic<int> droppedCount{ 0 };
+};
+
+
+/** Frame Event Queue
+* Preallocated ring buffer of events of one type. Any thread can push without lock (bounded multi-producer queue, a sequence number per cell),
+* the main thread drains the whole ring when the bus dispatches the queue's point and broadcasts the events to the observers of the queue.
+* Pushing and dispatching never allocate, a push on a full ring drops the event (it is counted and logged at the dispatch).
+*/
+template<typename T>
+class FrameEventQueue : public FrameEventQueueBase
+{
+public:
+	FrameEventQueue(const std::string& name_, FrameEventPoint point_, FrameEventCoalescing coalescing_, int capacity);
+	FrameEventQueue(const FrameEventQueue&) = delete;
+	FrameEventQueue& operator=(const FrameEventQueue&) = delete;
+
+	/**
+	* Push an event, can be called from any thread.
+	* @param	event	Event to copy in the ring.
+	* @return			False if the ring is full, the event is dropped.
+	*/
+	bool push(const T& event);
+
+	/**
+	* Pop all the events and broadcast them, on the main thread only. The events pushed by the observers are dispatched the next time.
+	*/
+	void dispatch() override;
+
+	inline int getCapacity() const { return static_cast<int>(mask + 1); }
+	inline FrameEventCoalescing getCoalescing() const { return coalescing; }
+
+	//  observers of the events of this queue, called during the dispatch
+	Event<const T&> onEvent;
+
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence{ 0 };
+		T event;
+	};
+
+	bool pop(T& outEvent);
+
+	std::unique_ptr<Cell[]> cells;
+	size_t mask{ 0 };
+	FrameEventCoalescing coalescing;
+
+	std::atomic<size_t> pushPosition{ 0 }; //  shared by the producers
+	std::atomic<size_t> popPosition{ 0 }; //  only moved by the main thread
+
+	std::vector<T> batch; //  events of the current dispatch, reserved for the whole ring
+};
+
+
+/** Frame Event Bus
+* Typed frame event queues, found by the type of their events. The gameplay pushes events from any thread instead of calling the observers
+* where they happen, and the engine dispatches each queue at the point of the frame it was declared for, in the order of the declarations.
+* The queues are declared on the main thread before anything pushes in them (when the engine or the game loads).
+*/
+class FrameEventBus
+{
+public:
+	static const int MAX_EVENT_TYPES{ 64 };
+
+	FrameEventBus() = default;
+	FrameEventBus(const FrameEventBus&) = delete;
+	FrameEventBus& operator=(const FrameEventBus&) = delete;
+
+	/**
+	* Declare the queue of an event type, declaring it again returns the existing queue.
+	* @param	name			Name of the event, for the logs.
+	* @param	point			Point of the frame where the events are dispatched.
+	* @param	coalescing		Events dispatched from all the events pushed during the frame.
+	* @param	capacity		Size of the ring, rounded up to a power of two.
+	* @return					The queue, to register observers.
+	*/
+	template<typename T>
+	FrameEventQueue<T>& declareEvent(const std::string& name, FrameEventPoint point, FrameEventCoalescing coalescing = FrameEventCoalescing::None, int capacity = 256);
+
+	//  queue of an event type, null if it wasn't declared
+	template<typename T>
+	FrameEventQueue<T>* getQueue();
+
+	/**
+	* Push an event in the queue of its type, can be called from any thread.
+	* The events of undeclared types are counted and logged by the next dispatch, on the main thread.
+	* @return	False if the queue wasn't declared or is full, the event is dropped.
+	*/
+	template<typename T>
+	bool push(const T& event);
+
+	/**
+	* Dispatch all the queues of a point of the frame, on the main thread only.
+	*/
+	void dispatch(FrameEventPoint point);
+
+private:
+	template<typename T>
+	static int GetTypeIndex()
+	{
+		static const int type_index = NextTypeIndex();
+		return type_index;
+	}
+	static int NextTypeIndex();
+
+	std::unique_ptr<FrameEventQueueBase> queues[MAX_EVENT_TYPES]; //  by type index, fixed so that the pushes never see it move
+	std::vector<FrameEventQueueBase*> pointsQueues[static_cast<int>(FrameEventPoint::Count)];
+	std::atomic<int> undeclaredCount{ 0 }; //  pushes of undeclared types since the last dispatch
+};
+
+
+
+template<typename T>
+FrameEventQueue<T>::FrameEventQueue(const std::string& name_, FrameEventPoint point_, FrameEventCoalescing coalescing_, int capacity) :
+	FrameEventQueueBase(name_, point_), coalescing(coalescing_)
+{
+	size_t cells_count = 2;
+	while (cells_count < static_cast<size_t>(capacity)) cells_count *= 2;
+
+	cells.reset(new Cell[cells_count]);
+	for (size_t i = 0; i < cells_count; i++)
+	{
+		cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	mask = cells_count - 1;
+
+	batch.reserve(cells_count);
+}
+
+template<typename T>
+bool FrameEventQueue<T>::push(const T& event)
+{
+	size_t position = pushPosition.load(std::memory_order_relaxed);
+	while (true)
+	{
+		Cell& cell = cells[position & mask];
+		const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+		if (difference == 0)
+		{
+			//  the cell is free for this position, take it if no other producer did
+			if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				cell.event = event;
+				cell.sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (difference < 0)
+		{
+			//  the cell still holds the event of the previous lap, the ring is full
+			droppedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			position = pushPosition.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template<typename T>
+bool FrameEventQueue<T>::pop(T& outEvent)
+{
+	const size_t position = popPosition.load(std::memory_order_relaxed);
+	Cell& cell = cells[position & mask];
+	if (cell.sequence.load(std::memory_order_acquire) != position + 1) return false; //  empty, or the producer didn't finish writing the event
+
+	outEvent = cell.event;
+	cell.sequence.store(position + mask + 1, std::memory_order_release);
+	popPosition.store(position + 1, std::memory_order_relaxed);
+	return true;
+}
+
+template<typename T>
+void FrameEventQueue<T>::dispatch()
+{
+	const int dropped_count = droppedCount.exchange(0, std::memory_order_relaxed);
+	if (dropped_count > 0)
+	{
+		Locator::getLog().LogMessage_Category("Frame Event Bus: " + std::to_string(dropped_count) + " '" + name + "' events were dropped, the ring of " +
+			std::to_string(getCapacity()) + " events is full.", LogCategory::Warning);
+	}
+
+	//  the ring is emptied before the broadcasts, so that the observers can push new events
+	batch.clear();
+	T event;
+	while (pop(event))
+	{
+		if (coalescing == FrameEventCoalescing::KeepLast && !batch.empty()) batch.back() = event;
+		else batch.push_back(event);
+	}
+
+	for (const T& batch_event : batch)
+	{
+		onEvent.broadcast(batch_event);
+	}
+}
+
+
+template<typename T>
+FrameEventQueue<T>& FrameEventBus::declareEvent(const std::string& name, FrameEventPoint point, FrameEventCoalescing coalescing, int capacity)
+{
+	const int type_index = GetTypeIndex<T>();
+	if (type_index >= MAX_EVENT_TYPES)
+	{
+		Locator::getLog().LogMessage_Category("Frame Event Bus: More than " + std::to_string(MAX_EVENT_TYPES) + " event types are declared, '" + name + "' can't be dispatched.", LogCategory::Error);
+
+		//  never pushed nor dispatched, only there so that the caller can register its observers
+		static FrameEventQueue<T> overflow_queue(name, point, coalescing, 2);
+		return overflow_queue;
+	}
+
+	if (!queues[type_index])
+	{
+		queues[type_index].reset(new FrameEventQueue<T>(name, point, coalescing, capacity));
+		pointsQueues[static_cast<int>(point)].push_back(queues[type_index].get());
+	}
+
+	return *static_cast<FrameEventQueue<T>*>(queues[type_index].get());
+}
+
+template<typename T>
+FrameEventQueue<T>* FrameEventBus::getQueue()
+{
+	const int type_index = GetTypeIndex<T>();
+	if (type_index >= MAX_EVENT_TYPES) return nullptr;
+
+	return static_cast<FrameEventQueue<T>*>(queues[type_index].get());
+}
+
+template<typename T>
+bool FrameEventBus::push(const T& event)
+{
+	FrameEventQueue<T>* queue = getQueue<T>();
+	if (!queue)
+	{
+		//  no log here, the pushing thread can be a worker
+		undeclaredCount.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	return queue->push(event);
+}
@@ -4,7 +4,8 @@
 Game* GameplayStatics::currentGame = nullptr;
 Scene* GameplayStatics::currentScene = nullptr;
 Vector2Int GameplayStatics::windowSize = Vector2Int::zero;
-Event<const Vector2Int> GameplayStatics::OnScrenResize;
+SystemScheduler* GameplayStatics::systemScheduler = nullptr;
+FrameEventBus GameplayStatics::FrameEvents;
 
 Game* GameplayStatics::GetGame()
 {
@@ -33,6 +34,23 @@ Vector2Int GameplayStatics::GetWindowSize()
 	return windowSize;
 }
 
+SystemScheduler* GameplayStatics::GetSystemScheduler()
+{
+	if (!systemScheduler)
+	{
+		Locator::getLog().LogMessage_Category("Gameplay Statics: There is no system scheduler.", LogCategory::Error);
+		return nullptr;
+	}
+
+	return systemScheduler;
+}
+
+FrameEventQueue<ScreenResizeEvent>& GameplayStatics::GetScreenResizeEvents()
+{
+	//  declared by the first caller, the engine or a hud component
+	return FrameEvents.declareEvent<ScreenResizeEvent>("Screen resize", FrameEventPoint::FrameStart, FrameEventCoalescing::KeepLast, 16);
+}
+
 
 void GameplayStatics::SetCurrentGame(Game* game)
 {
@@ -48,3 +66,8 @@ void GameplayStatics::SetWindowSize(const Vector2Int& size)
 {
 	windowSize = size;
 }
+
+void GameplayStatics::SetSystemScheduler(SystemScheduler* scheduler)
+{
+	systemScheduler = scheduler;
+}
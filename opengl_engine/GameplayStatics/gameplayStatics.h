@@ -1,11 +1,20 @@
 #pragma once
 #include <Core/game.h>
 #include <Core/scene.h>
+#include <Core/systemScheduler.h>
 #include <Maths/Vector2Int.h>
-#include <Events/event.h>
+#include <Events/frameEventBus.h>
 
 class Engine;
 
+
+/* Frame event pushed when the screen (window) is resized, dispatched at the start of the frame (once, with the last size). */
+struct ScreenResizeEvent
+{
+	Vector2Int windowSize;
+};
+
+
 class GameplayStatics
 {
 public:
@@ -24,15 +33,27 @@ public:
 	*/
 	static Vector2Int GetWindowSize();
 
+	/*
+	* Get the scheduler that runs the systems registered by the game and the scenes.
+	*/
+	static SystemScheduler* GetSystemScheduler();
+
+
+	/*
+	* Get the queue of the screen resize events, to register observers.
+	*/
+	static FrameEventQueue<ScreenResizeEvent>& GetScreenResizeEvents();
+
 
-	/* Event called when the screen (window) is resized. */
-	static Event<const Vector2Int> OnScrenResize;
+	/* Frame events of the engine and the game, pushed from any thread and dispatched at fixed points of the frame. */
+	static FrameEventBus FrameEvents;
 
 
 private:
 	static Game* currentGame;
 	static Scene* currentScene;
 	static Vector2Int windowSize;
+	static SystemScheduler* systemScheduler;
 
 
 	friend class Engine;
@@ -41,5 +62,6 @@ private:
 	static void SetCurrentGame(Game* game);
 	static void SetCurrentScene(Scene* scene);
 	static void SetWindowSize(const Vector2Int& size);
+	static void SetSystemScheduler(SystemScheduler* scheduler);
 };
 
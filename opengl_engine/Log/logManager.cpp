@@ -1,6 +1,7 @@
 #include "logManager.h"
 #include <ServiceLocator/locator.h>
 #include <Assets/assetManager.h>
+#include <Utils/frameArena.h>
 #include <iostream>
 #include <algorithm>
 
@@ -45,7 +46,7 @@ void LogManager::initialize()
 
 void LogManager::updateScreenLogs(float dt)
 {
-	std::vector<LogMessageScreen> expired_logs;
+	FrameVector<LogMessageScreen> expired_logs;
 
 	for (auto& screen_log : logMessagesOnScreen)
 	{
@@ -17,7 +17,7 @@ void DirectionalLight::load(Color lightColor_, Vector3 direction_, float ambient
 }
 
 
-void DirectionalLight::use(Shader& litShader, int lightIndex)
+void DirectionalLight::use(Shader& litShader, int lightIndex) const
 {
 	if (!loaded) return;
 
@@ -10,7 +10,7 @@ public:
 
 	void load(Color lightColor_, Vector3 direction_, float ambientStrength_ = 0.1f, float diffuseStrength_ = 0.5f);
 	
-	void use(Shader& litShader, int lightIndex) override;
+	void use(Shader& litShader, int lightIndex) const override;
 
 	
 	inline void setDirection(Vector3 newDirection) { direction = newDirection; }
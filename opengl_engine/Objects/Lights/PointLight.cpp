@@ -22,7 +22,7 @@ void PointLight::load(Color lightColor_, Vector3 position_, float ambientStrengt
 }
 
 
-void PointLight::use(Shader& litShader, int lightIndex)
+void PointLight::use(Shader& litShader, int lightIndex) const
 {
 	if (!loaded) return;
 
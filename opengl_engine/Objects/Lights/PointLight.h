@@ -11,7 +11,7 @@ public:
 	void load(Color lightColor_, Vector3 position_, float ambientStrength_ = 0.01f, float diffuseStrength_ = 0.7f,
 		float constant_ = 1.0f, float linear_ = 0.09f, float quadratic_ = 0.032f);
 
-	void use(Shader& litShader, int lightIndex) override;
+	void use(Shader& litShader, int lightIndex) const override;
 
 
 	inline void setPosition(Vector3 newPosition) { position = newPosition; }
@@ -27,6 +27,7 @@ public:
 	inline float getQuadratic() { return quadratic; }
 
 	inline void setUseDiffColorToSpecColor(bool value) { useColorToSpecular = value; }
+	inline bool getUseDiffColorToSpecColor() { return useColorToSpecular; }
 
 private:
 	Vector3 position{ Vector3::zero };
@@ -27,7 +27,7 @@ void SpotLight::load(Color lightColor_, Vector3 position_, Vector3 direction_,
 }
 
 
-void SpotLight::use(Shader& litShader, int lightIndex)
+void SpotLight::use(Shader& litShader, int lightIndex) const
 {
 	if (!loaded) return;
 
@@ -13,7 +13,7 @@ public:
 		float cutOff_ = Maths::cos(Maths::toRadians(12.5f)), float outerCutOff_ = Maths::cos(Maths::toRadians(17.5f)), 
 		float constant_ = 1.0f, float linear_ = 0.09f, float quadratic_ = 0.032f);
 
-	void use(Shader& litShader, int lightIndex) override;
+	void use(Shader& litShader, int lightIndex) const override;
 
 
 	inline void setPosition(Vector3 newPosition) { position = newPosition; }
@@ -1,6 +1,7 @@
 #pragma once
 #include <Rendering/shader.h>
 #include <Utils/color.h>
+#include <Utils/slotMap.h>
 
 
 enum LightType : uint8_t
@@ -18,7 +19,7 @@ public:
 	Light() {}
 	virtual ~Light() {}
 
-	virtual void use(Shader& litShader, int lightIndex) = 0;
+	virtual void use(Shader& litShader, int lightIndex) const = 0;
 
 
 	inline void setColor(Color newColor) { lightColor = newColor; }
@@ -37,6 +38,12 @@ public:
 
 	inline void turnOff() { off = true; }
 	inline void turnOn() { off = false; }
+	inline bool isOff() { return off; }
+
+
+	//  for scene and renderer
+	SlotHandle sceneHandle;
+	SlotHandle rendererHandle;
 
 
 protected:
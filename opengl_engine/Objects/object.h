@@ -2,6 +2,7 @@
 
 #include <Rendering/Model/model.h>
 #include "transform.h"
+#include <Utils/slotMap.h>
 
 #include <vector>
 
@@ -10,15 +11,20 @@ class Object : public Transform
 public:
 	Object();
 
-	void draw(Material& materialInUsage);
 	void update(float dt);
 
 	void addModel(Model* model);
 	Model& getModel(int index);
+	inline const std::vector<Model*>& getModels() const { return models; }
 
 	virtual void load() {}
 	virtual void updateObject(float dt) {}
 
+
+	//  for scene and renderer
+	SlotHandle sceneHandle;
+	SlotHandle rendererHandle;
+
 private:
 	std::vector<Model*> models;
 };
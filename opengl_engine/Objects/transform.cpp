@@ -9,7 +9,7 @@ Transform::Transform()
 void Transform::setPosition(Vector3 newPos)
 {
 	position = newPos;
-	matrixDirty = true;
+	markDirty();
 }
 
 void Transform::setPosition(float newPosX, float newPosY, float newPosZ)
@@ -38,7 +38,7 @@ void Transform::setScale(Vector3 newScale, bool scaleInWorld)
 	{
 		scale = newScale;
 	}
-	matrixDirty = true;
+	markDirty();
 }
 
 void Transform::setScale(float newScaleX, float newScaleY, float newScaleZ, bool scaleInWorld)
@@ -54,19 +54,19 @@ void Transform::setScale(float newUniformScale, bool scaleInWorld)
 void Transform::setRotation(Quaternion newRotation)
 {
 	rotation = newRotation;
-	matrixDirty = true;
+	markDirty();
 }
 
 void Transform::incrementRotation(Quaternion increment)
 {
 	rotation = Quaternion::concatenate(rotation, increment);
-	matrixDirty = true;
+	markDirty();
 }
 
 void Transform::rotateTowards(Vector3 posTowards)
 {
 	rotation = Quaternion::createLookAt(getPosition(), posTowards, Vector3::unitY);
-	matrixDirty = true;
+	markDirty();
 }
 
 
@@ -78,6 +78,7 @@ void Transform::pasteTransform(Transform& transform)
 	modelMatrix = transform.getModelMatrix();
 	normalMatrix = transform.getNormalMatrix();
 	matrixDirty = false;
+	transformVersion++;
 }
 
 
@@ -109,6 +110,12 @@ const Vector3 Transform::getRight() const
 }
 
 
+void Transform::markDirty()
+{
+	matrixDirty = true;
+	transformVersion++;
+}
+
 void Transform::computeMatrix()
 {
 	modelMatrix =
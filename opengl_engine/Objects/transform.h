@@ -39,6 +39,9 @@ public:
 	//  this function do not recompute model matrix if it is dirty, may need to work on that later on
 	const Matrix4 getModelMatrixConst() const { return modelMatrix; }
 
+	//  incremented each time position, scale or rotation change, useful to know if something computed from this transform is outdated
+	inline unsigned int getTransformVersion() const { return transformVersion; }
+
 	const Vector3 getForward() const;
 	const Vector3 getUp() const;
 	const Vector3 getRight() const;
@@ -48,6 +51,7 @@ public:
 
 private:
 	void computeMatrix();
+	void markDirty();
 
 	Vector3 position{ Vector3::zero };
 	Vector3 scale{ Vector3::one };
@@ -57,4 +61,5 @@ private:
 	Matrix4 normalMatrix{ Matrix4::identity };
 
 	bool matrixDirty{ false };
+	unsigned int transformVersion{ 0 };
 };
@@ -21,6 +21,7 @@ BoxAABBColComp::BoxAABBColComp(const Box& boxValues, Object* objectToAssociate,
 void BoxAABBColComp::changeBox(const Box& boxValues)
 {
 	box = boxValues;
+	invalidateBounds();
 }
 
 
@@ -46,18 +47,15 @@ bool BoxAABBColComp::resolveAABBSweepRaycastIntersection(const Ray& raycast, con
 
 
 
-void BoxAABBColComp::drawDebugMesh(Material& debugMaterial) const
+void BoxAABBColComp::drawDebugMesh(DebugDrawList& outDrawList, const Color& drawColor) const
 {
-	debugMaterial.getShader().setMatrix4("model", getModelMatrix().getAsFloatPtr());
-
-	if (debugMesh)
-	{
-		debugMesh->draw(true);
-	}
+	outDrawList.addMesh(debugMesh, getModelMatrix(), drawColor, true);
 }
 
 void BoxAABBColComp::onAssociatedTransformUpdated()
 {
+	invalidateBounds();
+
 	if (!isAudioCollision) return;
 
 	Audio& audio = Locator::getAudio();
@@ -122,27 +120,44 @@ void BoxAABBColComp::setupAudioCollision(const AudioCollisionOcclusion& audioCol
 	audio.AddPolygonToCollision(audioCollisionIndex, audioCollisionType, true,
 		{ vertex_bbr, vertex_btr, vertex_fbr, vertex_ftr }); //  left polygon
 
-	associatedObject->onTransformUpdated.registerObserver(this, Bind_0(&BoxAABBColComp::onAssociatedTransformUpdated));
+	associatedObject->onTransformUpdated.registerObserver(this, &BoxAABBColComp::onAssociatedTransformUpdated);
 
 	onAssociatedTransformUpdated(); //  call it at audio collision setup to set the audio collision transform
 }
 
 
+void BoxAABBColComp::invalidateBounds()
+{
+	cachedBoxValid = false;
+}
+
 Box BoxAABBColComp::getTransformedBox(bool forDrawDebug) const
 {
-	Box transformed_box;
+	if (cachedBoxValid)
+	{
+		//  static collisions never move once baked in the physics, no need to check their transform
+		if ((isStatic() && bakedInBroadphase) || cachedTransformVersion == associatedObject->getTransformVersion()) return cachedTransformedBox;
+	}
 
-	Vector3 center_factor = useTransformScaleForBoxCenter ? associatedObject->getScale() : Vector3::one;
-	Vector3 scale_factor = useTransformScaleForBoxSize ? associatedObject->getScale() : Vector3::one;
+	Box transformed_box = getScaledBox();
+	transformed_box.setCenterPoint(transformed_box.getCenterPoint() + associatedObject->getPosition());
+	//if (forDrawDebug) transformed_box.setHalfExtents(transformed_box.getHalfExtents() + Vector3{ 0.01f, 0.01f, 0.01f });
 
-	transformed_box.setCenterPoint((box.getCenterPoint() * center_factor) + associatedObject->getPosition());
-	Vector3 half_extents = box.getHalfExtents() * scale_factor;
-	//if (forDrawDebug) half_extents += Vector3{ 0.01f, 0.01f, 0.01f };
-	transformed_box.setHalfExtents(half_extents);
+	cachedTransformedBox = transformed_box;
+	cachedTransformVersion = associatedObject->getTransformVersion();
+	cachedBoxValid = true;
 
 	return transformed_box;
 }
 
+Box BoxAABBColComp::getScaledBox() const
+{
+	Vector3 center_factor = useTransformScaleForBoxCenter ? associatedObject->getScale() : Vector3::one;
+	Vector3 scale_factor = useTransformScaleForBoxSize ? associatedObject->getScale() : Vector3::one;
+
+	return Box{ box.getCenterPoint() * center_factor, box.getHalfExtents() * scale_factor };
+}
+
 Vector3 BoxAABBColComp::getNormal(const Vector3& point) const
 {
 	Box transformed_box = getTransformedBox();
@@ -17,16 +17,27 @@ public:
 	BoxAABBColComp(const Box& boxValues, Object* objectToAssociate, bool loadPersistent, std::string collisionChannel, CollisionType collisionType = CollisionType::Solid, bool scaleBoxSizeWithTransform = true, bool moveBoxCenterWithObjectScale = true);
 
 	void changeBox(const Box& boxValues);
+	inline const Box& getBox() const { return box; }
+
+	inline bool getScaleBoxSizeWithTransform() const { return useTransformScaleForBoxSize; }
+	inline bool getMoveBoxCenterWithObjectScale() const { return useTransformScaleForBoxCenter; }
 
 	const Matrix4 getModelMatrix() const override;
 
 	Vector3 getCenterDownPos() const override;
 	Box getEncapsulatingBox() const override;
+	bool isEncapsulatingBoxExact() const override { return true; }
 
 	void setupAudioCollision(const AudioCollisionOcclusion& audioCollisionType) override;
 
 	Box getTransformedBox(bool forDrawDebug = false) const;
 
+	/**
+	* Get the box with the scale of the associated object applied, but not its position.
+	* The transformed box is this box moved by the object position.
+	*/
+	Box getScaledBox() const;
+
 	/** 
 	* Get the normal of the surface the given point is on.
 	* If the given point isn't on a surface, return Vector3::zero
@@ -39,12 +50,19 @@ protected:
 	bool resolveAABBRaycastIntersection(const Box& raycast) const override;
 	bool resolveAABBSweepRaycastIntersection(const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, bool forCollisionTest) const override;
 
-	void drawDebugMesh(Material& debugMaterial) const override;
+	void drawDebugMesh(DebugDrawList& outDrawList, const Color& drawColor) const override;
 
 	void onAssociatedTransformUpdated() override;
 
+	void invalidateBounds() override;
+
 private:
 	Box box{ Box::zero };
 	bool useTransformScaleForBoxSize{ true };
 	bool useTransformScaleForBoxCenter{ true };
+
+	//  world box cache, computed again only when the associated transform version changes (never for static collisions)
+	mutable Box cachedTransformedBox{ Box::zero };
+	mutable unsigned int cachedTransformVersion{ 0 };
+	mutable bool cachedBoxValid{ false };
 };
@@ -12,9 +12,9 @@ RaycastAABB::RaycastAABB(const Vector3& location, const Box& boxInfos, float dra
 }
 
 
-void RaycastAABB::drawDebugRaycast(Material& debugMaterial)
+void RaycastAABB::drawDebugRaycast(DebugDrawList& outDrawList)
 {
-	drawDebugCube.drawCube(debugMaterial, hit ? Color::red : Color::green);
+	drawDebugCube.drawCube(outDrawList, hit ? Color::red : Color::green);
 }
 
 void RaycastAABB::setHit()
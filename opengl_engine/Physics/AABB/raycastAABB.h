@@ -16,7 +16,7 @@ public:
 	RaycastAABB(const RaycastAABB&) = delete;
 	RaycastAABB& operator=(const RaycastAABB&) = delete;
 
-	void drawDebugRaycast(Material& debugMaterial) override;
+	void drawDebugRaycast(DebugDrawList& outDrawList) override;
 
 	void setHit();
 
@@ -14,18 +14,18 @@ RaycastAABBSweep::RaycastAABBSweep(const Vector3& startPoint, const Vector3& end
 	drawDebugCubeTwo.setBox(box);
 }
 
-void RaycastAABBSweep::drawDebugRaycast(Material& debugMaterial)
+void RaycastAABBSweep::drawDebugRaycast(DebugDrawList& outDrawList)
 {
-	drawDebugLineOne.drawLine(debugMaterial, Color::green);
-	drawDebugCubeOne.drawCube(debugMaterial, Color::green);
+	drawDebugLineOne.drawLine(outDrawList, Color::green);
+	drawDebugCubeOne.drawCube(outDrawList, Color::green);
 	if (!hit)
 	{
-		drawDebugCubeTwo.drawCube(debugMaterial, Color::green);
+		drawDebugCubeTwo.drawCube(outDrawList, Color::green);
 		return;
 	}
 
-	drawDebugLineTwo.drawLine(debugMaterial, Color::red);
-	drawDebugCubeTwo.drawCube(debugMaterial, Color::red);
+	drawDebugLineTwo.drawLine(outDrawList, Color::red);
+	drawDebugCubeTwo.drawCube(outDrawList, Color::red);
 }
 
 void RaycastAABBSweep::setValues(bool raycastHit, Vector3 hitPosition)
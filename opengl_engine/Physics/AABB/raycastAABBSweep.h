@@ -20,7 +20,7 @@ public:
 	RaycastAABBSweep(const RaycastAABBSweep&) = delete;
 	RaycastAABBSweep& operator=(const RaycastAABBSweep&) = delete;
 
-	void drawDebugRaycast(Material& debugMaterial) override;
+	void drawDebugRaycast(DebugDrawList& outDrawList) override;
 
 	void setValues(bool raycastHit, Vector3 hitPosition);
 
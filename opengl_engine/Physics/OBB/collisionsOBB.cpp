@@ -0,0 +1,177 @@
+#include "collisionsOBB.h"
+#include <Physics/separatingAxis.h>
+#include <Maths/Maths.h>
+
+#include <limits>
+
+
+bool CollisionsOBB::IntersectPoint(const OrientedBoxColComp& orientedBox, const Vector3& point)
+{
+	const OrientedBox box = orientedBox.getOrientedBox();
+	const Vector3 local_point = box.toLocal(point);
+
+	return
+		Maths::abs(local_point.x) <= box.halfExtents.x &&
+		Maths::abs(local_point.y) <= box.halfExtents.y &&
+		Maths::abs(local_point.z) <= box.halfExtents.z;
+}
+
+bool CollisionsOBB::IntersectLineRaycast(const OrientedBoxColComp& orientedBox, const Ray& raycast, RaycastHitInfos& outHitInfos)
+{
+	const OrientedBox box = orientedBox.getOrientedBox();
+
+	float hit_distance = 0.0f;
+	Vector3 hit_normal = Vector3::zero;
+
+	bool intersect = BoxRayIntersection(box, raycast, hit_distance, hit_normal);
+
+	//  check if it is the closest collision found
+	if (intersect && hit_distance < outHitInfos.hitDistance)
+	{
+		outHitInfos.hitDistance = hit_distance;
+		outHitInfos.hitLocation = raycast.getOrigin() + raycast.getDirection() * hit_distance;
+		outHitInfos.hitNormal = hit_normal;
+		outHitInfos.hitCollision = &orientedBox;
+	}
+
+	return intersect;
+}
+
+bool CollisionsOBB::IntersectAABBRaycast(const OrientedBoxColComp& orientedBox, const Box& raycast)
+{
+	const OrientedBox box = orientedBox.getOrientedBox();
+
+	SeparatingAxisSweep overlap(raycast, Vector3::zero);
+	TestSeparatingAxes(box, overlap);
+
+	return overlap.hasHit(false);
+}
+
+bool CollisionsOBB::IntersectAABBSweepRaycast(const OrientedBoxColComp& orientedBox, const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, bool forCollisionTest)
+{
+	const OrientedBox box = orientedBox.getOrientedBox();
+
+	const Vector3 movement = raycast.getEnd() - boxRaycast.getCenterPoint();
+	SeparatingAxisSweep sweep(boxRaycast, movement);
+	TestSeparatingAxes(box, sweep);
+
+	bool intersect = sweep.hasHit(forCollisionTest);
+
+	//  check if it is trigger
+	if (intersect && orientedBox.getCollisionType() == CollisionType::Trigger)
+	{
+		outHitInfos.triggersDetected.push_back(&orientedBox);
+		return false;
+	}
+
+	//  check if it is the closest collision found
+	const float hit_distance = movement == Vector3::zero ? 0.0f : sweep.getEnterTime() * raycast.getLength();
+	if (intersect && hit_distance < outHitInfos.hitDistance)
+	{
+		outHitInfos.hitDistance = hit_distance;
+		outHitInfos.hitLocation = movement == Vector3::zero ? boxRaycast.getCenterPoint() : raycast.getOrigin() + raycast.getDirection() * hit_distance;
+		outHitInfos.hitNormal = sweep.getHitNormal();
+		outHitInfos.hitCollision = &orientedBox;
+	}
+
+	return intersect;
+}
+
+
+bool CollisionsOBB::BoxRayIntersection(const OrientedBox& box, const Ray& ray, float& distance, Vector3& normal)
+{
+	const Vector3 local_origin = box.toLocal(ray.getOrigin());
+	const Vector3 ray_direction = ray.getDirection();
+
+	const float origin[3] = { local_origin.x, local_origin.y, local_origin.z };
+	const float direction[3] = { Vector3::dot(ray_direction, box.axes[0]), Vector3::dot(ray_direction, box.axes[1]), Vector3::dot(ray_direction, box.axes[2]) };
+	const float half_extents[3] = { box.halfExtents.x, box.halfExtents.y, box.halfExtents.z };
+
+	float tmin = -std::numeric_limits<float>::max();
+	float tmax = std::numeric_limits<float>::max();
+	int tmin_axis = -1;
+	float tmin_sign = 0.0f;
+
+	for (int i = 0; i < 3; i++)
+	{
+		if (direction[i] == 0.0f)
+		{
+			//  parallel to this slab: the origin must be inside it
+			if (Maths::abs(origin[i]) > half_extents[i]) return false;
+			continue;
+		}
+
+		const float inv_direction = 1.0f / direction[i];
+		float t1 = (-half_extents[i] - origin[i]) * inv_direction;
+		float t2 = (half_extents[i] - origin[i]) * inv_direction;
+		float sign = -1.0f; //  entering by the negative face
+		if (t1 > t2)
+		{
+			const float swap = t1;
+			t1 = t2;
+			t2 = swap;
+			sign = 1.0f;
+		}
+
+		if (t1 > tmin)
+		{
+			tmin = t1;
+			tmin_axis = i;
+			tmin_sign = sign;
+		}
+		tmax = Maths::min(tmax, t2);
+	}
+
+	//  if tmax < 0, ray (line) is intersecting the box, but the whole box is behind us
+	//  if tmin > tmax, ray doesn't intersect the box
+	//  if tmin > length, the whole box is after the end of the raycast
+	if (tmax < 0.0f || tmin > tmax || tmin > ray.getLength()) return false;
+
+	distance = tmin;
+	normal = tmin_axis >= 0 ? box.axes[tmin_axis] * tmin_sign : Vector3::zero;
+	return true;
+}
+
+bool CollisionsOBB::TestSeparatingAxes(const OrientedBox& box, SeparatingAxisSweep& sweep)
+{
+	const Vector3 world_axes[3] = { Vector3::unitX, Vector3::unitY, Vector3::unitZ };
+	float shape_min = 0.0f;
+	float shape_max = 0.0f;
+
+	//  faces of the AABB and of the oriented box
+	for (int i = 0; i < 3; i++)
+	{
+		ProjectBox(box, world_axes[i], shape_min, shape_max);
+		if (!sweep.testAxis(world_axes[i], shape_min, shape_max)) return false;
+
+		ProjectBox(box, box.axes[i], shape_min, shape_max);
+		if (!sweep.testAxis(box.axes[i], shape_min, shape_max)) return false;
+	}
+
+	//  edges of the AABB against edges of the oriented box
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			const Vector3 axis = Vector3::cross(world_axes[i], box.axes[j]);
+			if (!SeparatingAxisSweep::IsValidCrossAxis(axis, box.axes[j])) continue;
+
+			ProjectBox(box, axis, shape_min, shape_max);
+			if (!sweep.testAxis(axis, shape_min, shape_max)) return false;
+		}
+	}
+
+	return true;
+}
+
+void CollisionsOBB::ProjectBox(const OrientedBox& box, const Vector3& axis, float& outMin, float& outMax)
+{
+	const float center = Vector3::dot(box.center, axis);
+	const float radius =
+		Maths::abs(Vector3::dot(box.axes[0], axis)) * box.halfExtents.x +
+		Maths::abs(Vector3::dot(box.axes[1], axis)) * box.halfExtents.y +
+		Maths::abs(Vector3::dot(box.axes[2], axis)) * box.halfExtents.z;
+
+	outMin = center - radius;
+	outMax = center + radius;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "orientedBoxColComp.h"
+
+class SeparatingAxisSweep;
+
+/** Collisions OBB
+* Static functions that will check collisions that involves Oriented Box components.
+*/
+class CollisionsOBB
+{
+public:
+	static bool IntersectPoint(const OrientedBoxColComp& orientedBox, const Vector3& point);
+
+	static bool IntersectLineRaycast(const OrientedBoxColComp& orientedBox, const Ray& raycast, RaycastHitInfos& outHitInfos);
+
+	static bool IntersectAABBRaycast(const OrientedBoxColComp& orientedBox, const Box& raycast);
+
+	static bool IntersectAABBSweepRaycast(const OrientedBoxColComp& orientedBox, const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, bool forCollisionTest);
+
+
+private:
+	//  ray against the box in its own space (slabs test)
+	static bool BoxRayIntersection(const OrientedBox& box, const Ray& ray, float& distance, Vector3& normal);
+
+	//  the 15 axes that can separate an AABB from an oriented box
+	static bool TestSeparatingAxes(const OrientedBox& box, SeparatingAxisSweep& sweep);
+
+	static void ProjectBox(const OrientedBox& box, const Vector3& axis, float& outMin, float& outMax);
+};
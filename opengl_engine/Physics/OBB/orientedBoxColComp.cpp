@@ -0,0 +1,149 @@
+#include "orientedBoxColComp.h"
+#include "collisionsOBB.h"
+
+#include <Assets/assetManager.h>
+#include <Rendering/material.h>
+#include <Maths/Maths.h>
+
+
+Vector3 OrientedBox::toLocal(const Vector3& point) const
+{
+	const Vector3 offset = point - center;
+	return Vector3{ Vector3::dot(offset, axes[0]), Vector3::dot(offset, axes[1]), Vector3::dot(offset, axes[2]) };
+}
+
+Vector3 OrientedBox::toWorld(const Vector3& localPoint) const
+{
+	return center + axes[0] * localPoint.x + axes[1] * localPoint.y + axes[2] * localPoint.z;
+}
+
+Box OrientedBox::getEncapsulatingBox() const
+{
+	const Vector3 extents = Vector3::abs(axes[0]) * halfExtents.x + Vector3::abs(axes[1]) * halfExtents.y + Vector3::abs(axes[2]) * halfExtents.z;
+	return Box{ center, extents };
+}
+
+
+
+OrientedBoxColComp::OrientedBoxColComp() :
+	CollisionComponent(CollisionShape::OrientedBox, CollisionType::Solid, nullptr, &AssetManager::GetSingleMesh("debug_cube"), false, "")
+{
+}
+
+OrientedBoxColComp::OrientedBoxColComp(const Box& boxValues, Object* objectToAssociate, bool loadPersistent, std::string collisionChannel, CollisionType collisionType) :
+	box(boxValues),
+	CollisionComponent(CollisionShape::OrientedBox, collisionType, objectToAssociate, &AssetManager::GetSingleMesh("debug_cube"), loadPersistent, collisionChannel)
+{
+}
+
+void OrientedBoxColComp::changeBox(const Box& boxValues)
+{
+	box = boxValues;
+	invalidateBounds();
+}
+
+
+bool OrientedBoxColComp::resolvePointIntersection(const Vector3& point) const
+{
+	return CollisionsOBB::IntersectPoint(*this, point);
+}
+
+bool OrientedBoxColComp::resolveLineRaycastIntersection(const Ray& raycast, RaycastHitInfos& outHitInfos) const
+{
+	return CollisionsOBB::IntersectLineRaycast(*this, raycast, outHitInfos);
+}
+
+bool OrientedBoxColComp::resolveAABBRaycastIntersection(const Box& raycast) const
+{
+	return CollisionsOBB::IntersectAABBRaycast(*this, raycast);
+}
+
+bool OrientedBoxColComp::resolveAABBSweepRaycastIntersection(const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, bool forCollisionTest) const
+{
+	return CollisionsOBB::IntersectAABBSweepRaycast(*this, raycast, boxRaycast, outHitInfos, forCollisionTest);
+}
+
+
+
+void OrientedBoxColComp::drawDebugMesh(DebugDrawList& outDrawList, const Color& drawColor) const
+{
+	outDrawList.addMesh(debugMesh, getModelMatrix(), drawColor, true);
+}
+
+const Matrix4 OrientedBoxColComp::getModelMatrix() const
+{
+	const OrientedBox oriented_box = getOrientedBox();
+	Matrix4 matrix =
+		Matrix4::createScale(oriented_box.halfExtents * 2.0f) *
+		Matrix4::createFromQuaternion(associatedObject->getRotation()) *
+		Matrix4::createTranslation(oriented_box.center);
+	return matrix;
+}
+
+Vector3 OrientedBoxColComp::getCenterDownPos() const
+{
+	const Box encapsulating_box = getEncapsulatingBox();
+	return encapsulating_box.getCenterPoint() + Vector3{ 0.0f, -encapsulating_box.getHalfExtents().y, 0.0f };
+}
+
+Box OrientedBoxColComp::getEncapsulatingBox() const
+{
+	return getOrientedBox().getEncapsulatingBox();
+}
+
+bool OrientedBoxColComp::isEncapsulatingBoxExact() const
+{
+	//  a box rotated by right angles (like the walls) is still an AABB
+	const OrientedBox oriented_box = getOrientedBox();
+	for (int i = 0; i < 3; i++)
+	{
+		const Vector3 axis = Vector3::abs(oriented_box.axes[i]);
+		if (Maths::max(axis.x, Maths::max(axis.y, axis.z)) < 0.99999f) return false;
+	}
+	return true;
+}
+
+Vector3 OrientedBoxColComp::getClosestPoint(const Vector3& point) const
+{
+	const OrientedBox oriented_box = getOrientedBox();
+	const Vector3 local_point = oriented_box.toLocal(point);
+	const Vector3 half_extents = oriented_box.halfExtents;
+
+	return oriented_box.toWorld(Vector3
+	{
+		Maths::clamp(local_point.x, -half_extents.x, half_extents.x),
+		Maths::clamp(local_point.y, -half_extents.y, half_extents.y),
+		Maths::clamp(local_point.z, -half_extents.z, half_extents.z)
+	});
+}
+
+
+void OrientedBoxColComp::invalidateBounds()
+{
+	cachedBoxValid = false;
+}
+
+OrientedBox OrientedBoxColComp::getOrientedBox() const
+{
+	if (cachedBoxValid)
+	{
+		//  static collisions never move once baked in the physics, no need to check their transform
+		if ((isStatic() && bakedInBroadphase) || cachedTransformVersion == associatedObject->getTransformVersion()) return cachedOrientedBox;
+	}
+
+	const Quaternion rotation = associatedObject->getRotation();
+	const Vector3 scale = associatedObject->getScale();
+
+	OrientedBox oriented_box;
+	oriented_box.center = associatedObject->getPosition() + Vector3::transform(box.getCenterPoint() * scale, rotation);
+	oriented_box.axes[0] = Vector3::normalize(Vector3::transform(Vector3::unitX, rotation));
+	oriented_box.axes[1] = Vector3::normalize(Vector3::transform(Vector3::unitY, rotation));
+	oriented_box.axes[2] = Vector3::normalize(Vector3::transform(Vector3::unitZ, rotation));
+	oriented_box.halfExtents = Vector3::abs(box.getHalfExtents() * scale);
+
+	cachedOrientedBox = oriented_box;
+	cachedTransformVersion = associatedObject->getTransformVersion();
+	cachedBoxValid = true;
+
+	return oriented_box;
+}
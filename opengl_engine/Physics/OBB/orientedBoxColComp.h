@@ -0,0 +1,63 @@
+#pragma once
+#include <Physics/collisionComponent.h>
+#include <Maths/Geometry/box.h>
+
+
+/** Oriented Box
+* World values of an oriented box: its axes are normalized, the half extents are along them.
+*/
+struct OrientedBox
+{
+	Vector3 center{ Vector3::zero };
+	Vector3 axes[3]{ Vector3::unitX, Vector3::unitY, Vector3::unitZ };
+	Vector3 halfExtents{ Vector3::zero };
+
+	Vector3 toLocal(const Vector3& point) const;
+	Vector3 toWorld(const Vector3& localPoint) const;
+
+	//  smallest AABB that contains this box
+	Box getEncapsulatingBox() const;
+};
+
+
+/** Oriented Box Collision Component
+* Class for collision components of type Oriented Box
+* This type of collision support position, rotation and scale from transform: the box is given in the associated object space.
+* It can't be used by a rigidbody (rigidbodies move as box AABB).
+*/
+class OrientedBoxColComp : public CollisionComponent
+{
+public:
+	OrientedBoxColComp();
+	OrientedBoxColComp(const Box& boxValues, Object* objectToAssociate, bool loadPersistent, std::string collisionChannel, CollisionType collisionType = CollisionType::Solid);
+
+	void changeBox(const Box& boxValues);
+	inline const Box& getBox() const { return box; }
+
+	const Matrix4 getModelMatrix() const override;
+
+	Vector3 getCenterDownPos() const override;
+	Box getEncapsulatingBox() const override;
+	bool isEncapsulatingBoxExact() const override;
+	Vector3 getClosestPoint(const Vector3& point) const override;
+
+	OrientedBox getOrientedBox() const;
+
+protected:
+	bool resolvePointIntersection(const Vector3& point) const override;
+	bool resolveLineRaycastIntersection(const Ray& raycast, RaycastHitInfos& outHitInfos) const override;
+	bool resolveAABBRaycastIntersection(const Box& raycast) const override;
+	bool resolveAABBSweepRaycastIntersection(const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, bool forCollisionTest) const override;
+
+	void drawDebugMesh(DebugDrawList& outDrawList, const Color& drawColor) const override;
+
+	void invalidateBounds() override;
+
+private:
+	Box box{ Box::zero };
+
+	//  world box cache, computed again only when the associated transform version changes (never for static collisions)
+	mutable OrientedBox cachedOrientedBox;
+	mutable unsigned int cachedTransformVersion{ 0 };
+	mutable bool cachedBoxValid{ false };
+};
@@ -14,13 +14,16 @@ void CollisionChannels::RegisterTestChannel(std::string name, std::vector<std::s
 	registeredTestsChannels.emplace(name, testChannel);
 }
 
-std::vector<std::string> CollisionChannels::GetRegisteredTestChannel(std::string name)
+const std::vector<std::string>& CollisionChannels::GetRegisteredTestChannel(const std::string& name)
 {
-	if (registeredTestsChannels.find(name) == registeredTestsChannels.end())
+	auto iter = registeredTestsChannels.find(name);
+	if (iter == registeredTestsChannels.end())
 	{
 		Locator::getLog().LogMessage_Category("Collision Channels: Tried to get a registered test channel with a name that doesn't exists. Name is " + name + ".", LogCategory::Error);
-		return { "" };
+
+		static const std::vector<std::string> unknown_test_channel{ "" };
+		return unknown_test_channel;
 	}
 
-	return registeredTestsChannels.at(name);
+	return iter->second;
 }
\ No newline at end of file
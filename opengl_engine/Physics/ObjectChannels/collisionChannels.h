@@ -12,9 +12,9 @@ class CollisionChannels
 public:
 	static void RegisterTestChannel(std::string name, std::vector<std::string> testChannel);
 
-	static std::vector<std::string> GetRegisteredTestChannel(std::string name);
+	static const std::vector<std::string>& GetRegisteredTestChannel(const std::string& name);
 
-	static std::string DefaultEverything() { return defaultEverything; }
+	static const std::string& DefaultEverything() { return defaultEverything; }
 
 private:
 	static std::unordered_map<std::string, std::vector<std::string>> registeredTestsChannels;
@@ -0,0 +1,228 @@
+#include "collisionsTriangleMesh.h"
+#include "triangleMeshBVH.h"
+#include <Physics/separatingAxis.h>
+#include <Maths/Maths.h>
+
+#include <limits>
+
+
+bool CollisionsTriangleMesh::IntersectPoint(const TriangleMeshColComp& triangleMesh, const Vector3& point)
+{
+	const TriangleMeshBVH* mesh = triangleMesh.getTriangleMesh();
+	if (!mesh) return false;
+
+	const TriangleMeshTransform transform = triangleMesh.getMeshTransform();
+	const Vector3 local_point = transform.toLocal(point);
+
+	const Box bounds = mesh->getBounds();
+	if (!bounds.containsPoint(local_point)) return false;
+
+	//  count the triangles crossed from the point to the outside of the mesh bounds
+	const Vector3 segment{ bounds.getMaxPoint().x - local_point.x + 1.0f, 0.0f, 0.0f };
+	int crossings = 0;
+	mesh->visitSegment(local_point, segment, Vector3::zero, 1.0f, [&](int triangle, float& maxFraction)
+	{
+		const Vector3* vertices = mesh->getTriangle(triangle);
+		float fraction = 0.0f;
+		if (TriangleMeshBVH::SegmentTriangleIntersection(local_point, segment, vertices[0], vertices[1], vertices[2], fraction)) crossings++;
+	});
+
+	return crossings % 2 == 1;
+}
+
+bool CollisionsTriangleMesh::IntersectLineRaycast(const TriangleMeshColComp& triangleMesh, const Ray& raycast, RaycastHitInfos& outHitInfos)
+{
+	const TriangleMeshBVH* mesh = triangleMesh.getTriangleMesh();
+	if (!mesh) return false;
+
+	//  the mesh space is an affine transformation of the world, so the fractions of the segment are the same in both
+	const TriangleMeshTransform transform = triangleMesh.getMeshTransform();
+	const Vector3 local_start = transform.toLocal(raycast.getStart());
+	const Vector3 local_segment = transform.toLocal(raycast.getEnd()) - local_start;
+
+	float best_fraction = std::numeric_limits<float>::max();
+	int best_triangle = -1;
+	mesh->visitSegment(local_start, local_segment, Vector3::zero, 1.0f, [&](int triangle, float& maxFraction)
+	{
+		const Vector3* vertices = mesh->getTriangle(triangle);
+		float fraction = 0.0f;
+		if (!TriangleMeshBVH::SegmentTriangleIntersection(local_start, local_segment, vertices[0], vertices[1], vertices[2], fraction)) return;
+		if (fraction >= best_fraction) return;
+
+		best_fraction = fraction;
+		best_triangle = triangle;
+		maxFraction = fraction;
+	});
+
+	if (best_triangle < 0) return false;
+
+	//  check if it is the closest collision found
+	const float hit_distance = best_fraction * raycast.getLength();
+	if (hit_distance < outHitInfos.hitDistance)
+	{
+		Vector3 world_triangle[3];
+		GetWorldTriangle(*mesh, transform, best_triangle, world_triangle);
+		Vector3 normal = Vector3::normalize(Vector3::cross(world_triangle[1] - world_triangle[0], world_triangle[2] - world_triangle[0]));
+		if (Vector3::dot(normal, raycast.getDirection()) > 0.0f) normal = -normal; //  the face that has been hit
+
+		outHitInfos.hitDistance = hit_distance;
+		outHitInfos.hitLocation = raycast.getOrigin() + raycast.getDirection() * hit_distance;
+		outHitInfos.hitNormal = normal;
+		outHitInfos.hitCollision = &triangleMesh;
+	}
+
+	return true;
+}
+
+bool CollisionsTriangleMesh::IntersectAABBRaycast(const TriangleMeshColComp& triangleMesh, const Box& raycast)
+{
+	const TriangleMeshBVH* mesh = triangleMesh.getTriangleMesh();
+	if (!mesh) return false;
+
+	const TriangleMeshTransform transform = triangleMesh.getMeshTransform();
+	const Vector3 local_center = transform.toLocal(raycast.getCenterPoint());
+	const Vector3 local_half_extents = transform.toLocalHalfExtents(raycast.getHalfExtents());
+
+	bool intersect = false;
+	mesh->visitBox(local_center - local_half_extents, local_center + local_half_extents, [&](int triangle)
+	{
+		Vector3 world_triangle[3];
+		GetWorldTriangle(*mesh, transform, triangle, world_triangle);
+
+		SeparatingAxisSweep overlap(raycast, Vector3::zero);
+		TestSeparatingAxes(world_triangle[0], world_triangle[1], world_triangle[2], overlap);
+		intersect = overlap.hasHit(false);
+		return !intersect;
+	});
+
+	return intersect;
+}
+
+bool CollisionsTriangleMesh::IntersectAABBSweepRaycast(const TriangleMeshColComp& triangleMesh, const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, bool forCollisionTest)
+{
+	const TriangleMeshBVH* mesh = triangleMesh.getTriangleMesh();
+	if (!mesh) return false;
+
+	const TriangleMeshTransform transform = triangleMesh.getMeshTransform();
+	const Vector3 movement = raycast.getEnd() - boxRaycast.getCenterPoint();
+	const Vector3 local_start = transform.toLocal(boxRaycast.getCenterPoint());
+	const Vector3 local_segment = transform.toLocal(raycast.getEnd()) - local_start;
+	const Vector3 local_half_extents = transform.toLocalHalfExtents(boxRaycast.getHalfExtents());
+
+	const bool is_trigger = triangleMesh.getCollisionType() == CollisionType::Trigger;
+	bool intersect = false;
+	float best_time = std::numeric_limits<float>::max();
+	Vector3 best_normal = Vector3::zero;
+	mesh->visitSegment(local_start, local_segment, local_half_extents, 1.0f, [&](int triangle, float& maxFraction)
+	{
+		if (is_trigger && intersect) return; //  a trigger only needs to know that the box overlaps it
+
+		Vector3 world_triangle[3];
+		GetWorldTriangle(*mesh, transform, triangle, world_triangle);
+
+		SeparatingAxisSweep sweep(boxRaycast, movement);
+		TestSeparatingAxes(world_triangle[0], world_triangle[1], world_triangle[2], sweep);
+		if (!sweep.hasHit(forCollisionTest)) return;
+
+		intersect = true;
+		const float time = movement == Vector3::zero ? 0.0f : sweep.getEnterTime();
+		if (time >= best_time) return;
+
+		best_time = time;
+		best_normal = sweep.getHitNormal();
+		maxFraction = is_trigger ? -1.0f : Maths::max(time, 0.0f);
+	});
+
+	//  check if it is trigger
+	if (intersect && is_trigger)
+	{
+		outHitInfos.triggersDetected.push_back(&triangleMesh);
+		return false;
+	}
+
+	//  check if it is the closest collision found
+	const float hit_distance = best_time * raycast.getLength();
+	if (intersect && hit_distance < outHitInfos.hitDistance)
+	{
+		outHitInfos.hitDistance = hit_distance;
+		outHitInfos.hitLocation = movement == Vector3::zero ? boxRaycast.getCenterPoint() : raycast.getOrigin() + raycast.getDirection() * hit_distance;
+		outHitInfos.hitNormal = best_normal;
+		outHitInfos.hitCollision = &triangleMesh;
+	}
+
+	return intersect;
+}
+
+Vector3 CollisionsTriangleMesh::ClosestPoint(const TriangleMeshColComp& triangleMesh, const Vector3& point)
+{
+	const TriangleMeshBVH* mesh = triangleMesh.getTriangleMesh();
+	const TriangleMeshTransform transform = triangleMesh.getMeshTransform();
+	if (!mesh || !mesh->isBuilt()) return transform.position;
+
+	//  the BVH is in mesh space: a world distance is at least the mesh space distance times the smallest scale
+	const float min_scale = transform.getMinScale();
+	const float min_scale_sq = min_scale * min_scale;
+	const Vector3 local_point = transform.toLocal(point);
+
+	float best_distance_sq = std::numeric_limits<float>::max();
+	Vector3 best_point = transform.position;
+	mesh->visitNearest(local_point, std::numeric_limits<float>::max(), [&](int triangle, float& maxDistanceSq)
+	{
+		Vector3 world_triangle[3];
+		GetWorldTriangle(*mesh, transform, triangle, world_triangle);
+
+		const Vector3 closest = TriangleMeshBVH::ClosestPointOnTriangle(point, world_triangle[0], world_triangle[1], world_triangle[2]);
+		const float distance_sq = (closest - point).lengthSq();
+		if (distance_sq >= best_distance_sq) return;
+
+		best_distance_sq = distance_sq;
+		best_point = closest;
+		if (min_scale_sq > 0.0f) maxDistanceSq = distance_sq / min_scale_sq;
+	});
+
+	return best_point;
+}
+
+
+bool CollisionsTriangleMesh::TestSeparatingAxes(const Vector3& a, const Vector3& b, const Vector3& c, SeparatingAxisSweep& sweep)
+{
+	const Vector3 world_axes[3] = { Vector3::unitX, Vector3::unitY, Vector3::unitZ };
+	const Vector3 edges[3] = { b - a, c - b, a - c };
+	float shape_min = 0.0f;
+	float shape_max = 0.0f;
+
+	//  faces of the AABB
+	for (int i = 0; i < 3; i++)
+	{
+		SeparatingAxisSweep::ProjectTriangle(world_axes[i], a, b, c, shape_min, shape_max);
+		if (!sweep.testAxis(world_axes[i], shape_min, shape_max)) return false;
+	}
+
+	//  face of the triangle (the triangle is flat on its normal)
+	const Vector3 normal = Vector3::cross(edges[0], edges[1]);
+	const float plane = Vector3::dot(normal, a);
+	if (!sweep.testAxis(normal, plane, plane)) return false;
+
+	//  edges of the AABB against edges of the triangle
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+		{
+			const Vector3 axis = Vector3::cross(world_axes[i], edges[j]);
+			if (!SeparatingAxisSweep::IsValidCrossAxis(axis, edges[j])) continue;
+
+			SeparatingAxisSweep::ProjectTriangle(axis, a, b, c, shape_min, shape_max);
+			if (!sweep.testAxis(axis, shape_min, shape_max)) return false;
+		}
+	}
+
+	return true;
+}
+
+void CollisionsTriangleMesh::GetWorldTriangle(const TriangleMeshBVH& mesh, const TriangleMeshTransform& transform, int triangle, Vector3 outVertices[3])
+{
+	const Vector3* vertices = mesh.getTriangle(triangle);
+	outVertices[0] = transform.toWorld(vertices[0]);
+	outVertices[1] = transform.toWorld(vertices[1]);
+	outVertices[2] = transform.toWorld(vertices[2]);
+}
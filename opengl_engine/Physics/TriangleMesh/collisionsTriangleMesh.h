@@ -0,0 +1,30 @@
+#pragma once
+#include "triangleMeshColComp.h"
+
+class SeparatingAxisSweep;
+
+/** Collisions Triangle Mesh
+* Static functions that will check collisions that involves Triangle Mesh components.
+* The BVH of the mesh is traversed in mesh space, the triangles it gives are then tested in world space.
+*/
+class CollisionsTriangleMesh
+{
+public:
+	//  a point is inside the mesh if a ray from it crosses the triangles an odd number of times (only meaningful for closed meshes)
+	static bool IntersectPoint(const TriangleMeshColComp& triangleMesh, const Vector3& point);
+
+	static bool IntersectLineRaycast(const TriangleMeshColComp& triangleMesh, const Ray& raycast, RaycastHitInfos& outHitInfos);
+
+	static bool IntersectAABBRaycast(const TriangleMeshColComp& triangleMesh, const Box& raycast);
+
+	static bool IntersectAABBSweepRaycast(const TriangleMeshColComp& triangleMesh, const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, bool forCollisionTest);
+
+	static Vector3 ClosestPoint(const TriangleMeshColComp& triangleMesh, const Vector3& point);
+
+	//  the 13 axes that can separate an AABB from a world triangle (public for the brute-force checks of the benchmarks)
+	static bool TestSeparatingAxes(const Vector3& a, const Vector3& b, const Vector3& c, SeparatingAxisSweep& sweep);
+
+
+private:
+	static void GetWorldTriangle(const TriangleMeshBVH& mesh, const TriangleMeshTransform& transform, int triangle, Vector3 outVertices[3]);
+};
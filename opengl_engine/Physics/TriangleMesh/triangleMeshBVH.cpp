@@ -0,0 +1,341 @@
+#include "triangleMeshBVH.h"
+#include <Maths/Maths.h>
+
+#include <algorithm>
+#include <limits>
+
+
+TriangleMeshBVH::TriangleMeshBVH(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+	addMesh(vertices, indices);
+	build();
+}
+
+void TriangleMeshBVH::addMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
+{
+	std::vector<Vector3> positions;
+	positions.reserve(vertices.size());
+	for (auto& vertex : vertices)
+	{
+		positions.push_back(vertex.position);
+	}
+
+	addMesh(positions, indices);
+}
+
+void TriangleMeshBVH::addMesh(const std::vector<Vector3>& positions, const std::vector<unsigned int>& indices)
+{
+	const size_t indices_count = indices.empty() ? positions.size() : indices.size();
+	trianglesVertices.reserve(trianglesVertices.size() + indices_count - indices_count % 3);
+
+	for (size_t i = 0; i + 2 < indices_count; i += 3)
+	{
+		const size_t a = indices.empty() ? i : indices[i];
+		const size_t b = indices.empty() ? i + 1 : indices[i + 1];
+		const size_t c = indices.empty() ? i + 2 : indices[i + 2];
+		if (a >= positions.size() || b >= positions.size() || c >= positions.size()) continue;
+
+		trianglesVertices.push_back(positions[a]);
+		trianglesVertices.push_back(positions[b]);
+		trianglesVertices.push_back(positions[c]);
+	}
+
+	nodes.clear();
+}
+
+void TriangleMeshBVH::build()
+{
+	nodes.clear();
+	const int triangles_count = getTrianglesCount();
+	if (triangles_count == 0) return;
+
+	//  bounds and centroids of the triangles, computed once
+	std::vector<Vector3> triangles_min(triangles_count);
+	std::vector<Vector3> triangles_max(triangles_count);
+	std::vector<Vector3> centroids(triangles_count);
+	trianglesOrder.resize(triangles_count);
+	for (int i = 0; i < triangles_count; i++)
+	{
+		const Vector3* triangle = getTriangle(i);
+		triangles_min[i] = Vector3{ Maths::min(triangle[0].x, Maths::min(triangle[1].x, triangle[2].x)), Maths::min(triangle[0].y, Maths::min(triangle[1].y, triangle[2].y)), Maths::min(triangle[0].z, Maths::min(triangle[1].z, triangle[2].z)) };
+		triangles_max[i] = Vector3{ Maths::max(triangle[0].x, Maths::max(triangle[1].x, triangle[2].x)), Maths::max(triangle[0].y, Maths::max(triangle[1].y, triangle[2].y)), Maths::max(triangle[0].z, Maths::max(triangle[1].z, triangle[2].z)) };
+		centroids[i] = (triangles_min[i] + triangles_max[i]) * 0.5f;
+		trianglesOrder[i] = i;
+	}
+
+	auto get_axis = [](const Vector3& vec, int axis) { return axis == 0 ? vec.x : (axis == 1 ? vec.y : vec.z); };
+	auto surface_area = [](const Vector3& min, const Vector3& max)
+	{
+		const Vector3 size = max - min;
+		return size.x * size.y + size.y * size.z + size.z * size.x;
+	};
+
+	struct Bin
+	{
+		Vector3 min{ Vector3::infinity };
+		Vector3 max{ Vector3::negInfinity };
+		int count{ 0 };
+	};
+
+	struct BuildEntry
+	{
+		uint32_t node;
+		int depth;
+	};
+
+	nodes.reserve(triangles_count * 2);
+	nodes.emplace_back();
+	nodes[0].leftOrFirst = 0;
+	nodes[0].trianglesCount = triangles_count;
+	updateNodeBounds(nodes[0], triangles_min, triangles_max);
+
+	std::vector<BuildEntry> build_stack;
+	build_stack.push_back(BuildEntry{ 0, 0 });
+
+	while (!build_stack.empty())
+	{
+		const BuildEntry entry = build_stack.back();
+		build_stack.pop_back();
+
+		const uint32_t first = nodes[entry.node].leftOrFirst;
+		const uint32_t count = nodes[entry.node].trianglesCount;
+		if (count <= MAX_LEAF_TRIANGLES || entry.depth >= MAX_DEPTH) continue;
+
+		//  split along the longest axis of the centroids bounds
+		Vector3 centroids_min = Vector3::infinity;
+		Vector3 centroids_max = Vector3::negInfinity;
+		for (uint32_t i = first; i < first + count; i++)
+		{
+			const Vector3& centroid = centroids[trianglesOrder[i]];
+			centroids_min = Vector3{ Maths::min(centroids_min.x, centroid.x), Maths::min(centroids_min.y, centroid.y), Maths::min(centroids_min.z, centroid.z) };
+			centroids_max = Vector3{ Maths::max(centroids_max.x, centroid.x), Maths::max(centroids_max.y, centroid.y), Maths::max(centroids_max.z, centroid.z) };
+		}
+		const Vector3 centroids_size = centroids_max - centroids_min;
+		const int axis = centroids_size.x >= centroids_size.y && centroids_size.x >= centroids_size.z ? 0 : (centroids_size.y >= centroids_size.z ? 1 : 2);
+		const float axis_min = get_axis(centroids_min, axis);
+		const float axis_size = get_axis(centroids_size, axis);
+		if (axis_size <= 0.0f) continue; //  all the centroids are at the same place, it can't be split
+
+		//  binned surface area heuristic
+		Bin bins[BINS_COUNT];
+		const float bins_scale = BINS_COUNT / axis_size;
+		auto get_bin = [&](uint32_t triangle)
+		{
+			const int bin = static_cast<int>((get_axis(centroids[triangle], axis) - axis_min) * bins_scale);
+			return bin < 0 ? 0 : (bin >= BINS_COUNT ? BINS_COUNT - 1 : bin);
+		};
+
+		for (uint32_t i = first; i < first + count; i++)
+		{
+			const uint32_t triangle = trianglesOrder[i];
+			Bin& bin = bins[get_bin(triangle)];
+			bin.count++;
+			bin.min = Vector3{ Maths::min(bin.min.x, triangles_min[triangle].x), Maths::min(bin.min.y, triangles_min[triangle].y), Maths::min(bin.min.z, triangles_min[triangle].z) };
+			bin.max = Vector3{ Maths::max(bin.max.x, triangles_max[triangle].x), Maths::max(bin.max.y, triangles_max[triangle].y), Maths::max(bin.max.z, triangles_max[triangle].z) };
+		}
+
+		//  sweep the bins from the left and from the right to get the cost of every split plane
+		float left_costs[BINS_COUNT - 1];
+		Bin left_bounds;
+		int left_count = 0;
+		for (int i = 0; i < BINS_COUNT - 1; i++)
+		{
+			left_count += bins[i].count;
+			if (bins[i].count > 0)
+			{
+				left_bounds.min = Vector3{ Maths::min(left_bounds.min.x, bins[i].min.x), Maths::min(left_bounds.min.y, bins[i].min.y), Maths::min(left_bounds.min.z, bins[i].min.z) };
+				left_bounds.max = Vector3{ Maths::max(left_bounds.max.x, bins[i].max.x), Maths::max(left_bounds.max.y, bins[i].max.y), Maths::max(left_bounds.max.z, bins[i].max.z) };
+			}
+			left_costs[i] = left_count > 0 ? left_count * surface_area(left_bounds.min, left_bounds.max) : 0.0f;
+		}
+
+		int best_split = -1;
+		float best_cost = std::numeric_limits<float>::max();
+		Bin right_bounds;
+		int right_count = 0;
+		for (int i = BINS_COUNT - 1; i > 0; i--)
+		{
+			right_count += bins[i].count;
+			if (bins[i].count > 0)
+			{
+				right_bounds.min = Vector3{ Maths::min(right_bounds.min.x, bins[i].min.x), Maths::min(right_bounds.min.y, bins[i].min.y), Maths::min(right_bounds.min.z, bins[i].min.z) };
+				right_bounds.max = Vector3{ Maths::max(right_bounds.max.x, bins[i].max.x), Maths::max(right_bounds.max.y, bins[i].max.y), Maths::max(right_bounds.max.z, bins[i].max.z) };
+			}
+			if (right_count == 0 || right_count == static_cast<int>(count)) continue;
+
+			const float cost = left_costs[i - 1] + right_count * surface_area(right_bounds.min, right_bounds.max);
+			if (cost < best_cost)
+			{
+				best_cost = cost;
+				best_split = i;
+			}
+		}
+
+		const TriangleMeshBVHNode& parent = nodes[entry.node];
+		const float leaf_cost = count * surface_area(parent.boundsMin, parent.boundsMax);
+		if (best_split < 0 || (best_cost >= leaf_cost && count <= MAX_LEAF_TRIANGLES * 4)) continue;
+
+		//  partition the triangles of the node around the split plane
+		uint32_t* order_first = &trianglesOrder[first];
+		uint32_t* order_middle = std::partition(order_first, order_first + count, [&](uint32_t triangle) { return get_bin(triangle) < best_split; });
+		const uint32_t left_triangles = static_cast<uint32_t>(order_middle - order_first);
+
+		const uint32_t left_child = static_cast<uint32_t>(nodes.size());
+		nodes.emplace_back();
+		nodes.emplace_back();
+
+		nodes[left_child].leftOrFirst = first;
+		nodes[left_child].trianglesCount = left_triangles;
+		nodes[left_child + 1].leftOrFirst = first + left_triangles;
+		nodes[left_child + 1].trianglesCount = count - left_triangles;
+		updateNodeBounds(nodes[left_child], triangles_min, triangles_max);
+		updateNodeBounds(nodes[left_child + 1], triangles_min, triangles_max);
+
+		nodes[entry.node].leftOrFirst = left_child;
+		nodes[entry.node].trianglesCount = 0;
+
+		build_stack.push_back(BuildEntry{ left_child, entry.depth + 1 });
+		build_stack.push_back(BuildEntry{ left_child + 1, entry.depth + 1 });
+	}
+
+	//  store the triangles in the order of the leaves
+	std::vector<Vector3> ordered_vertices(trianglesVertices.size());
+	for (int i = 0; i < triangles_count; i++)
+	{
+		const Vector3* triangle = getTriangle(trianglesOrder[i]);
+		ordered_vertices[i * 3] = triangle[0];
+		ordered_vertices[i * 3 + 1] = triangle[1];
+		ordered_vertices[i * 3 + 2] = triangle[2];
+	}
+	trianglesVertices.swap(ordered_vertices);
+
+	nodes.shrink_to_fit();
+	trianglesOrder.clear();
+	trianglesOrder.shrink_to_fit();
+}
+
+Box TriangleMeshBVH::getBounds() const
+{
+	if (nodes.empty()) return Box::zero;
+
+	Box bounds;
+	bounds.setupWithMinAndMaxPoints(nodes[0].boundsMin, nodes[0].boundsMax);
+	return bounds;
+}
+
+
+Vector3 TriangleMeshBVH::ClosestPointOnTriangle(const Vector3& point, const Vector3& a, const Vector3& b, const Vector3& c)
+{
+	//  voronoi regions of the triangle (Real-Time Collision Detection, 5.1.5)
+	const Vector3 ab = b - a;
+	const Vector3 ac = c - a;
+	const Vector3 ap = point - a;
+	const float d1 = Vector3::dot(ab, ap);
+	const float d2 = Vector3::dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+	const Vector3 bp = point - b;
+	const float d3 = Vector3::dot(ab, bp);
+	const float d4 = Vector3::dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3) return b;
+
+	const float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+
+	const Vector3 cp = point - c;
+	const float d5 = Vector3::dot(ab, cp);
+	const float d6 = Vector3::dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6) return c;
+
+	const float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+
+	const float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+	const float denom = 1.0f / (va + vb + vc);
+	return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+bool TriangleMeshBVH::SegmentTriangleIntersection(const Vector3& start, const Vector3& segment, const Vector3& a, const Vector3& b, const Vector3& c, float& outFraction)
+{
+	//  Moller-Trumbore, with the segment as the ray direction so that the result is a fraction of it
+	const Vector3 edge_ab = b - a;
+	const Vector3 edge_ac = c - a;
+	const Vector3 p = Vector3::cross(segment, edge_ac);
+	const float determinant = Vector3::dot(edge_ab, p);
+	if (determinant == 0.0f) return false; //  segment parallel to the triangle
+
+	const float inv_determinant = 1.0f / determinant;
+	const Vector3 to_start = start - a;
+	const float u = Vector3::dot(to_start, p) * inv_determinant;
+	if (u < 0.0f || u > 1.0f) return false;
+
+	const Vector3 q = Vector3::cross(to_start, edge_ab);
+	const float v = Vector3::dot(segment, q) * inv_determinant;
+	if (v < 0.0f || u + v > 1.0f) return false;
+
+	const float fraction = Vector3::dot(edge_ac, q) * inv_determinant;
+	if (fraction < 0.0f || fraction > 1.0f) return false;
+
+	outFraction = fraction;
+	return true;
+}
+
+
+bool TriangleMeshBVH::segmentEntersNode(const TriangleMeshBVHNode& node, const Vector3& start, const Vector3& invSegment, const Vector3& segment, const Vector3& halfExtents, float& outEnter) const
+{
+	const float starts[3] = { start.x, start.y, start.z };
+	const float segments[3] = { segment.x, segment.y, segment.z };
+	const float inv_segments[3] = { invSegment.x, invSegment.y, invSegment.z };
+	const float mins[3] = { node.boundsMin.x - halfExtents.x, node.boundsMin.y - halfExtents.y, node.boundsMin.z - halfExtents.z };
+	const float maxs[3] = { node.boundsMax.x + halfExtents.x, node.boundsMax.y + halfExtents.y, node.boundsMax.z + halfExtents.z };
+
+	float enter = 0.0f;
+	float exit = 1.0f;
+	for (int i = 0; i < 3; i++)
+	{
+		if (segments[i] == 0.0f)
+		{
+			if (starts[i] < mins[i] || starts[i] > maxs[i]) return false;
+			continue;
+		}
+
+		float t1 = (mins[i] - starts[i]) * inv_segments[i];
+		float t2 = (maxs[i] - starts[i]) * inv_segments[i];
+		if (t1 > t2) std::swap(t1, t2);
+
+		enter = Maths::max(enter, t1);
+		exit = Maths::min(exit, t2);
+		if (enter > exit) return false;
+	}
+
+	outEnter = enter;
+	return true;
+}
+
+float TriangleMeshBVH::NodeDistanceSq(const TriangleMeshBVHNode& node, const Vector3& point)
+{
+	const Vector3 closest
+	{
+		Maths::clamp(point.x, node.boundsMin.x, node.boundsMax.x),
+		Maths::clamp(point.y, node.boundsMin.y, node.boundsMax.y),
+		Maths::clamp(point.z, node.boundsMin.z, node.boundsMax.z)
+	};
+	return (closest - point).lengthSq();
+}
+
+void TriangleMeshBVH::updateNodeBounds(TriangleMeshBVHNode& node, const std::vector<Vector3>& trianglesMin, const std::vector<Vector3>& trianglesMax) const
+{
+	Vector3 bounds_min = Vector3::infinity;
+	Vector3 bounds_max = Vector3::negInfinity;
+	for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.trianglesCount; i++)
+	{
+		const uint32_t triangle = trianglesOrder[i];
+		bounds_min = Vector3{ Maths::min(bounds_min.x, trianglesMin[triangle].x), Maths::min(bounds_min.y, trianglesMin[triangle].y), Maths::min(bounds_min.z, trianglesMin[triangle].z) };
+		bounds_max = Vector3{ Maths::max(bounds_max.x, trianglesMax[triangle].x), Maths::max(bounds_max.y, trianglesMax[triangle].y), Maths::max(bounds_max.z, trianglesMax[triangle].z) };
+	}
+
+	node.boundsMin = bounds_min;
+	node.boundsMax = bounds_max;
+}
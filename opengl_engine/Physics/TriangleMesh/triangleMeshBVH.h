@@ -0,0 +1,245 @@
+#pragma once
+#include <Maths/Geometry/box.h>
+#include <Maths/vector3.h>
+#include <Rendering/Model/vertexArray.h>
+
+#include <cstdint>
+#include <vector>
+
+
+/** Triangle Mesh BVH Node
+* Node of the packed bounding volume hierarchy, 32 bytes so that two siblings share a cache line.
+* The two children of an inner node are always stored next to each other, only the first one is indexed.
+*/
+struct TriangleMeshBVHNode
+{
+	Vector3 boundsMin{ Vector3::zero };
+	uint32_t leftOrFirst{ 0 }; //  index of the left child for inner nodes, index of the first triangle for leaves
+	Vector3 boundsMax{ Vector3::zero };
+	uint32_t trianglesCount{ 0 }; //  0 for inner nodes
+
+	inline bool isLeaf() const { return trianglesCount > 0; }
+};
+
+
+/** Triangle Mesh BVH
+* Triangles of a mesh (in mesh space) and their bounding volume hierarchy, shared by every triangle mesh collision that uses this mesh.
+* The hierarchy is built once with a binned surface area heuristic and stored in a single array, the triangles are reordered
+* so that the triangles of a leaf are contiguous. Queries are visitors that receive the triangles of the leaves they reach.
+*/
+class TriangleMeshBVH
+{
+public:
+	TriangleMeshBVH() {}
+	TriangleMeshBVH(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+	/**
+	* Add the triangles of a mesh, the hierarchy must be built again once every mesh has been added.
+	* @param	vertices	Vertices of the mesh.
+	* @param	indices		Indices of the triangles, the vertices are taken three by three if there are none.
+	*/
+	void addMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices);
+	void addMesh(const std::vector<Vector3>& positions, const std::vector<unsigned int>& indices);
+
+	void build();
+
+	inline bool isBuilt() const { return !nodes.empty(); }
+	inline int getTrianglesCount() const { return static_cast<int>(trianglesVertices.size() / 3); }
+	inline int getNodesCount() const { return static_cast<int>(nodes.size()); }
+	Box getBounds() const;
+
+	//  the three vertices of a triangle (mesh space)
+	inline const Vector3* getTriangle(int index) const { return &trianglesVertices[index * 3]; }
+
+	/**
+	* Visit the triangles of the leaves that overlap a box.
+	* @param	boxMin		Min point of the box (mesh space).
+	* @param	boxMax		Max point of the box (mesh space).
+	* @param	visitor		Called with the index of each triangle, must return false to stop the query.
+	*/
+	template<typename TriangleVisitor>
+	void visitBox(const Vector3& boxMin, const Vector3& boxMax, TriangleVisitor visitor) const;
+
+	/**
+	* Visit the triangles of the leaves crossed by a segment inflated by half extents, the nearest leaves first.
+	* @param	start			Start of the segment (mesh space).
+	* @param	segment			Segment from its start to its end (mesh space).
+	* @param	halfExtents		Half extents of the box that is swept along the segment (zero for a line).
+	* @param	maxFraction		Fraction of the segment after which the leaves are ignored.
+	* @param	visitor			Called with the index of each triangle and the max fraction, which it can lower once it found a hit.
+	*/
+	template<typename TriangleVisitor>
+	void visitSegment(const Vector3& start, const Vector3& segment, const Vector3& halfExtents, float maxFraction, TriangleVisitor visitor) const;
+
+	/**
+	* Visit the triangles of the leaves that are closer to a point than a distance, the nearest leaves first.
+	* @param	point			Point to search around (mesh space).
+	* @param	maxDistanceSq	Squared distance after which the leaves are ignored.
+	* @param	visitor			Called with the index of each triangle and the max squared distance, which it can lower once it found a closer triangle.
+	*/
+	template<typename TriangleVisitor>
+	void visitNearest(const Vector3& point, float maxDistanceSq, TriangleVisitor visitor) const;
+
+	/**
+	* Closest point of a triangle to a point.
+	*/
+	static Vector3 ClosestPointOnTriangle(const Vector3& point, const Vector3& a, const Vector3& b, const Vector3& c);
+
+	/**
+	* Intersection of a segment with a triangle (both faces).
+	* @param	start		Start of the segment.
+	* @param	segment		Segment from its start to its end.
+	* @param	outFraction	Fraction of the segment at the intersection. [OUT]
+	* @return				Does the segment cross the triangle?
+	*/
+	static bool SegmentTriangleIntersection(const Vector3& start, const Vector3& segment, const Vector3& a, const Vector3& b, const Vector3& c, float& outFraction);
+
+private:
+	//  entry fraction of a segment into a node inflated by half extents, false if the segment misses it
+	bool segmentEntersNode(const TriangleMeshBVHNode& node, const Vector3& start, const Vector3& invSegment, const Vector3& segment, const Vector3& halfExtents, float& outEnter) const;
+	static float NodeDistanceSq(const TriangleMeshBVHNode& node, const Vector3& point);
+
+	void updateNodeBounds(TriangleMeshBVHNode& node, const std::vector<Vector3>& trianglesMin, const std::vector<Vector3>& trianglesMax) const;
+
+	std::vector<TriangleMeshBVHNode> nodes;
+	std::vector<Vector3> trianglesVertices; //  three vertices per triangle, in the order of the leaves once built
+	std::vector<uint32_t> trianglesOrder; //  scratch order of the triangles during the build
+
+	static const int MAX_LEAF_TRIANGLES{ 4 };
+	static const int MAX_DEPTH{ 48 };
+	static const int BINS_COUNT{ 12 };
+};
+
+
+
+template<typename TriangleVisitor>
+void TriangleMeshBVH::visitBox(const Vector3& boxMin, const Vector3& boxMax, TriangleVisitor visitor) const
+{
+	if (nodes.empty()) return;
+
+	uint32_t stack[MAX_DEPTH + 2];
+	int stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0)
+	{
+		const TriangleMeshBVHNode& node = nodes[stack[--stack_size]];
+		if (boxMin.x > node.boundsMax.x || boxMax.x < node.boundsMin.x ||
+			boxMin.y > node.boundsMax.y || boxMax.y < node.boundsMin.y ||
+			boxMin.z > node.boundsMax.z || boxMax.z < node.boundsMin.z) continue;
+
+		if (node.isLeaf())
+		{
+			for (uint32_t i = 0; i < node.trianglesCount; i++)
+			{
+				if (!visitor(static_cast<int>(node.leftOrFirst + i))) return;
+			}
+			continue;
+		}
+
+		stack[stack_size++] = node.leftOrFirst + 1;
+		stack[stack_size++] = node.leftOrFirst;
+	}
+}
+
+template<typename TriangleVisitor>
+void TriangleMeshBVH::visitSegment(const Vector3& start, const Vector3& segment, const Vector3& halfExtents, float maxFraction, TriangleVisitor visitor) const
+{
+	if (nodes.empty()) return;
+
+	const Vector3 inv_segment
+	{
+		segment.x != 0.0f ? 1.0f / segment.x : 0.0f,
+		segment.y != 0.0f ? 1.0f / segment.y : 0.0f,
+		segment.z != 0.0f ? 1.0f / segment.z : 0.0f
+	};
+
+	struct StackEntry
+	{
+		uint32_t node;
+		float enter;
+	};
+	StackEntry stack[MAX_DEPTH + 2];
+	int stack_size = 0;
+
+	float root_enter = 0.0f;
+	if (!segmentEntersNode(nodes[0], start, inv_segment, segment, halfExtents, root_enter)) return;
+	stack[stack_size++] = StackEntry{ 0, root_enter };
+
+	while (stack_size > 0)
+	{
+		const StackEntry entry = stack[--stack_size];
+		if (entry.enter > maxFraction) continue; //  a closer hit has been found since this node was pushed
+
+		const TriangleMeshBVHNode& node = nodes[entry.node];
+		if (node.isLeaf())
+		{
+			for (uint32_t i = 0; i < node.trianglesCount; i++)
+			{
+				visitor(static_cast<int>(node.leftOrFirst + i), maxFraction);
+			}
+			continue;
+		}
+
+		//  the nearest child is pushed last to be visited first
+		float enter_left = 0.0f;
+		float enter_right = 0.0f;
+		const bool hit_left = segmentEntersNode(nodes[node.leftOrFirst], start, inv_segment, segment, halfExtents, enter_left) && enter_left <= maxFraction;
+		const bool hit_right = segmentEntersNode(nodes[node.leftOrFirst + 1], start, inv_segment, segment, halfExtents, enter_right) && enter_right <= maxFraction;
+
+		if (hit_left && hit_right)
+		{
+			const bool left_first = enter_left <= enter_right;
+			stack[stack_size++] = left_first ? StackEntry{ node.leftOrFirst + 1, enter_right } : StackEntry{ node.leftOrFirst, enter_left };
+			stack[stack_size++] = left_first ? StackEntry{ node.leftOrFirst, enter_left } : StackEntry{ node.leftOrFirst + 1, enter_right };
+		}
+		else if (hit_left)
+		{
+			stack[stack_size++] = StackEntry{ node.leftOrFirst, enter_left };
+		}
+		else if (hit_right)
+		{
+			stack[stack_size++] = StackEntry{ node.leftOrFirst + 1, enter_right };
+		}
+	}
+}
+
+template<typename TriangleVisitor>
+void TriangleMeshBVH::visitNearest(const Vector3& point, float maxDistanceSq, TriangleVisitor visitor) const
+{
+	if (nodes.empty()) return;
+
+	struct StackEntry
+	{
+		uint32_t node;
+		float distanceSq;
+	};
+	StackEntry stack[MAX_DEPTH + 2];
+	int stack_size = 0;
+
+	const float root_distance_sq = NodeDistanceSq(nodes[0], point);
+	if (root_distance_sq > maxDistanceSq) return;
+	stack[stack_size++] = StackEntry{ 0, root_distance_sq };
+
+	while (stack_size > 0)
+	{
+		const StackEntry entry = stack[--stack_size];
+		if (entry.distanceSq > maxDistanceSq) continue;
+
+		const TriangleMeshBVHNode& node = nodes[entry.node];
+		if (node.isLeaf())
+		{
+			for (uint32_t i = 0; i < node.trianglesCount; i++)
+			{
+				visitor(static_cast<int>(node.leftOrFirst + i), maxDistanceSq);
+			}
+			continue;
+		}
+
+		const float distance_left = NodeDistanceSq(nodes[node.leftOrFirst], point);
+		const float distance_right = NodeDistanceSq(nodes[node.leftOrFirst + 1], point);
+		const bool left_first = distance_left <= distance_right;
+		stack[stack_size++] = left_first ? StackEntry{ node.leftOrFirst + 1, distance_right } : StackEntry{ node.leftOrFirst, distance_left };
+		stack[stack_size++] = left_first ? StackEntry{ node.leftOrFirst, distance_left } : StackEntry{ node.leftOrFirst + 1, distance_right };
+	}
+}
@@ -0,0 +1,157 @@
+#include "triangleMeshColComp.h"
+#include "triangleMeshBVH.h"
+#include "collisionsTriangleMesh.h"
+
+#include <ServiceLocator/locator.h>
+
+#include <Assets/assetManager.h>
+#include <Rendering/material.h>
+#include <Maths/Maths.h>
+
+
+Vector3 TriangleMeshTransform::toLocal(const Vector3& point) const
+{
+	const Vector3 offset = point - position;
+	return Vector3{ Vector3::dot(offset, axes[0]), Vector3::dot(offset, axes[1]), Vector3::dot(offset, axes[2]) } * invScale;
+}
+
+Vector3 TriangleMeshTransform::toWorld(const Vector3& localPoint) const
+{
+	const Vector3 scaled_point = localPoint * scale;
+	return position + axes[0] * scaled_point.x + axes[1] * scaled_point.y + axes[2] * scaled_point.z;
+}
+
+Vector3 TriangleMeshTransform::toLocalHalfExtents(const Vector3& worldHalfExtents) const
+{
+	return Vector3
+	{
+		Vector3::dot(Vector3::abs(axes[0]), worldHalfExtents),
+		Vector3::dot(Vector3::abs(axes[1]), worldHalfExtents),
+		Vector3::dot(Vector3::abs(axes[2]), worldHalfExtents)
+	} * Vector3::abs(invScale);
+}
+
+Box TriangleMeshTransform::toWorldBox(const Box& localBox) const
+{
+	const Vector3 half_extents = Vector3::abs(localBox.getHalfExtents() * scale);
+	const Vector3 extents = Vector3::abs(axes[0]) * half_extents.x + Vector3::abs(axes[1]) * half_extents.y + Vector3::abs(axes[2]) * half_extents.z;
+	return Box{ toWorld(localBox.getCenterPoint()), extents };
+}
+
+float TriangleMeshTransform::getMinScale() const
+{
+	return Maths::min(Maths::abs(scale.x), Maths::min(Maths::abs(scale.y), Maths::abs(scale.z)));
+}
+
+
+
+TriangleMeshColComp::TriangleMeshColComp() :
+	CollisionComponent(CollisionShape::TriangleMesh, CollisionType::Solid, nullptr, &AssetManager::GetSingleMesh("debug_cube"), false, "")
+{
+}
+
+TriangleMeshColComp::TriangleMeshColComp(const TriangleMeshBVH& triangleMesh_, Object* objectToAssociate, bool loadPersistent, std::string collisionChannel, CollisionType collisionType) :
+	triangleMesh(&triangleMesh_),
+	CollisionComponent(CollisionShape::TriangleMesh, collisionType, objectToAssociate, &AssetManager::GetSingleMesh("debug_cube"), loadPersistent, collisionChannel)
+{
+	if (!triangleMesh->isBuilt())
+	{
+		Locator::getLog().LogMessage_Category("Triangle Mesh Collision: Created a collision with a triangle mesh that has no triangles or isn't built.", LogCategory::Warning);
+	}
+}
+
+
+bool TriangleMeshColComp::resolvePointIntersection(const Vector3& point) const
+{
+	return CollisionsTriangleMesh::IntersectPoint(*this, point);
+}
+
+bool TriangleMeshColComp::resolveLineRaycastIntersection(const Ray& raycast, RaycastHitInfos& outHitInfos) const
+{
+	return CollisionsTriangleMesh::IntersectLineRaycast(*this, raycast, outHitInfos);
+}
+
+bool TriangleMeshColComp::resolveAABBRaycastIntersection(const Box& raycast) const
+{
+	return CollisionsTriangleMesh::IntersectAABBRaycast(*this, raycast);
+}
+
+bool TriangleMeshColComp::resolveAABBSweepRaycastIntersection(const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, bool forCollisionTest) const
+{
+	return CollisionsTriangleMesh::IntersectAABBSweepRaycast(*this, raycast, boxRaycast, outHitInfos, forCollisionTest);
+}
+
+
+
+void TriangleMeshColComp::drawDebugMesh(DebugDrawList& outDrawList, const Color& drawColor) const
+{
+	outDrawList.addMesh(debugMesh, getModelMatrix(), drawColor, true);
+}
+
+const Matrix4 TriangleMeshColComp::getModelMatrix() const
+{
+	const Box bounds = getEncapsulatingBox();
+	Matrix4 matrix =
+		Matrix4::createScale(bounds.getHalfExtents() * 2.0f) *
+		Matrix4::createTranslation(bounds.getCenterPoint());
+	return matrix;
+}
+
+Vector3 TriangleMeshColComp::getCenterDownPos() const
+{
+	const Box bounds = getEncapsulatingBox();
+	return bounds.getCenterPoint() + Vector3{ 0.0f, -bounds.getHalfExtents().y, 0.0f };
+}
+
+Box TriangleMeshColComp::getEncapsulatingBox() const
+{
+	updateCache();
+	return cachedBounds;
+}
+
+Vector3 TriangleMeshColComp::getClosestPoint(const Vector3& point) const
+{
+	return CollisionsTriangleMesh::ClosestPoint(*this, point);
+}
+
+TriangleMeshTransform TriangleMeshColComp::getMeshTransform() const
+{
+	updateCache();
+	return cachedTransform;
+}
+
+
+void TriangleMeshColComp::invalidateBounds()
+{
+	cachedValid = false;
+}
+
+void TriangleMeshColComp::updateCache() const
+{
+	if (cachedValid)
+	{
+		//  static collisions never move once baked in the physics, no need to check their transform
+		if ((isStatic() && bakedInBroadphase) || cachedTransformVersion == associatedObject->getTransformVersion()) return;
+	}
+
+	const Quaternion rotation = associatedObject->getRotation();
+	const Vector3 scale = associatedObject->getScale();
+
+	TriangleMeshTransform transform;
+	transform.position = associatedObject->getPosition();
+	transform.axes[0] = Vector3::normalize(Vector3::transform(Vector3::unitX, rotation));
+	transform.axes[1] = Vector3::normalize(Vector3::transform(Vector3::unitY, rotation));
+	transform.axes[2] = Vector3::normalize(Vector3::transform(Vector3::unitZ, rotation));
+	transform.scale = scale;
+	transform.invScale = Vector3
+	{
+		scale.x != 0.0f ? 1.0f / scale.x : 0.0f,
+		scale.y != 0.0f ? 1.0f / scale.y : 0.0f,
+		scale.z != 0.0f ? 1.0f / scale.z : 0.0f
+	};
+
+	cachedTransform = transform;
+	cachedBounds = triangleMesh ? transform.toWorldBox(triangleMesh->getBounds()) : Box{ transform.position, Vector3::zero };
+	cachedTransformVersion = associatedObject->getTransformVersion();
+	cachedValid = true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <Physics/collisionComponent.h>
+#include <Maths/Geometry/box.h>
+
+class TriangleMeshBVH;
+
+
+/** Triangle Mesh Transform
+* Position, rotation and scale of a triangle mesh collision, to go from the mesh space to the world and back.
+*/
+struct TriangleMeshTransform
+{
+	Vector3 position{ Vector3::zero };
+	Vector3 axes[3]{ Vector3::unitX, Vector3::unitY, Vector3::unitZ }; //  rotated axes, normalized
+	Vector3 scale{ Vector3::one };
+	Vector3 invScale{ Vector3::one };
+
+	Vector3 toLocal(const Vector3& point) const;
+	Vector3 toWorld(const Vector3& localPoint) const;
+
+	//  half extents of the mesh space box that contains a world box (exact if the mesh isn't rotated)
+	Vector3 toLocalHalfExtents(const Vector3& worldHalfExtents) const;
+
+	//  world box that contains a mesh space box
+	Box toWorldBox(const Box& localBox) const;
+
+	float getMinScale() const;
+};
+
+
+/** Triangle Mesh Collision Component
+* Class for collision components of type Triangle Mesh
+* The triangles come from a triangle mesh BVH (usually loaded by the asset manager and shared by all the collisions of a mesh),
+* and are placed in the world with the position, rotation and scale of the associated object.
+* The triangles have no inside: a triangle mesh collision is a surface, the queries hit both faces of its triangles.
+* It can't be used by a rigidbody (rigidbodies move as box AABB).
+*/
+class TriangleMeshColComp : public CollisionComponent
+{
+public:
+	TriangleMeshColComp();
+	TriangleMeshColComp(const TriangleMeshBVH& triangleMesh, Object* objectToAssociate, bool loadPersistent, std::string collisionChannel, CollisionType collisionType = CollisionType::Solid);
+
+	inline const TriangleMeshBVH* getTriangleMesh() const { return triangleMesh; }
+
+	const Matrix4 getModelMatrix() const override;
+
+	Vector3 getCenterDownPos() const override;
+	Box getEncapsulatingBox() const override;
+	Vector3 getClosestPoint(const Vector3& point) const override;
+
+	TriangleMeshTransform getMeshTransform() const;
+
+protected:
+	bool resolvePointIntersection(const Vector3& point) const override;
+	bool resolveLineRaycastIntersection(const Ray& raycast, RaycastHitInfos& outHitInfos) const override;
+	bool resolveAABBRaycastIntersection(const Box& raycast) const override;
+	bool resolveAABBSweepRaycastIntersection(const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, bool forCollisionTest) const override;
+
+	//  draws the encapsulating box, drawing every triangle would be too slow for big meshes
+	void drawDebugMesh(DebugDrawList& outDrawList, const Color& drawColor) const override;
+
+	void invalidateBounds() override;
+
+private:
+	void updateCache() const;
+
+	const TriangleMeshBVH* triangleMesh{ nullptr };
+
+	//  world transform and bounds cache, computed again only when the associated transform version changes (never for static collisions)
+	mutable TriangleMeshTransform cachedTransform;
+	mutable Box cachedBounds{ Box::zero };
+	mutable unsigned int cachedTransformVersion{ 0 };
+	mutable bool cachedValid{ false };
+};
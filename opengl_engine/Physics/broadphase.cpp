@@ -0,0 +1,369 @@
+#include "broadphase.h"
+#include "collisionComponent.h"
+#include "rigidbodyComponent.h"
+#include <Maths/Geometry/ray.h>
+#include <Maths/Maths.h>
+#include <algorithm>
+
+
+void Broadphase::rebuild(const std::vector<CollisionComponent*>& collisions, const std::vector<RigidbodyComponent*>& rigidbodies)
+{
+	dynamicProxies.clear();
+	dynamicProxies.reserve(collisions.size() + rigidbodies.size());
+
+	for (auto col : collisions)
+	{
+		if (col->isStatic())
+		{
+			if (col->bakedInBroadphase) continue;
+
+			staticProxies.push_back(BroadphaseProxy{ col->getEncapsulatingBox(), col });
+			col->bakedInBroadphase = true;
+			staticGridDirty = true;
+			continue;
+		}
+
+		dynamicProxies.push_back(BroadphaseProxy{ col->getEncapsulatingBox(), col });
+	}
+	for (auto body : rigidbodies)
+	{
+		if (!body->isAssociatedCollisionValid()) continue;
+
+		const CollisionComponent& col = body->getAssociatedCollision();
+		dynamicProxies.push_back(BroadphaseProxy{ col.getEncapsulatingBox(), &col });
+	}
+
+	//  static collisions are usually all created with the scene, so the grid is built once at the first step of the scene
+	if (staticGridDirty && useStaticGrid)
+	{
+		staticGrid.build(staticProxies);
+		staticGridDirty = false;
+	}
+}
+
+void Broadphase::removeCollision(CollisionComponent* collision)
+{
+	std::vector<BroadphaseProxy>& proxies = collision->bakedInBroadphase ? staticProxies : dynamicProxies;
+
+	//  the grid stores the static proxies indices, the queries test all the static proxies until it is built again
+	if (collision->bakedInBroadphase)
+	{
+		staticGrid.clear();
+		staticGridDirty = true;
+	}
+
+	auto iter = std::find_if(proxies.begin(), proxies.end(), [collision](const BroadphaseProxy& proxy) { return proxy.collision == collision; });
+	if (iter != proxies.end())
+	{
+		std::iter_swap(iter, proxies.end() - 1);
+		proxies.pop_back();
+	}
+
+	collision->bakedInBroadphase = false;
+}
+
+void Broadphase::clear(const std::vector<CollisionComponent*>& collisions)
+{
+	staticProxies.clear();
+	dynamicProxies.clear();
+	staticGrid.clear();
+	staticGridDirty = false;
+
+	for (auto col : collisions)
+	{
+		col->bakedInBroadphase = false;
+	}
+}
+
+
+bool Broadphase::sweepAABB(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos, bool forCollisionTest, const CollisionComponent* ignoredCollision) const
+{
+	outHitInfos = RaycastHitInfos();
+
+	Ray ray;
+	ray.setupWithStartEnd(start, end);
+	Box box = aabbBox;
+	box.setCenterPoint(start);
+
+	//  bounds of the whole sweep, used to cull the proxies
+	const Vector3 half_extents = aabbBox.getHalfExtents();
+	const Vector3 sweep_min = Vector3{ Maths::min(start.x, end.x), Maths::min(start.y, end.y), Maths::min(start.z, end.z) } - half_extents;
+	const Vector3 sweep_max = Vector3{ Maths::max(start.x, end.x), Maths::max(start.y, end.y), Maths::max(start.z, end.z) } + half_extents;
+
+	bool static_hit = staticGrid.isBuilt() ?
+		sweepStaticGrid(ray, box, sweep_min, sweep_max, testChannels, outHitInfos, forCollisionTest, ignoredCollision) :
+		sweepProxies(staticProxies, ray, box, sweep_min, sweep_max, testChannels, outHitInfos, forCollisionTest, ignoredCollision);
+	bool dynamic_hit = sweepProxies(dynamicProxies, ray, box, sweep_min, sweep_max, testChannels, outHitInfos, forCollisionTest, ignoredCollision);
+
+	return static_hit || dynamic_hit;
+}
+
+bool Broadphase::overlapAABB(const Box& aabbBox, const std::vector<std::string>& testChannels, const CollisionComponent* ignoredCollision) const
+{
+	const Vector3 box_min = aabbBox.getMinPoint();
+	const Vector3 box_max = aabbBox.getMaxPoint();
+
+	bool static_hit = staticGrid.isBuilt() ?
+		overlapStaticGrid(aabbBox, box_min, box_max, testChannels, ignoredCollision) :
+		overlapProxies(staticProxies, aabbBox, box_min, box_max, testChannels, ignoredCollision);
+	if (static_hit) return true;
+	return overlapProxies(dynamicProxies, aabbBox, box_min, box_max, testChannels, ignoredCollision);
+}
+
+void Broadphase::overlapTriggers(const Box& aabbBox, const std::vector<std::string>& testChannels, std::vector<const CollisionComponent*>& outTriggers, const CollisionComponent* ignoredCollision) const
+{
+	const Vector3 box_min = aabbBox.getMinPoint();
+	const Vector3 box_max = aabbBox.getMaxPoint();
+
+	if (staticGrid.isBuilt())
+	{
+		//  the static triggers are not in the grid cells
+		for (int index : staticGrid.getTriggersIndices())
+		{
+			const BroadphaseProxy& proxy = staticProxies[index];
+			if (proxy.collision == ignoredCollision) continue;
+			if (!BoundsOverlap(box_min, box_max, proxy.boundsMin, proxy.boundsMax)) continue;
+
+			if (proxy.collision->resolveAABBRaycast(aabbBox, testChannels)) outTriggers.push_back(proxy.collision);
+		}
+	}
+	else
+	{
+		overlapTriggerProxies(staticProxies, aabbBox, box_min, box_max, testChannels, outTriggers, ignoredCollision);
+	}
+	overlapTriggerProxies(dynamicProxies, aabbBox, box_min, box_max, testChannels, outTriggers, ignoredCollision);
+}
+
+bool Broadphase::lineRaycastStatic(const Ray& ray, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos) const
+{
+	bool hit = false;
+
+	if (!staticGrid.isBuilt())
+	{
+		for (auto& proxy : staticProxies)
+		{
+			bool col_hit = proxy.collision->resolveLineRaycast(ray, outHitInfos, testChannels);
+			hit = hit || col_hit;
+		}
+		return hit;
+	}
+
+	for (int index : staticGrid.getTriggersIndices())
+	{
+		bool col_hit = staticProxies[index].collision->resolveLineRaycast(ray, outHitInfos, testChannels);
+		hit = hit || col_hit;
+	}
+	for (int index : staticGrid.getOversizedIndices())
+	{
+		bool col_hit = staticProxies[index].collision->resolveLineRaycast(ray, outHitInfos, testChannels);
+		hit = hit || col_hit;
+	}
+
+	staticGrid.walkSegment(ray.getStart(), ray.getEnd(), Vector3::zero, [&](const int* indices, int count, float enterDistance)
+	{
+		//  nothing further can be closer than the current hit (hits behind the start are all found in the first cells)
+		if (enterDistance > 0.0f && enterDistance > outHitInfos.hitDistance) return false;
+
+		for (int i = 0; i < count; i++)
+		{
+			bool col_hit = staticProxies[indices[i]].collision->resolveLineRaycast(ray, outHitInfos, testChannels);
+			hit = hit || col_hit;
+		}
+		return true;
+	});
+
+	return hit;
+}
+
+bool Broadphase::aabbSweepRaycastStatic(const Ray& ray, const Box& box, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos, bool forCollisionTest) const
+{
+	const Vector3 start = ray.getStart();
+	const Vector3 end = ray.getEnd();
+	const Vector3 half_extents = box.getHalfExtents();
+	const Vector3 sweep_min = Vector3{ Maths::min(start.x, end.x), Maths::min(start.y, end.y), Maths::min(start.z, end.z) } - half_extents;
+	const Vector3 sweep_max = Vector3{ Maths::max(start.x, end.x), Maths::max(start.y, end.y), Maths::max(start.z, end.z) } + half_extents;
+
+	return staticGrid.isBuilt() ?
+		sweepStaticGrid(ray, box, sweep_min, sweep_max, testChannels, outHitInfos, forCollisionTest, nullptr) :
+		sweepProxies(staticProxies, ray, box, sweep_min, sweep_max, testChannels, outHitInfos, forCollisionTest, nullptr);
+}
+
+bool Broadphase::aabbRaycastStatic(const Box& aabbBox, const std::vector<std::string>& testChannels, std::vector<const CollisionComponent*>& outCollisions) const
+{
+	const size_t first = outCollisions.size();
+	gatherStatic(aabbBox.getMinPoint(), aabbBox.getMaxPoint(), outCollisions);
+
+	//  only the bounds were tested, keep the collisions that the box really intersects
+	auto missed = std::remove_if(outCollisions.begin() + first, outCollisions.end(), [&](const CollisionComponent* collision)
+	{
+		return !collision->resolveAABBRaycast(aabbBox, testChannels);
+	});
+	outCollisions.erase(missed, outCollisions.end());
+
+	return outCollisions.size() > first;
+}
+
+void Broadphase::gatherStatic(const Vector3& boxMin, const Vector3& boxMax, std::vector<const CollisionComponent*>& outCollisions) const
+{
+	auto gather_proxy = [&](const BroadphaseProxy& proxy)
+	{
+		if (BoundsOverlap(boxMin, boxMax, proxy.boundsMin, proxy.boundsMax)) outCollisions.push_back(proxy.collision);
+	};
+
+	FrameVector<int> indices;
+	if (!staticGrid.isBuilt() || !staticGrid.gatherBox(boxMin, boxMax, indices))
+	{
+		for (auto& proxy : staticProxies) gather_proxy(proxy);
+		return;
+	}
+
+	for (int index : staticGrid.getTriggersIndices()) gather_proxy(staticProxies[index]);
+	for (int index : staticGrid.getOversizedIndices()) gather_proxy(staticProxies[index]);
+	for (int index : indices) gather_proxy(staticProxies[index]);
+}
+
+void Broadphase::gatherDynamic(const Vector3& boxMin, const Vector3& boxMax, std::vector<const CollisionComponent*>& outCollisions) const
+{
+	for (auto& proxy : dynamicProxies)
+	{
+		if (BoundsOverlap(boxMin, boxMax, proxy.boundsMin, proxy.boundsMax)) outCollisions.push_back(proxy.collision);
+	}
+}
+
+void Broadphase::setUseStaticGrid(bool use)
+{
+	useStaticGrid = use;
+
+	if (!useStaticGrid)
+	{
+		staticGrid.clear();
+		staticGridDirty = false;
+		return;
+	}
+
+	if (!staticGrid.isBuilt() && !staticProxies.empty()) staticGridDirty = true;
+}
+
+
+bool Broadphase::BoundsOverlap(const Vector3& minA, const Vector3& maxA, const Vector3& minB, const Vector3& maxB)
+{
+	//  inclusive test so that touching boxes are still sent to the narrow phase
+	return
+		minA.x <= maxB.x && maxA.x >= minB.x &&
+		minA.y <= maxB.y && maxA.y >= minB.y &&
+		minA.z <= maxB.z && maxA.z >= minB.z;
+}
+
+bool Broadphase::sweepProxies(const std::vector<BroadphaseProxy>& proxies, const Ray& ray, const Box& box, const Vector3& sweepMin, const Vector3& sweepMax, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos, bool forCollisionTest, const CollisionComponent* ignoredCollision) const
+{
+	bool hit = false;
+	for (auto& proxy : proxies)
+	{
+		if (proxy.collision == ignoredCollision) continue;
+		if (!BoundsOverlap(sweepMin, sweepMax, proxy.boundsMin, proxy.boundsMax)) continue;
+
+		bool col_hit = proxy.collision->resolveAABBSweepRaycast(ray, box, outHitInfos, testChannels, forCollisionTest);
+		hit = hit || col_hit;
+	}
+
+	return hit;
+}
+
+bool Broadphase::overlapProxies(const std::vector<BroadphaseProxy>& proxies, const Box& aabbBox, const Vector3& boxMin, const Vector3& boxMax, const std::vector<std::string>& testChannels, const CollisionComponent* ignoredCollision) const
+{
+	for (auto& proxy : proxies)
+	{
+		if (proxy.collision == ignoredCollision) continue;
+		if (!BoundsOverlap(boxMin, boxMax, proxy.boundsMin, proxy.boundsMax)) continue;
+
+		if (proxy.collision->resolveAABBRaycast(aabbBox, testChannels)) return true;
+	}
+
+	return false;
+}
+
+void Broadphase::overlapTriggerProxies(const std::vector<BroadphaseProxy>& proxies, const Box& aabbBox, const Vector3& boxMin, const Vector3& boxMax, const std::vector<std::string>& testChannels, std::vector<const CollisionComponent*>& outTriggers, const CollisionComponent* ignoredCollision) const
+{
+	for (auto& proxy : proxies)
+	{
+		if (proxy.collision == ignoredCollision) continue;
+		if (proxy.collision->getCollisionType() != CollisionType::Trigger) continue;
+		if (!BoundsOverlap(boxMin, boxMax, proxy.boundsMin, proxy.boundsMax)) continue;
+
+		if (proxy.collision->resolveAABBRaycast(aabbBox, testChannels)) outTriggers.push_back(proxy.collision);
+	}
+}
+
+bool Broadphase::sweepStaticGrid(const Ray& ray, const Box& box, const Vector3& sweepMin, const Vector3& sweepMax, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos, bool forCollisionTest, const CollisionComponent* ignoredCollision) const
+{
+	bool hit = false;
+	auto test_proxy = [&](int index)
+	{
+		const BroadphaseProxy& proxy = staticProxies[index];
+		if (proxy.collision == ignoredCollision) return;
+		if (!BoundsOverlap(sweepMin, sweepMax, proxy.boundsMin, proxy.boundsMax)) return;
+
+		bool col_hit = proxy.collision->resolveAABBSweepRaycast(ray, box, outHitInfos, testChannels, forCollisionTest);
+		hit = hit || col_hit;
+	};
+
+	//  triggers are detected along the whole sweep, not only until the closest hit
+	for (int index : staticGrid.getTriggersIndices()) test_proxy(index);
+	for (int index : staticGrid.getOversizedIndices()) test_proxy(index);
+
+	//  short sweeps just read the cells under their bounds, long ones walk their path
+	if (ray.getLength() < staticGrid.getCellSize())
+	{
+		FrameVector<int> indices;
+		if (staticGrid.gatherBox(sweepMin, sweepMax, indices))
+		{
+			for (int index : indices) test_proxy(index);
+			return hit;
+		}
+	}
+
+	staticGrid.walkSegment(ray.getStart(), ray.getEnd(), box.getHalfExtents(), [&](const int* indices, int count, float enterDistance)
+	{
+		//  nothing further can be closer than the current hit (hits behind the start are all found in the first cells)
+		if (enterDistance > 0.0f && enterDistance > outHitInfos.hitDistance) return false;
+
+		for (int i = 0; i < count; i++) test_proxy(indices[i]);
+		return true;
+	});
+
+	return hit;
+}
+
+bool Broadphase::overlapStaticGrid(const Box& aabbBox, const Vector3& boxMin, const Vector3& boxMax, const std::vector<std::string>& testChannels, const CollisionComponent* ignoredCollision) const
+{
+	auto test_proxy = [&](int index)
+	{
+		const BroadphaseProxy& proxy = staticProxies[index];
+		if (proxy.collision == ignoredCollision) return false;
+		if (!BoundsOverlap(boxMin, boxMax, proxy.boundsMin, proxy.boundsMax)) return false;
+
+		return proxy.collision->resolveAABBRaycast(aabbBox, testChannels);
+	};
+
+	for (int index : staticGrid.getTriggersIndices())
+	{
+		if (test_proxy(index)) return true;
+	}
+	for (int index : staticGrid.getOversizedIndices())
+	{
+		if (test_proxy(index)) return true;
+	}
+
+	FrameVector<int> indices;
+	if (!staticGrid.gatherBox(boxMin, boxMax, indices))
+	{
+		return overlapProxies(staticProxies, aabbBox, boxMin, boxMax, testChannels, ignoredCollision);
+	}
+
+	for (int index : indices)
+	{
+		if (test_proxy(index)) return true;
+	}
+
+	return false;
+}
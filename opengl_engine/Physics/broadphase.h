@@ -0,0 +1,165 @@
+#pragma once
+#include <Maths/Geometry/box.h>
+#include <Maths/vector3.h>
+#include "raycast.h"
+#include "staticGrid.h"
+
+#include <string>
+#include <vector>
+
+class CollisionComponent;
+class RigidbodyComponent;
+class Ray;
+
+
+struct BroadphaseProxy
+{
+	BroadphaseProxy(const Box& bounds, const CollisionComponent* collision_) :
+		boundsMin(bounds.getMinPoint()), boundsMax(bounds.getMaxPoint()), collision(collision_) {}
+
+	Vector3 boundsMin{ Vector3::zero };
+	Vector3 boundsMax{ Vector3::zero };
+	const CollisionComponent* collision{ nullptr };
+};
+
+
+/** Broadphase
+* Stores the world bounds of every registered collision so the queries can cull them before running the narrow phase tests.
+* Dynamic entries are rebuilt at the beginning of each physics step, then stay read-only during the rigidbodies solve.
+* This is what allows the rigidbodies to be solved on multiple threads.
+* Static collisions are baked once in their own entries and never computed again.
+* Baked static collisions can also be indexed by a static grid (built once the static collisions are baked, so at scene load),
+* then the queries only test the static collisions along their path instead of all of them.
+*/
+class Broadphase
+{
+public:
+	/**
+	* Take a snapshot of the world bounds of the given collisions and rigidbodies.
+	* Static collisions that are not baked yet are baked here, the already baked ones are skipped.
+	* This also refreshes the world box cache of the collisions, so the solve threads only read them.
+	* @param	collisions		Collisions registered in the physics manager.
+	* @param	rigidbodies		Rigidbodies registered in the physics manager.
+	*/
+	void rebuild(const std::vector<CollisionComponent*>& collisions, const std::vector<RigidbodyComponent*>& rigidbodies);
+
+	/**
+	* Remove the entry of a collision, so that the queries done later in the step never see it.
+	* @param	collision	Collision that is being removed from the physics.
+	*/
+	void removeCollision(CollisionComponent* collision);
+
+	/**
+	* Remove all the entries, static collisions will be baked again at the next rebuild.
+	* @param	collisions		Collisions that stay registered in the physics manager.
+	*/
+	void clear(const std::vector<CollisionComponent*>& collisions);
+
+	/**
+	* Sweep an AABB box against the snapshot. Doesn't broadcast any event, so it is safe to call from any thread during the solve.
+	* @param	start				Start point of the sweep (world coordinates).
+	* @param	end					End point of the sweep (world coordinates).
+	* @param	aabbBox				Box shape of the sweep (only its size will matter).
+	* @param	testChannels		Collision channels the sweep will test.
+	* @param	outHitInfos			Informations on the closest encountered collision. [OUT]
+	* @param	forCollisionTest	Does this function is used by the collision test algorithm?
+	* @param	ignoredCollision	(optionnal) A collision that will not be tested (usually the collision of the rigidbody that sweeps).
+	* @return						True if at least one solid collision intersect the sweeped box.
+	*/
+	bool sweepAABB(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos, bool forCollisionTest, const CollisionComponent* ignoredCollision = nullptr) const;
+
+	/**
+	* Test an AABB box against the snapshot. Doesn't broadcast any event, so it is safe to call from any thread during the solve.
+	* @param	aabbBox				Box to test (world coordinates).
+	* @param	testChannels		Collision channels the box will test.
+	* @param	ignoredCollision	(optionnal) A collision that will not be tested.
+	* @return						True if at least one collision intersect the box.
+	*/
+	bool overlapAABB(const Box& aabbBox, const std::vector<std::string>& testChannels, const CollisionComponent* ignoredCollision = nullptr) const;
+
+	/**
+	* Find all the triggers that intersect an AABB box. Doesn't broadcast any event.
+	* @param	aabbBox				Box to test (world coordinates).
+	* @param	testChannels		Collision channels the box will test.
+	* @param	outTriggers			Triggers that intersect the box. [OUT]
+	* @param	ignoredCollision	(optionnal) A collision that will not be tested.
+	*/
+	void overlapTriggers(const Box& aabbBox, const std::vector<std::string>& testChannels, std::vector<const CollisionComponent*>& outTriggers, const CollisionComponent* ignoredCollision = nullptr) const;
+
+	/**
+	* Line raycast against the baked static collisions only. Doesn't broadcast any event.
+	* Can be used outside of the step since baked static collisions never move, the other collisions must be tested by the caller.
+	* @param	ray				Ray to test.
+	* @param	testChannels	Collision channels the ray will test.
+	* @param	outHitInfos		Informations on the closest encountered collision (only replaced if a closer one is found). [OUT]
+	* @return					True if at least one baked static collision intersect the ray.
+	*/
+	bool lineRaycastStatic(const Ray& ray, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos) const;
+
+	/**
+	* AABB sweep raycast against the baked static collisions only, the long sweeps walk the static grid cells. Doesn't broadcast any event.
+	* Can be used outside of the step since baked static collisions never move, the other collisions must be tested by the caller.
+	* @param	ray					Ray of the sweep.
+	* @param	box					Box shape of the sweep, centered on the start of the ray.
+	* @param	testChannels		Collision channels the sweep will test.
+	* @param	outHitInfos			Informations on the closest encountered collision (only replaced if a closer one is found). [OUT]
+	* @param	forCollisionTest	Does this function is used by the collision test algorithm?
+	* @return						True if at least one baked static collision intersect the sweeped box.
+	*/
+	bool aabbSweepRaycastStatic(const Ray& ray, const Box& box, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos, bool forCollisionTest) const;
+
+	/**
+	* AABB raycast against the baked static collisions only. Doesn't broadcast any event.
+	* Can be used outside of the step since baked static collisions never move, the other collisions must be tested by the caller.
+	* @param	aabbBox			Box to test (world coordinates).
+	* @param	testChannels	Collision channels the box will test.
+	* @param	outCollisions	Baked static collisions that intersect the box, added at the end of the vector. [OUT]
+	* @return					True if at least one baked static collision intersect the box.
+	*/
+	bool aabbRaycastStatic(const Box& aabbBox, const std::vector<std::string>& testChannels, std::vector<const CollisionComponent*>& outCollisions) const;
+
+	/**
+	* Find the baked static collisions whose bounds overlap a box. Doesn't test the collisions shapes nor their channels.
+	* Can be used outside of the step since baked static collisions never move, the other collisions must be gathered by the caller.
+	* @param	boxMin			Min point of the box (world coordinates).
+	* @param	boxMax			Max point of the box (world coordinates).
+	* @param	outCollisions	Static collisions found, added at the end of the vector. [OUT]
+	*/
+	void gatherStatic(const Vector3& boxMin, const Vector3& boxMax, std::vector<const CollisionComponent*>& outCollisions) const;
+
+	/**
+	* Find the dynamic collisions (everything that is not baked) whose snapshot bounds overlap a box. Doesn't test the collisions shapes nor their channels.
+	* @param	boxMin			Min point of the box (world coordinates).
+	* @param	boxMax			Max point of the box (world coordinates).
+	* @param	outCollisions	Dynamic collisions found, added at the end of the vector. [OUT]
+	*/
+	void gatherDynamic(const Vector3& boxMin, const Vector3& boxMax, std::vector<const CollisionComponent*>& outCollisions) const;
+
+	/**
+	* Set if the baked static collisions are indexed by the static grid. If not, the queries test all of them.
+	* @param	use		Use state of the static grid.
+	*/
+	void setUseStaticGrid(bool use);
+	inline bool isStaticGridBuilt() const { return staticGrid.isBuilt(); }
+	inline const StaticGrid& getStaticGrid() const { return staticGrid; }
+
+	inline size_t getProxiesCount() const { return staticProxies.size() + dynamicProxies.size(); }
+	inline size_t getStaticProxiesCount() const { return staticProxies.size(); }
+
+private:
+	static bool BoundsOverlap(const Vector3& minA, const Vector3& maxA, const Vector3& minB, const Vector3& maxB);
+
+	bool sweepProxies(const std::vector<BroadphaseProxy>& proxies, const Ray& ray, const Box& box, const Vector3& sweepMin, const Vector3& sweepMax, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos, bool forCollisionTest, const CollisionComponent* ignoredCollision) const;
+	bool overlapProxies(const std::vector<BroadphaseProxy>& proxies, const Box& aabbBox, const Vector3& boxMin, const Vector3& boxMax, const std::vector<std::string>& testChannels, const CollisionComponent* ignoredCollision) const;
+	void overlapTriggerProxies(const std::vector<BroadphaseProxy>& proxies, const Box& aabbBox, const Vector3& boxMin, const Vector3& boxMax, const std::vector<std::string>& testChannels, std::vector<const CollisionComponent*>& outTriggers, const CollisionComponent* ignoredCollision) const;
+
+	bool sweepStaticGrid(const Ray& ray, const Box& box, const Vector3& sweepMin, const Vector3& sweepMax, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos, bool forCollisionTest, const CollisionComponent* ignoredCollision) const;
+	bool overlapStaticGrid(const Box& aabbBox, const Vector3& boxMin, const Vector3& boxMax, const std::vector<std::string>& testChannels, const CollisionComponent* ignoredCollision) const;
+
+	std::vector<BroadphaseProxy> staticProxies;
+	std::vector<BroadphaseProxy> dynamicProxies;
+
+	StaticGrid staticGrid;
+	bool useStaticGrid{ true };
+	bool staticGridDirty{ false };
+};
@@ -4,6 +4,7 @@
 #include "ObjectChannels/collisionChannels.h"
 #include <Rendering/material.h>
 #include <Utils/color.h>
+#include <Maths/Maths.h>
 
 CollisionComponent::~CollisionComponent()
 {
@@ -23,6 +24,7 @@ CollisionComponent::~CollisionComponent()
 void CollisionComponent::setAssociatedObject(Object* newObject)
 {
 	associatedObject = newObject;
+	invalidateBounds();
 }
 
 bool CollisionComponent::resolvePoint(const Vector3& point) const
@@ -31,7 +33,7 @@ bool CollisionComponent::resolvePoint(const Vector3& point) const
 	return intersect;
 }
 
-bool CollisionComponent::resolveLineRaycast(const Ray& raycast, RaycastHitInfos& outHitInfos, const std::vector<std::string> testChannels) const
+bool CollisionComponent::resolveLineRaycast(const Ray& raycast, RaycastHitInfos& outHitInfos, const std::vector<std::string>& testChannels) const
 {
 	if (!channelTest(testChannels)) return false;
 
@@ -40,7 +42,7 @@ bool CollisionComponent::resolveLineRaycast(const Ray& raycast, RaycastHitInfos&
 	return intersect;
 }
 
-bool CollisionComponent::resolveAABBRaycast(const Box& raycast, const std::vector<std::string> testChannels) const
+bool CollisionComponent::resolveAABBRaycast(const Box& raycast, const std::vector<std::string>& testChannels) const
 {
 	if (!channelTest(testChannels)) return false;
 
@@ -49,7 +51,7 @@ bool CollisionComponent::resolveAABBRaycast(const Box& raycast, const std::vecto
 	return intersect;
 }
 
-bool CollisionComponent::resolveAABBSweepRaycast(const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, const std::vector<std::string> testChannels, bool forCollisionTest) const
+bool CollisionComponent::resolveAABBSweepRaycast(const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, const std::vector<std::string>& testChannels, bool forCollisionTest) const
 {
 	if (!channelTest(testChannels)) return false;
 
@@ -58,10 +60,9 @@ bool CollisionComponent::resolveAABBSweepRaycast(const Ray& raycast, const Box&
 	return intersect;
 }
 
-void CollisionComponent::drawDebug(Material& debugMaterial) const
+void CollisionComponent::drawDebug(DebugDrawList& outDrawList) const
 {
-	debugMaterial.getShader().setVec3("color", intersectedLastFrame ? Color::red : Color::green);
-	drawDebugMesh(debugMaterial);
+	drawDebugMesh(outDrawList, intersectedLastFrame ? Color::red : Color::green);
 }
 
 const Matrix4 CollisionComponent::getModelMatrix() const
@@ -81,10 +82,42 @@ void CollisionComponent::forceIntersected() const
 	intersectedLastFrame = true;
 }
 
+Vector3 CollisionComponent::getClosestPoint(const Vector3& point) const
+{
+	const Box box = getEncapsulatingBox();
+	const Vector3 box_min = box.getMinPoint();
+	const Vector3 box_max = box.getMaxPoint();
+
+	return Vector3
+	{
+		Maths::clamp(point.x, box_min.x, box_max.x),
+		Maths::clamp(point.y, box_min.y, box_max.y),
+		Maths::clamp(point.z, box_min.z, box_max.z)
+	};
+}
+
 void CollisionComponent::addPosition(const Vector3& posToAdd)
 {
 	if (!associatedObject) return;
 	associatedObject->setPosition(associatedObject->getPosition() + posToAdd);
+	invalidateBounds();
+}
+
+void CollisionComponent::setStatic(bool value)
+{
+	if (bakedInBroadphase)
+	{
+		Locator::getLog().LogMessage_Category("Collision: Tried to change the static state of a collision that is already baked in the physics.", LogCategory::Error);
+		return;
+	}
+
+	staticCollision = value;
+}
+
+unsigned int CollisionComponent::getTransformVersion() const
+{
+	if (!associatedObject) return 0;
+	return associatedObject->getTransformVersion();
 }
 
 void CollisionComponent::setCollisionChannel(std::string newCollisionChannel)
@@ -109,9 +142,9 @@ CollisionComponent::CollisionComponent(CollisionShape collisionShape_, Collision
 {
 }
 
-bool CollisionComponent::channelTest(const std::vector<std::string> testChannels) const
+bool CollisionComponent::channelTest(const std::vector<std::string>& testChannels) const
 {
-	for (auto test_channel : testChannels)
+	for (auto& test_channel : testChannels)
 	{
 		if (test_channel == "") continue;
 
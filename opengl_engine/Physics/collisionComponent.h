@@ -6,6 +6,7 @@
 #include "AABB/raycastAABB.h"
 #include <Maths/Geometry/box.h>
 #include <Audio/audioUtils.h>
+#include <Utils/slotMap.h>
 
 #include <Events/event.h>
 #include <Events/observer.h>
@@ -13,14 +14,16 @@
 
 #include <Rendering/Model/mesh.h>
 
-class Material;
+class DebugDrawList;
 class RigidbodyComponent;
 
 
 enum class CollisionShape : uint8_t
 {
 	Null = 0,
-	BoxAABB = 1
+	BoxAABB = 1,
+	OrientedBox = 2,
+	TriangleMesh = 3
 };
 
 enum class CollisionType : uint8_t
@@ -47,17 +50,28 @@ public:
 	inline const Object* getAssociatedObject() const { return associatedObject; }
 
 	bool resolvePoint(const Vector3& point) const;
-	bool resolveLineRaycast(const Ray& raycast, RaycastHitInfos& outHitInfos, const std::vector<std::string> testChannels) const;
-	bool resolveAABBRaycast(const Box& raycast, const std::vector<std::string> testChannels) const;
-	bool resolveAABBSweepRaycast(const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, const std::vector<std::string> testChannels, bool forCollisionTest = false) const;
+	bool resolveLineRaycast(const Ray& raycast, RaycastHitInfos& outHitInfos, const std::vector<std::string>& testChannels) const;
+	bool resolveAABBRaycast(const Box& raycast, const std::vector<std::string>& testChannels) const;
+	bool resolveAABBSweepRaycast(const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, const std::vector<std::string>& testChannels, bool forCollisionTest = false) const;
 
-	void drawDebug(Material& debugMaterial) const;
+	void drawDebug(DebugDrawList& outDrawList) const;
 
 	virtual const Matrix4 getModelMatrix() const;
 
 	virtual Vector3 getCenterDownPos() const { return Vector3::zero; }
 	virtual Box getEncapsulatingBox() const { return Box::zero; }
 
+	//  is the encapsulating box the exact shape of this collision? (the contact solver only pushes bodies out of those)
+	virtual bool isEncapsulatingBoxExact() const { return false; }
+
+	/**
+	* Find the point of this collision that is the closest to a point (the point itself if it is inside the collision).
+	* The default implementation uses the encapsulating box, which is exact for AABB collisions.
+	* @param	point	Point to test (world coordinates).
+	* @return			Closest point on the collision (world coordinates).
+	*/
+	virtual Vector3 getClosestPoint(const Vector3& point) const;
+
 	void resetIntersected();
 
 	//  for physics manager
@@ -66,6 +80,17 @@ public:
 
 	void addPosition(const Vector3& posToAdd);
 
+	/**
+	* Flag this collision as static: its world bounds are computed once at the next physics step, then never again.
+	* Must be set before the first physics step that sees this collision, and the associated object must not move after that.
+	* @param	value	Is this collision static?
+	*/
+	void setStatic(bool value);
+	inline bool isStatic() const { return staticCollision; }
+
+	//  version of the associated object transform, used to know if this collision moved
+	unsigned int getTransformVersion() const;
+
 	void setCollisionChannel(std::string newCollisionChannel);
 	std::string getCollisionChannel() const { return collisionChannel; }
 
@@ -78,6 +103,8 @@ public:
 
 	//  for physics manager
 	bool registered{ false };
+	bool bakedInBroadphase{ false };
+	SlotHandle physicsHandle;
 
 
 	
@@ -85,10 +112,12 @@ public:
 	mutable Event<RaycastType, const Vector3&> onRaycastIntersect;
 	mutable Event<RigidbodyComponent&, const struct CollisionResponse&> onCollisionIntersect;
 	mutable Event<RigidbodyComponent&> onTriggerEnter;
+	mutable Event<RigidbodyComponent&> onTriggerStay;
+	mutable Event<RigidbodyComponent&> onTriggerExit;
 
 
 
-	bool channelTest(const std::vector<std::string> testChannels) const;
+	bool channelTest(const std::vector<std::string>& testChannels) const;
 
 
 protected:
@@ -99,10 +128,13 @@ protected:
 	virtual bool resolveAABBRaycastIntersection(const Box& raycast) const = 0;
 	virtual bool resolveAABBSweepRaycastIntersection(const Ray& raycast, const Box& boxRaycast, RaycastHitInfos& outHitInfos, bool forCollisionTest) const = 0;
 
-	virtual void drawDebugMesh(Material& debugMaterial) const = 0;
+	virtual void drawDebugMesh(DebugDrawList& outDrawList, const Color& drawColor) const = 0;
 
 	virtual void onAssociatedTransformUpdated() {}
 
+	//  called when the world bounds of this collision must be computed again
+	virtual void invalidateBounds() {}
+
 
 	CollisionShape collisionShape{ CollisionShape::Null };
 	CollisionType collisionType{ CollisionType::Solid };
@@ -118,6 +150,8 @@ protected:
 private:
 	mutable bool intersectedLastFrame{ false };
 
+	bool staticCollision{ false };
+
 	std::string collisionChannel{ "" };
 
 	friend class RigidbodyComponent;
@@ -1,12 +1,13 @@
 #include "collisionTests.h"
-#include <ServiceLocator/locator.h>
+#include "broadphase.h"
 #include <Physics/rigidbodyComponent.h>
 #include <Physics/AABB/boxAABBColComp.h>
 #include <Maths/Geometry/box.h>
+#include <algorithm>
 
 
 
-bool CollisionTests::RigidbodyCollideAndSlideAABB(const RigidbodyComponent& rigidbody, const bool gravityPass, Vector3& computedMovement, std::vector<CollisionHit>& colResponses, std::vector<const CollisionComponent*>& triggers)
+bool CollisionTests::RigidbodyCollideAndSlideAABB(const Broadphase& broadphase, const RigidbodyComponent& rigidbody, const bool gravityPass, Vector3& computedMovement, std::vector<CollisionHit>& colResponses, std::vector<const CollisionComponent*>& triggers)
 {
 	const Vector3 body_start_movement = gravityPass ? rigidbody.getAnticipatedGravityMovement() : rigidbody.getAnticipatedMovement();
 	if (body_start_movement == Vector3::zero)
@@ -21,7 +22,7 @@ bool CollisionTests::RigidbodyCollideAndSlideAABB(const RigidbodyComponent& rigi
 
 	Vector3 computed_pos = Vector3::zero;
 
-	bool col_hit = CollideAndSlideAABB(rigidbody, body_shape, body_start_pos, body_start_movement, 0, gravityPass, computed_pos, colResponses, triggers);
+	bool col_hit = CollideAndSlideAABB(broadphase, rigidbody, body_shape, body_start_pos, body_start_movement, 0, gravityPass, computed_pos, colResponses, triggers);
 	computedMovement = computed_pos - body_start_pos;
 	return col_hit;
 }
@@ -29,10 +30,10 @@ bool CollisionTests::RigidbodyCollideAndSlideAABB(const RigidbodyComponent& rigi
 
 
 
-bool CollisionTests::CollideAndSlideAABB(const RigidbodyComponent& rigidbody, const Box& boxAABB, const Vector3 startPos, const Vector3 movement, const int bounces, const bool gravityPass, Vector3& computedPos, std::vector<CollisionHit>& colResponses, std::vector<const CollisionComponent*>& triggers)
+bool CollisionTests::CollideAndSlideAABB(const Broadphase& broadphase, const RigidbodyComponent& rigidbody, const Box& boxAABB, const Vector3 startPos, const Vector3 movement, const int bounces, const bool gravityPass, Vector3& computedPos, std::vector<CollisionHit>& colResponses, std::vector<const CollisionComponent*>& triggers)
 {
 	RaycastHitInfos out_raycast;
-	bool col_encountered = Locator::getPhysics().AABBSweepRaycast(startPos, startPos + movement, boxAABB, rigidbody.getTestChannels(), out_raycast, 0.0f, true, false);
+	bool col_encountered = broadphase.sweepAABB(startPos, startPos + movement, boxAABB, rigidbody.getTestChannels(), out_raycast, false, &rigidbody.getAssociatedCollision());
 	
 	//  check for triggers
 	if (!out_raycast.triggersDetected.empty())
@@ -48,7 +49,7 @@ bool CollisionTests::CollideAndSlideAABB(const RigidbodyComponent& rigidbody, co
 	if (col_encountered) //  collision encountered, continuing recursion
 	{
 		float step_mechanic = 0.0f;
-		if (rigidbody.checkStepMechanic(*out_raycast.hitCollision, startPos + movement, out_raycast.hitNormal, step_mechanic))
+		if (rigidbody.checkStepMechanic(broadphase, *out_raycast.hitCollision, startPos + movement, out_raycast.hitNormal, step_mechanic))
 		{
 			computedPos = startPos + movement + Vector3{ 0.0f, step_mechanic, 0.0f };
 
@@ -101,7 +102,7 @@ bool CollisionTests::CollideAndSlideAABB(const RigidbodyComponent& rigidbody, co
 		}
 
 
-		CollideAndSlideAABB(rigidbody, boxAABB, out_location_secure, remaining_movement, bounces + 1, gravityPass, computedPos, colResponses, triggers);
+		CollideAndSlideAABB(broadphase, rigidbody, boxAABB, out_location_secure, remaining_movement, bounces + 1, gravityPass, computedPos, colResponses, triggers);
 		return true;
 	}
 	else //  no collision encountered, end of the recursion
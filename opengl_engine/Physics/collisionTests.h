@@ -5,6 +5,7 @@
 class RigidbodyComponent;
 class CollisionComponent;
 class Box;
+class Broadphase;
 
 struct CollisionHit
 {
@@ -23,6 +24,8 @@ public:
 	/**
 	* Compute the movement by checking collisions for a physic activated rigidbody.
 	* Algorithm used is Collide and Slide.
+	* Only reads the broadphase and the rigidbody, so it can be called for several rigidbodies in parallel.
+	* @param	broadphase			Snapshot of the collisions to test against.
 	* @param	rigidbody			Rigidbody to compute.
 	* @param	gravityPass			Are we computing gravity?
 	* @param	computedMovement	Movement to apply to the rigidbody. [OUT]
@@ -30,13 +33,14 @@ public:
 	* @param	triggers			List of all triggers detected. [OUT]
 	* @return						True if the rigidbody encountered at least one collision.
 	*/
-	static bool RigidbodyCollideAndSlideAABB(const RigidbodyComponent& rigidbody, const bool gravityPass, Vector3& computedMovement, std::vector<CollisionHit>& colResponses, std::vector<const CollisionComponent*>& triggers);
+	static bool RigidbodyCollideAndSlideAABB(const Broadphase& broadphase, const RigidbodyComponent& rigidbody, const bool gravityPass, Vector3& computedMovement, std::vector<CollisionHit>& colResponses, std::vector<const CollisionComponent*>& triggers);
 
 
 private:
 
 	/**
 	* Core of the Collide and Slide algorithm, recursive function that will check the shape raycast.
+	* @param	broadphase			Snapshot of the collisions to test against.
 	* @param	rigidbody			Rigidbody to use.
 	* @param	boxAABB				Shape to use.
 	* @param	startPos			Start of the raycast for this iteration.
@@ -48,6 +52,6 @@ private:
 	* @param	triggers			List of all triggers detected. [OUT/PASSTHROUGH]
 	* @return						True if this iteration's raycast encountered a collision.
 	*/
-	static bool CollideAndSlideAABB(const RigidbodyComponent& rigidbody, const Box& boxAABB, const Vector3 startPos, const Vector3 movement, const int bounces, const bool gravityPass, Vector3& computedPos, std::vector<CollisionHit>& colResponses, std::vector<const CollisionComponent*>& triggers);
+	static bool CollideAndSlideAABB(const Broadphase& broadphase, const RigidbodyComponent& rigidbody, const Box& boxAABB, const Vector3 startPos, const Vector3 movement, const int bounces, const bool gravityPass, Vector3& computedPos, std::vector<CollisionHit>& colResponses, std::vector<const CollisionComponent*>& triggers);
 };
 
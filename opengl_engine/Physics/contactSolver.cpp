@@ -0,0 +1,249 @@
+#include "contactSolver.h"
+#include "rigidbodyComponent.h"
+#include <Maths/Maths.h>
+#include <ServiceLocator/jobs.h>
+
+
+void ContactSolver::clear()
+{
+	minX.clear(); minY.clear(); minZ.clear();
+	maxX.clear(); maxY.clear(); maxZ.clear();
+	inverseMass.clear();
+	correctionX.clear(); correctionY.clear(); correctionZ.clear();
+	islandParents.clear();
+
+	contactBodyA.clear(); contactBodyB.clear();
+	contactNormalX.clear(); contactNormalY.clear(); contactNormalZ.clear();
+	contactPenetration.clear();
+	contactInvMassA.clear(); contactInvMassB.clear();
+	contactImpulse.clear();
+	contactHeight.clear();
+
+	contactsOrder.clear();
+	islandsRanges.clear();
+}
+
+int ContactSolver::addBody(const Box& bounds, float inverseMass_)
+{
+	const Vector3 min = bounds.getMinPoint();
+	const Vector3 max = bounds.getMaxPoint();
+
+	minX.push_back(min.x); minY.push_back(min.y); minZ.push_back(min.z);
+	maxX.push_back(max.x); maxY.push_back(max.y); maxZ.push_back(max.z);
+	inverseMass.push_back(inverseMass_);
+	correctionX.push_back(0.0f); correctionY.push_back(0.0f); correctionZ.push_back(0.0f);
+	islandParents.push_back(static_cast<int>(islandParents.size()));
+
+	return static_cast<int>(inverseMass.size()) - 1;
+}
+
+bool ContactSolver::addStaticContact(int body, const Vector3& staticMin, const Vector3& staticMax)
+{
+	if (inverseMass[body] <= 0.0f) return false;
+	if (!overlapsBody(body, staticMin, staticMax)) return false;
+
+	addContact(body, -1, inverseMass[body], 0.0f, Vector3{ minX[body], minY[body], minZ[body] }, Vector3{ maxX[body], maxY[body], maxZ[body] }, staticMin, staticMax);
+	return true;
+}
+
+bool ContactSolver::overlapsBody(int body, const Vector3& boxMin, const Vector3& boxMax) const
+{
+	return
+		minX[body] < boxMax.x && maxX[body] > boxMin.x &&
+		minY[body] < boxMax.y && maxY[body] > boxMin.y &&
+		minZ[body] < boxMax.z && maxZ[body] > boxMin.z;
+}
+
+void ContactSolver::solve(int iterations, Jobs* jobs)
+{
+	const int bodies_count = getBodiesCount();
+	const int contacts_count = getContactsCount();
+	islandsRanges.clear();
+	if (contacts_count == 0) return;
+
+	//  two bodies in the same contact must be solved by the same thread, so they are in the same island
+	for (int i = 0; i < contacts_count; i++)
+	{
+		if (contactBodyB[i] < 0) continue;
+
+		const int root_a = findIslandRoot(contactBodyA[i]);
+		const int root_b = findIslandRoot(contactBodyB[i]);
+		if (root_a != root_b) islandParents[root_b] = root_a;
+	}
+
+	//  sort the contacts by island (counting sort on the island roots, that keeps the creation order in each island)
+	islandsIndices.assign(bodies_count, -1);
+	for (int i = 0; i < contacts_count; i++)
+	{
+		const int root = findIslandRoot(contactBodyA[i]);
+		if (islandsIndices[root] < 0)
+		{
+			islandsIndices[root] = static_cast<int>(islandsRanges.size());
+			islandsRanges.push_back(IslandRange{});
+		}
+		islandsRanges[islandsIndices[root]].count++;
+	}
+
+	int offset = 0;
+	for (auto& range : islandsRanges)
+	{
+		range.start = offset;
+		offset += range.count;
+		range.count = 0;
+	}
+
+	contactsOrder.resize(contacts_count);
+	for (int i = 0; i < contacts_count; i++)
+	{
+		IslandRange& range = islandsRanges[islandsIndices[findIslandRoot(contactBodyA[i])]];
+		contactsOrder[range.start + range.count] = i;
+		range.count++;
+	}
+
+	//  each island only writes the corrections of its own bodies and the impulses of its own contacts
+	const int islands_count = getIslandsCount();
+	auto solve_job = [this, iterations](int island) { solveIsland(island, iterations); };
+	if (jobs && islands_count >= minIslandsForMultithreading)
+	{
+		jobs->ParallelFor(islands_count, solve_job);
+	}
+	else
+	{
+		for (int i = 0; i < islands_count; i++) solve_job(i);
+	}
+}
+
+float ContactSolver::getMaxPenetration() const
+{
+	float max_penetration = 0.0f;
+	for (int i = 0; i < getContactsCount(); i++)
+	{
+		const int a = contactBodyA[i];
+		const int b = contactBodyB[i];
+
+		float relative_correction = contactNormalX[i] * correctionX[a] + contactNormalY[i] * correctionY[a] + contactNormalZ[i] * correctionZ[a];
+		if (b >= 0) relative_correction -= contactNormalX[i] * correctionX[b] + contactNormalY[i] * correctionY[b] + contactNormalZ[i] * correctionZ[b];
+
+		//  the security distance is part of the stored penetration but isn't a real penetration
+		const float penetration = contactPenetration[i] - Rigidbody::SECURITY_DIST - relative_correction;
+		max_penetration = Maths::max(max_penetration, penetration);
+	}
+
+	return max_penetration;
+}
+
+
+void ContactSolver::addContact(int bodyA, int bodyB, float invMassA, float invMassB, const Vector3& minA, const Vector3& maxA, const Vector3& minB, const Vector3& maxB)
+{
+	//  the manifold of two AABB boxes: the axis of smallest overlap, pushing A away from the center of B
+	const float overlap[3] =
+	{
+		Maths::min(maxA.x, maxB.x) - Maths::max(minA.x, minB.x),
+		Maths::min(maxA.y, maxB.y) - Maths::max(minA.y, minB.y),
+		Maths::min(maxA.z, maxB.z) - Maths::max(minA.z, minB.z)
+	};
+	const float centers_delta[3] =
+	{
+		(minA.x + maxA.x) - (minB.x + maxB.x),
+		(minA.y + maxA.y) - (minB.y + maxB.y),
+		(minA.z + maxA.z) - (minB.z + maxB.z)
+	};
+
+	int axis = 0;
+	if (overlap[1] < overlap[axis]) axis = 1;
+	if (overlap[2] < overlap[axis]) axis = 2;
+
+	float normal[3] = { 0.0f, 0.0f, 0.0f };
+	normal[axis] = centers_delta[axis] >= 0.0f ? 1.0f : -1.0f;
+
+	contactBodyA.push_back(bodyA);
+	contactBodyB.push_back(bodyB);
+	contactNormalX.push_back(normal[0]);
+	contactNormalY.push_back(normal[1]);
+	contactNormalZ.push_back(normal[2]);
+	contactPenetration.push_back(overlap[axis] + Rigidbody::SECURITY_DIST); //  resolved bodies keep the same distance as after a collide and slide
+	contactInvMassA.push_back(invMassA);
+	contactInvMassB.push_back(invMassB);
+	contactImpulse.push_back(0.0f);
+	contactHeight.push_back(Maths::max(minA.y, minB.y));
+}
+
+int ContactSolver::findIslandRoot(int body)
+{
+	while (islandParents[body] != body)
+	{
+		islandParents[body] = islandParents[islandParents[body]];
+		body = islandParents[body];
+	}
+	return body;
+}
+
+uint64_t ContactSolver::GetCellKey(int x, int y, int z)
+{
+	//  21 bits per axis, offset so that the keys of consecutive cells on z always follow each other
+	const uint64_t mask = (1ull << 21) - 1;
+	const int offset = 1 << 20;
+	return ((static_cast<uint64_t>(x + offset) & mask) << 42) | ((static_cast<uint64_t>(y + offset) & mask) << 21) | (static_cast<uint64_t>(z + offset) & mask);
+}
+
+void ContactSolver::solveIsland(int island, int iterations)
+{
+	const IslandRange& range = islandsRanges[island];
+
+	//  bottom to top, so that the corrections go up the stacks in a single pass
+	std::sort(contactsOrder.begin() + range.start, contactsOrder.begin() + range.start + range.count,
+		[this](int a, int b) { return contactHeight[a] < contactHeight[b]; });
+
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		for (int k = range.start; k < range.start + range.count; k++)
+		{
+			const int i = contactsOrder[k];
+			solveContact(i, contactInvMassA[i], contactInvMassB[i]);
+		}
+	}
+
+	//  shock propagation: a last pass where the lower body of a vertical contact can't be pushed,
+	//  the iterations alone share the corrections between the bodies of a stack and need a lot of passes to push the whole stack up
+	for (int k = range.start; k < range.start + range.count; k++)
+	{
+		const int i = contactsOrder[k];
+		float inv_mass_a = contactInvMassA[i];
+		float inv_mass_b = contactInvMassB[i];
+		if (contactBodyB[i] >= 0 && contactNormalY[i] != 0.0f)
+		{
+			const bool a_above = contactNormalY[i] > 0.0f;
+			if (a_above && inv_mass_a > 0.0f) inv_mass_b = 0.0f;
+			else if (!a_above && inv_mass_b > 0.0f) inv_mass_a = 0.0f;
+		}
+
+		solveContact(i, inv_mass_a, inv_mass_b);
+	}
+}
+
+void ContactSolver::solveContact(int contact, float invMassA, float invMassB)
+{
+	const int a = contactBodyA[contact];
+	const int b = contactBodyB[contact];
+	const float nx = contactNormalX[contact], ny = contactNormalY[contact], nz = contactNormalZ[contact];
+
+	//  penetration left with the corrections computed so far
+	float relative_correction = nx * correctionX[a] + ny * correctionY[a] + nz * correctionZ[a];
+	if (b >= 0) relative_correction -= nx * correctionX[b] + ny * correctionY[b] + nz * correctionZ[b];
+	const float error = contactPenetration[contact] - relative_correction;
+
+	//  projection: the accumulated impulse can only push the bodies apart
+	const float previous_impulse = contactImpulse[contact];
+	contactImpulse[contact] = Maths::max(previous_impulse + error / (invMassA + invMassB), 0.0f);
+	const float impulse = contactImpulse[contact] - previous_impulse;
+
+	correctionX[a] += nx * impulse * invMassA;
+	correctionY[a] += ny * impulse * invMassA;
+	correctionZ[a] += nz * impulse * invMassA;
+	if (b >= 0)
+	{
+		correctionX[b] -= nx * impulse * invMassB;
+		correctionY[b] -= ny * impulse * invMassB;
+		correctionZ[b] -= nz * impulse * invMassB;
+	}
+}
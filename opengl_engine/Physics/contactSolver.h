@@ -0,0 +1,190 @@
+#pragma once
+#include <Maths/Geometry/box.h>
+#include <Maths/vector3.h>
+#include <Maths/Maths.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class Jobs;
+
+
+/** Contact Solver
+* Resolves the penetrations that are left after the collide and slide pass (bodies moved in the same step, bodies pushed by a moving collision,
+* bodies spawned inside each other) with a few projected Gauss-Seidel iterations on their positions.
+* Bodies are AABB boxes with an inverse mass, static boxes have no entry and are given to the contacts directly.
+* Bodies and contacts are stored in flat arrays (one per value), the contacts are sorted by island and the islands are solved in parallel.
+* The collide and slide is not replaced: bodies that don't penetrate anything create no contact and are never moved.
+*/
+class ContactSolver
+{
+public:
+	void clear();
+
+	/**
+	* Add a body to the solver.
+	* @param	bounds			World bounds of the body.
+	* @param	inverseMass		Inverse of the mass of the body (0 for a body that can't be pushed).
+	* @return					Index of the body in the solver.
+	*/
+	int addBody(const Box& bounds, float inverseMass);
+
+	/**
+	* Create the contact between a body and a static box if they penetrate each other.
+	* @param	body			Index of the body.
+	* @param	staticMin		Min point of the static box (world coordinates).
+	* @param	staticMax		Max point of the static box (world coordinates).
+	* @return					True if a contact has been created.
+	*/
+	bool addStaticContact(int body, const Vector3& staticMin, const Vector3& staticMax);
+
+	/**
+	* Test if a body penetrates a box (touching boxes don't penetrate).
+	* @param	body			Index of the body.
+	* @param	boxMin			Min point of the box (world coordinates).
+	* @param	boxMax			Max point of the box (world coordinates).
+	* @return					True if the body penetrates the box.
+	*/
+	bool overlapsBody(int body, const Vector3& boxMin, const Vector3& boxMax) const;
+
+	/**
+	* Create the contacts between the bodies that penetrate each other (the bodies are sorted in a grid so that only the neighbours are tested).
+	* @param	pairFilter		Called with the indices of two penetrating bodies as bool(int bodyA, int bodyB, bool& outMoveA, bool& outMoveB).
+	*							Returns false to ignore the pair, the out values tell which bodies the contact can push.
+	*/
+	template<typename PairFilter>
+	void findBodiesContacts(PairFilter pairFilter);
+
+	/**
+	* Group the contacts in islands and run the iterations on each island.
+	* @param	iterations		Number of Gauss-Seidel iterations.
+	* @param	jobs			Jobs service used to solve the islands (can be null to solve them serially).
+	*/
+	void solve(int iterations, Jobs* jobs);
+
+	inline Vector3 getCorrection(int body) const { return Vector3{ correctionX[body], correctionY[body], correctionZ[body] }; }
+
+	inline int getBodiesCount() const { return static_cast<int>(inverseMass.size()); }
+	inline int getContactsCount() const { return static_cast<int>(contactPenetration.size()); }
+	inline int getIslandsCount() const { return static_cast<int>(islandsRanges.size()); }
+
+	/**
+	* Compute the deepest penetration left between the bodies and the contacts once the corrections are applied, to check the convergence.
+	* @return		Deepest penetration (0 if every contact is resolved).
+	*/
+	float getMaxPenetration() const;
+
+private:
+	struct IslandRange
+	{
+		int start{ 0 };
+		int count{ 0 };
+	};
+
+	void addContact(int bodyA, int bodyB, float invMassA, float invMassB, const Vector3& minA, const Vector3& maxA, const Vector3& minB, const Vector3& maxB);
+	int findIslandRoot(int body);
+	static uint64_t GetCellKey(int x, int y, int z);
+	void solveIsland(int island, int iterations);
+	void solveContact(int contact, float invMassA, float invMassB);
+
+	//  bodies
+	std::vector<float> minX, minY, minZ;
+	std::vector<float> maxX, maxY, maxZ;
+	std::vector<float> inverseMass;
+	std::vector<float> correctionX, correctionY, correctionZ;
+	std::vector<int> islandParents;
+
+	//  contacts (body B is -1 for a static box), the normal pushes body A out of body B
+	std::vector<int> contactBodyA, contactBodyB;
+	std::vector<float> contactNormalX, contactNormalY, contactNormalZ;
+	std::vector<float> contactPenetration;
+	std::vector<float> contactInvMassA, contactInvMassB;
+	std::vector<float> contactImpulse;
+	std::vector<float> contactHeight; //  bottom of the penetration, to solve the stacks from the ground
+
+	//  contacts order sorted by island
+	std::vector<int> contactsOrder;
+	std::vector<IslandRange> islandsRanges;
+
+	//  scratch buffers
+	std::vector<std::pair<uint64_t, int>> bodiesCells; //  cell key and index of each body, sorted by cell
+	std::vector<int> islandsIndices;
+
+	const int minIslandsForMultithreading{ 4 };
+};
+
+
+
+template<typename PairFilter>
+void ContactSolver::findBodiesContacts(PairFilter pairFilter)
+{
+	const int count = getBodiesCount();
+	if (count < 2) return;
+
+	//  hash the bodies in cells as big as the biggest body: two bodies can only penetrate if their min cells are neighbours
+	float cell_size = 0.0f;
+	for (int i = 0; i < count; i++)
+	{
+		cell_size = Maths::max(cell_size, Maths::max(maxX[i] - minX[i], Maths::max(maxY[i] - minY[i], maxZ[i] - minZ[i])));
+	}
+	if (cell_size <= 0.0f) return;
+	const float inv_cell_size = 1.0f / cell_size;
+
+	bodiesCells.resize(count);
+	for (int i = 0; i < count; i++)
+	{
+		bodiesCells[i] = std::make_pair(GetCellKey(
+			static_cast<int>(std::floor(minX[i] * inv_cell_size)),
+			static_cast<int>(std::floor(minY[i] * inv_cell_size)),
+			static_cast<int>(std::floor(minZ[i] * inv_cell_size))), i);
+	}
+	std::sort(bodiesCells.begin(), bodiesCells.end());
+
+	auto test_pair = [&](int a, int b)
+	{
+		//  strict test: touching bodies don't penetrate
+		if (!(minX[a] < maxX[b] && maxX[a] > minX[b] && minY[a] < maxY[b] && maxY[a] > minY[b] && minZ[a] < maxZ[b] && maxZ[a] > minZ[b])) return;
+
+		bool move_a = true, move_b = true;
+		if (!pairFilter(a, b, move_a, move_b)) return;
+
+		const float inv_mass_a = move_a ? inverseMass[a] : 0.0f;
+		const float inv_mass_b = move_b ? inverseMass[b] : 0.0f;
+		if (inv_mass_a + inv_mass_b <= 0.0f) return;
+
+		addContact(a, b, inv_mass_a, inv_mass_b,
+			Vector3{ minX[a], minY[a], minZ[a] }, Vector3{ maxX[a], maxY[a], maxZ[a] },
+			Vector3{ minX[b], minY[b], minZ[b] }, Vector3{ maxX[b], maxY[b], maxZ[b] });
+	};
+
+	//  each pair is tested once, from the body whose cell comes first: only the half of the neighbour cells that come after are read
+	//  (the keys of consecutive cells on z follow each other, so each column of 3 cells is a single range of the sorted bodies)
+	for (int i = 0; i < count; i++)
+	{
+		const int a = bodiesCells[i].second;
+		const int cell_x = static_cast<int>(std::floor(minX[a] * inv_cell_size));
+		const int cell_y = static_cast<int>(std::floor(minY[a] * inv_cell_size));
+		const int cell_z = static_cast<int>(std::floor(minZ[a] * inv_cell_size));
+
+		//  same column: the next bodies of the same cell and the bodies of the next cell on z
+		const uint64_t column_last_key = GetCellKey(cell_x, cell_y, cell_z + 1);
+		for (int j = i + 1; j < count && bodiesCells[j].first <= column_last_key; j++)
+		{
+			test_pair(a, bodiesCells[j].second);
+		}
+
+		const int columns[4][2] = { { cell_x, cell_y + 1 }, { cell_x + 1, cell_y - 1 }, { cell_x + 1, cell_y }, { cell_x + 1, cell_y + 1 } };
+		for (auto& column : columns)
+		{
+			const uint64_t last_key = GetCellKey(column[0], column[1], cell_z + 1);
+			auto iter = std::lower_bound(bodiesCells.begin(), bodiesCells.end(), std::make_pair(GetCellKey(column[0], column[1], cell_z - 1), 0));
+			for (; iter != bodiesCells.end() && iter->first <= last_key; ++iter)
+			{
+				test_pair(a, iter->second);
+			}
+		}
+	}
+}
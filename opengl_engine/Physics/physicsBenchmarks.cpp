@@ -0,0 +1,556 @@
+#include "physicsBenchmarks.h"
+#include "broadphase.h"
+#include "contactSolver.h"
+#include "physicsReplay.h"
+#include "rigidbodyComponent.h"
+#include "AABB/boxAABBColComp.h"
+#include "TriangleMesh/triangleMeshBVH.h"
+#include "TriangleMesh/triangleMeshColComp.h"
+#include "TriangleMesh/collisionsTriangleMesh.h"
+#include "separatingAxis.h"
+#include "ObjectChannels/collisionChannels.h"
+#include <Maths/Geometry/ray.h>
+#include <Maths/Maths.h>
+#include <ServiceLocator/locator.h>
+#include <Utils/elapsedTime.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+namespace
+{
+	void LogComparison(const std::string& name, double bruteForceTime, double gridTime, int queriesCount, bool sameResults, const std::string& structureName = "static grid")
+	{
+		Log& log = Locator::getLog();
+		log.LogMessage_Category("Physics Benchmark: " + name + " x" + std::to_string(queriesCount) +
+			" | brute force: " + std::to_string(bruteForceTime) + " ms | " + structureName + ": " + std::to_string(gridTime) +
+			" ms | speedup: x" + std::to_string(gridTime > 0.0 ? bruteForceTime / gridTime : 0.0), LogCategory::Info);
+
+		if (!sameResults) log.LogMessage_Category("Physics Benchmark: " + name + " results differ between the brute force and the " + structureName + ".", LogCategory::Warning);
+	}
+}
+
+
+void PhysicsBenchmarks::StaticGridBenchmark(int boxesCount, int queriesCount)
+{
+	Log& log = Locator::getLog();
+	log.LogMessage_Category("Physics Benchmark: Static grid with " + std::to_string(boxesCount) + " static boxes.", LogCategory::Info);
+
+	std::mt19937 random(42); //  always the same level and queries
+	const float level_size = std::sqrt(static_cast<float>(boxesCount)) * 3.0f;
+	std::uniform_real_distribution<float> random_position(0.0f, level_size);
+	std::uniform_real_distribution<float> random_unit(0.0f, 1.0f);
+	std::uniform_real_distribution<float> random_angle(0.0f, Maths::toRadians(360.0f));
+
+	//  generate a doom-like level: a floor, walls and some crates, all static
+	Object level_object;
+	std::vector<CollisionComponent*> collisions;
+	collisions.reserve(boxesCount);
+
+	const float half_level = level_size * 0.5f;
+	collisions.push_back(new BoxAABBColComp(Box{ Vector3{ half_level, -0.5f, half_level }, Vector3{ half_level, 0.5f, half_level } }, &level_object, false, "solid"));
+	for (int i = 1; i < boxesCount; i++)
+	{
+		const Vector3 position{ random_position(random), 0.0f, random_position(random) };
+		Vector3 half_extents;
+		if (random_unit(random) < 0.7f)
+		{
+			const float length = 0.5f + random_unit(random) * 2.0f;
+			half_extents = random_unit(random) < 0.5f ? Vector3{ length, 1.5f, 0.1f } : Vector3{ 0.1f, 1.5f, length };
+		}
+		else
+		{
+			const float crate_size = 0.25f + random_unit(random) * 0.5f;
+			half_extents = Vector3{ crate_size, crate_size, crate_size };
+		}
+
+		collisions.push_back(new BoxAABBColComp(Box{ position + Vector3{ 0.0f, half_extents.y, 0.0f }, half_extents }, &level_object, false, "solid"));
+	}
+	for (auto col : collisions)
+	{
+		col->setStatic(true);
+	}
+
+	const std::vector<RigidbodyComponent*> no_rigidbodies;
+	const std::vector<std::string> test_channels{ CollisionChannels::DefaultEverything() };
+
+	//  brute force broadphase
+	Broadphase brute_force;
+	brute_force.setUseStaticGrid(false);
+	brute_force.rebuild(collisions, no_rigidbodies);
+
+	//  the grid broadphase must bake the collisions again
+	for (auto col : collisions)
+	{
+		col->bakedInBroadphase = false;
+	}
+	Broadphase grid;
+	auto build_start = std::chrono::steady_clock::now();
+	grid.rebuild(collisions, no_rigidbodies);
+	const double build_time = GetElapsedMilliseconds(build_start);
+	log.LogMessage_Category("Physics Benchmark: Static grid built in " + std::to_string(build_time) + " ms (" + std::to_string(grid.getStaticGrid().getCellsCount()) +
+		" cells of size " + std::to_string(grid.getStaticGrid().getCellSize()) + ").", LogCategory::Info);
+
+
+	//  generate the queries
+	std::vector<Vector3> starts(queriesCount);
+	std::vector<Vector3> directions(queriesCount);
+	for (int i = 0; i < queriesCount; i++)
+	{
+		starts[i] = Vector3{ random_position(random), 0.9f, random_position(random) };
+		const float angle = random_angle(random);
+		directions[i] = Vector3{ std::cos(angle), 0.0f, std::sin(angle) };
+	}
+
+	const Box player_box{ Vector3::zero, Vector3{ 0.3f, 0.85f, 0.3f } };
+	const Box projectile_box{ Vector3::zero, Vector3{ 0.05f, 0.05f, 0.05f } };
+
+	auto run_sweeps = [&](const Broadphase& broadphase, const Box& box, float length, double& outDistancesSum)
+	{
+		int hits_count = 0;
+		outDistancesSum = 0.0;
+		for (int i = 0; i < queriesCount; i++)
+		{
+			RaycastHitInfos out;
+			if (broadphase.sweepAABB(starts[i], starts[i] + directions[i] * length, box, test_channels, out, true) && out.hitCollision)
+			{
+				hits_count++;
+				outDistancesSum += out.hitDistance;
+			}
+		}
+		return hits_count;
+	};
+
+	auto run_lines = [&](const Broadphase& broadphase, double& outDistancesSum)
+	{
+		int hits_count = 0;
+		outDistancesSum = 0.0;
+		for (int i = 0; i < queriesCount; i++)
+		{
+			Ray ray;
+			ray.setupWithStartEnd(starts[i], starts[i] + directions[i] * 50.0f);
+
+			RaycastHitInfos out;
+			if (broadphase.lineRaycastStatic(ray, test_channels, out) && out.hitCollision)
+			{
+				hits_count++;
+				outDistancesSum += out.hitDistance;
+			}
+		}
+		return hits_count;
+	};
+
+	auto run_overlaps = [&](const Broadphase& broadphase)
+	{
+		int hits_count = 0;
+		for (int i = 0; i < queriesCount; i++)
+		{
+			Box box = player_box;
+			box.setCenterPoint(starts[i]);
+			if (broadphase.overlapAABB(box, test_channels)) hits_count++;
+		}
+		return hits_count;
+	};
+
+
+	double brute_sum = 0.0, grid_sum = 0.0;
+	int brute_hits = 0, grid_hits = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	brute_hits = run_lines(brute_force, brute_sum);
+	double brute_time = GetElapsedMilliseconds(start);
+	start = std::chrono::steady_clock::now();
+	grid_hits = run_lines(grid, grid_sum);
+	double grid_time = GetElapsedMilliseconds(start);
+	LogComparison("Line raycasts (50 units)", brute_time, grid_time, queriesCount, brute_hits == grid_hits && std::abs(brute_sum - grid_sum) < 0.01);
+
+	start = std::chrono::steady_clock::now();
+	brute_hits = run_sweeps(brute_force, player_box, 0.15f, brute_sum);
+	brute_time = GetElapsedMilliseconds(start);
+	start = std::chrono::steady_clock::now();
+	grid_hits = run_sweeps(grid, player_box, 0.15f, grid_sum);
+	grid_time = GetElapsedMilliseconds(start);
+	LogComparison("Rigidbody sweeps (0.15 units)", brute_time, grid_time, queriesCount, brute_hits == grid_hits && std::abs(brute_sum - grid_sum) < 0.01);
+
+	start = std::chrono::steady_clock::now();
+	brute_hits = run_sweeps(brute_force, projectile_box, 30.0f, brute_sum);
+	brute_time = GetElapsedMilliseconds(start);
+	start = std::chrono::steady_clock::now();
+	grid_hits = run_sweeps(grid, projectile_box, 30.0f, grid_sum);
+	grid_time = GetElapsedMilliseconds(start);
+	LogComparison("Projectile sweeps (30 units)", brute_time, grid_time, queriesCount, brute_hits == grid_hits && std::abs(brute_sum - grid_sum) < 0.01);
+
+	start = std::chrono::steady_clock::now();
+	brute_hits = run_overlaps(brute_force);
+	brute_time = GetElapsedMilliseconds(start);
+	start = std::chrono::steady_clock::now();
+	grid_hits = run_overlaps(grid);
+	grid_time = GetElapsedMilliseconds(start);
+	LogComparison("Box overlaps", brute_time, grid_time, queriesCount, brute_hits == grid_hits);
+
+
+	for (auto col : collisions)
+	{
+		col->bakedInBroadphase = false;
+		delete col;
+	}
+}
+
+void PhysicsBenchmarks::StackedBoxesBenchmark(int boxesCount, int stepsCount)
+{
+	Log& log = Locator::getLog();
+
+	const int stack_height = 20;
+	const int stacks_count = Maths::max(boxesCount / stack_height, 1);
+	const int stacks_per_row = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(stacks_count))));
+	const Vector3 half_extents{ 0.5f, 0.5f, 0.5f };
+	const Vector3 floor_min{ -1.0f, -1.0f, -1.0f };
+	const Vector3 floor_max{ stacks_per_row * 2.0f, 0.0f, stacks_per_row * 2.0f };
+
+	log.LogMessage_Category("Physics Benchmark: Contact solver with " + std::to_string(stacks_count * stack_height) + " boxes in " +
+		std::to_string(stacks_count) + " stacks of " + std::to_string(stack_height) + ".", LogCategory::Info);
+
+	//  each box starts inside the one under it (the first one inside the floor)
+	auto build_stacks = [&](float penetration)
+	{
+		std::vector<Vector3> centers;
+		centers.reserve(stacks_count * stack_height);
+		for (int stack = 0; stack < stacks_count; stack++)
+		{
+			const float x = (stack % stacks_per_row) * 2.0f;
+			const float z = (stack / stacks_per_row) * 2.0f;
+			for (int level = 0; level < stack_height; level++)
+			{
+				centers.push_back(Vector3{ x, half_extents.y + level * (half_extents.y * 2.0f - penetration) - penetration, z });
+			}
+		}
+		return centers;
+	};
+
+	ContactSolver solver;
+	auto fill_solver = [&](const std::vector<Vector3>& centers)
+	{
+		solver.clear();
+		for (auto& center : centers)
+		{
+			const int body = solver.addBody(Box{ center, half_extents }, 1.0f);
+			solver.addStaticContact(body, floor_min, floor_max);
+		}
+		solver.findBodiesContacts([](int bodyA, int bodyB, bool& outMoveA, bool& outMoveB) { return true; });
+	};
+
+	//  run the steps from the same stacks each time: find the contacts, solve them and apply the corrections, like the physics manager does
+	std::vector<Vector3> centers;
+	auto run_steps = [&](float penetration, Jobs* jobs, float& outPenetrationLeft)
+	{
+		double time = 0.0;
+		for (int step = 0; step < stepsCount; step++)
+		{
+			centers = build_stacks(penetration);
+
+			auto start = std::chrono::steady_clock::now();
+			fill_solver(centers);
+			if (solver.getContactsCount() > 0)
+			{
+				solver.solve(8, jobs);
+				for (int i = 0; i < centers.size(); i++)
+				{
+					centers[i] += solver.getCorrection(i);
+				}
+			}
+			time += GetElapsedMilliseconds(start);
+		}
+
+		fill_solver(centers);
+		outPenetrationLeft = solver.getMaxPenetration();
+		return time / stepsCount;
+	};
+
+	Jobs& jobs = Locator::getJobs();
+
+	//  penetrating stacks
+	centers = build_stacks(0.1f);
+	fill_solver(centers);
+	const int contacts_count = solver.getContactsCount();
+	const float first_penetration = solver.getMaxPenetration();
+
+	float serial_penetration = 0.0f, parallel_penetration = 0.0f;
+	const double serial_time = run_steps(0.1f, nullptr, serial_penetration);
+	const double parallel_time = run_steps(0.1f, &jobs, parallel_penetration);
+
+	log.LogMessage_Category("Physics Benchmark: Penetrating stacks (" + std::to_string(contacts_count) + " contacts, deepest penetration " + std::to_string(first_penetration) +
+		") x" + std::to_string(stepsCount) + " | serial: " + std::to_string(serial_time) + " ms/step | jobs (" +
+		std::to_string(jobs.GetThreadsCount()) + " threads): " + std::to_string(parallel_time) + " ms/step", LogCategory::Info);
+	log.LogMessage_Category("Physics Benchmark: Deepest penetration left after one step | serial: " + std::to_string(serial_penetration) + " | jobs: " + std::to_string(parallel_penetration), LogCategory::Info);
+
+	if (Maths::abs(serial_penetration - parallel_penetration) > 0.0001f)
+		log.LogMessage_Category("Physics Benchmark: Penetrating stacks results differ between the serial and the parallel solve.", LogCategory::Warning);
+
+	//  resting stacks, as the collide and slide leaves them: only the contacts search runs
+	float resting_penetration = 0.0f;
+	const double resting_time = run_steps(-Rigidbody::SECURITY_DIST, &jobs, resting_penetration);
+	log.LogMessage_Category("Physics Benchmark: Resting stacks (" + std::to_string(solver.getContactsCount()) + " contacts) x" + std::to_string(stepsCount) +
+		" | " + std::to_string(resting_time) + " ms/step", LogCategory::Info);
+}
+
+void PhysicsBenchmarks::RecordingReplayBenchmark(const std::string& filePath)
+{
+	Log& log = Locator::getLog();
+
+	PhysicsRecording recording;
+	if (!recording.loadFromFile(filePath)) return;
+	if (recording.steps.empty())
+	{
+		log.LogMessage_Category("Physics Benchmark: The recording " + filePath + " has no step to replay.", LogCategory::Warning);
+		return;
+	}
+
+	log.LogMessage_Category("Physics Benchmark: Replay of " + filePath + " (" + std::to_string(recording.steps.size()) + " steps).", LogCategory::Info);
+
+	auto log_replay = [&log](const std::string& name, const PhysicsReplayResults& results)
+	{
+		log.LogMessage_Category("Physics Benchmark: " + name + " | " + std::to_string(results.stepsTime / results.stepsCount) + " ms/step (max " +
+			std::to_string(results.maxStepTime) + " ms) | up to " + std::to_string(results.maxRigidbodiesCount) + " rigidbodies", LogCategory::Info);
+
+		if (results.divergentStep >= 0)
+			log.LogMessage_Category("Physics Benchmark: " + name + " diverges from the recording at step " + std::to_string(results.divergentStep) + ".", LogCategory::Warning);
+		else
+			log.LogMessage_Category("Physics Benchmark: " + name + " is bit-identical to the recording.", LogCategory::Info);
+
+		if (results.raycastsMismatches > 0)
+			log.LogMessage_Category("Physics Benchmark: " + name + " has " + std::to_string(results.raycastsMismatches) + " raycasts that don't give the recorded result.", LogCategory::Warning);
+	};
+
+	PhysicsReplayResults results;
+	PhysicsReplay::Run(recording, true, results);
+	log_replay("Thread pool replay", results);
+
+	PhysicsReplay::Run(recording, false, results);
+	log_replay("Serial replay", results);
+}
+
+void PhysicsBenchmarks::TriangleMeshBenchmark(int trianglesCount, int queriesCount)
+{
+	Log& log = Locator::getLog();
+
+	//  generate a closed bumpy sphere, the bumps stop the BVH from being a perfect grid
+	const int rings = Maths::max(static_cast<int>(std::sqrt(trianglesCount / 4.0f)), 2);
+	const int segments = rings * 2;
+	const float radius = 10.0f;
+
+	std::vector<Vector3> positions;
+	positions.reserve((rings + 1) * segments);
+	for (int ring = 0; ring <= rings; ring++)
+	{
+		const float theta = Maths::pi * ring / rings;
+		for (int segment = 0; segment < segments; segment++)
+		{
+			const float phi = Maths::twoPi * segment / segments;
+			const float bump_radius = radius + 0.5f * std::sin(theta * 9.0f) * std::sin(phi * 7.0f);
+			positions.push_back(Vector3{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) } * bump_radius);
+		}
+	}
+
+	std::vector<unsigned int> indices;
+	indices.reserve(rings * segments * 6);
+	for (int ring = 0; ring < rings; ring++)
+	{
+		for (int segment = 0; segment < segments; segment++)
+		{
+			const unsigned int a = ring * segments + segment;
+			const unsigned int b = ring * segments + (segment + 1) % segments;
+			const unsigned int c = a + segments;
+			const unsigned int d = b + segments;
+			indices.insert(indices.end(), { a, c, b, b, c, d });
+		}
+	}
+
+	TriangleMeshBVH mesh;
+	mesh.addMesh(positions, indices);
+	auto build_start = std::chrono::steady_clock::now();
+	mesh.build();
+	const double build_time = GetElapsedMilliseconds(build_start);
+	log.LogMessage_Category("Physics Benchmark: Triangle mesh BVH of " + std::to_string(mesh.getTrianglesCount()) + " triangles built in " +
+		std::to_string(build_time) + " ms (" + std::to_string(mesh.getNodesCount()) + " nodes).", LogCategory::Info);
+
+	Object mesh_object;
+	mesh_object.setPosition(Vector3{ 5.0f, 2.0f, -3.0f });
+	mesh_object.setRotation(Quaternion::fromEuler(Maths::toRadians(30.0f), Maths::toRadians(20.0f), Maths::toRadians(10.0f)));
+	mesh_object.setScale(Vector3{ 1.5f, 1.0f, 1.2f });
+	TriangleMeshColComp mesh_collision(mesh, &mesh_object, false, "solid");
+	const TriangleMeshTransform transform = mesh_collision.getMeshTransform();
+
+	std::vector<Vector3> world_triangles(mesh.getTrianglesCount() * 3);
+	for (int i = 0; i < mesh.getTrianglesCount(); i++)
+	{
+		const Vector3* vertices = mesh.getTriangle(i);
+		for (int j = 0; j < 3; j++)
+		{
+			world_triangles[i * 3 + j] = transform.toWorld(vertices[j]);
+		}
+	}
+
+	//  generate the queries: lines from outside the mesh, sweeps and overlaps around its surface
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> random_unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> random_distance(radius - 2.0f, radius + 2.0f);
+	auto random_direction = [&]()
+	{
+		Vector3 direction{ random_unit(random), random_unit(random), random_unit(random) };
+		return Maths::nearZero(direction.lengthSq()) ? Vector3::unitY : Vector3::normalize(direction);
+	};
+
+	std::vector<Vector3> line_starts(queriesCount), line_ends(queriesCount), starts(queriesCount), movements(queriesCount);
+	for (int i = 0; i < queriesCount; i++)
+	{
+		line_starts[i] = transform.toWorld(random_direction() * radius * 2.0f);
+		line_ends[i] = transform.toWorld(random_direction() * radius * 0.5f);
+		starts[i] = transform.toWorld(random_direction() * random_distance(random));
+		movements[i] = random_direction();
+	}
+
+	const Box query_box{ Vector3::zero, Vector3{ 0.3f, 0.85f, 0.3f } };
+	const std::vector<std::string> test_channels{ CollisionChannels::DefaultEverything() };
+
+	//  line raycasts
+	auto start = std::chrono::steady_clock::now();
+	int brute_hits = 0;
+	double brute_sum = 0.0;
+	for (int i = 0; i < queriesCount; i++)
+	{
+		float best_fraction = 2.0f;
+		for (int triangle = 0; triangle < mesh.getTrianglesCount(); triangle++)
+		{
+			float fraction = 0.0f;
+			const Vector3* vertices = &world_triangles[triangle * 3];
+			if (TriangleMeshBVH::SegmentTriangleIntersection(line_starts[i], line_ends[i] - line_starts[i], vertices[0], vertices[1], vertices[2], fraction))
+				best_fraction = Maths::min(best_fraction, fraction);
+		}
+		if (best_fraction <= 1.0f)
+		{
+			brute_hits++;
+			brute_sum += best_fraction * (line_ends[i] - line_starts[i]).length();
+		}
+	}
+	double brute_time = GetElapsedMilliseconds(start);
+
+	start = std::chrono::steady_clock::now();
+	int bvh_hits = 0;
+	double bvh_sum = 0.0;
+	for (int i = 0; i < queriesCount; i++)
+	{
+		Ray ray;
+		ray.setupWithStartEnd(line_starts[i], line_ends[i]);
+
+		RaycastHitInfos out;
+		if (mesh_collision.resolveLineRaycast(ray, out, test_channels))
+		{
+			bvh_hits++;
+			bvh_sum += out.hitDistance;
+		}
+	}
+	double bvh_time = GetElapsedMilliseconds(start);
+	LogComparison("Mesh line raycasts", brute_time, bvh_time, queriesCount, brute_hits == bvh_hits && std::abs(brute_sum - bvh_sum) < 0.01 * queriesCount, "BVH");
+
+	//  sweeps
+	start = std::chrono::steady_clock::now();
+	brute_hits = 0;
+	brute_sum = 0.0;
+	for (int i = 0; i < queriesCount; i++)
+	{
+		const Box box{ starts[i], query_box.getHalfExtents() };
+		bool hit = false;
+		float best_time = 2.0f;
+		for (int triangle = 0; triangle < mesh.getTrianglesCount(); triangle++)
+		{
+			const Vector3* vertices = &world_triangles[triangle * 3];
+			SeparatingAxisSweep sweep(box, movements[i]);
+			CollisionsTriangleMesh::TestSeparatingAxes(vertices[0], vertices[1], vertices[2], sweep);
+			if (!sweep.hasHit(true)) continue;
+
+			hit = true;
+			best_time = Maths::min(best_time, sweep.getEnterTime());
+		}
+		if (hit)
+		{
+			brute_hits++;
+			brute_sum += best_time;
+		}
+	}
+	brute_time = GetElapsedMilliseconds(start);
+
+	start = std::chrono::steady_clock::now();
+	bvh_hits = 0;
+	bvh_sum = 0.0;
+	for (int i = 0; i < queriesCount; i++)
+	{
+		Ray ray;
+		ray.setupWithStartEnd(starts[i], starts[i] + movements[i]);
+
+		RaycastHitInfos out;
+		if (mesh_collision.resolveAABBSweepRaycast(ray, Box{ starts[i], query_box.getHalfExtents() }, out, test_channels, true))
+		{
+			bvh_hits++;
+			bvh_sum += out.hitDistance;
+		}
+	}
+	bvh_time = GetElapsedMilliseconds(start);
+	LogComparison("Mesh sweeps (1 unit)", brute_time, bvh_time, queriesCount, brute_hits == bvh_hits && std::abs(brute_sum - bvh_sum) < 0.01 * queriesCount, "BVH");
+
+	//  box overlaps
+	start = std::chrono::steady_clock::now();
+	brute_hits = 0;
+	for (int i = 0; i < queriesCount; i++)
+	{
+		const Box box{ starts[i], query_box.getHalfExtents() };
+		for (int triangle = 0; triangle < mesh.getTrianglesCount(); triangle++)
+		{
+			const Vector3* vertices = &world_triangles[triangle * 3];
+			SeparatingAxisSweep overlap(box, Vector3::zero);
+			CollisionsTriangleMesh::TestSeparatingAxes(vertices[0], vertices[1], vertices[2], overlap);
+			if (overlap.hasHit(false))
+			{
+				brute_hits++;
+				break;
+			}
+		}
+	}
+	brute_time = GetElapsedMilliseconds(start);
+
+	start = std::chrono::steady_clock::now();
+	bvh_hits = 0;
+	for (int i = 0; i < queriesCount; i++)
+	{
+		if (mesh_collision.resolveAABBRaycast(Box{ starts[i], query_box.getHalfExtents() }, test_channels)) bvh_hits++;
+	}
+	bvh_time = GetElapsedMilliseconds(start);
+	LogComparison("Mesh box overlaps", brute_time, bvh_time, queriesCount, brute_hits == bvh_hits, "BVH");
+
+	//  closest points
+	start = std::chrono::steady_clock::now();
+	brute_sum = 0.0;
+	for (int i = 0; i < queriesCount; i++)
+	{
+		float best_distance_sq = std::numeric_limits<float>::max();
+		for (int triangle = 0; triangle < mesh.getTrianglesCount(); triangle++)
+		{
+			const Vector3* vertices = &world_triangles[triangle * 3];
+			const Vector3 closest = TriangleMeshBVH::ClosestPointOnTriangle(starts[i], vertices[0], vertices[1], vertices[2]);
+			best_distance_sq = Maths::min(best_distance_sq, (closest - starts[i]).lengthSq());
+		}
+		brute_sum += std::sqrt(best_distance_sq);
+	}
+	brute_time = GetElapsedMilliseconds(start);
+
+	start = std::chrono::steady_clock::now();
+	bvh_sum = 0.0;
+	for (int i = 0; i < queriesCount; i++)
+	{
+		bvh_sum += (mesh_collision.getClosestPoint(starts[i]) - starts[i]).length();
+	}
+	bvh_time = GetElapsedMilliseconds(start);
+	LogComparison("Mesh closest points", brute_time, bvh_time, queriesCount, std::abs(brute_sum - bvh_sum) < 0.001 * queriesCount, "BVH");
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+
+
+/** Physics Benchmarks
+* Debug functions that measure the physics on generated scenes and log the timings.
+* They don't touch the registered collisions and rigidbodies, so they can run at any time (the engine runs them from the debug view).
+*/
+class PhysicsBenchmarks
+{
+public:
+	/**
+	* Compare the static grid of the broadphase to the brute-force scan of the static collisions,
+	* with line raycasts, short sweeps (rigidbody moves), long sweeps (projectiles) and box overlaps on a generated level.
+	* Also checks that both give the same results.
+	* @param	boxesCount		Number of static boxes of the generated level.
+	* @param	queriesCount	Number of queries of each type.
+	*/
+	static void StaticGridBenchmark(int boxesCount = 50000, int queriesCount = 2000);
+
+	/**
+	* Measure the contact solver on stacks of boxes that penetrate each other and the floor, solved serially and with the thread pool.
+	* Also measures the same stacks without any penetration, which is the cost added to a step where the collide and slide left nothing to solve.
+	* @param	boxesCount		Number of stacked boxes.
+	* @param	stepsCount		Number of solver steps to run.
+	*/
+	static void StackedBoxesBenchmark(int boxesCount = 5000, int stepsCount = 60);
+
+	/**
+	* Replay a recorded physics session headless (see Physics::StartRecording), with the thread pool and serially.
+	* Logs the physics time per step and checks that both replays give the exact same state as the recorded session at each step.
+	* @param	filePath		Path of the recording file.
+	*/
+	static void RecordingReplayBenchmark(const std::string& filePath);
+
+	/**
+	* Compare the BVH of a triangle mesh collision to the brute-force test of all its triangles,
+	* with line raycasts, sweeps, box overlaps and closest points on a generated bumpy sphere (rotated and scaled).
+	* Also checks that both give the same results.
+	* @param	trianglesCount	Approximate number of triangles of the generated mesh.
+	* @param	queriesCount	Number of queries of each type.
+	*/
+	static void TriangleMeshBenchmark(int trianglesCount = 100000, int queriesCount = 2000);
+};
@@ -0,0 +1,156 @@
+#include "physicsEventBuffer.h"
+#include "collisionComponent.h"
+
+
+void RigidbodyStepResult::reset()
+{
+	solved = false;
+	movement = Vector3::zero;
+	gravityMovement = Vector3::zero;
+	movementHits.clear();
+	gravityHits.clear();
+	triggers.clear();
+}
+
+
+
+void PhysicsEventBuffer::recordCollisionHits(RigidbodyComponent& body, const std::vector<CollisionHit>& hits)
+{
+	for (int k = 0; k < hits.size(); k++)
+	{
+		PhysicsEvent intersect_event;
+		intersect_event.type = PhysicsEventType::CollisionIntersect;
+		intersect_event.body = &body;
+		intersect_event.collision = &hits[k].collisionComponent;
+		intersect_event.collisionOwner = hits[k].collisionComponent.getOwningRigidbody();
+		intersect_event.response = CollisionResponse{ hits[k].impactPoint, hits[k].impactNormal };
+		events.push_back(intersect_event);
+
+		if (k != 0) continue;
+
+		//  only the first hit of a pass repulse the rigidbody
+		PhysicsEvent repulse_event;
+		repulse_event.type = PhysicsEventType::CollisionRepulsed;
+		repulse_event.body = &body;
+		repulse_event.response = intersect_event.response;
+		events.push_back(repulse_event);
+	}
+}
+
+void PhysicsEventBuffer::recordTrigger(PhysicsEventType type, RigidbodyComponent& body, const CollisionComponent* trigger)
+{
+	PhysicsEvent trigger_event;
+	trigger_event.type = type;
+	trigger_event.body = &body;
+	trigger_event.collision = trigger;
+	events.push_back(trigger_event);
+}
+
+void PhysicsEventBuffer::recordProjectileHit(const ProjectileHit& hit)
+{
+	PhysicsEvent projectile_event;
+	projectile_event.type = PhysicsEventType::ProjectileHit;
+	projectile_event.collision = hit.hitCollision;
+	projectile_event.response = CollisionResponse{ hit.hitLocation, hit.hitNormal };
+	events.push_back(projectile_event);
+}
+
+void PhysicsEventBuffer::dispatch()
+{
+	dispatching = true;
+
+	//  events are read again after each broadcast since a callback can invalidate them
+	for (size_t i = 0; i < events.size(); i++)
+	{
+		const PhysicsEvent& physics_event = events[i];
+		const CollisionResponse response = physics_event.response;
+
+		switch (physics_event.type)
+		{
+		case PhysicsEventType::CollisionIntersect:
+			if (!physics_event.body || !physics_event.collision) break;
+
+			physics_event.body->getAssociatedCollision().forceIntersected();
+			physics_event.collision->onCollisionIntersect.broadcast(*physics_event.body, response);
+			if (physics_event.collision) physics_event.collision->forceIntersected();
+
+			if (physics_event.body && physics_event.collisionOwner)
+			{
+				physics_event.body->getAssociatedCollisionNonConst().onCollisionIntersect.broadcast(*physics_event.collisionOwner, response);
+			}
+			break;
+
+		case PhysicsEventType::CollisionRepulsed:
+			if (!physics_event.body) break;
+
+			physics_event.body->onCollisionRepulsed.broadcast(response);
+			break;
+
+		case PhysicsEventType::TriggerEnter:
+			if (!physics_event.body || !physics_event.collision) break;
+
+			physics_event.collision->onTriggerEnter.broadcast(*physics_event.body);
+			if (physics_event.collision) physics_event.collision->forceIntersected();
+			break;
+
+		case PhysicsEventType::TriggerStay:
+			if (!physics_event.body || !physics_event.collision) break;
+
+			physics_event.collision->onTriggerStay.broadcast(*physics_event.body);
+			if (physics_event.collision) physics_event.collision->forceIntersected();
+			break;
+
+		case PhysicsEventType::TriggerExit:
+			if (!physics_event.body || !physics_event.collision) break;
+
+			physics_event.collision->onTriggerExit.broadcast(*physics_event.body);
+			break;
+
+		case PhysicsEventType::ProjectileHit:
+			if (!physics_event.collision) break;
+
+			physics_event.collision->onRaycastIntersect.broadcast(RaycastType::RaycastTypeProjectile, response.impactPoint);
+			if (physics_event.collision) physics_event.collision->forceIntersected();
+			break;
+		}
+	}
+
+	dispatching = false;
+	events.clear();
+}
+
+void PhysicsEventBuffer::invalidateRigidbody(const RigidbodyComponent* body)
+{
+	const CollisionComponent* body_collision = body->isAssociatedCollisionValid() ? &body->getAssociatedCollision() : nullptr;
+
+	for (auto& physics_event : events)
+	{
+		if (physics_event.body == body) physics_event.body = nullptr;
+		if (physics_event.collisionOwner == body) physics_event.collisionOwner = nullptr;
+		if (body_collision && physics_event.collision == body_collision) physics_event.collision = nullptr;
+	}
+}
+
+void PhysicsEventBuffer::invalidateCollision(const CollisionComponent* collision)
+{
+	for (auto& physics_event : events)
+	{
+		if (physics_event.collision == collision) physics_event.collision = nullptr;
+	}
+}
+
+void PhysicsEventBuffer::clear()
+{
+	if (!dispatching)
+	{
+		events.clear();
+		return;
+	}
+
+	for (auto& physics_event : events)
+	{
+		physics_event.body = nullptr;
+		physics_event.collision = nullptr;
+		physics_event.collisionOwner = nullptr;
+	}
+}
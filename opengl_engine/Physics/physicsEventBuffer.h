@@ -0,0 +1,104 @@
+#pragma once
+#include "rigidbodyComponent.h"
+#include "collisionTests.h"
+#include "projectileSystem.h"
+
+#include <vector>
+
+class CollisionComponent;
+
+
+/**
+* Result of the collide and slide of one rigidbody during a physics step.
+* Written by the solve (possibly from a worker thread), read back on the main thread.
+*/
+struct RigidbodyStepResult
+{
+	bool solved{ false };
+	Vector3 movement{ Vector3::zero };
+	Vector3 gravityMovement{ Vector3::zero };
+	std::vector<CollisionHit> movementHits;
+	std::vector<CollisionHit> gravityHits;
+	std::vector<const CollisionComponent*> triggers;
+
+	void reset();
+};
+
+
+enum class PhysicsEventType : uint8_t
+{
+	CollisionIntersect = 0,
+	CollisionRepulsed = 1,
+	TriggerEnter = 2,
+	TriggerStay = 3,
+	TriggerExit = 4,
+	ProjectileHit = 5
+};
+
+struct PhysicsEvent
+{
+	PhysicsEventType type{ PhysicsEventType::CollisionIntersect };
+	RigidbodyComponent* body{ nullptr };
+	const CollisionComponent* collision{ nullptr };
+	RigidbodyComponent* collisionOwner{ nullptr };
+	CollisionResponse response;
+};
+
+
+/** Physics Event Buffer
+* Stores the physics events of a step so that they are broadcasted once the step is over, on the main thread.
+* Gameplay callbacks can then create or delete rigidbodies and collisions:
+* the events that target a deleted one are invalidated and skipped.
+*/
+class PhysicsEventBuffer
+{
+public:
+	/**
+	* Record the events of a rigidbody collide and slide pass, in the order they used to be broadcasted.
+	* @param	body	Rigidbody that did the pass.
+	* @param	hits	Collisions hit during the pass.
+	*/
+	void recordCollisionHits(RigidbodyComponent& body, const std::vector<CollisionHit>& hits);
+
+	/**
+	* Record a trigger event between a rigidbody and a trigger.
+	* @param	type		Trigger event type (enter, stay or exit).
+	* @param	body		Rigidbody that overlaps the trigger.
+	* @param	trigger		Trigger collision.
+	*/
+	void recordTrigger(PhysicsEventType type, RigidbodyComponent& body, const CollisionComponent* trigger);
+
+	/**
+	* Record the hit of a projectile, broadcasted on the hit collision as a projectile raycast intersection.
+	* @param	hit		Hit of the projectile.
+	*/
+	void recordProjectileHit(const ProjectileHit& hit);
+
+	/**
+	* Broadcast all the recorded events then clear the buffer.
+	*/
+	void dispatch();
+
+	/**
+	* Make sure no event will be broadcasted on or with the given rigidbody (and its associated collision).
+	* @param	body	Rigidbody that is being removed from the physics.
+	*/
+	void invalidateRigidbody(const RigidbodyComponent* body);
+
+	/**
+	* Make sure no event will be broadcasted on or with the given collision.
+	* @param	collision	Collision that is being removed from the physics.
+	*/
+	void invalidateCollision(const CollisionComponent* collision);
+
+	/**
+	* Remove all the recorded events. If called during the dispatch, the remaining events are invalidated instead.
+	*/
+	void clear();
+
+	inline size_t getEventsCount() const { return events.size(); }
+
+private:
+	std::vector<PhysicsEvent> events;
+	bool dispatching{ false };
+};
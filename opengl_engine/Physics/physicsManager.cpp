@@ -1,4 +1,5 @@
 #include "physicsManager.h"
+#include "physicsReplay.h"
 
 #include "raycastLine.h"
 #include "AABB/raycastAABB.h"
@@ -17,26 +18,35 @@
 CollisionComponent& PhysicsManager::CreateCollisionComponent(CollisionComponent* colComp)
 {
 	if(enableInfoLogs) Locator::getLog().LogMessage_Category("Physics: Create a collision.", LogCategory::Info);
-	collisionsComponents.push_back(colComp);
+	colComp->physicsHandle = collisionsComponents.insert(colComp);
 
-	CollisionComponent& col = *(collisionsComponents.back());
+	CollisionComponent& col = *colComp;
 	col.registered = true;
+	recorder.recordCollisionCreated(&col);
 	return col;
 }
 
 void PhysicsManager::RemoveCollision(CollisionComponent* colComp)
 {
-	auto iter = std::find(collisionsComponents.begin(), collisionsComponents.end(), colComp);
-	if (iter == collisionsComponents.end())
+	CollisionComponent** registered_collision = collisionsComponents.get(colComp->physicsHandle);
+	if (!registered_collision || *registered_collision != colComp)
 	{
 		Locator::getLog().LogMessage_Category("Physics: Failed to remove a collision.", LogCategory::Error);
 		return;
 	}
 
-	std::iter_swap(iter, collisionsComponents.end() - 1);
-	CollisionComponent& col = *(collisionsComponents.back());
-	col.registered = false;
-	collisionsComponents.pop_back();
+	collisionsComponents.remove(colComp->physicsHandle);
+	colComp->physicsHandle = SlotHandle{};
+	colComp->registered = false;
+	recorder.recordCollisionRemoved(colComp);
+
+	stepEvents.invalidateCollision(colComp); //  in case it is removed by a physics event callback
+	invalidateProjectileHits(colComp);
+	broadphase.removeCollision(colComp);
+	if (colComp->getCollisionType() == CollisionType::Trigger) triggerOverlaps.removeTrigger(colComp);
+
+	//  a sleeping rigidbody might have been resting on this collision
+	if (colComp->getCollisionType() == CollisionType::Solid) wakeAllRequested = true;
 
 	if (enableInfoLogs) Locator::getLog().LogMessage_Category("Physics: Successfully removed a collision.", LogCategory::Info);
 }
@@ -44,44 +54,70 @@ void PhysicsManager::RemoveCollision(CollisionComponent* colComp)
 RigidbodyComponent& PhysicsManager::CreateRigidbodyComponent(RigidbodyComponent* rigidbodyComp)
 {
 	if (enableInfoLogs) Locator::getLog().LogMessage_Category("Physics: Create a rigidbody.", LogCategory::Info);
-	rigidbodiesComponents.push_back(rigidbodyComp);
+	rigidbodyComp->physicsHandle = rigidbodiesComponents.insert(rigidbodyComp);
 
-	RigidbodyComponent& rigidbody = *(rigidbodiesComponents.back());
+	RigidbodyComponent& rigidbody = *rigidbodyComp;
 	rigidbody.registered = true;
+	rigidbodyStorage.setFlag(rigidbody.storageIndex, RigidbodyFlags::Registered, true);
+	recorder.recordRigidbodyCreated(&rigidbody);
 	return rigidbody;
 }
 
 void PhysicsManager::RemoveRigidbody(RigidbodyComponent* rigidbodyComp)
 {
-	auto iter = std::find(rigidbodiesComponents.begin(), rigidbodiesComponents.end(), rigidbodyComp);
-	if (iter == rigidbodiesComponents.end())
+	RigidbodyComponent** registered_rigidbody = rigidbodiesComponents.get(rigidbodyComp->physicsHandle);
+	if (!registered_rigidbody || *registered_rigidbody != rigidbodyComp)
 	{
 		Locator::getLog().LogMessage_Category("Physics: Failed to remove a rigidbody", LogCategory::Error);
 		return;
 	}
 
-	std::iter_swap(iter, rigidbodiesComponents.end() - 1);
-	RigidbodyComponent& rigidbody = *(rigidbodiesComponents.back());
-	rigidbody.registered = false;
-	rigidbodiesComponents.pop_back();
+	rigidbodiesComponents.remove(rigidbodyComp->physicsHandle);
+	rigidbodyComp->physicsHandle = SlotHandle{};
+	rigidbodyComp->registered = false;
+	rigidbodyStorage.setFlag(rigidbodyComp->storageIndex, RigidbodyFlags::Registered, false);
+	recorder.recordRigidbodyRemoved(rigidbodyComp);
+
+	stepEvents.invalidateRigidbody(rigidbodyComp); //  in case it is removed by a physics event callback
+	triggerOverlaps.removeRigidbody(rigidbodyComp);
+	if (rigidbodyComp->isAssociatedCollisionValid())
+	{
+		invalidateProjectileHits(&rigidbodyComp->getAssociatedCollision());
+		broadphase.removeCollision(&rigidbodyComp->getAssociatedCollisionNonConst());
+	}
+
+	//  only the rigidbodies that touched this one wake up: its sleep island, and the rigidbodies it hit (or that hit it) this step
+	if (rigidbodyComp->isAsleep()) removedBodiesIslands.push_back(rigidbodyComp->getSleepIslandId());
+	for (auto& contact : stepContacts)
+	{
+		if (contact.first == rigidbodyComp) contact.second->requestWakeUp();
+		else if (contact.second == rigidbodyComp) contact.first->requestWakeUp();
+	}
+	stepContacts.erase(std::remove_if(stepContacts.begin(), stepContacts.end(),
+		[rigidbodyComp](const std::pair<RigidbodyComponent*, RigidbodyComponent*>& contact) { return contact.first == rigidbodyComp || contact.second == rigidbodyComp; }),
+		stepContacts.end());
 
 	if (enableInfoLogs) Locator::getLog().LogMessage_Category("Physics: Successfully removed a rigidbody.", LogCategory::Info);
 }
 
+RigidbodyStorage& PhysicsManager::GetRigidbodyStorage()
+{
+	return rigidbodyStorage;
+}
+
 
 
 // ===============================================
 //  ---------------- Raycasts -------------------
 // ===============================================
 
-bool PhysicsManager::LineRaycast(const Vector3& start, const Vector3& end, const std::vector<std::string> testChannels, RaycastHitInfos& outHitInfos, float drawDebugTime, bool createOnScene)
+bool PhysicsManager::LineRaycast(const Vector3& start, const Vector3& end, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos, float drawDebugTime, bool createOnScene)
 {
 	outHitInfos = RaycastHitInfos();
 
 	bool hit = false;
 
-	std::vector<std::string> test_channels = testChannels;
-	if (test_channels.empty()) test_channels = CollisionChannels::GetRegisteredTestChannel("TestEverything");
+	const std::vector<std::string>& test_channels = testChannels.empty() ? CollisionChannels::GetRegisteredTestChannel("TestEverything") : testChannels;
 
 	if (drawDebugTime != 0.0f)
 	{
@@ -95,9 +131,12 @@ bool PhysicsManager::LineRaycast(const Vector3& start, const Vector3& end, const
 
 		for (auto& col : collisionsComponents)
 		{
+			if (col->bakedInBroadphase) continue; //  tested through the broadphase static grid
 			bool col_hit = col->resolveLineRaycast(ray, outHitInfos, test_channels);
 			hit = hit || col_hit;
 		}
+		bool static_hit = broadphase.lineRaycastStatic(ray, test_channels, outHitInfos);
+		hit = hit || static_hit;
 		for (auto& body : rigidbodiesComponents)
 		{
 			const CollisionComponent& col = body->getAssociatedCollision();
@@ -113,6 +152,7 @@ bool PhysicsManager::LineRaycast(const Vector3& start, const Vector3& end, const
 
 		if (hit) raycast.setHitPos(outHitInfos.hitLocation);
 
+		recorder.recordLineRaycast(start, end, testChannels, hit, outHitInfos);
 		return hit;
 	}
 	else //  do not register the raycast in the list if it will not draw debug
@@ -123,9 +163,12 @@ bool PhysicsManager::LineRaycast(const Vector3& start, const Vector3& end, const
 
 		for (auto& col : collisionsComponents)
 		{
+			if (col->bakedInBroadphase) continue; //  tested through the broadphase static grid
 			bool col_hit = col->resolveLineRaycast(ray, outHitInfos, test_channels);
 			hit = hit || col_hit;
 		}
+		bool static_hit = broadphase.lineRaycastStatic(ray, test_channels, outHitInfos);
+		hit = hit || static_hit;
 		for (auto& body : rigidbodiesComponents)
 		{
 			const CollisionComponent& col = body->getAssociatedCollision();
@@ -142,16 +185,16 @@ bool PhysicsManager::LineRaycast(const Vector3& start, const Vector3& end, const
 
 		//  finally no need to set the hit pos on the raycast if it will not draw debug
 
+		recorder.recordLineRaycast(start, end, testChannels, hit, outHitInfos);
 		return hit;
 	}
 }
 
-bool PhysicsManager::AABBRaycast(const Vector3& location, const Box& aabbBox, const std::vector<std::string> testChannels, float drawDebugTime, bool createOnScene)
+bool PhysicsManager::AABBRaycast(const Vector3& location, const Box& aabbBox, const std::vector<std::string>& testChannels, float drawDebugTime, bool createOnScene)
 {
 	bool hit = false;
 
-	std::vector<std::string> test_channels = testChannels;
-	if (test_channels.empty()) test_channels = CollisionChannels::GetRegisteredTestChannel("TestEverything");
+	const std::vector<std::string>& test_channels = testChannels.empty() ? CollisionChannels::GetRegisteredTestChannel("TestEverything") : testChannels;
 
 	std::vector<const CollisionComponent*> intersected_cols;
 
@@ -167,16 +210,19 @@ bool PhysicsManager::AABBRaycast(const Vector3& location, const Box& aabbBox, co
 
 		for (auto col : collisionsComponents)
 		{
+			if (col->bakedInBroadphase) continue; //  tested through the broadphase static grid
 			if (col->resolveAABBRaycast(box, test_channels))
 			{
 				hit = true;
 				intersected_cols.push_back(col);
 			}
 		}
+		bool static_hit = broadphase.aabbRaycastStatic(box, test_channels, intersected_cols);
+		hit = hit || static_hit;
 		for (auto body : rigidbodiesComponents)
 		{
 			const CollisionComponent& col = body->getAssociatedCollision();
-			if (col.resolveAABBRaycast(box, testChannels))
+			if (col.resolveAABBRaycast(box, test_channels))
 			{
 				hit = true;
 				intersected_cols.push_back(&col);
@@ -190,6 +236,7 @@ bool PhysicsManager::AABBRaycast(const Vector3& location, const Box& aabbBox, co
 
 		if (hit) raycast.setHit();
 
+		recorder.recordAABBRaycast(location, aabbBox, testChannels, hit);
 		return hit;
 	}
 	else //  do not register the raycast in the list if it will not draw debug
@@ -200,16 +247,19 @@ bool PhysicsManager::AABBRaycast(const Vector3& location, const Box& aabbBox, co
 
 		for (auto col : collisionsComponents)
 		{
+			if (col->bakedInBroadphase) continue; //  tested through the broadphase static grid
 			if (col->resolveAABBRaycast(box, test_channels))
 			{
 				hit = true;
 				intersected_cols.push_back(col);
 			}
 		}
+		bool static_hit = broadphase.aabbRaycastStatic(box, test_channels, intersected_cols);
+		hit = hit || static_hit;
 		for (auto body : rigidbodiesComponents)
 		{
 			const CollisionComponent& col = body->getAssociatedCollision();
-			if (col.resolveAABBRaycast(box, testChannels))
+			if (col.resolveAABBRaycast(box, test_channels))
 			{
 				hit = true;
 				intersected_cols.push_back(&col);
@@ -225,18 +275,18 @@ bool PhysicsManager::AABBRaycast(const Vector3& location, const Box& aabbBox, co
 
 		//  finally no need to set the hit on the raycast if it will not draw debug
 
+		recorder.recordAABBRaycast(location, aabbBox, testChannels, hit);
 		return hit;
 	}
 }
 
-bool PhysicsManager::AABBSweepRaycast(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string> testChannels, RaycastHitInfos& outHitInfos, float drawDebugTime, bool createOnScene, bool forCollisionTest)
+bool PhysicsManager::AABBSweepRaycast(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string>& testChannels, RaycastHitInfos& outHitInfos, float drawDebugTime, bool createOnScene, bool forCollisionTest)
 {
 	outHitInfos = RaycastHitInfos();
 
 	bool hit = false;
 
-	std::vector<std::string> test_channels = testChannels;
-	if (test_channels.empty()) test_channels = CollisionChannels::GetRegisteredTestChannel("TestEverything");
+	const std::vector<std::string>& test_channels = testChannels.empty() ? CollisionChannels::GetRegisteredTestChannel("TestEverything") : testChannels;
 
 	if (drawDebugTime != 0.0f)
 	{
@@ -251,9 +301,12 @@ bool PhysicsManager::AABBSweepRaycast(const Vector3& start, const Vector3& end,
 
 		for (auto& col : collisionsComponents)
 		{
+			if (col->bakedInBroadphase) continue; //  tested through the broadphase static grid
 			bool col_hit = col->resolveAABBSweepRaycast(ray, box, outHitInfos, test_channels, forCollisionTest);
 			hit = hit || col_hit;
 		}
+		bool static_hit = broadphase.aabbSweepRaycastStatic(ray, box, test_channels, outHitInfos, forCollisionTest);
+		hit = hit || static_hit;
 		for (auto& body : rigidbodiesComponents)
 		{
 			const CollisionComponent& col = body->getAssociatedCollision();
@@ -268,6 +321,7 @@ bool PhysicsManager::AABBSweepRaycast(const Vector3& start, const Vector3& end,
 
 		raycast.setValues(hit, outHitInfos.hitLocation);
 
+		recorder.recordAABBSweepRaycast(start, end, aabbBox, testChannels, hit, outHitInfos);
 		return hit;
 	}
 	else //  do not register the raycast in the list if it will not draw debug
@@ -279,9 +333,12 @@ bool PhysicsManager::AABBSweepRaycast(const Vector3& start, const Vector3& end,
 
 		for (auto& col : collisionsComponents)
 		{
+			if (col->bakedInBroadphase) continue; //  tested through the broadphase static grid
 			bool col_hit = col->resolveAABBSweepRaycast(ray, box, outHitInfos, test_channels, forCollisionTest);
 			hit = hit || col_hit;
 		}
+		bool static_hit = broadphase.aabbSweepRaycastStatic(ray, box, test_channels, outHitInfos, forCollisionTest);
+		hit = hit || static_hit;
 		for (auto& body : rigidbodiesComponents)
 		{
 			const CollisionComponent& col = body->getAssociatedCollision();
@@ -298,12 +355,157 @@ bool PhysicsManager::AABBSweepRaycast(const Vector3& start, const Vector3& end,
 
 		//  finally no need to set the values of the raycast if it will not draw debug
 
+		recorder.recordAABBSweepRaycast(start, end, aabbBox, testChannels, hit, outHitInfos);
 		return hit;
 	}
 }
 
 
 
+// ===============================================
+//  --------------- Scene Queries ---------------
+// ===============================================
+
+int PhysicsManager::OverlapBox(const Box& aabbBox, std::vector<const CollisionComponent*>& outCollisions, const std::vector<std::string>& testChannels)
+{
+	outCollisions.clear();
+
+	const std::vector<std::string>& test_channels = testChannels.empty() ? CollisionChannels::GetRegisteredTestChannel("TestEverything") : testChannels;
+
+	queryCandidates.clear();
+	gatherQueryCandidates(aabbBox.getMinPoint(), aabbBox.getMaxPoint(), test_channels, queryCandidates);
+
+	for (auto col : queryCandidates)
+	{
+		if (col->resolveAABBRaycast(aabbBox, test_channels)) outCollisions.push_back(col);
+	}
+
+	return static_cast<int>(outCollisions.size());
+}
+
+int PhysicsManager::OverlapSphere(const Vector3& center, float radius, std::vector<const CollisionComponent*>& outCollisions, const std::vector<std::string>& testChannels)
+{
+	outCollisions.clear();
+
+	const std::vector<std::string>& test_channels = testChannels.empty() ? CollisionChannels::GetRegisteredTestChannel("TestEverything") : testChannels;
+
+	const Vector3 radius_extents{ radius, radius, radius };
+	queryCandidates.clear();
+	gatherQueryCandidates(center - radius_extents, center + radius_extents, test_channels, queryCandidates);
+
+	const float radius_sq = radius * radius;
+	for (auto col : queryCandidates)
+	{
+		if ((col->getClosestPoint(center) - center).lengthSq() <= radius_sq) outCollisions.push_back(col);
+	}
+
+	return static_cast<int>(outCollisions.size());
+}
+
+bool PhysicsManager::ClosestCollider(const Vector3& point, float maxDistance, ColliderDistanceInfos& outInfos, const std::vector<std::string>& testChannels)
+{
+	outInfos = ColliderDistanceInfos();
+
+	if (KNearest(point, 1, maxDistance, queryNearest, testChannels) == 0) return false;
+
+	outInfos = queryNearest[0];
+	return true;
+}
+
+int PhysicsManager::KNearest(const Vector3& point, int count, float maxDistance, std::vector<ColliderDistanceInfos>& outInfos, const std::vector<std::string>& testChannels)
+{
+	outInfos.clear();
+	if (count <= 0 || maxDistance < 0.0f) return 0;
+
+	const std::vector<std::string>& test_channels = testChannels.empty() ? CollisionChannels::GetRegisteredTestChannel("TestEverything") : testChannels;
+
+	//  search in a growing box: every collision closer than the search radius overlaps the box, so once k of them are found the result is exact
+	const StaticGrid& static_grid = broadphase.getStaticGrid();
+	float search_radius = static_grid.isBuilt() ? Maths::min(static_grid.getCellSize(), maxDistance) : maxDistance;
+	while (true)
+	{
+		const Vector3 radius_extents{ search_radius, search_radius, search_radius };
+		queryCandidates.clear();
+		gatherQueryCandidates(point - radius_extents, point + radius_extents, test_channels, queryCandidates);
+
+		outInfos.clear();
+		for (auto col : queryCandidates)
+		{
+			ColliderDistanceInfos infos;
+			infos.collision = col;
+			infos.closestPoint = col->getClosestPoint(point);
+			infos.distance = (infos.closestPoint - point).length();
+			if (infos.distance <= search_radius) outInfos.push_back(infos);
+		}
+
+		if (static_cast<int>(outInfos.size()) >= count || search_radius >= maxDistance) break;
+
+		search_radius = Maths::min(search_radius * 2.0f, maxDistance);
+	}
+
+	auto closer = [](const ColliderDistanceInfos& a, const ColliderDistanceInfos& b) { return a.distance < b.distance; };
+	if (static_cast<int>(outInfos.size()) > count)
+	{
+		std::partial_sort(outInfos.begin(), outInfos.begin() + count, outInfos.end(), closer);
+		outInfos.resize(count);
+	}
+	else
+	{
+		std::sort(outInfos.begin(), outInfos.end(), closer);
+	}
+
+	return static_cast<int>(outInfos.size());
+}
+
+int PhysicsManager::GetObjectCollisions(const Object& object, std::vector<const CollisionComponent*>& outCollisions)
+{
+	outCollisions.clear();
+
+	for (auto col : collisionsComponents)
+	{
+		if (col->getAssociatedObject() == &object) outCollisions.push_back(col);
+	}
+
+	return static_cast<int>(outCollisions.size());
+}
+
+void PhysicsManager::gatherQueryCandidates(const Vector3& boxMin, const Vector3& boxMax, const std::vector<std::string>& testChannels, std::vector<const CollisionComponent*>& outCandidates) const
+{
+	auto bounds_overlap = [&boxMin, &boxMax](const CollisionComponent& col)
+	{
+		const Box bounds = col.getEncapsulatingBox();
+		const Vector3 bounds_min = bounds.getMinPoint();
+		const Vector3 bounds_max = bounds.getMaxPoint();
+		return
+			boxMin.x <= bounds_max.x && boxMax.x >= bounds_min.x &&
+			boxMin.y <= bounds_max.y && boxMax.y >= bounds_min.y &&
+			boxMin.z <= bounds_max.z && boxMax.z >= bounds_min.z;
+	};
+
+	//  baked static collisions never move, so the broadphase can be used even outside of the step
+	const size_t static_start = outCandidates.size();
+	broadphase.gatherStatic(boxMin, boxMax, outCandidates);
+	outCandidates.erase(std::remove_if(outCandidates.begin() + static_start, outCandidates.end(),
+		[&testChannels](const CollisionComponent* col) { return !col->channelTest(testChannels); }), outCandidates.end());
+
+	for (auto col : collisionsComponents)
+	{
+		if (col->bakedInBroadphase) continue;
+		if (!col->channelTest(testChannels)) continue;
+		if (bounds_overlap(*col)) outCandidates.push_back(col);
+	}
+	for (auto body : rigidbodiesComponents)
+	{
+		if (!body->isAssociatedCollisionValid()) continue;
+
+		const CollisionComponent& col = body->getAssociatedCollision();
+		if (!col.channelTest(testChannels)) continue;
+		if (bounds_overlap(col)) outCandidates.push_back(&col);
+	}
+}
+
+
+
 // ===============================================
 //  ----------------- Update --------------------
 // ===============================================
@@ -315,15 +517,37 @@ void PhysicsManager::InitialisePhysics()
 
 void PhysicsManager::UpdatePhysics(float dt)
 {
+	//  record what the gameplay changed since the last step
+	recorder.beginStep(dt);
+
 	//  reset the 'intersected last frame' parameter
+	bool triggers_moved = false;
 	for (auto& col : collisionsComponents)
 	{
 		col->resetIntersected();
+
+		if (col->getCollisionType() == CollisionType::Trigger && !col->bakedInBroadphase)
+		{
+			if (triggerOverlaps.checkTriggerMoved(col)) triggers_moved = true;
+		}
 	}
-	for (auto& rigidbody : rigidbodiesComponents)
+
+	//  wake up the sleeping rigidbodies that need it, with their whole island
+	wakeUpRigidbodies();
+
+	//  gravity and anticipated movements only need the simulation state, they run over the storage arrays
+	rigidbodyStorage.integrateGravity(dt, gravity);
+	rigidbodyStorage.computeAnticipatedMovements(dt);
+
+	awakeBodies.clear();
+	for (int i = 0; i < rigidbodiesComponents.size(); i++)
 	{
+		RigidbodyComponent* rigidbody = rigidbodiesComponents[i];
 		rigidbody->resetIntersected();
-		rigidbody->updatePhysicsPreCollision(dt); //  compute the anticipated movements for physics activated rigidbodies, and apply the movement for non-physics activated ones
+		if (rigidbody->isAsleep()) continue; //  sleeping rigidbodies cost nothing until they wake up
+
+		awakeBodies.push_back(i);
+		rigidbody->updatePhysicsPreCollision(dt); //  apply the velocity one frame, and the movement for non-physics activated ones
 	}
 
 	//  delete raycasts that have run out of time
@@ -342,100 +566,298 @@ void PhysicsManager::UpdatePhysics(float dt)
 		}
 	}
 
-	//  test all the rigidbodies
+	//  take a snapshot of the collisions bounds, it stays read-only during the whole solve
+	broadphase.rebuild(collisionsComponents.getValues(), rigidbodiesComponents.getValues());
+
+	//  solve all the awake rigidbodies, nothing is written outside of their step result so it can be done in parallel
+	const int bodies_count = static_cast<int>(rigidbodiesComponents.size());
+	const int awake_count = static_cast<int>(awakeBodies.size());
+	if (stepResults.size() < bodies_count) stepResults.resize(bodies_count);
+
+	auto solve_job = [this](int index) { solveRigidbody(*rigidbodiesComponents[awakeBodies[index]], stepResults[awakeBodies[index]]); };
+	if (enableMultithreading && awake_count >= minBodiesForMultithreading)
+	{
+		Locator::getJobs().ParallelFor(awake_count, solve_job);
+	}
+	else
+	{
+		for (int i = 0; i < awake_count; i++) solve_job(i);
+	}
+
+	//  move the projectiles through the same snapshot
+	projectileHits.clear();
+	projectiles.update(dt, broadphase, enableMultithreading ? &Locator::getJobs() : nullptr, projectileHits);
+
+	//  apply the computed movements and record the events in the order they used to be broadcasted
+	stepContacts.clear();
+	stepContactsValid = true;
+	for (int awake_index : awakeBodies)
+	{
+		const RigidbodyStepResult& result = stepResults[awake_index];
+		if (!result.solved) continue;
+
+		RigidbodyComponent& rigidbody = *rigidbodiesComponents[awake_index];
+		rigidbody.applyComputedMovement(result.movement);
+		rigidbody.applyComputedGravityMovement(result.gravityMovement);
+
+		stepEvents.recordCollisionHits(rigidbody, result.movementHits);
+		stepEvents.recordCollisionHits(rigidbody, result.gravityHits);
+		triggerOverlaps.addCrossedTriggers(rigidbody, result.triggers);
+
+		recordContacts(rigidbody, result.movementHits);
+		recordContacts(rigidbody, result.gravityHits);
+	}
+
+	for (auto& hit : projectileHits)
+	{
+		stepEvents.recordProjectileHit(hit);
+	}
+
+	//  rigidbodies hit by an awake one are woken up before the events, so that they react to it
+	wakeUpRigidbodies();
+
+	//  broadcast the physics events once the solve is over, gameplay callbacks can safely create and delete bodies from here
+	recorder.beginEventsWindow(PhysicsStepPoint::AfterCollisionsEvents);
+	stepEvents.dispatch();
+
+	//  all the projectiles hits of the step are broadcasted at once
+	if (!projectileHits.empty()) onProjectilesHit.broadcast(projectileHits);
+	recorder.endEventsWindow();
+	if (replay) replay->applyCommands(PhysicsStepPoint::AfterCollisionsEvents);
+
+
+	for (auto& rigidbody : rigidbodiesComponents)
+	{
+		if (rigidbody->isAsleep()) continue;
+		rigidbody->updatePhysicsPostCollision(dt); // apply rigidbody movement for physic activated ones
+	}
+
+	//  push apart what is still penetrating after the movements
+	if (enableContactSolver) resolvePenetrations();
+
+	//  now that the rigidbodies moved, update the trigger overlaps and broadcast their events
+	triggerOverlaps.update(broadphase, rigidbodiesComponents.getValues(), triggers_moved, stepEvents);
+	recorder.beginEventsWindow(PhysicsStepPoint::AfterTriggersEvents);
+	stepEvents.dispatch();
+	recorder.endEventsWindow();
+	if (replay) replay->applyCommands(PhysicsStepPoint::AfterTriggersEvents);
+
+	//  put to sleep the islands whose rigidbodies are all resting
+	updateSleepIslands(dt);
+
+	recorder.endStep();
+}
+
+
+void PhysicsManager::resolvePenetrations()
+{
+	contactSolver.clear();
+	solverBodies.clear();
+
+	//  the awake physics activated rigidbodies are the bodies of the solver, with their bounds after the movements
+	//  (the awake bodies list can't be used, rigidbodies may have been created or removed by the events)
 	for (int i = 0; i < rigidbodiesComponents.size(); i++)
 	{
 		RigidbodyComponent& rigidbody = *rigidbodiesComponents[i];
-		if (!rigidbody.isAssociatedCollisionValid()) continue;
+		if (rigidbody.isAsleep() || !rigidbody.isPhysicsActivated()) continue;
+		if (rigidbody.getAssociatedCollision().getCollisionType() == CollisionType::Trigger) continue;
+
+		contactSolver.addBody(rigidbody.getAssociatedCollision().getEncapsulatingBox(), rigidbody.getInverseMass());
+		solverBodies.push_back(i);
+	}
+	if (solverBodies.empty()) return;
 
-		if (rigidbody.isPhysicsActivated())
+	//  contacts against the collisions that the solver can't move: static and dynamic collisions, non physics activated and sleeping rigidbodies
+	for (int body = 0; body < solverBodies.size(); body++)
+	{
+		const RigidbodyComponent& rigidbody = *rigidbodiesComponents[solverBodies[body]];
+		const CollisionComponent& body_collision = rigidbody.getAssociatedCollision();
+		const Box body_box = body_collision.getEncapsulatingBox();
+		const Vector3 body_min = body_box.getMinPoint();
+		const Vector3 body_max = body_box.getMaxPoint();
+
+		contactCandidates.clear();
+		broadphase.gatherStatic(body_min, body_max, contactCandidates);
+		broadphase.gatherDynamic(body_min, body_max, contactCandidates);
+
+		const std::vector<std::string>& test_channels = rigidbody.getTestChannels();
+		for (auto candidate : contactCandidates)
 		{
-			//  compute body movement with collisions
-			Vector3 body_movement = Vector3::zero;
-			std::vector<CollisionHit> col_responses;
-			std::vector<const CollisionComponent*> triggers_detected;
-			bool hit = CollisionTests::RigidbodyCollideAndSlideAABB(rigidbody, false, body_movement, col_responses, triggers_detected);
-			if (hit)
-			{
-				rigidbody.getAssociatedCollision().forceIntersected();
-				for (int k = 0; k < col_responses.size(); k++)
-				{
-					CollisionResponse col_datas = { col_responses[k].impactPoint, col_responses[k].impactNormal };
-
-					col_responses[k].collisionComponent.onCollisionIntersect.broadcast(rigidbody, col_datas);
-					col_responses[k].collisionComponent.forceIntersected();
-
-					if (col_responses[k].collisionComponent.usedByRigidbody())
-					{
-						rigidbody.getAssociatedCollisionNonConst().onCollisionIntersect.broadcast(*(col_responses[k].collisionComponent.getOwningRigidbody()), col_datas);
-					}
-
-					if (k != 0) continue;
-					rigidbody.onCollisionRepulsed.broadcast(CollisionResponse{ col_responses[k].impactPoint, col_responses[k].impactNormal });
-				}
-			}
-			rigidbody.applyComputedMovement(body_movement);
+			if (candidate == &body_collision || candidate->getCollisionType() == CollisionType::Trigger) continue;
 
-			//  compute body gravity movement with collisions
-			Vector3 gravity_movement = Vector3::zero;
-			col_responses.clear();
-			hit = CollisionTests::RigidbodyCollideAndSlideAABB(rigidbody, true, gravity_movement, col_responses, triggers_detected);
-			if (hit)
-			{
-				rigidbody.getAssociatedCollision().forceIntersected();
-				for (int k = 0; k < col_responses.size(); k++)
-				{
-					CollisionResponse col_datas = { col_responses[k].impactPoint, col_responses[k].impactNormal };
-
-					col_responses[k].collisionComponent.onCollisionIntersect.broadcast(rigidbody, col_datas);
-					col_responses[k].collisionComponent.forceIntersected();
-
-					if (col_responses[k].collisionComponent.usedByRigidbody())
-					{
-						rigidbody.getAssociatedCollisionNonConst().onCollisionIntersect.broadcast(*(col_responses[k].collisionComponent.getOwningRigidbody()), col_datas);
-					}
-
-					if (k != 0) continue;
-					rigidbody.onCollisionRepulsed.broadcast(CollisionResponse{ col_responses[k].impactPoint, col_responses[k].impactNormal });
-				}
-			}
-			rigidbody.applyComputedGravityMovement(gravity_movement);
+			//  the solver pushes the bodies out of boxes, rotated boxes and triangle meshes are only handled by the collide and slide
+			if (!candidate->isEncapsulatingBoxExact()) continue;
 
-			//  call event on detected triggers
-			if (!triggers_detected.empty())
-			{
-				for (auto trigger_detected : triggers_detected)
-				{
-					trigger_detected->onTriggerEnter.broadcast(rigidbody);
-					trigger_detected->forceIntersected();
-				}
-			}
+			RigidbodyComponent* other = candidate->getOwningRigidbody();
+			if (other && other->isPhysicsActivated() && !other->isAsleep()) continue; //  solver bodies are paired below
+
+			const Box candidate_box = candidate->getEncapsulatingBox();
+			if (!contactSolver.overlapsBody(body, candidate_box.getMinPoint(), candidate_box.getMaxPoint())) continue;
+
+			if (!candidate->channelTest(test_channels)) continue;
+
+			contactSolver.addStaticContact(body, candidate_box.getMinPoint(), candidate_box.getMaxPoint());
+			if (other) other->requestWakeUp(); //  a sleeping rigidbody that is penetrated will be able to move at the next step
 		}
 	}
 
+	//  contacts between the bodies: a rigidbody is pushed by the other one if it tests its collision channel
+	contactSolver.findBodiesContacts([this](int bodyA, int bodyB, bool& outMoveA, bool& outMoveB)
+	{
+		const RigidbodyComponent& rigidbody_a = *rigidbodiesComponents[solverBodies[bodyA]];
+		const RigidbodyComponent& rigidbody_b = *rigidbodiesComponents[solverBodies[bodyB]];
 
-	for (auto& rigidbody : rigidbodiesComponents)
+		outMoveA = rigidbody_b.getAssociatedCollision().getCollisionType() == CollisionType::Solid && rigidbody_b.getAssociatedCollision().channelTest(rigidbody_a.getTestChannels());
+		outMoveB = rigidbody_a.getAssociatedCollision().getCollisionType() == CollisionType::Solid && rigidbody_a.getAssociatedCollision().channelTest(rigidbody_b.getTestChannels());
+		return outMoveA || outMoveB;
+	});
+
+	if (contactSolver.getContactsCount() == 0) return;
+
+	contactSolver.solve(contactSolverIterations, enableMultithreading ? &Locator::getJobs() : nullptr);
+
+	for (int body = 0; body < solverBodies.size(); body++)
 	{
-		rigidbody->updatePhysicsPostCollision(dt); // apply rigidbody movement for physic activated ones
+		const Vector3 correction = contactSolver.getCorrection(body);
+		if (correction == Vector3::zero) continue;
+
+		rigidbodiesComponents[solverBodies[body]]->getAssociatedCollisionNonConst().addPosition(correction);
+	}
+}
+
+void PhysicsManager::recordContacts(RigidbodyComponent& rigidbody, const std::vector<CollisionHit>& hits)
+{
+	for (auto& hit : hits)
+	{
+		RigidbodyComponent* other = hit.collisionComponent.getOwningRigidbody();
+		if (!other) continue; //  static collisions don't link islands
+
+		other->requestWakeUp();
+		stepContacts.push_back(std::make_pair(&rigidbody, other));
+	}
+}
+
+void PhysicsManager::wakeUpRigidbodies()
+{
+	islandsToWake.clear();
+	for (auto rigidbody : rigidbodiesComponents)
+	{
+		if (!rigidbody->isAsleep()) continue;
+		if (!wakeAllRequested && !rigidbody->needWakeUp()) continue;
+
+		islandsToWake.push_back(rigidbody->getSleepIslandId());
+	}
+	islandsToWake.insert(islandsToWake.end(), removedBodiesIslands.begin(), removedBodiesIslands.end());
+	removedBodiesIslands.clear();
+	wakeAllRequested = false;
+
+	if (islandsToWake.empty()) return;
+
+	for (auto rigidbody : rigidbodiesComponents)
+	{
+		if (!rigidbody->isAsleep()) continue;
+
+		if (std::find(islandsToWake.begin(), islandsToWake.end(), rigidbody->getSleepIslandId()) != islandsToWake.end())
+		{
+			rigidbody->wakeUp();
+		}
 	}
 }
 
+void PhysicsManager::invalidateProjectileHits(const CollisionComponent* collision)
+{
+	for (auto& hit : projectileHits)
+	{
+		if (hit.hitCollision == collision) hit.hitCollision = nullptr;
+	}
+}
 
-void PhysicsManager::DrawCollisionsDebug(Material& debugMaterial)
+int PhysicsManager::findIslandRoot(int index)
+{
+	while (islandParents[index] != index)
+	{
+		islandParents[index] = islandParents[islandParents[index]];
+		index = islandParents[index];
+	}
+	return index;
+}
+
+void PhysicsManager::updateSleepIslands(float dt)
+{
+	const int bodies_count = static_cast<int>(rigidbodiesComponents.size());
+
+	islandParents.resize(bodies_count);
+	islandsSleepable.assign(bodies_count, 1);
+	for (int i = 0; i < bodies_count; i++)
+	{
+		islandParents[i] = i;
+		rigidbodiesComponents[i]->stepIndex = i;
+		rigidbodiesComponents[i]->updateSleepTimer(dt);
+	}
+
+	//  a rigidbody removed during the events makes the contacts unreliable, wait for the next step
+	if (!stepContactsValid) return;
+
+	//  group the rigidbodies that touched each other during this step
+	for (auto& contact : stepContacts)
+	{
+		int root_a = findIslandRoot(contact.first->stepIndex);
+		int root_b = findIslandRoot(contact.second->stepIndex);
+		if (root_a != root_b) islandParents[root_b] = root_a;
+	}
+
+	//  an island can sleep only if all its rigidbodies are resting
+	for (int i = 0; i < bodies_count; i++)
+	{
+		const RigidbodyComponent& rigidbody = *rigidbodiesComponents[i];
+		if (rigidbody.isAsleep() || !rigidbody.canSleep()) islandsSleepable[findIslandRoot(i)] = 0;
+	}
+
+	islandsSleepIds.resize(bodies_count);
+	for (int i = 0; i < bodies_count; i++)
+	{
+		if (islandParents[i] == i && islandsSleepable[i]) islandsSleepIds[i] = nextSleepIslandId++;
+	}
+	for (int i = 0; i < bodies_count; i++)
+	{
+		int root = findIslandRoot(i);
+		if (!islandsSleepable[root]) continue;
+
+		rigidbodiesComponents[i]->sleep(islandsSleepIds[root]);
+	}
+}
+
+void PhysicsManager::solveRigidbody(const RigidbodyComponent& rigidbody, RigidbodyStepResult& result) const
+{
+	result.reset();
+
+	if (!rigidbody.isAssociatedCollisionValid()) return;
+	if (!rigidbody.isPhysicsActivated() || rigidbody.isAsleep()) return;
+
+	//  compute body movement with collisions
+	CollisionTests::RigidbodyCollideAndSlideAABB(broadphase, rigidbody, false, result.movement, result.movementHits, result.triggers);
+
+	//  compute body gravity movement with collisions
+	CollisionTests::RigidbodyCollideAndSlideAABB(broadphase, rigidbody, true, result.gravityMovement, result.gravityHits, result.triggers);
+
+	result.solved = true;
+}
+
+void PhysicsManager::DrawCollisionsDebug(DebugDrawList& outDrawList)
 {
 	for (auto& col : collisionsComponents)
 	{
-		col->drawDebug(debugMaterial);
+		col->drawDebug(outDrawList);
 	}
 
 	for (auto& rigidbody : rigidbodiesComponents)
 	{
-		rigidbody->getAssociatedCollision().drawDebug(debugMaterial);
+		rigidbody->getAssociatedCollision().drawDebug(outDrawList);
 	}
 
 	for (auto& raycast : raycasts)
 	{
-		raycast->drawDebugRaycast(debugMaterial);
+		raycast->drawDebugRaycast(outDrawList);
 	}
 }
 
@@ -452,12 +874,27 @@ void PhysicsManager::ClearAllCollisions(bool engineClosing)
 	{
 		if (enableInfoLogs) Locator::getLog().LogMessage_Category("Physics: Clearing all collisions, rigidbodies and raycasts.", LogCategory::Info);
 
+		if (recorder.isRecording())
+		{
+			Locator::getLog().LogMessage_Category("Physics: The physics recording has been discarded, it was still running when the physics closed.", LogCategory::Warning);
+			recorder.stop();
+		}
+
+		stepEvents.clear();
+		stepContacts.clear();
+		stepContactsValid = false;
+		removedBodiesIslands.clear();
+		triggerOverlaps.clear();
+		projectiles.clear();
+		projectileHits.clear();
+
 		for (auto col : collisionsComponents)
 		{
 			col->registered = false;
 			delete col;
 		}
 		collisionsComponents.clear();
+		broadphase.clear(collisionsComponents.getValues());
 
 		for (auto rigidbody : rigidbodiesComponents)
 		{
@@ -477,35 +914,38 @@ void PhysicsManager::ClearAllCollisions(bool engineClosing)
 
 	if (enableInfoLogs) Locator::getLog().LogMessage_Category("Physics: Clearing active scene collisions, rigidbodies and raycasts.", LogCategory::Info);
 
-	std::vector<CollisionComponent*> game_collisions;
-	for (auto col : collisionsComponents)
+	recorder.recordSceneCleared(); //  before the scene bodies are deleted
+
+	stepEvents.clear(); //  the scene can be changed by a physics event callback
+	stepContacts.clear();
+	stepContactsValid = false;
+	removedBodiesIslands.clear();
+	triggerOverlaps.clear(); //  persistent rigidbodies will enter again the persistent triggers they overlap
+	projectiles.clear();
+	for (auto& hit : projectileHits)
 	{
-		if (col->loadedPersistent)
-		{
-			game_collisions.push_back(col);
-			continue;
-		}
+		hit.hitCollision = nullptr; //  the scene can be changed by a projectiles hit callback, so the hits are kept but invalidated
+	}
+
+	//  the persistent collisions and rigidbodies keep their handles
+	collisionsComponents.removeIf([](CollisionComponent* col)
+	{
+		if (col->loadedPersistent) return false;
 
 		col->registered = false;
 		delete col;
-	}
-	collisionsComponents.clear();
-	collisionsComponents = game_collisions;
+		return true;
+	});
+	broadphase.clear(collisionsComponents.getValues()); //  persistent static collisions will be baked again at the next step
 
-	std::vector<RigidbodyComponent*> game_rigidbodies;
-	for (auto rigidbody : rigidbodiesComponents)
+	rigidbodiesComponents.removeIf([](RigidbodyComponent* rigidbody)
 	{
-		if (rigidbody->loadedPersistent)
-		{
-			game_rigidbodies.push_back(rigidbody);
-			continue;
-		}
+		if (rigidbody->loadedPersistent) return false;
 
 		rigidbody->registered = false;
 		delete rigidbody;
-	}
-	rigidbodiesComponents.clear();
-	rigidbodiesComponents = game_rigidbodies;
+		return true;
+	});
 
 	std::vector<Raycast*> game_raycasts;
 	for (auto raycast : raycasts)
@@ -522,6 +962,31 @@ void PhysicsManager::ClearAllCollisions(bool engineClosing)
 	raycasts = game_raycasts;
 }
 
+uint32_t PhysicsManager::CreateProjectile(const Vector3& position, const Vector3& velocity, float radius, float lifetime, const std::vector<std::string>& testChannels)
+{
+	const std::vector<std::string>& test_channels = testChannels.empty() ? CollisionChannels::GetRegisteredTestChannel("TestEverything") : testChannels;
+
+	const uint32_t projectile_id = projectiles.create(position, velocity, radius, lifetime, test_channels);
+	recorder.recordProjectileCreated(projectile_id, position, velocity, radius, lifetime, testChannels);
+	return projectile_id;
+}
+
+void PhysicsManager::RemoveProjectile(uint32_t projectileId)
+{
+	projectiles.remove(projectileId);
+	recorder.recordProjectileRemoved(projectileId);
+}
+
+bool PhysicsManager::GetProjectilePosition(uint32_t projectileId, Vector3& outPosition)
+{
+	return projectiles.getPosition(projectileId, outPosition);
+}
+
+Event<const std::vector<ProjectileHit>&>& PhysicsManager::GetProjectilesHitEvent()
+{
+	return onProjectilesHit;
+}
+
 float PhysicsManager::GetGravityValue()
 {
 	return gravity;
@@ -531,3 +996,76 @@ void PhysicsManager::SetEnableInfoLogs(bool enable)
 {
 	enableInfoLogs = enable;
 }
+
+void PhysicsManager::SetEnableMultithreading(bool enable)
+{
+	enableMultithreading = enable;
+}
+
+void PhysicsManager::SetEnableStaticGrid(bool enable)
+{
+	broadphase.setUseStaticGrid(enable);
+}
+
+void PhysicsManager::SetEnableContactSolver(bool enable)
+{
+	enableContactSolver = enable;
+}
+
+int PhysicsManager::GetAwakeRigidbodiesCount()
+{
+	int count = 0;
+	for (auto rigidbody : rigidbodiesComponents)
+	{
+		if (rigidbody->isPhysicsActivated() && !rigidbody->isAsleep()) count++;
+	}
+	return count;
+}
+
+int PhysicsManager::GetAsleepRigidbodiesCount()
+{
+	int count = 0;
+	for (auto rigidbody : rigidbodiesComponents)
+	{
+		if (rigidbody->isPhysicsActivated() && rigidbody->isAsleep()) count++;
+	}
+	return count;
+}
+
+void PhysicsManager::StartRecording()
+{
+	if (recorder.isRecording())
+	{
+		Locator::getLog().LogMessage_Category("Physics: Tried to start a physics recording, but one is already running.", LogCategory::Warning);
+		return;
+	}
+
+	//  the replay creates every rigidbody awake, with a new sleep timer
+	for (auto rigidbody : rigidbodiesComponents)
+	{
+		rigidbody->wakeUp();
+	}
+
+	recorder.start();
+	Locator::getLog().LogMessage_Category("Physics: Started to record the physics.", LogCategory::Info);
+}
+
+bool PhysicsManager::StopRecording(const std::string& filePath)
+{
+	if (!recorder.isRecording())
+	{
+		Locator::getLog().LogMessage_Category("Physics: Tried to stop the physics recording, but none is running.", LogCategory::Warning);
+		return false;
+	}
+
+	recorder.stop();
+	if (!recorder.getRecording().saveToFile(filePath)) return false;
+
+	Locator::getLog().LogMessage_Category("Physics: Recorded " + std::to_string(recorder.getRecording().steps.size()) + " physics steps in " + filePath + ".", LogCategory::Info);
+	return true;
+}
+
+bool PhysicsManager::IsRecording()
+{
+	return recorder.isRecording();
+}
@@ -2,12 +2,22 @@
 #include <ServiceLocator/physics.h>
 #include "collisionComponent.h"
 #include "rigidbodyComponent.h"
+#include "rigidbodyStorage.h"
 #include <Maths/Geometry/box.h>
 #include "raycast.h"
+#include "broadphase.h"
+#include "physicsEventBuffer.h"
+#include "triggerOverlaps.h"
+#include "projectileSystem.h"
+#include "contactSolver.h"
+#include "physicsRecorder.h"
+#include <Utils/slotMap.h>
 
+#include <utility>
 #include <vector>
 
-class Material;
+class DebugDrawList;
+class PhysicsReplay;
 
 /**
 * The physics service provider class.
@@ -20,10 +30,22 @@ public:
 
 	RigidbodyComponent& CreateRigidbodyComponent(RigidbodyComponent* rigidbodyComp) override;
 	void RemoveRigidbody(RigidbodyComponent* rigidbodyComp) override;
+	RigidbodyStorage& GetRigidbodyStorage() override;
 
-	bool LineRaycast(const Vector3& start, const Vector3& end, const std::vector<std::string> testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true) override;
-	bool AABBRaycast(const Vector3& location, const Box& aabbBox, const std::vector<std::string> testChannels = {}, float drawDebugTime = 5.0f, bool createOnScene = true) override;
-	bool AABBSweepRaycast(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string> testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true, bool forCollisionTest = false) override;
+	bool LineRaycast(const Vector3& start, const Vector3& end, const std::vector<std::string>& testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true) override;
+	bool AABBRaycast(const Vector3& location, const Box& aabbBox, const std::vector<std::string>& testChannels = {}, float drawDebugTime = 5.0f, bool createOnScene = true) override;
+	bool AABBSweepRaycast(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string>& testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true, bool forCollisionTest = false) override;
+
+	int OverlapBox(const Box& aabbBox, std::vector<const CollisionComponent*>& outCollisions, const std::vector<std::string>& testChannels = {}) override;
+	int OverlapSphere(const Vector3& center, float radius, std::vector<const CollisionComponent*>& outCollisions, const std::vector<std::string>& testChannels = {}) override;
+	bool ClosestCollider(const Vector3& point, float maxDistance, ColliderDistanceInfos& outInfos, const std::vector<std::string>& testChannels = {}) override;
+	int KNearest(const Vector3& point, int count, float maxDistance, std::vector<ColliderDistanceInfos>& outInfos, const std::vector<std::string>& testChannels = {}) override;
+	int GetObjectCollisions(const Object& object, std::vector<const CollisionComponent*>& outCollisions) override;
+
+	uint32_t CreateProjectile(const Vector3& position, const Vector3& velocity, float radius, float lifetime, const std::vector<std::string>& testChannels = {}) override;
+	void RemoveProjectile(uint32_t projectileId) override;
+	bool GetProjectilePosition(uint32_t projectileId, Vector3& outPosition) override;
+	Event<const std::vector<ProjectileHit>&>& GetProjectilesHitEvent() override;
 
 	void ClearAllCollisions(bool closeGame) override;
 
@@ -31,17 +53,122 @@ public:
 
 	void SetEnableInfoLogs(bool enable) override;
 
+	void SetEnableMultithreading(bool enable) override;
+
+	void SetEnableStaticGrid(bool enable) override;
+
+	void SetEnableContactSolver(bool enable) override;
+
+	int GetAwakeRigidbodiesCount() override;
+	int GetAsleepRigidbodiesCount() override;
+
+	void StartRecording() override;
+	bool StopRecording(const std::string& filePath) override;
+	bool IsRecording() override;
+
 
 private:
+	friend class PhysicsReplay;
+
 	void InitialisePhysics() override;
 	void UpdatePhysics(float dt) override;
-	void DrawCollisionsDebug(Material& debugMaterial) override;
+	void DrawCollisionsDebug(DebugDrawList& outDrawList) override;
+
+	/**
+	* Compute the collide and slide of a rigidbody against the broadphase snapshot.
+	* Doesn't modify anything but the result, so it can run on a worker thread.
+	* @param	rigidbody	Rigidbody to solve.
+	* @param	result		Movements, hits and triggers computed for this rigidbody. [OUT]
+	*/
+	void solveRigidbody(const RigidbodyComponent& rigidbody, RigidbodyStepResult& result) const;
+
+	/**
+	* Push apart the awake rigidbodies that still penetrate other rigidbodies or solid collisions once their movements are applied.
+	* The collide and slide already stops them before any penetration, so this only moves the rigidbodies that are left inside something.
+	*/
+	void resolvePenetrations();
+
+	/**
+	* Store the contacts between the rigidbody and the other rigidbodies it hit, to group them in islands.
+	* Also ask the hit rigidbodies to wake up.
+	* @param	rigidbody	Rigidbody that did the collide and slide pass.
+	* @param	hits		Collisions hit during the pass.
+	*/
+	void recordContacts(RigidbodyComponent& rigidbody, const std::vector<CollisionHit>& hits);
+
+	/**
+	* Wake up the islands of the sleeping rigidbodies that asked for it (or that have been moved from outside the physics).
+	*/
+	void wakeUpRigidbodies();
+
+	/**
+	* Group the rigidbodies in islands with the contacts of this step, and put to sleep the islands where every rigidbody is resting.
+	* @param	dt		Delta time of the physics step.
+	*/
+	void updateSleepIslands(float dt);
+	int findIslandRoot(int index);
+
+	/**
+	* Make sure the projectiles hits of this step don't point to a collision that is being removed.
+	* @param	collision	Collision that is being removed from the physics.
+	*/
+	void invalidateProjectileHits(const CollisionComponent* collision);
+
+	/**
+	* Find the registered collisions whose bounds overlap a box and that match the test channels, for the scene queries.
+	* Baked static collisions come from the broadphase, the others are tested with their current bounds.
+	* @param	boxMin			Min point of the box (world coordinates).
+	* @param	boxMax			Max point of the box (world coordinates).
+	* @param	testChannels	Collision channels the query will test.
+	* @param	outCandidates	Collisions found. [OUT]
+	*/
+	void gatherQueryCandidates(const Vector3& boxMin, const Vector3& boxMax, const std::vector<std::string>& testChannels, std::vector<const CollisionComponent*>& outCandidates) const;
 
 	bool enableInfoLogs{ false };
+	bool enableMultithreading{ true };
+	bool enableContactSolver{ true };
 
-	std::vector<CollisionComponent*> collisionsComponents;
-	std::vector<RigidbodyComponent*> rigidbodiesComponents;
+	SlotMap<CollisionComponent*> collisionsComponents;
+	SlotMap<RigidbodyComponent*> rigidbodiesComponents;
+	RigidbodyStorage rigidbodyStorage; //  simulation state of the rigidbodies, registered or not
 	std::vector<Raycast*> raycasts; //  actually only used for storing raycast and drawing the feedback in the debug draw
 	const float gravity{ -9.8f };
+
+	Broadphase broadphase;
+	PhysicsEventBuffer stepEvents;
+	TriggerOverlaps triggerOverlaps;
+	std::vector<RigidbodyStepResult> stepResults;
+	const int minBodiesForMultithreading{ 16 }; //  under this, dispatching the solve to the jobs costs more than it saves
+
+	//  penetrations resolution
+	ContactSolver contactSolver;
+	std::vector<int> solverBodies; //  index in the rigidbodies of each body of the contact solver
+	std::vector<const CollisionComponent*> contactCandidates;
+	const int contactSolverIterations{ 8 };
+
+	//  scene queries (only used from the main thread)
+	std::vector<const CollisionComponent*> queryCandidates;
+	std::vector<ColliderDistanceInfos> queryNearest;
+
+	//  projectiles
+	ProjectileSystem projectiles;
+	std::vector<ProjectileHit> projectileHits;
+	Event<const std::vector<ProjectileHit>&> onProjectilesHit;
+
+	//  sleeping & simulation islands
+	std::vector<int> awakeBodies;
+	std::vector<std::pair<RigidbodyComponent*, RigidbodyComponent*>> stepContacts;
+	bool stepContactsValid{ true };
+	std::vector<int> islandParents;
+	std::vector<char> islandsSleepable;
+	std::vector<unsigned int> islandsSleepIds;
+	std::vector<unsigned int> islandsToWake;
+	std::vector<unsigned int> removedBodiesIslands; //  islands of the sleeping rigidbodies removed since the last wake up
+	unsigned int nextSleepIslandId{ 1 };
+	bool wakeAllRequested{ false };
+
+	//  record & replay
+	PhysicsRecorder recorder{ collisionsComponents.getValues(), rigidbodiesComponents.getValues(), rigidbodyStorage };
+	PhysicsReplay* replay{ nullptr }; //  set while this physics is the one of a replay
 };
 
@@ -0,0 +1,754 @@
+#include "physicsRecorder.h"
+#include "collisionComponent.h"
+#include "rigidbodyComponent.h"
+#include "rigidbodyStorage.h"
+#include "raycast.h"
+#include "AABB/boxAABBColComp.h"
+#include "OBB/orientedBoxColComp.h"
+#include "TriangleMesh/triangleMeshColComp.h"
+#include <Assets/assetManager.h>
+#include <Objects/object.h>
+#include <ServiceLocator/locator.h>
+
+#include <algorithm>
+#include <fstream>
+
+
+namespace
+{
+	const char RECORDING_MAGIC[8] = { 'C', 'Y', 'P', 'H', 'Y', 'R', 'E', 'C' };
+	const uint32_t RECORDING_VERSION = 2;
+	const uint32_t MAX_RECORDED_COUNT = 1u << 24; //  anything bigger in a file is a corrupted value
+
+	//  flags the gameplay can change, the others are only written by the physics
+	const uint8_t GAMEPLAY_FLAGS = RigidbodyFlags::PhysicsActivated | RigidbodyFlags::UseGravity;
+	//  flags given to a recorded rigidbody when it is created, the replay registers it and starts it awake
+	const uint8_t CREATION_FLAGS = static_cast<uint8_t>(~(RigidbodyFlags::Registered | RigidbodyFlags::Asleep));
+
+
+	template<typename T>
+	void WriteValue(std::ofstream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<typename T>
+	bool ReadValue(std::ifstream& stream, T& value)
+	{
+		stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return static_cast<bool>(stream);
+	}
+
+	void WriteVector3(std::ofstream& stream, const Vector3& value)
+	{
+		WriteValue(stream, value.x);
+		WriteValue(stream, value.y);
+		WriteValue(stream, value.z);
+	}
+
+	bool ReadVector3(std::ifstream& stream, Vector3& value)
+	{
+		return ReadValue(stream, value.x) && ReadValue(stream, value.y) && ReadValue(stream, value.z);
+	}
+
+	void WriteQuaternion(std::ofstream& stream, const Quaternion& value)
+	{
+		WriteValue(stream, value.x);
+		WriteValue(stream, value.y);
+		WriteValue(stream, value.z);
+		WriteValue(stream, value.w);
+	}
+
+	bool ReadQuaternion(std::ifstream& stream, Quaternion& value)
+	{
+		return ReadValue(stream, value.x) && ReadValue(stream, value.y) && ReadValue(stream, value.z) && ReadValue(stream, value.w);
+	}
+
+	void WriteBox(std::ofstream& stream, const Box& value)
+	{
+		WriteVector3(stream, value.getCenterPoint());
+		WriteVector3(stream, value.getHalfExtents());
+	}
+
+	bool ReadBox(std::ifstream& stream, Box& value)
+	{
+		Vector3 center, half_extents;
+		if (!ReadVector3(stream, center) || !ReadVector3(stream, half_extents)) return false;
+
+		value = Box{ center, half_extents };
+		return true;
+	}
+
+	void WriteString(std::ofstream& stream, const std::string& value)
+	{
+		WriteValue(stream, static_cast<uint32_t>(value.size()));
+		stream.write(value.data(), value.size());
+	}
+
+	bool ReadString(std::ifstream& stream, std::string& value)
+	{
+		uint32_t size = 0;
+		if (!ReadValue(stream, size) || size > MAX_RECORDED_COUNT) return false;
+
+		value.resize(size);
+		if (size > 0) stream.read(&value[0], size);
+		return static_cast<bool>(stream);
+	}
+
+	void WriteStrings(std::ofstream& stream, const std::vector<std::string>& values)
+	{
+		WriteValue(stream, static_cast<uint32_t>(values.size()));
+		for (auto& value : values)
+		{
+			WriteString(stream, value);
+		}
+	}
+
+	bool ReadStrings(std::ifstream& stream, std::vector<std::string>& values)
+	{
+		uint32_t count = 0;
+		if (!ReadValue(stream, count) || count > MAX_RECORDED_COUNT) return false;
+
+		values.resize(count);
+		for (auto& value : values)
+		{
+			if (!ReadString(stream, value)) return false;
+		}
+		return true;
+	}
+
+	bool SameBox(const Box& a, const Box& b)
+	{
+		return a.getCenterPoint() == b.getCenterPoint() && a.getHalfExtents() == b.getHalfExtents();
+	}
+
+	bool SameQuaternion(const Quaternion& a, const Quaternion& b)
+	{
+		return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+	}
+
+	bool SameTransform(const Vector3& positionA, const Quaternion& rotationA, const Vector3& scaleA, const Box& boxA,
+		const Vector3& positionB, const Quaternion& rotationB, const Vector3& scaleB, const Box& boxB)
+	{
+		return positionA == positionB && SameQuaternion(rotationA, rotationB) && scaleA == scaleB && SameBox(boxA, boxB);
+	}
+}
+
+
+
+// ===============================================
+//  ------------------ Recording ----------------
+// ===============================================
+
+bool PhysicsRecording::saveToFile(const std::string& filePath) const
+{
+	std::ofstream stream(filePath, std::ios::binary);
+	if (!stream.is_open())
+	{
+		Locator::getLog().LogMessage_Category("Physics Recording: Unable to open the file " + filePath + " to save the recording.", LogCategory::Error);
+		return false;
+	}
+
+	stream.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+	WriteValue(stream, RECORDING_VERSION);
+	WriteValue(stream, static_cast<uint32_t>(steps.size()));
+
+	for (auto& step : steps)
+	{
+		WriteValue(stream, step.dt);
+		WriteValue(stream, step.stateHash);
+		WriteValue(stream, static_cast<uint32_t>(step.commands.size()));
+
+		for (auto& command : step.commands)
+		{
+			WriteValue(stream, command.type);
+			WriteValue(stream, command.point);
+			WriteValue(stream, command.id);
+
+			WriteVector3(stream, command.position);
+			WriteQuaternion(stream, command.rotation);
+			WriteVector3(stream, command.scale);
+			WriteBox(stream, command.box);
+			WriteValue(stream, command.collisionShape);
+			WriteString(stream, command.collisionMesh);
+			WriteString(stream, command.collisionChannel);
+			WriteValue(stream, command.collisionType);
+			WriteValue(stream, command.persistent);
+			WriteValue(stream, command.staticCollision);
+
+			WriteVector3(stream, command.velocity);
+			WriteVector3(stream, command.gravityVelocity);
+			WriteVector3(stream, command.velocityOneFrame);
+			WriteValue(stream, command.stepHeight);
+			WriteValue(stream, command.mass);
+			WriteValue(stream, command.flags);
+			WriteValue(stream, command.wakeUp);
+			WriteStrings(stream, command.testChannels);
+
+			WriteVector3(stream, command.end);
+			WriteValue(stream, command.radius);
+			WriteValue(stream, command.lifetime);
+			WriteValue(stream, command.hit);
+			WriteValue(stream, command.hitDistance);
+		}
+	}
+
+	if (!stream)
+	{
+		Locator::getLog().LogMessage_Category("Physics Recording: Failed to write the recording in the file " + filePath + ".", LogCategory::Error);
+		return false;
+	}
+
+	return true;
+}
+
+bool PhysicsRecording::loadFromFile(const std::string& filePath)
+{
+	steps.clear();
+
+	std::ifstream stream(filePath, std::ios::binary);
+	if (!stream.is_open())
+	{
+		Locator::getLog().LogMessage_Category("Physics Recording: Unable to open the file " + filePath + " to load the recording.", LogCategory::Error);
+		return false;
+	}
+
+	char magic[sizeof(RECORDING_MAGIC)];
+	uint32_t version = 0;
+	stream.read(magic, sizeof(magic));
+	if (!stream || !std::equal(magic, magic + sizeof(magic), RECORDING_MAGIC) || !ReadValue(stream, version) || version != RECORDING_VERSION)
+	{
+		Locator::getLog().LogMessage_Category("Physics Recording: The file " + filePath + " isn't a physics recording of this version.", LogCategory::Error);
+		return false;
+	}
+
+	uint32_t steps_count = 0;
+	bool valid = ReadValue(stream, steps_count) && steps_count <= MAX_RECORDED_COUNT;
+	if (valid) steps.resize(steps_count);
+
+	for (int i = 0; valid && i < steps.size(); i++)
+	{
+		PhysicsRecordedStep& step = steps[i];
+
+		uint32_t commands_count = 0;
+		valid = ReadValue(stream, step.dt) && ReadValue(stream, step.stateHash) && ReadValue(stream, commands_count) && commands_count <= MAX_RECORDED_COUNT;
+		if (valid) step.commands.resize(commands_count);
+
+		for (int j = 0; valid && j < step.commands.size(); j++)
+		{
+			PhysicsCommand& command = step.commands[j];
+
+			valid = ReadValue(stream, command.type) && ReadValue(stream, command.point) && ReadValue(stream, command.id) &&
+
+				ReadVector3(stream, command.position) && ReadQuaternion(stream, command.rotation) && ReadVector3(stream, command.scale) && ReadBox(stream, command.box) &&
+				ReadValue(stream, command.collisionShape) && ReadString(stream, command.collisionMesh) && ReadString(stream, command.collisionChannel) &&
+				ReadValue(stream, command.collisionType) && ReadValue(stream, command.persistent) && ReadValue(stream, command.staticCollision) &&
+
+				ReadVector3(stream, command.velocity) && ReadVector3(stream, command.gravityVelocity) && ReadVector3(stream, command.velocityOneFrame) &&
+				ReadValue(stream, command.stepHeight) && ReadValue(stream, command.mass) && ReadValue(stream, command.flags) &&
+				ReadValue(stream, command.wakeUp) && ReadStrings(stream, command.testChannels) &&
+
+				ReadVector3(stream, command.end) && ReadValue(stream, command.radius) && ReadValue(stream, command.lifetime) &&
+				ReadValue(stream, command.hit) && ReadValue(stream, command.hitDistance);
+		}
+	}
+
+	if (!valid)
+	{
+		Locator::getLog().LogMessage_Category("Physics Recording: The file " + filePath + " is corrupted.", LogCategory::Error);
+		steps.clear();
+		return false;
+	}
+
+	return true;
+}
+
+uint64_t PhysicsRecording::HashRigidbodies(const std::vector<RigidbodyComponent*>& rigidbodies, const RigidbodyStorage& storage)
+{
+	//  FNV-1a on the raw bytes: the replay must give the exact same floats, not only close ones
+	uint64_t hash = 14695981039346656037ull;
+	auto hash_bytes = [&hash](const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+	};
+	auto hash_vector = [&hash_bytes](const Vector3& value)
+	{
+		hash_bytes(&value.x, sizeof(float));
+		hash_bytes(&value.y, sizeof(float));
+		hash_bytes(&value.z, sizeof(float));
+	};
+
+	for (auto rigidbody : rigidbodies)
+	{
+		const int index = rigidbody->storageIndex;
+
+		if (rigidbody->isAssociatedCollisionValid())
+		{
+			const Box bounds = rigidbody->getAssociatedCollision().getEncapsulatingBox();
+			hash_vector(bounds.getCenterPoint());
+			hash_vector(bounds.getHalfExtents());
+		}
+
+		hash_vector(storage.velocities[index]);
+		hash_vector(storage.gravityVelocities[index]);
+		hash_vector(storage.velocitiesOneFrame[index]);
+		hash_bytes(&storage.flags[index], sizeof(uint8_t));
+	}
+
+	return hash;
+}
+
+
+
+// ===============================================
+//  ------------------ Recorder -----------------
+// ===============================================
+
+PhysicsRecorder::PhysicsRecorder(const std::vector<CollisionComponent*>& collisions_, const std::vector<RigidbodyComponent*>& rigidbodies_, RigidbodyStorage& storage_) :
+	collisions(collisions_), rigidbodies(rigidbodies_), storage(storage_)
+{
+}
+
+void PhysicsRecorder::start()
+{
+	record.steps.clear();
+	currentStep = PhysicsRecordedStep();
+	trackedCollisions.clear();
+	trackedRigidbodies.clear();
+	pendingCreations.clear();
+	nextBodyId = 1;
+
+	recording = true;
+	insideStep = false;
+	insideEventsWindow = false;
+	currentPoint = PhysicsStepPoint::BeforeStep;
+
+	//  the bodies that already exist are created by the replay before its first step, in the same order
+	for (auto collision : collisions)
+	{
+		recordCollisionCreated(collision);
+	}
+	for (auto rigidbody : rigidbodies)
+	{
+		recordRigidbodyCreated(rigidbody);
+	}
+	flushCreations();
+}
+
+void PhysicsRecorder::stop()
+{
+	recording = false;
+
+	//  the inputs given after the last step have no step to be replayed with
+	currentStep = PhysicsRecordedStep();
+	trackedCollisions.clear();
+	trackedRigidbodies.clear();
+	pendingCreations.clear();
+}
+
+void PhysicsRecorder::recordCollisionCreated(const CollisionComponent* collision)
+{
+	if (!recording) return;
+
+	TrackedBody tracked;
+	tracked.id = nextBodyId++;
+	tracked.createCommand = static_cast<int>(currentStep.commands.size());
+	addCommand(PhysicsCommandType::CreateCollision, tracked.id);
+
+	trackedCollisions[collision] = tracked;
+	pendingCreations.push_back(std::make_pair(collision, nullptr));
+}
+
+void PhysicsRecorder::recordRigidbodyCreated(const RigidbodyComponent* rigidbody)
+{
+	if (!recording) return;
+
+	TrackedBody tracked;
+	tracked.id = nextBodyId++;
+	tracked.createCommand = static_cast<int>(currentStep.commands.size());
+	addCommand(PhysicsCommandType::CreateRigidbody, tracked.id);
+
+	trackedRigidbodies[rigidbody] = tracked;
+	pendingCreations.push_back(std::make_pair(nullptr, rigidbody));
+}
+
+void PhysicsRecorder::recordCollisionRemoved(const CollisionComponent* collision)
+{
+	if (!recording) return;
+
+	auto iter = trackedCollisions.find(collision);
+	if (iter == trackedCollisions.end()) return;
+
+	if (iter->second.createCommand >= 0)
+	{
+		//  removed before any step used it (it might be deleted already): the replay only needs its removal to have the same effects
+		PhysicsCommand& create_command = currentStep.commands[iter->second.createCommand];
+		create_command.collisionShape = static_cast<uint8_t>(CollisionShape::BoxAABB); //  an empty box has the same removal effects whatever the shape
+		create_command.collisionType = static_cast<uint8_t>(collision->getCollisionType());
+		create_command.persistent = collision->loadedPersistent;
+		pendingCreations.erase(std::find(pendingCreations.begin(), pendingCreations.end(), std::make_pair(collision, static_cast<const RigidbodyComponent*>(nullptr))));
+	}
+
+	addCommand(PhysicsCommandType::RemoveBody, iter->second.id);
+	trackedCollisions.erase(iter);
+}
+
+void PhysicsRecorder::recordRigidbodyRemoved(const RigidbodyComponent* rigidbody)
+{
+	if (!recording) return;
+
+	auto iter = trackedRigidbodies.find(rigidbody);
+	if (iter == trackedRigidbodies.end()) return;
+
+	if (iter->second.createCommand >= 0)
+	{
+		//  removed before any step used it: the replay only needs its removal to have the same effects
+		PhysicsCommand& create_command = currentStep.commands[iter->second.createCommand];
+		create_command.collisionShape = static_cast<uint8_t>(CollisionShape::BoxAABB);
+		if (rigidbody->isAssociatedCollisionValid()) create_command.collisionType = static_cast<uint8_t>(rigidbody->getAssociatedCollision().getCollisionType());
+		create_command.persistent = rigidbody->loadedPersistent;
+		pendingCreations.erase(std::find(pendingCreations.begin(), pendingCreations.end(), std::make_pair(static_cast<const CollisionComponent*>(nullptr), rigidbody)));
+	}
+
+	addCommand(PhysicsCommandType::RemoveBody, iter->second.id);
+	trackedRigidbodies.erase(iter);
+}
+
+void PhysicsRecorder::recordSceneCleared()
+{
+	if (!recording) return;
+
+	//  called before the scene bodies are deleted: the pending ones still need their values to be created by the replay
+	flushCreations();
+	addCommand(PhysicsCommandType::ClearScene, 0);
+
+	for (auto iter = trackedCollisions.begin(); iter != trackedCollisions.end();)
+	{
+		if (iter->first->loadedPersistent) ++iter;
+		else iter = trackedCollisions.erase(iter);
+	}
+	for (auto iter = trackedRigidbodies.begin(); iter != trackedRigidbodies.end();)
+	{
+		if (iter->first->loadedPersistent) ++iter;
+		else iter = trackedRigidbodies.erase(iter);
+	}
+}
+
+void PhysicsRecorder::recordProjectileCreated(uint32_t projectileId, const Vector3& position, const Vector3& velocity, float radius, float lifetime, const std::vector<std::string>& testChannels)
+{
+	if (!recording) return;
+
+	PhysicsCommand& command = addCommand(PhysicsCommandType::CreateProjectile, projectileId);
+	command.position = position;
+	command.velocity = velocity;
+	command.radius = radius;
+	command.lifetime = lifetime;
+	command.testChannels = testChannels;
+}
+
+void PhysicsRecorder::recordProjectileRemoved(uint32_t projectileId)
+{
+	if (!recording) return;
+
+	addCommand(PhysicsCommandType::RemoveProjectile, projectileId);
+}
+
+void PhysicsRecorder::recordLineRaycast(const Vector3& start, const Vector3& end, const std::vector<std::string>& testChannels, bool hit, const RaycastHitInfos& hitInfos)
+{
+	if (!canRecordQuery()) return;
+
+	PhysicsCommand& command = addCommand(PhysicsCommandType::LineRaycast, 0);
+	command.position = start;
+	command.end = end;
+	command.testChannels = testChannels;
+	command.hit = hit;
+	command.hitDistance = hitInfos.hitDistance;
+}
+
+void PhysicsRecorder::recordAABBRaycast(const Vector3& location, const Box& aabbBox, const std::vector<std::string>& testChannels, bool hit)
+{
+	if (!canRecordQuery()) return;
+
+	PhysicsCommand& command = addCommand(PhysicsCommandType::AABBRaycast, 0);
+	command.position = location;
+	command.box = aabbBox;
+	command.testChannels = testChannels;
+	command.hit = hit;
+}
+
+void PhysicsRecorder::recordAABBSweepRaycast(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string>& testChannels, bool hit, const RaycastHitInfos& hitInfos)
+{
+	if (!canRecordQuery()) return;
+
+	PhysicsCommand& command = addCommand(PhysicsCommandType::AABBSweepRaycast, 0);
+	command.position = start;
+	command.end = end;
+	command.box = aabbBox;
+	command.testChannels = testChannels;
+	command.hit = hit;
+	command.hitDistance = hitInfos.hitDistance;
+}
+
+void PhysicsRecorder::beginStep(float dt)
+{
+	if (!recording) return;
+
+	recordChanges();
+	currentStep.dt = dt;
+	insideStep = true;
+}
+
+void PhysicsRecorder::beginEventsWindow(PhysicsStepPoint point)
+{
+	if (!recording) return;
+
+	takeSnapshot();
+	currentPoint = point;
+	insideEventsWindow = true;
+}
+
+void PhysicsRecorder::endEventsWindow()
+{
+	if (!recording) return;
+
+	recordChanges();
+	insideEventsWindow = false;
+}
+
+void PhysicsRecorder::endStep()
+{
+	if (!recording) return;
+
+	currentStep.stateHash = PhysicsRecording::HashRigidbodies(rigidbodies, storage);
+	record.steps.push_back(std::move(currentStep));
+	currentStep = PhysicsRecordedStep();
+
+	insideStep = false;
+	currentPoint = PhysicsStepPoint::BeforeStep;
+	takeSnapshot();
+}
+
+
+bool PhysicsRecorder::canRecordQuery() const
+{
+	//  the queries done by the physics during the step (step mechanic) are not inputs, the replay will do them again
+	return recording && (!insideStep || insideEventsWindow);
+}
+
+PhysicsCommand& PhysicsRecorder::addCommand(PhysicsCommandType type, uint32_t id)
+{
+	currentStep.commands.emplace_back();
+	PhysicsCommand& command = currentStep.commands.back();
+	command.type = type;
+	command.point = currentPoint;
+	command.id = id;
+	return command;
+}
+
+void PhysicsRecorder::flushCreations()
+{
+	if (pendingCreations.empty()) return;
+
+	for (auto& pending : pendingCreations)
+	{
+		auto collision_iter = trackedCollisions.find(pending.first);
+		auto rigidbody_iter = trackedRigidbodies.find(pending.second);
+		TrackedBody& tracked = pending.first ? collision_iter->second : rigidbody_iter->second;
+		PhysicsCommand& command = currentStep.commands[tracked.createCommand];
+		tracked.createCommand = -1;
+
+		const CollisionComponent* collision = pending.first;
+		if (pending.second) collision = pending.second->isAssociatedCollisionValid() ? &pending.second->getAssociatedCollision() : nullptr;
+
+		//  a triangle mesh is replayed from the asset manager, it has to be found there by its name
+		std::string collision_mesh;
+		if (collision && collision->getCollisionShape() == CollisionShape::TriangleMesh)
+		{
+			const TriangleMeshBVH* triangle_mesh = static_cast<const TriangleMeshColComp*>(collision)->getTriangleMesh();
+			if (triangle_mesh) collision_mesh = AssetManager::GetCollisionMeshName(*triangle_mesh);
+		}
+
+		const bool missing_mesh = collision && collision->getCollisionShape() == CollisionShape::TriangleMesh && collision_mesh.empty();
+		if (!collision || missing_mesh || !snapshotCollision(*collision, tracked.snapshot))
+		{
+			Locator::getLog().LogMessage_Category("Physics Recorder: Only the collisions with an associated object (and a triangle mesh of the asset manager for the triangle mesh collisions) can be recorded, a body is ignored.", LogCategory::Warning);
+			command.id = 0;
+			if (pending.first) trackedCollisions.erase(collision_iter);
+			else trackedRigidbodies.erase(rigidbody_iter);
+			continue;
+		}
+
+		command.position = tracked.snapshot.position;
+		command.rotation = tracked.snapshot.rotation;
+		command.scale = tracked.snapshot.scale;
+		command.box = tracked.snapshot.box;
+		command.collisionShape = static_cast<uint8_t>(collision->getCollisionShape());
+		command.collisionMesh = collision_mesh;
+		command.collisionChannel = collision->getCollisionChannel();
+		command.collisionType = static_cast<uint8_t>(collision->getCollisionType());
+		command.persistent = collision->loadedPersistent;
+		command.staticCollision = collision->isStatic();
+
+		if (pending.second)
+		{
+			const RigidbodyComponent& rigidbody = *pending.second;
+			snapshotRigidbody(rigidbody, tracked.snapshot);
+
+			command.persistent = rigidbody.loadedPersistent;
+			command.velocity = tracked.snapshot.velocity;
+			command.gravityVelocity = tracked.snapshot.gravityVelocity;
+			command.velocityOneFrame = tracked.snapshot.velocityOneFrame;
+			command.stepHeight = tracked.snapshot.stepHeight;
+			command.mass = tracked.snapshot.mass;
+			command.flags = storage.flags[rigidbody.storageIndex] & CREATION_FLAGS;
+			command.testChannels = tracked.snapshot.testChannels;
+		}
+	}
+	pendingCreations.clear();
+
+	//  creations cancelled by an unsupported shape
+	auto& commands = currentStep.commands;
+	commands.erase(std::remove_if(commands.begin(), commands.end(), [](const PhysicsCommand& command)
+	{
+		return command.id == 0 && (command.type == PhysicsCommandType::CreateCollision || command.type == PhysicsCommandType::CreateRigidbody);
+	}), commands.end());
+}
+
+void PhysicsRecorder::recordChanges()
+{
+	flushCreations();
+
+	for (auto collision : collisions)
+	{
+		if (collision->isStatic()) continue;
+
+		auto iter = trackedCollisions.find(collision);
+		if (iter == trackedCollisions.end()) continue;
+		if (!snapshotCollision(*collision, currentSnapshot)) continue;
+
+		BodySnapshot& snapshot = iter->second.snapshot;
+		if (SameTransform(currentSnapshot.position, currentSnapshot.rotation, currentSnapshot.scale, currentSnapshot.box,
+			snapshot.position, snapshot.rotation, snapshot.scale, snapshot.box)) continue;
+
+		PhysicsCommand& command = addCommand(PhysicsCommandType::MoveBody, iter->second.id);
+		command.position = currentSnapshot.position;
+		command.rotation = currentSnapshot.rotation;
+		command.scale = currentSnapshot.scale;
+		command.box = currentSnapshot.box;
+		snapshot.position = currentSnapshot.position;
+		snapshot.rotation = currentSnapshot.rotation;
+		snapshot.scale = currentSnapshot.scale;
+		snapshot.box = currentSnapshot.box;
+	}
+
+	for (auto rigidbody : rigidbodies)
+	{
+		auto iter = trackedRigidbodies.find(rigidbody);
+		if (iter == trackedRigidbodies.end()) continue;
+		if (!snapshotCollision(rigidbody->getAssociatedCollision(), currentSnapshot)) continue;
+		snapshotRigidbody(*rigidbody, currentSnapshot);
+
+		BodySnapshot& snapshot = iter->second.snapshot;
+		if (!SameTransform(currentSnapshot.position, currentSnapshot.rotation, currentSnapshot.scale, currentSnapshot.box,
+			snapshot.position, snapshot.rotation, snapshot.scale, snapshot.box))
+		{
+			PhysicsCommand& command = addCommand(PhysicsCommandType::MoveBody, iter->second.id);
+			command.position = currentSnapshot.position;
+			command.rotation = currentSnapshot.rotation;
+			command.scale = currentSnapshot.scale;
+			command.box = currentSnapshot.box;
+		}
+
+		//  a wake up request doesn't always come with a change (velocity set to the same value)
+		const bool wake_up = rigidbody->needWakeUp();
+		const bool state_changed =
+			!(currentSnapshot.velocity == snapshot.velocity) || !(currentSnapshot.gravityVelocity == snapshot.gravityVelocity) ||
+			!(currentSnapshot.velocityOneFrame == snapshot.velocityOneFrame) || currentSnapshot.stepHeight != snapshot.stepHeight ||
+			currentSnapshot.mass != snapshot.mass || currentSnapshot.flags != snapshot.flags || currentSnapshot.testChannels != snapshot.testChannels;
+		if (state_changed || wake_up)
+		{
+			PhysicsCommand& command = addCommand(PhysicsCommandType::SetRigidbodyState, iter->second.id);
+			command.velocity = currentSnapshot.velocity;
+			command.gravityVelocity = currentSnapshot.gravityVelocity;
+			command.velocityOneFrame = currentSnapshot.velocityOneFrame;
+			command.stepHeight = currentSnapshot.stepHeight;
+			command.mass = currentSnapshot.mass;
+			command.flags = currentSnapshot.flags;
+			command.wakeUp = wake_up;
+			command.testChannels = currentSnapshot.testChannels;
+		}
+
+		std::swap(snapshot, currentSnapshot);
+	}
+}
+
+void PhysicsRecorder::takeSnapshot()
+{
+	flushCreations();
+
+	for (auto collision : collisions)
+	{
+		if (collision->isStatic()) continue;
+
+		auto iter = trackedCollisions.find(collision);
+		if (iter != trackedCollisions.end()) snapshotCollision(*collision, iter->second.snapshot);
+	}
+
+	for (auto rigidbody : rigidbodies)
+	{
+		auto iter = trackedRigidbodies.find(rigidbody);
+		if (iter == trackedRigidbodies.end()) continue;
+
+		snapshotCollision(rigidbody->getAssociatedCollision(), iter->second.snapshot);
+		snapshotRigidbody(*rigidbody, iter->second.snapshot);
+	}
+}
+
+bool PhysicsRecorder::snapshotCollision(const CollisionComponent& collision, BodySnapshot& outSnapshot) const
+{
+	const Object* object = collision.getAssociatedObject();
+	if (!object) return false;
+
+	outSnapshot.position = object->getPosition();
+	switch (collision.getCollisionShape())
+	{
+	case CollisionShape::BoxAABB:
+		//  the scale is already in the box and an AABB ignores the rotation, the replayed object keeps the identity for both
+		outSnapshot.rotation = Quaternion::identity;
+		outSnapshot.scale = Vector3::one;
+		outSnapshot.box = static_cast<const BoxAABBColComp&>(collision).getScaledBox();
+		return true;
+
+	case CollisionShape::OrientedBox:
+		outSnapshot.rotation = object->getRotation();
+		outSnapshot.scale = object->getScale();
+		outSnapshot.box = static_cast<const OrientedBoxColComp&>(collision).getBox();
+		return true;
+
+	case CollisionShape::TriangleMesh:
+		outSnapshot.rotation = object->getRotation();
+		outSnapshot.scale = object->getScale();
+		outSnapshot.box = Box::zero;
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+void PhysicsRecorder::snapshotRigidbody(const RigidbodyComponent& rigidbody, BodySnapshot& outSnapshot) const
+{
+	const int index = rigidbody.storageIndex;
+	outSnapshot.velocity = storage.velocities[index];
+	outSnapshot.gravityVelocity = storage.gravityVelocities[index];
+	outSnapshot.velocityOneFrame = storage.velocitiesOneFrame[index];
+	outSnapshot.stepHeight = storage.stepHeights[index];
+	outSnapshot.mass = storage.masses[index];
+	outSnapshot.flags = storage.flags[index] & GAMEPLAY_FLAGS;
+	outSnapshot.testChannels = storage.testChannels[index];
+}
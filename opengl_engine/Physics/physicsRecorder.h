@@ -0,0 +1,219 @@
+#pragma once
+#include <Maths/Geometry/box.h>
+#include <Maths/vector3.h>
+#include <Maths/quaternion.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class CollisionComponent;
+class RigidbodyComponent;
+class RigidbodyStorage;
+struct RaycastHitInfos;
+
+
+const std::string PHYSICS_RECORDING_FILE{ "physics_recording.bin" };
+
+
+enum class PhysicsCommandType : uint8_t
+{
+	CreateCollision,
+	CreateRigidbody,
+	RemoveBody,
+	ClearScene,
+	MoveBody,
+	SetRigidbodyState,
+	CreateProjectile,
+	RemoveProjectile,
+	LineRaycast,
+	AABBRaycast,
+	AABBSweepRaycast
+};
+
+//  moments of a physics step where the gameplay can change the physics: between two steps and in the events callbacks
+enum class PhysicsStepPoint : uint8_t
+{
+	BeforeStep = 0,
+	AfterCollisionsEvents = 1,
+	AfterTriggersEvents = 2
+};
+
+
+/** Physics Command
+* An input of the physics that has been recorded: something the gameplay created, removed, moved or changed.
+* Values are absolute (positions, velocities), so replaying a command that the replay already did gives the same state.
+*/
+struct PhysicsCommand
+{
+	PhysicsCommandType type{ PhysicsCommandType::ClearScene };
+	PhysicsStepPoint point{ PhysicsStepPoint::BeforeStep };
+	uint32_t id{ 0 }; //  body id (shared by collisions and rigidbodies) or projectile id
+
+	//  bodies: transform of the associated object and box of the collision, so that the replay computes the exact same bounds
+	//  (box AABB: the box has the object scale applied and the rotation is ignored, oriented box: the box is in the object space)
+	//  projectiles and raycasts: the position is the start point
+	Vector3 position{ Vector3::zero };
+	Quaternion rotation{ Quaternion::identity };
+	Vector3 scale{ Vector3::one };
+	Box box{ Box::zero };
+	uint8_t collisionShape{ 0 };
+	std::string collisionMesh; //  name of the triangle mesh in the asset manager
+	std::string collisionChannel;
+	uint8_t collisionType{ 0 };
+	bool persistent{ false };
+	bool staticCollision{ false };
+
+	//  rigidbodies state (the velocity is also the projectiles velocity)
+	Vector3 velocity{ Vector3::zero };
+	Vector3 gravityVelocity{ Vector3::zero };
+	Vector3 velocityOneFrame{ Vector3::zero };
+	float stepHeight{ 0.0f };
+	float mass{ 1.0f };
+	uint8_t flags{ 0 };
+	bool wakeUp{ false };
+	std::vector<std::string> testChannels; //  also used by projectiles and raycasts
+
+	//  projectiles and raycasts
+	Vector3 end{ Vector3::zero };
+	float radius{ 0.0f };
+	float lifetime{ 0.0f };
+	bool hit{ false }; //  recorded result of the raycast
+	float hitDistance{ 0.0f };
+};
+
+
+struct PhysicsRecordedStep
+{
+	float dt{ 0.0f };
+	uint64_t stateHash{ 0 }; //  hash of the rigidbodies state at the end of the step
+	std::vector<PhysicsCommand> commands; //  in the order they have to be replayed, grouped by step point
+};
+
+
+/** Physics Recording
+* Inputs of the physics recorded step by step, with a hash of the rigidbodies state after each step.
+* Replaying it through a physics manager must give the exact same hashes, and can be saved to compare several versions of the engine.
+*/
+class PhysicsRecording
+{
+public:
+	bool saveToFile(const std::string& filePath) const;
+	bool loadFromFile(const std::string& filePath);
+
+	/**
+	* Hash the simulation state of the rigidbodies (bounds, velocities and flags), in the order of the physics.
+	* @param	rigidbodies		Registered rigidbodies.
+	* @param	storage			Storage of the rigidbodies simulation state.
+	* @return					FNV-1a hash of the state.
+	*/
+	static uint64_t HashRigidbodies(const std::vector<RigidbodyComponent*>& rigidbodies, const RigidbodyStorage& storage);
+
+	std::vector<PhysicsRecordedStep> steps;
+};
+
+
+/** Physics Recorder
+* Records the inputs of the physics manager that owns it: delta time of each step, bodies creation and removal,
+* what the gameplay changed on the bodies (positions, velocities, flags), projectiles and raycasts.
+* The changes are found by comparing the bodies to a snapshot taken each time the gameplay is given the hand,
+* so that nothing has to be recorded from the gameplay code.
+*/
+class PhysicsRecorder
+{
+public:
+	PhysicsRecorder(const std::vector<CollisionComponent*>& collisions, const std::vector<RigidbodyComponent*>& rigidbodies, RigidbodyStorage& storage);
+
+	/**
+	* Start a new recording from the current bodies. They should all be awake, so that the replay starts from the same sleep state.
+	*/
+	void start();
+	void stop();
+	inline bool isRecording() const { return recording; }
+	inline const PhysicsRecording& getRecording() const { return record; }
+
+	void recordCollisionCreated(const CollisionComponent* collision);
+	void recordRigidbodyCreated(const RigidbodyComponent* rigidbody);
+	void recordCollisionRemoved(const CollisionComponent* collision);
+	void recordRigidbodyRemoved(const RigidbodyComponent* rigidbody);
+	void recordSceneCleared();
+
+	void recordProjectileCreated(uint32_t projectileId, const Vector3& position, const Vector3& velocity, float radius, float lifetime, const std::vector<std::string>& testChannels);
+	void recordProjectileRemoved(uint32_t projectileId);
+
+	void recordLineRaycast(const Vector3& start, const Vector3& end, const std::vector<std::string>& testChannels, bool hit, const RaycastHitInfos& hitInfos);
+	void recordAABBRaycast(const Vector3& location, const Box& aabbBox, const std::vector<std::string>& testChannels, bool hit);
+	void recordAABBSweepRaycast(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string>& testChannels, bool hit, const RaycastHitInfos& hitInfos);
+
+	/**
+	* Start to record a physics step, with the changes made by the gameplay since the previous step.
+	* @param	dt		Delta time of the physics step.
+	*/
+	void beginStep(float dt);
+
+	/**
+	* Snapshot the bodies before an events dispatch, the changes made by the callbacks are recorded by endEventsWindow.
+	* @param	point	Step point the changes will be replayed at.
+	*/
+	void beginEventsWindow(PhysicsStepPoint point);
+	void endEventsWindow();
+
+	/**
+	* End the recorded step with the hash of the rigidbodies state, and snapshot the bodies for the next step.
+	*/
+	void endStep();
+
+private:
+	struct BodySnapshot
+	{
+		Vector3 position{ Vector3::zero };
+		Quaternion rotation{ Quaternion::identity };
+		Vector3 scale{ Vector3::one };
+		Box box{ Box::zero };
+		Vector3 velocity{ Vector3::zero };
+		Vector3 gravityVelocity{ Vector3::zero };
+		Vector3 velocityOneFrame{ Vector3::zero };
+		float stepHeight{ 0.0f };
+		float mass{ 1.0f };
+		uint8_t flags{ 0 };
+		std::vector<std::string> testChannels;
+	};
+
+	struct TrackedBody
+	{
+		uint32_t id{ 0 };
+		int createCommand{ -1 }; //  index of the creation command while its values are waiting for the next snapshot
+		BodySnapshot snapshot;
+	};
+
+	bool canRecordQuery() const;
+	PhysicsCommand& addCommand(PhysicsCommandType type, uint32_t id);
+
+	//  fill the creation commands that wait for their values, and record the changes from the snapshot
+	void flushCreations();
+	void recordChanges();
+	void takeSnapshot();
+
+	bool snapshotCollision(const CollisionComponent& collision, BodySnapshot& outSnapshot) const;
+	void snapshotRigidbody(const RigidbodyComponent& rigidbody, BodySnapshot& outSnapshot) const;
+
+	const std::vector<CollisionComponent*>& collisions;
+	const std::vector<RigidbodyComponent*>& rigidbodies;
+	RigidbodyStorage& storage;
+
+	bool recording{ false };
+	bool insideStep{ false };
+	bool insideEventsWindow{ false };
+	PhysicsStepPoint currentPoint{ PhysicsStepPoint::BeforeStep };
+
+	PhysicsRecording record;
+	PhysicsRecordedStep currentStep;
+
+	uint32_t nextBodyId{ 1 };
+	std::unordered_map<const CollisionComponent*, TrackedBody> trackedCollisions;
+	std::unordered_map<const RigidbodyComponent*, TrackedBody> trackedRigidbodies;
+	std::vector<std::pair<const CollisionComponent*, const RigidbodyComponent*>> pendingCreations;
+	BodySnapshot currentSnapshot; //  scratch snapshot
+};
@@ -0,0 +1,300 @@
+#include "physicsReplay.h"
+#include "physicsManager.h"
+#include "AABB/boxAABBColComp.h"
+#include "OBB/orientedBoxColComp.h"
+#include "TriangleMesh/triangleMeshColComp.h"
+#include <Assets/assetManager.h>
+#include <Maths/Maths.h>
+#include <Objects/object.h>
+#include <ServiceLocator/locator.h>
+#include <Utils/elapsedTime.h>
+
+#include <chrono>
+
+
+bool PhysicsReplay::Run(const PhysicsRecording& recording, bool multithreading, PhysicsReplayResults& outResults)
+{
+	outResults = PhysicsReplayResults();
+	if (recording.steps.empty()) return false;
+
+	//  the replayed bodies register themselves in the physics of the Locator
+	Physics& game_physics = Locator::getPhysics();
+	PhysicsManager manager;
+	Locator::providePhysics(&manager);
+
+	//  the test channels are already registered by the game physics, the solve uses the jobs service of the engine
+	manager.SetEnableMultithreading(multithreading);
+
+	{
+		PhysicsReplay replay(manager);
+		manager.replay = &replay;
+
+		for (int i = 0; i < recording.steps.size(); i++)
+		{
+			const PhysicsRecordedStep& step = recording.steps[i];
+			replay.currentStep = &step;
+			replay.nextCommand = 0;
+			replay.applyCommands(PhysicsStepPoint::BeforeStep);
+			replay.commandsTime = 0.0;
+
+			auto start = std::chrono::steady_clock::now();
+			manager.UpdatePhysics(step.dt);
+			const double step_time = GetElapsedMilliseconds(start) - replay.commandsTime;
+
+			outResults.stepsTime += step_time;
+			outResults.maxStepTime = Maths::max(outResults.maxStepTime, step_time);
+			outResults.maxRigidbodiesCount = Maths::max(outResults.maxRigidbodiesCount, static_cast<int>(manager.rigidbodiesComponents.size()));
+
+			if (outResults.divergentStep < 0 && PhysicsRecording::HashRigidbodies(manager.rigidbodiesComponents.getValues(), manager.rigidbodyStorage) != step.stateHash)
+			{
+				outResults.divergentStep = i;
+			}
+		}
+
+		outResults.stepsCount = static_cast<int>(recording.steps.size());
+		outResults.raycastsMismatches = replay.raycastsMismatches;
+
+		//  the replayed collisions and rigidbodies are deleted by the physics, their objects by the replay
+		manager.replay = nullptr;
+		manager.ClearAllCollisions(true);
+	}
+
+	Locator::providePhysics(&game_physics);
+	return true;
+}
+
+
+PhysicsReplay::PhysicsReplay(PhysicsManager& manager_) : manager(manager_)
+{
+}
+
+PhysicsReplay::~PhysicsReplay()
+{
+	for (auto& body : bodies)
+	{
+		delete body.second.object;
+	}
+}
+
+void PhysicsReplay::applyCommands(PhysicsStepPoint point)
+{
+	if (!currentStep) return;
+
+	auto start = std::chrono::steady_clock::now();
+
+	const std::vector<PhysicsCommand>& commands = currentStep->commands;
+	while (nextCommand < commands.size() && commands[nextCommand].point == point)
+	{
+		applyCommand(commands[nextCommand]);
+		nextCommand++;
+	}
+
+	commandsTime += GetElapsedMilliseconds(start);
+}
+
+void PhysicsReplay::applyCommand(const PhysicsCommand& command)
+{
+	RigidbodyStorage& storage = manager.GetRigidbodyStorage();
+
+	switch (command.type)
+	{
+	case PhysicsCommandType::CreateCollision:
+		createBody(command, false);
+		break;
+
+	case PhysicsCommandType::CreateRigidbody:
+		createBody(command, true);
+		break;
+
+	case PhysicsCommandType::RemoveBody:
+		removeBody(command.id);
+		break;
+
+	case PhysicsCommandType::ClearScene:
+		clearScene();
+		break;
+
+	case PhysicsCommandType::MoveBody:
+	{
+		auto iter = bodies.find(command.id);
+		if (iter == bodies.end()) break;
+
+		//  only what changed, moving an object to its own position would still wake up its rigidbody
+		ReplayedBody& body = iter->second;
+		Object& object = *body.object;
+		if (!(object.getPosition() == command.position)) object.setPosition(command.position);
+
+		const Quaternion rotation = object.getRotation();
+		if (rotation.x != command.rotation.x || rotation.y != command.rotation.y || rotation.z != command.rotation.z || rotation.w != command.rotation.w) object.setRotation(command.rotation);
+		if (!(object.getScale() == command.scale)) object.setScale(command.scale);
+
+		Box box = Box::zero;
+		switch (body.collision->getCollisionShape())
+		{
+		case CollisionShape::BoxAABB:
+			box = static_cast<BoxAABBColComp*>(body.collision)->getScaledBox();
+			if (!(box.getCenterPoint() == command.box.getCenterPoint()) || !(box.getHalfExtents() == command.box.getHalfExtents())) static_cast<BoxAABBColComp*>(body.collision)->changeBox(command.box);
+			break;
+
+		case CollisionShape::OrientedBox:
+			box = static_cast<OrientedBoxColComp*>(body.collision)->getBox();
+			if (!(box.getCenterPoint() == command.box.getCenterPoint()) || !(box.getHalfExtents() == command.box.getHalfExtents())) static_cast<OrientedBoxColComp*>(body.collision)->changeBox(command.box);
+			break;
+
+		default:
+			break;
+		}
+		break;
+	}
+
+	case PhysicsCommandType::SetRigidbodyState:
+	{
+		auto iter = bodies.find(command.id);
+		if (iter == bodies.end() || !iter->second.rigidbody) break;
+
+		RigidbodyComponent& rigidbody = *iter->second.rigidbody;
+		rigidbody.setPhysicsActivated((command.flags & RigidbodyFlags::PhysicsActivated) != 0);
+		rigidbody.setUseGravity((command.flags & RigidbodyFlags::UseGravity) != 0);
+
+		const int index = rigidbody.storageIndex;
+		storage.velocities[index] = command.velocity;
+		storage.gravityVelocities[index] = command.gravityVelocity;
+		storage.velocitiesOneFrame[index] = command.velocityOneFrame;
+		storage.stepHeights[index] = command.stepHeight;
+		storage.masses[index] = command.mass;
+		storage.testChannels[index] = command.testChannels;
+
+		if (command.wakeUp) rigidbody.requestWakeUp();
+		break;
+	}
+
+	case PhysicsCommandType::CreateProjectile:
+		projectilesIds[command.id] = manager.CreateProjectile(command.position, command.velocity, command.radius, command.lifetime, command.testChannels);
+		break;
+
+	case PhysicsCommandType::RemoveProjectile:
+	{
+		auto iter = projectilesIds.find(command.id);
+		if (iter == projectilesIds.end()) break;
+
+		manager.RemoveProjectile(iter->second);
+		projectilesIds.erase(iter);
+		break;
+	}
+
+	case PhysicsCommandType::LineRaycast:
+	{
+		RaycastHitInfos hit_infos;
+		const bool hit = manager.LineRaycast(command.position, command.end, command.testChannels, hit_infos, 0.0f);
+		if (hit != command.hit || (hit && hit_infos.hitDistance != command.hitDistance)) raycastsMismatches++;
+		break;
+	}
+
+	case PhysicsCommandType::AABBRaycast:
+	{
+		const bool hit = manager.AABBRaycast(command.position, command.box, command.testChannels, 0.0f);
+		if (hit != command.hit) raycastsMismatches++;
+		break;
+	}
+
+	case PhysicsCommandType::AABBSweepRaycast:
+	{
+		RaycastHitInfos hit_infos;
+		const bool hit = manager.AABBSweepRaycast(command.position, command.end, command.box, command.testChannels, hit_infos, 0.0f);
+		if (hit != command.hit || (hit && hit_infos.hitDistance != command.hitDistance)) raycastsMismatches++;
+		break;
+	}
+	}
+}
+
+void PhysicsReplay::createBody(const PhysicsCommand& command, bool withRigidbody)
+{
+	const CollisionShape shape = static_cast<CollisionShape>(command.collisionShape);
+	const CollisionType collision_type = static_cast<CollisionType>(command.collisionType);
+	if (withRigidbody && shape != CollisionShape::BoxAABB) return; //  rigidbodies always move as box AABB
+
+	//  a recorded box AABB already has the object scale, the object keeps a scale of one so that the bounds are computed the same way
+	//  the other shapes use the whole recorded transform of their object
+	ReplayedBody body;
+	body.object = new Object();
+	body.object->setPosition(command.position);
+	body.object->setRotation(command.rotation);
+	body.object->setScale(command.scale);
+	body.persistent = command.persistent;
+
+	CollisionComponent* collision = nullptr;
+	switch (shape)
+	{
+	case CollisionShape::BoxAABB:
+		collision = new BoxAABBColComp(command.box, body.object, command.persistent, command.collisionChannel, collision_type);
+		break;
+
+	case CollisionShape::OrientedBox:
+		collision = new OrientedBoxColComp(command.box, body.object, command.persistent, command.collisionChannel, collision_type);
+		break;
+
+	case CollisionShape::TriangleMesh:
+		collision = new TriangleMeshColComp(AssetManager::GetCollisionMesh(command.collisionMesh), body.object, command.persistent, command.collisionChannel, collision_type);
+		break;
+
+	default:
+		Locator::getLog().LogMessage_Category("Physics Replay: A recorded body has an unknown collision shape, it is ignored.", LogCategory::Warning);
+		delete body.object;
+		return;
+	}
+	body.collision = collision;
+
+	if (!withRigidbody)
+	{
+		collision->setStatic(command.staticCollision);
+		manager.CreateCollisionComponent(collision);
+	}
+	else
+	{
+		body.rigidbody = new RigidbodyComponent(collision, false);
+		manager.CreateRigidbodyComponent(body.rigidbody);
+
+		RigidbodyStorage& storage = manager.GetRigidbodyStorage();
+		const int index = body.rigidbody->storageIndex;
+		storage.flags[index] = command.flags | RigidbodyFlags::Registered;
+		storage.velocities[index] = command.velocity;
+		storage.gravityVelocities[index] = command.gravityVelocity;
+		storage.velocitiesOneFrame[index] = command.velocityOneFrame;
+		storage.stepHeights[index] = command.stepHeight;
+		storage.masses[index] = command.mass;
+		storage.testChannels[index] = command.testChannels;
+	}
+
+	bodies[command.id] = body;
+}
+
+void PhysicsReplay::removeBody(uint32_t id)
+{
+	auto iter = bodies.find(id);
+	if (iter == bodies.end()) return;
+
+	ReplayedBody& body = iter->second;
+	if (body.rigidbody) delete body.rigidbody; //  also deletes its collision
+	else delete body.collision;
+	delete body.object;
+
+	bodies.erase(iter);
+}
+
+void PhysicsReplay::clearScene()
+{
+	manager.ClearAllCollisions(false);
+	projectilesIds.clear();
+
+	for (auto iter = bodies.begin(); iter != bodies.end();)
+	{
+		if (iter->second.persistent)
+		{
+			++iter;
+			continue;
+		}
+
+		delete iter->second.object;
+		iter = bodies.erase(iter);
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "physicsRecorder.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+class PhysicsManager;
+class Object;
+
+
+struct PhysicsReplayResults
+{
+	int stepsCount{ 0 };
+	int divergentStep{ -1 }; //  first step whose state hash differs from the recording (-1 if the whole replay is bit-identical)
+	int raycastsMismatches{ 0 }; //  recorded raycasts that didn't give the same result
+	int maxRigidbodiesCount{ 0 };
+	double stepsTime{ 0.0 }; //  physics time of all the steps in ms, the time spent to replay the commands isn't part of it
+	double maxStepTime{ 0.0 };
+};
+
+
+/** Physics Replay
+* Replays a physics recording headless, on a physics manager of its own that is given to the Locator during the replay
+* (the replayed collisions and rigidbodies use the Locator like the ones of the game). The game physics is never touched.
+* The recorded commands are replayed at the same points of the steps they have been recorded at, and the rigidbodies state
+* is hashed after each step to check that the replay gives the exact same results as the recorded session.
+*/
+class PhysicsReplay
+{
+public:
+	/**
+	* Replay a whole recording.
+	* @param	recording		Recording to replay.
+	* @param	multithreading	Enable state of the multithreaded solve of the replay physics.
+	* @param	outResults		Timings and determinism results of the replay. [OUT]
+	* @return					False if the recording is empty.
+	*/
+	static bool Run(const PhysicsRecording& recording, bool multithreading, PhysicsReplayResults& outResults);
+
+private:
+	struct ReplayedBody
+	{
+		Object* object{ nullptr };
+		CollisionComponent* collision{ nullptr };
+		RigidbodyComponent* rigidbody{ nullptr };
+		bool persistent{ false };
+	};
+
+	PhysicsReplay(PhysicsManager& manager);
+	~PhysicsReplay();
+	PhysicsReplay(const PhysicsReplay&) = delete;
+	PhysicsReplay& operator=(const PhysicsReplay&) = delete;
+
+	//  called by the physics manager after its events dispatches
+	friend class PhysicsManager;
+	void applyCommands(PhysicsStepPoint point);
+
+	void applyCommand(const PhysicsCommand& command);
+	void createBody(const PhysicsCommand& command, bool withRigidbody);
+	void removeBody(uint32_t id);
+	void clearScene();
+
+	PhysicsManager& manager;
+
+	const PhysicsRecordedStep* currentStep{ nullptr };
+	int nextCommand{ 0 };
+	double commandsTime{ 0.0 };
+	int raycastsMismatches{ 0 };
+
+	std::unordered_map<uint32_t, ReplayedBody> bodies;
+	std::unordered_map<uint32_t, uint32_t> projectilesIds; //  recorded id to replayed id
+};
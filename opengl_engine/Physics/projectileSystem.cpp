@@ -0,0 +1,127 @@
+#include "projectileSystem.h"
+#include "broadphase.h"
+#include <Maths/Geometry/box.h>
+#include <ServiceLocator/jobs.h>
+
+
+uint32_t ProjectileSystem::create(const Vector3& position, const Vector3& velocity, float radius, float lifetime, const std::vector<std::string>& testChannels)
+{
+	Projectile projectile;
+	projectile.position = position;
+	projectile.velocity = velocity;
+	projectile.radius = radius;
+	projectile.lifetime = lifetime;
+	projectile.channelsIndex = findChannels(testChannels);
+	projectile.id = nextId++;
+
+	idToIndex[projectile.id] = static_cast<int>(projectiles.size());
+	projectiles.push_back(projectile);
+
+	return projectile.id;
+}
+
+void ProjectileSystem::remove(uint32_t projectileId)
+{
+	auto iter = idToIndex.find(projectileId);
+	if (iter == idToIndex.end()) return;
+
+	removeAt(iter->second);
+}
+
+bool ProjectileSystem::getPosition(uint32_t projectileId, Vector3& outPosition) const
+{
+	auto iter = idToIndex.find(projectileId);
+	if (iter == idToIndex.end()) return false;
+
+	outPosition = projectiles[iter->second].position;
+	return true;
+}
+
+void ProjectileSystem::update(float dt, const Broadphase& broadphase, Jobs* jobs, std::vector<ProjectileHit>& outHits)
+{
+	const int count = static_cast<int>(projectiles.size());
+
+	//  each sweep only writes in its own projectile, so they can be done in parallel
+	auto sweep_job = [this, dt, &broadphase](int index) { sweepProjectile(projectiles[index], dt, broadphase); };
+	if (jobs && count >= minProjectilesForMultithreading)
+	{
+		jobs->ParallelFor(count, sweep_job);
+	}
+	else
+	{
+		for (int i = 0; i < count; i++) sweep_job(i);
+	}
+
+	//  gather the hits in the projectiles order, then remove the dead projectiles
+	for (int i = 0; i < projectiles.size(); i++)
+	{
+		if (projectiles[i].hit)
+		{
+			outHits.push_back(projectiles[i].hitInfos);
+			removeAt(i);
+			i--;
+			continue;
+		}
+
+		if (projectiles[i].lifetime <= 0.0f)
+		{
+			removeAt(i);
+			i--;
+		}
+	}
+}
+
+void ProjectileSystem::clear()
+{
+	projectiles.clear();
+	idToIndex.clear();
+	channelsSets.clear();
+}
+
+
+int ProjectileSystem::findChannels(const std::vector<std::string>& testChannels)
+{
+	for (int i = 0; i < channelsSets.size(); i++)
+	{
+		if (channelsSets[i] == testChannels) return i;
+	}
+
+	channelsSets.push_back(testChannels);
+	return static_cast<int>(channelsSets.size()) - 1;
+}
+
+void ProjectileSystem::sweepProjectile(Projectile& projectile, float dt, const Broadphase& broadphase) const
+{
+	projectile.lifetime -= dt;
+
+	const Vector3 movement = projectile.velocity * dt;
+	if (movement == Vector3::zero) return;
+
+	const Vector3 end = projectile.position + movement;
+
+	RaycastHitInfos hit_infos;
+	if (broadphase.sweepAABB(projectile.position, end, Box{ Vector3::zero, Vector3{ projectile.radius, projectile.radius, projectile.radius } }, channelsSets[projectile.channelsIndex], hit_infos, false) && hit_infos.hitCollision)
+	{
+		projectile.hit = true;
+		projectile.position = hit_infos.hitLocation;
+		projectile.hitInfos.projectileId = projectile.id;
+		projectile.hitInfos.hitCollision = hit_infos.hitCollision;
+		projectile.hitInfos.hitLocation = hit_infos.hitLocation;
+		projectile.hitInfos.hitNormal = hit_infos.hitNormal;
+		return;
+	}
+
+	projectile.position = end;
+}
+
+void ProjectileSystem::removeAt(int index)
+{
+	idToIndex.erase(projectiles[index].id);
+
+	if (index != projectiles.size() - 1)
+	{
+		projectiles[index] = projectiles.back();
+		idToIndex[projectiles[index].id] = index;
+	}
+	projectiles.pop_back();
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <Maths/vector3.h>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Broadphase;
+class Jobs;
+class CollisionComponent;
+
+
+/**
+* Hit of a projectile against a solid collision, broadcasted in the batch of the physics step.
+*/
+struct ProjectileHit
+{
+	uint32_t projectileId{ 0 };
+	const CollisionComponent* hitCollision{ nullptr }; //  can be null if the collision has been removed by a callback of the same step
+	Vector3 hitLocation{ Vector3::zero };
+	Vector3 hitNormal{ Vector3::zero };
+};
+
+
+/** Projectile System
+* Lightweight moving primitives (swept sphere, or point with a radius of 0) that are not rigidbodies:
+* no gravity, no collide and slide and no collision of their own, they only move straight and stop at the first solid collision they hit.
+* Projectiles are stored in a packed array and swept through the broadphase, which makes thousands of bullets affordable.
+* The sphere is tested with its bounding box, like every other shape of the physics.
+*/
+class ProjectileSystem
+{
+public:
+	/**
+	* Create a projectile.
+	* @param	position		Start position (world coordinates).
+	* @param	velocity		Velocity of the projectile (units per second), constant during its whole life.
+	* @param	radius			Radius of the swept sphere (0 for a point).
+	* @param	lifetime		Duration after which the projectile is removed if it didn't hit anything.
+	* @param	testChannels	Collision channels the projectile will test.
+	* @return					Id of the created projectile.
+	*/
+	uint32_t create(const Vector3& position, const Vector3& velocity, float radius, float lifetime, const std::vector<std::string>& testChannels);
+
+	/**
+	* Remove a projectile. Does nothing if it has already hit something or run out of time.
+	* @param	projectileId	Id of the projectile to remove.
+	*/
+	void remove(uint32_t projectileId);
+
+	/**
+	* Retrieve the position of a projectile.
+	* @param	projectileId	Id of the projectile.
+	* @param	outPosition		Position of the projectile. [OUT]
+	* @return					False if the projectile doesn't exist anymore.
+	*/
+	bool getPosition(uint32_t projectileId, Vector3& outPosition) const;
+
+	/**
+	* Move all the projectiles and sweep them through the broadphase.
+	* The projectiles that hit something or run out of time are removed.
+	* @param	dt					Delta time of the physics step.
+	* @param	broadphase			Broadphase snapshot of the step.
+	* @param	jobs				Jobs service used to sweep the projectiles (can be null to sweep them serially).
+	* @param	outHits				Hits of this step, in the order of the projectiles. [OUT]
+	*/
+	void update(float dt, const Broadphase& broadphase, Jobs* jobs, std::vector<ProjectileHit>& outHits);
+
+	void clear();
+
+	inline size_t getProjectilesCount() const { return projectiles.size(); }
+
+private:
+	struct Projectile
+	{
+		Vector3 position{ Vector3::zero };
+		Vector3 velocity{ Vector3::zero };
+		float radius{ 0.0f };
+		float lifetime{ 0.0f };
+		int channelsIndex{ 0 };
+		uint32_t id{ 0 };
+
+		//  written by the sweep
+		bool hit{ false };
+		ProjectileHit hitInfos;
+	};
+
+	int findChannels(const std::vector<std::string>& testChannels);
+	void sweepProjectile(Projectile& projectile, float dt, const Broadphase& broadphase) const;
+	void removeAt(int index);
+
+	std::vector<Projectile> projectiles;
+	std::unordered_map<uint32_t, int> idToIndex;
+	std::vector<std::vector<std::string>> channelsSets; //  projectiles share their test channels vectors (usually one per weapon)
+	uint32_t nextId{ 1 };
+
+	const int minProjectilesForMultithreading{ 64 };
+};
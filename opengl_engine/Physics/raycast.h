@@ -2,11 +2,12 @@
 #include "physicEntity.h"
 
 #include <Maths/vector3.h>
+#include <Utils/frameArena.h>
 #include <limits>
 #include <vector>
 
 class CollisionComponent;
-class Material;
+class DebugDrawList;
 
 
 enum class RaycastType : uint8_t
@@ -14,13 +15,14 @@ enum class RaycastType : uint8_t
 	RaycastTypeNone = 0,
 	RaycastTypeLine = 1,
 	RaycastTypeAABB = 2,
-	RaycastTypeAABBSweep = 3
+	RaycastTypeAABBSweep = 3,
+	RaycastTypeProjectile = 4
 };
 
 
 struct RaycastHitInfos
 {
-	RaycastHitInfos(Vector3 location, Vector3 normal, float distance, const CollisionComponent* collision, std::vector<const CollisionComponent*> triggers) :
+	RaycastHitInfos(Vector3 location, Vector3 normal, float distance, const CollisionComponent* collision, FrameVector<const CollisionComponent*> triggers) :
 		hitLocation(location), hitNormal(normal), hitDistance(distance), hitCollision(collision), triggersDetected(triggers) {}
 
 	RaycastHitInfos() :
@@ -30,12 +32,20 @@ struct RaycastHitInfos
 	Vector3 hitNormal{ Vector3::zero };
 	float hitDistance{ std::numeric_limits<float>::max() }; //  used to get the nearest hit in case of multiple hits
 	const CollisionComponent* hitCollision{ nullptr };
-	std::vector<const CollisionComponent*> triggersDetected;
+	FrameVector<const CollisionComponent*> triggersDetected; //  filled during the frame, valid until the end of the next one
 
 	static RaycastHitInfos defaultInfos;
 };
 
 
+struct ColliderDistanceInfos
+{
+	const CollisionComponent* collision{ nullptr };
+	Vector3 closestPoint{ Vector3::zero }; //  point of the collision that is the closest to the query point
+	float distance{ std::numeric_limits<float>::max() }; //  0 if the query point is inside the collision
+};
+
+
 /** Raycast
 * Raycast class contains common functionnalities to all raycasts types, such as timer and draw.
 */
@@ -47,7 +57,7 @@ public:
 	Raycast(const Raycast&) = delete;
 	Raycast& operator=(const Raycast&) = delete;
 
-	virtual void drawDebugRaycast(Material& debugMaterial) = 0;
+	virtual void drawDebugRaycast(DebugDrawList& outDrawList) = 0;
 
 	void updateDrawDebugTimer(float dt);
 
@@ -12,14 +12,14 @@ RaycastLine::RaycastLine(const Vector3& startPoint, const Vector3& endPoint, flo
 }
 
 
-void RaycastLine::drawDebugRaycast(Material& debugMaterial)
+void RaycastLine::drawDebugRaycast(DebugDrawList& outDrawList)
 {
-	drawDebugLineOne.drawLine(debugMaterial, Color::green);
+	drawDebugLineOne.drawLine(outDrawList, Color::green);
 
 	if (!hit) return;
 
-	drawDebugLineTwo.drawLine(debugMaterial, Color::red);
-	drawDebugPointHit.drawPoint(debugMaterial, Color::green);
+	drawDebugLineTwo.drawLine(outDrawList, Color::red);
+	drawDebugPointHit.drawPoint(outDrawList, Color::green);
 }
 
 void RaycastLine::setHitPos(Vector3 hitPosition)
@@ -17,7 +17,7 @@ public:
 	RaycastLine(const RaycastLine&) = delete;
 	RaycastLine& operator=(const RaycastLine&) = delete;
 
-	void drawDebugRaycast(Material& debugMaterial) override;
+	void drawDebugRaycast(DebugDrawList& outDrawList) override;
 
 	void setHitPos(Vector3 hitPosition);
 
@@ -1,13 +1,18 @@
 #include "rigidbodyComponent.h"
 #include <ServiceLocator/locator.h>
 #include "ObjectChannels/collisionChannels.h"
+#include "broadphase.h"
 
 RigidbodyComponent::RigidbodyComponent(CollisionComponent* collisionToAssociate, bool activatePhysics) :
-	PhysicEntity(collisionToAssociate->loadedPersistent), physicsActivated(activatePhysics), useGravity(activatePhysics)
+	PhysicEntity(collisionToAssociate->loadedPersistent), storage(&Locator::getPhysics().GetRigidbodyStorage())
 {
+	uint8_t flags = RigidbodyFlags::FirstFrame;
+	if (activatePhysics) flags |= RigidbodyFlags::PhysicsActivated | RigidbodyFlags::UseGravity;
+	storageIndex = storage->add(this, flags);
+
 	associateCollision(collisionToAssociate);
 
-	onCollisionRepulsed.registerObserver(this, Bind_1(&RigidbodyComponent::onCollision));
+	onCollisionRepulsed.registerObserver(this, &RigidbodyComponent::onCollision);
 }
 
 RigidbodyComponent::~RigidbodyComponent()
@@ -20,6 +25,8 @@ RigidbodyComponent::~RigidbodyComponent()
 	onRigidbodyDelete.broadcast();
 
 	delete associatedCollision;
+
+	storage->remove(storageIndex);
 }
 
 void RigidbodyComponent::associateCollision(CollisionComponent* collisionToAssociate)
@@ -32,76 +39,71 @@ void RigidbodyComponent::associateCollision(CollisionComponent* collisionToAssoc
 	associatedCollision = collisionToAssociate;
 	if (associatedCollision)
 	{
+		if (associatedCollision->getCollisionShape() != CollisionShape::BoxAABB)
+		{
+			//  the collide and slide moves the rigidbodies as boxes
+			Locator::getLog().LogMessage_Category("Rigidbody: Associated a collision that isn't a box AABB, rigidbodies only support box AABB collisions.", LogCategory::Error);
+		}
+
 		//  do initialization things with the newly associated collision
 		associatedCollision->setRigidbody(this);
 
-		associatedCollision->onCollisionIntersect.registerObserver(this, Bind_2(&RigidbodyComponent::onCollisionIntersected));
+		associatedCollision->onCollisionIntersect.registerObserver(this, &RigidbodyComponent::onCollisionIntersected);
 	}
 }
 
 
 void RigidbodyComponent::updatePhysicsPreCollision(float dt)
 {
-	if (firstFrame) return;
-
-	//  compute gravity in velocity
-	if (useGravity)
-	{
-		float gravity_strength = Locator::getPhysics().GetGravityValue();
-
-		if (gravityVelocity.y > gravity_strength * 2.0f)
-			gravityVelocity.y += gravity_strength * dt * 2.5f;
-
+	if (hasFlag(RigidbodyFlags::FirstFrame)) return;
 
-		groundedLastFrame = onGround;
-		onGround = false;
-	}
-
-	//  compute anticipated movement
-	if (velocityOneFrame.y != 0.0f)
+	//  the gravity and the anticipated movements have been computed by the rigidbody storage
+	Vector3& velocity_one_frame = storage->velocitiesOneFrame[storageIndex];
+	if (velocity_one_frame.y != 0.0f)
 	{
 		//  y velocity one frame will make the rigidbody start the test inside the collision that gave it
-		associatedCollision->addPosition(Vector3{ 0.0f, velocityOneFrame.y, 0.0f } *dt);
-		velocityOneFrame.y = 0.0f;
+		associatedCollision->addPosition(Vector3{ 0.0f, velocity_one_frame.y, 0.0f } *dt);
 	}
-
-	movement = (velocity + velocityOneFrame) * dt;
-	gravityMovement = gravityVelocity * dt;
-	velocityOneFrame = Vector3::zero;
+	velocity_one_frame = Vector3::zero;
 
 	//  if rigidbody has no physic activated, it moves but without checking for collisions to repulse its movement
 	if (!isPhysicsActivated())
 	{
+		Vector3& movement = storage->movements[storageIndex];
+		Vector3& gravity_movement = storage->gravityMovements[storageIndex];
 		associatedCollision->addPosition(movement);
-		associatedCollision->addPosition(gravityMovement);
+		associatedCollision->addPosition(gravity_movement);
 		movement = Vector3::zero;
-		gravityMovement = Vector3::zero;
+		gravity_movement = Vector3::zero;
 	}
 }
 
 void RigidbodyComponent::updatePhysicsPostCollision(float dt)
 {
-	if (firstFrame)
+	if (hasFlag(RigidbodyFlags::FirstFrame))
 	{
-		firstFrame = false;
+		setFlag(RigidbodyFlags::FirstFrame, false);
 		return;
 	}
 
 	if (!isPhysicsActivated()) return;
 
+	Vector3& movement = storage->movements[storageIndex];
+	Vector3& gravity_movement = storage->gravityMovements[storageIndex];
+	const float step_height = getStepHeight();
 
 	//  inversed step mechanic
-	if (getStepHeight() > 0.0f && groundedLastFrame && !isOnGround() && gravityMovement.y < 0.0f)
+	if (step_height > 0.0f && hasFlag(RigidbodyFlags::GroundedLastFrame) && !isOnGround() && gravity_movement.y < 0.0f)
 	{
 		Box box = associatedCollision->getEncapsulatingBox();
 		RaycastHitInfos out;
 
-		bool hit = Locator::getPhysics().AABBSweepRaycast(box.getCenterPoint() + gravityMovement, box.getCenterPoint() + Vector3{ 0.0f, -stepHeight, 0.0f }, box, { "solid" }, out, 0.0f);
+		bool hit = Locator::getPhysics().AABBSweepRaycast(box.getCenterPoint() + gravity_movement, box.getCenterPoint() + Vector3{ 0.0f, -step_height, 0.0f }, box, { "solid" }, out, 0.0f);
 		if (hit)
 		{
 			if (out.hitNormal == Vector3::unitY)
 			{
-				gravityMovement += Vector3{ 0.0f, -(out.hitDistance - Rigidbody::SECURITY_DIST), 0.0f };
+				gravity_movement += Vector3{ 0.0f, -(out.hitDistance - Rigidbody::SECURITY_DIST), 0.0f };
 			}
 		}
 	}
@@ -109,43 +111,51 @@ void RigidbodyComponent::updatePhysicsPostCollision(float dt)
 
 	//  apply real movement (anticipated movement modified by the collisions during physics step)
 	associatedCollision->addPosition(movement);
-	associatedCollision->addPosition(gravityMovement);
+	associatedCollision->addPosition(gravity_movement);
 	movement = Vector3::zero;
-	gravityMovement = Vector3::zero;
+	gravity_movement = Vector3::zero;
 }
 
 void RigidbodyComponent::setPhysicsActivated(bool value)
 {
-	physicsActivated = value;
+	if (hasFlag(RigidbodyFlags::PhysicsActivated) != value) requestWakeUp();
+	setFlag(RigidbodyFlags::PhysicsActivated, value);
 }
 
 void RigidbodyComponent::setUseGravity(bool value)
 {
-	useGravity = value;
+	if (hasFlag(RigidbodyFlags::UseGravity) != value) requestWakeUp();
+	setFlag(RigidbodyFlags::UseGravity, value);
 }
 
 void RigidbodyComponent::setStepHeight(float value)
 {
-	stepHeight = value;
+	storage->stepHeights[storageIndex] = value;
+}
+
+void RigidbodyComponent::setMass(float value)
+{
+	storage->masses[storageIndex] = value;
 }
 
 void RigidbodyComponent::applyComputedMovement(const Vector3& computedMovement)
 {
 	if (!isPhysicsActivated()) return;
 
-	movement = computedMovement;
+	storage->movements[storageIndex] = computedMovement;
 }
 
 void RigidbodyComponent::applyComputedGravityMovement(const Vector3& computedGravityMovement)
 {
 	if (!isPhysicsActivated()) return;
 
-	gravityMovement = computedGravityMovement;
+	storage->gravityMovements[storageIndex] = computedGravityMovement;
 }
 
-bool RigidbodyComponent::checkStepMechanic(const CollisionComponent& collidedComp, const Vector3 aimedDestination, const Vector3 hitNormal, float& stepMovement) const
+bool RigidbodyComponent::checkStepMechanic(const Broadphase& broadphase, const CollisionComponent& collidedComp, const Vector3 aimedDestination, const Vector3 hitNormal, float& stepMovement) const
 {
-	if (stepHeight <= 0.0f)
+	const float step_height = getStepHeight();
+	if (step_height <= 0.0f)
 		return false; //  continue only if this rigidbody use step mechanic
 
 	if (!(Maths::abs(Vector3::dot(Vector3::unitY, hitNormal)) < 0.5f))
@@ -159,11 +169,11 @@ bool RigidbodyComponent::checkStepMechanic(const CollisionComponent& collidedCom
 	Box collided_box = collidedComp.getEncapsulatingBox();
 	stepMovement = collided_box.getMaxPoint().y - body_box.getMinPoint().y + Rigidbody::SECURITY_DIST; //  compute needed step movement
 
-	if (stepMovement > stepHeight)
+	if (stepMovement > step_height)
 		return false; //  continue only if needed step movement is lower than this rigidbody step height
 
 	body_box.setCenterPoint(aimedDestination + Vector3{ 0.0f, stepMovement, 0.0f });
-	if (Locator::getPhysics().AABBRaycast(Vector3::zero, body_box, getTestChannels(), 0.0f, true))
+	if (broadphase.overlapAABB(body_box, getTestChannels(), associatedCollision))
 		return false; //  continue only if step destination is free
 
 	return true;
@@ -171,54 +181,62 @@ bool RigidbodyComponent::checkStepMechanic(const CollisionComponent& collidedCom
 
 void RigidbodyComponent::setVelocity(const Vector3& value)
 {
+	Vector3& velocity = storage->velocities[storageIndex];
+	if (!(velocity == value)) requestWakeUp();
 	velocity = value;
 }
 
 void RigidbodyComponent::addVelocity(const Vector3& value)
 {
-	velocity += value;
+	if (!(value == Vector3::zero)) requestWakeUp();
+	storage->velocities[storageIndex] += value;
 }
 
 Vector3 RigidbodyComponent::getVelocity() const
 {
-	return velocity;
+	return storage->velocities[storageIndex];
 }
 
 void RigidbodyComponent::setGravityVelocity(const Vector3& value)
 {
-	gravityVelocity = value;
+	Vector3& gravity_velocity = storage->gravityVelocities[storageIndex];
+	if (!(gravity_velocity == value)) requestWakeUp();
+	gravity_velocity = value;
 }
 
 void RigidbodyComponent::addGravityVelocity(const Vector3& value)
 {
-	gravityVelocity += value;
+	if (!(value == Vector3::zero)) requestWakeUp();
+	storage->gravityVelocities[storageIndex] += value;
 }
 
 Vector3 RigidbodyComponent::getGravityVelocity() const
 {
-	return gravityVelocity;
+	return storage->gravityVelocities[storageIndex];
 }
 
 void RigidbodyComponent::addVelocityOneFrame(const Vector3& value)
 {
-	velocityOneFrame += value;
+	if (!(value == Vector3::zero)) requestWakeUp();
+	storage->velocitiesOneFrame[storageIndex] += value;
 }
 
 void RigidbodyComponent::setTestChannels(std::vector<std::string> newTestChannels)
 {
-	testChannels = newTestChannels;
+	storage->testChannels[storageIndex] = newTestChannels;
 }
 
 void RigidbodyComponent::addTestChannel(std::string newTestChannel)
 {
-	testChannels.push_back(newTestChannel);
+	storage->testChannels[storageIndex].push_back(newTestChannel);
 }
 
-std::vector<std::string> RigidbodyComponent::getTestChannels() const
+const std::vector<std::string>& RigidbodyComponent::getTestChannels() const
 {
-	if (testChannels.empty()) return CollisionChannels::GetRegisteredTestChannel("TestEverything");
+	const std::vector<std::string>& test_channels = storage->testChannels[storageIndex];
+	if (test_channels.empty()) return CollisionChannels::GetRegisteredTestChannel("TestEverything");
 
-	return testChannels;
+	return test_channels;
 }
 
 void RigidbodyComponent::resetIntersected()
@@ -226,6 +244,74 @@ void RigidbodyComponent::resetIntersected()
 	associatedCollision->resetIntersected();
 }
 
+void RigidbodyComponent::updateSleepTimer(float dt)
+{
+	if (isAsleep()) return;
+
+	const Vector3& velocity = storage->velocities[storageIndex];
+	const Vector3& gravity_velocity = storage->gravityVelocities[storageIndex];
+
+	bool resting = storage->velocitiesOneFrame[storageIndex] == Vector3::zero;
+	if (isPhysicsActivated())
+	{
+		const float threshold_sq = Rigidbody::SLEEP_VELOCITY_THRESHOLD * Rigidbody::SLEEP_VELOCITY_THRESHOLD;
+		resting = resting && velocity.lengthSq() <= threshold_sq;
+
+		//  ground contact zeroes the gravity velocity at each step
+		if (getUseGravity()) resting = resting && hasFlag(RigidbodyFlags::OnGround);
+		else resting = resting && gravity_velocity.lengthSq() <= threshold_sq;
+	}
+	else
+	{
+		//  non physics activated rigidbodies move without any test, so they must be perfectly still
+		resting = resting && velocity == Vector3::zero && gravity_velocity == Vector3::zero;
+	}
+
+	if (hasFlag(RigidbodyFlags::FirstFrame) || !resting)
+	{
+		sleepTimer = 0.0f;
+		return;
+	}
+
+	sleepTimer += dt;
+}
+
+void RigidbodyComponent::sleep(unsigned int islandId)
+{
+	setFlag(RigidbodyFlags::Asleep, true);
+	wakeUpRequested = false;
+	sleepIslandId = islandId;
+
+	storage->movements[storageIndex] = Vector3::zero;
+	storage->gravityMovements[storageIndex] = Vector3::zero;
+
+	//  used to wake up the rigidbody if something moves it from outside the physics
+	if (associatedCollision && associatedCollision->getAssociatedObject())
+	{
+		sleepTransformVersion = associatedCollision->getAssociatedObject()->getTransformVersion();
+	}
+}
+
+void RigidbodyComponent::wakeUp()
+{
+	setFlag(RigidbodyFlags::Asleep, false);
+	wakeUpRequested = false;
+	sleepTimer = 0.0f;
+}
+
+bool RigidbodyComponent::needWakeUp() const
+{
+	if (!isAsleep()) return false;
+	if (wakeUpRequested) return true;
+
+	if (associatedCollision && associatedCollision->getAssociatedObject())
+	{
+		return associatedCollision->getAssociatedObject()->getTransformVersion() != sleepTransformVersion;
+	}
+
+	return false;
+}
+
 void RigidbodyComponent::onCollisionIntersected(RigidbodyComponent& other, const CollisionResponse& collisionResponse)
 {
 	if (isPhysicsActivated() || !other.isPhysicsActivated()) return;
@@ -242,8 +328,8 @@ void RigidbodyComponent::onCollision(const CollisionResponse& collisionResponse)
 {
 	if (collisionResponse.impactNormal == Vector3::unitY)
 	{
-		onGround = true;
-		gravityVelocity = Vector3::zero;
+		setFlag(RigidbodyFlags::OnGround, true);
+		storage->gravityVelocities[storageIndex] = Vector3::zero;
 	}
 	//  might change that later to allow onGround even on non perfectly flat surfaces using dot product
 	//  not necessary now since there is only AABB currently implemented in this engine
@@ -1,14 +1,21 @@
 #pragma once
 #include "collisionComponent.h"
 #include "physicEntity.h"
+#include "rigidbodyStorage.h"
 #include <Events/event.h>
 #include <Events/observer.h>
 
 
+class Broadphase;
+
+
 namespace Rigidbody
 {
 	const int MAX_BOUNCES = 5;
 	const float SECURITY_DIST = 0.001f;
+
+	const float SLEEP_VELOCITY_THRESHOLD = 0.05f; //  under this velocity, a rigidbody is considered resting
+	const float SLEEP_TIME = 0.5f; //  time a rigidbody must be resting before being allowed to sleep
 }
 
 
@@ -22,6 +29,7 @@ struct CollisionResponse
 /** Rigidbody Component
 * Will tests other colliders and react with physics if it is activated.
 * If physics is not activated, will act as a static collision (even if it moves with velocity).
+* Its simulation state (velocities, movements, flags) is stored in the rigidbody storage of the physics service, the component is a handle on it.
 */
 class RigidbodyComponent : public PhysicEntity, public Observer
 {
@@ -37,20 +45,29 @@ public:
 	void updatePhysicsPostCollision(float dt);
 
 	void setPhysicsActivated(bool value);
-	inline bool isPhysicsActivated() const { return physicsActivated && associatedCollision; }
+	inline bool isPhysicsActivated() const { return hasFlag(RigidbodyFlags::PhysicsActivated) && associatedCollision; }
 
 	void setUseGravity(bool value);
-	inline bool getUseGravity() const { return useGravity; }
+	inline bool getUseGravity() const { return hasFlag(RigidbodyFlags::UseGravity); }
 
 	void setStepHeight(float value);
-	inline float getStepHeight() const { return stepHeight; }
-
-	inline Vector3 getAnticipatedMovement() const { return movement; }
-	inline Vector3 getAnticipatedGravityMovement() const { return gravityMovement; }
+	inline float getStepHeight() const { return storage->stepHeights[storageIndex]; }
+
+	/**
+	* Set the mass used when this rigidbody penetrates another one: the lighter one is pushed more.
+	* A mass of 0 (or less) means this rigidbody is never pushed by the other rigidbodies.
+	* @param	value	New mass of this rigidbody.
+	*/
+	void setMass(float value);
+	inline float getMass() const { return storage->masses[storageIndex]; }
+	inline float getInverseMass() const { return getMass() > 0.0f ? 1.0f / getMass() : 0.0f; }
+
+	inline Vector3 getAnticipatedMovement() const { return storage->movements[storageIndex]; }
+	inline Vector3 getAnticipatedGravityMovement() const { return storage->gravityMovements[storageIndex]; }
 	void applyComputedMovement(const Vector3& computedMovement);
 	void applyComputedGravityMovement(const Vector3& computedGravityMovement);
 
-	bool checkStepMechanic(const CollisionComponent& collidedComp, const Vector3 aimedDestination, const Vector3 hitNormal, float& stepMovement) const;
+	bool checkStepMechanic(const Broadphase& broadphase, const CollisionComponent& collidedComp, const Vector3 aimedDestination, const Vector3 hitNormal, float& stepMovement) const;
 
 	void setVelocity(const Vector3& value);
 	void addVelocity(const Vector3& value);
@@ -64,17 +81,40 @@ public:
 
 	inline bool isAssociatedCollisionValid() const { return associatedCollision; }
 
-	inline bool isOnGround() const { return onGround && getUseGravity(); }
+	inline bool isOnGround() const { return hasFlag(RigidbodyFlags::OnGround) && getUseGravity(); }
 
 	void setTestChannels(std::vector<std::string> newTestChannels);
 	void addTestChannel(std::string newTestChannel);
-	std::vector<std::string> getTestChannels() const;
+	const std::vector<std::string>& getTestChannels() const;
 
 	void resetIntersected();
 
+	/**
+	* Update the sleep timer of this rigidbody, at the end of a physics step.
+	* @param	dt		Delta time of the physics step.
+	*/
+	void updateSleepTimer(float dt);
+	inline bool canSleep() const { return sleepTimer >= Rigidbody::SLEEP_TIME; }
+	inline bool isAsleep() const { return hasFlag(RigidbodyFlags::Asleep); }
+
+	/**
+	* Put this rigidbody to sleep: it will not be updated by the physics until it wakes up.
+	* @param	islandId	Id of the simulation island this rigidbody falls asleep with.
+	*/
+	void sleep(unsigned int islandId);
+	void wakeUp();
+
+	//  ask the physics manager to wake this rigidbody (and its island) at the beginning of the next physics step
+	inline void requestWakeUp() { if (isAsleep()) wakeUpRequested = true; }
+	bool needWakeUp() const;
+	inline unsigned int getSleepIslandId() const { return sleepIslandId; }
+
 
 	//  for physics manager
 	bool registered{ false };
+	SlotHandle physicsHandle;
+	int stepIndex{ -1 };
+	int storageIndex{ -1 }; //  kept up to date by the rigidbody storage
 
 	Event<> onRigidbodyDelete;
 	Event<const CollisionResponse&> onCollisionRepulsed;
@@ -84,24 +124,17 @@ public:
 private:
 	CollisionComponent* associatedCollision{ nullptr };
 
-	bool physicsActivated{ false };
-
-	float stepHeight{ 0.0f };
-
-	Vector3 velocity{ Vector3::zero };
-	Vector3 gravityVelocity{ Vector3::zero };
-	Vector3 velocityOneFrame{ Vector3::zero };
-	Vector3 movement{ Vector3::zero };
-	Vector3 gravityMovement{ Vector3::zero };
-	bool useGravity{ false };
-
-	bool onGround{ false };
-	bool groundedLastFrame{ false };
-
+	//  storage of the physics service this rigidbody has been created with
+	RigidbodyStorage* storage{ nullptr };
 
-	bool firstFrame{ true };
+	inline bool hasFlag(uint8_t flag) const { return storage->hasFlag(storageIndex, flag); }
+	inline void setFlag(uint8_t flag, bool value) { storage->setFlag(storageIndex, flag, value); }
 
-	std::vector<std::string> testChannels;
+	//  sleeping
+	bool wakeUpRequested{ false };
+	float sleepTimer{ 0.0f };
+	unsigned int sleepIslandId{ 0 };
+	unsigned int sleepTransformVersion{ 0 };
 
 
 	void onCollisionIntersected(RigidbodyComponent& other, const CollisionResponse& collisionResponse);
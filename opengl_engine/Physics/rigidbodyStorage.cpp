@@ -0,0 +1,90 @@
+#include "rigidbodyStorage.h"
+#include "rigidbodyComponent.h"
+
+
+int RigidbodyStorage::add(RigidbodyComponent* owner, uint8_t flags_)
+{
+	owners.push_back(owner);
+	velocities.push_back(Vector3::zero);
+	gravityVelocities.push_back(Vector3::zero);
+	velocitiesOneFrame.push_back(Vector3::zero);
+	movements.push_back(Vector3::zero);
+	gravityMovements.push_back(Vector3::zero);
+	stepHeights.push_back(0.0f);
+	masses.push_back(1.0f);
+	flags.push_back(flags_);
+	testChannels.emplace_back();
+
+	return getCount() - 1;
+}
+
+void RigidbodyStorage::remove(int index)
+{
+	const int last = getCount() - 1;
+	if (index != last)
+	{
+		owners[index] = owners[last];
+		velocities[index] = velocities[last];
+		gravityVelocities[index] = gravityVelocities[last];
+		velocitiesOneFrame[index] = velocitiesOneFrame[last];
+		movements[index] = movements[last];
+		gravityMovements[index] = gravityMovements[last];
+		stepHeights[index] = stepHeights[last];
+		masses[index] = masses[last];
+		flags[index] = flags[last];
+		testChannels[index].swap(testChannels[last]);
+
+		owners[index]->storageIndex = index;
+	}
+
+	owners.pop_back();
+	velocities.pop_back();
+	gravityVelocities.pop_back();
+	velocitiesOneFrame.pop_back();
+	movements.pop_back();
+	gravityMovements.pop_back();
+	stepHeights.pop_back();
+	masses.pop_back();
+	flags.pop_back();
+	testChannels.pop_back();
+}
+
+void RigidbodyStorage::integrateGravity(float dt, float gravity)
+{
+	const int count = getCount();
+	const uint8_t skipped = RigidbodyFlags::Asleep | RigidbodyFlags::FirstFrame;
+	const uint8_t required = RigidbodyFlags::Registered | RigidbodyFlags::UseGravity;
+	const float max_fall_velocity = gravity * 2.0f;
+	const float gravity_step = gravity * dt * 2.5f;
+
+	for (int i = 0; i < count; i++)
+	{
+		uint8_t& body_flags = flags[i];
+		if ((body_flags & required) != required || (body_flags & skipped) != 0) continue;
+
+		if (gravityVelocities[i].y > max_fall_velocity) gravityVelocities[i].y += gravity_step;
+
+		//  grounded last frame = on ground, then on ground = false
+		body_flags = (body_flags & ~(RigidbodyFlags::GroundedLastFrame | RigidbodyFlags::OnGround)) | ((body_flags & RigidbodyFlags::OnGround) ? RigidbodyFlags::GroundedLastFrame : 0);
+	}
+}
+
+void RigidbodyStorage::computeAnticipatedMovements(float dt)
+{
+	//  the asleep rigidbodies never use their anticipated movements, only the first frame must keep them at zero
+	const int count = getCount();
+	for (int i = 0; i < count; i++)
+	{
+		if (flags[i] & RigidbodyFlags::FirstFrame)
+		{
+			movements[i] = Vector3::zero;
+			gravityMovements[i] = Vector3::zero;
+			continue;
+		}
+
+		const Vector3& velocity = velocities[i];
+		const Vector3& velocity_one_frame = velocitiesOneFrame[i];
+		movements[i] = Vector3{ (velocity.x + velocity_one_frame.x) * dt, velocity.y * dt, (velocity.z + velocity_one_frame.z) * dt };
+		gravityMovements[i] = gravityVelocities[i] * dt;
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <Maths/vector3.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class RigidbodyComponent;
+
+
+namespace RigidbodyFlags
+{
+	const uint8_t Registered = 1 << 0; //  simulated by the physics manager
+	const uint8_t PhysicsActivated = 1 << 1;
+	const uint8_t UseGravity = 1 << 2;
+	const uint8_t OnGround = 1 << 3;
+	const uint8_t GroundedLastFrame = 1 << 4;
+	const uint8_t FirstFrame = 1 << 5;
+	const uint8_t Asleep = 1 << 6;
+}
+
+
+/** Rigidbody Storage
+* Simulation state of the rigidbodies, stored in contiguous arrays (one per value) owned by the physics service.
+* A rigidbody component is a handle on its index in these arrays, the index can change when another rigidbody is removed.
+* The passes that only need the simulation state (gravity, anticipated movements) run as plain loops over the arrays
+* instead of going through every rigidbody component.
+*/
+class RigidbodyStorage
+{
+public:
+	RigidbodyStorage() = default;
+	RigidbodyStorage(const RigidbodyStorage&) = delete;
+	RigidbodyStorage& operator=(const RigidbodyStorage&) = delete;
+
+	/**
+	* Add the state of a rigidbody, zeroed except for the flags.
+	* @param	owner		Rigidbody component that owns this state.
+	* @param	flags		Initial flags of the rigidbody.
+	* @return				Index of the state in the arrays.
+	*/
+	int add(RigidbodyComponent* owner, uint8_t flags);
+
+	/**
+	* Remove the state of a rigidbody. The last state takes its place and its owner is given its new index.
+	* @param	index		Index of the state to remove.
+	*/
+	void remove(int index);
+
+	/**
+	* Apply the gravity to the gravity velocity of the registered, awake rigidbodies that use it, and reset their ground state.
+	* @param	dt				Delta time of the physics step.
+	* @param	gravity			Gravity value of the physics.
+	*/
+	void integrateGravity(float dt, float gravity);
+
+	/**
+	* Compute the anticipated movements of all the rigidbodies from their velocities.
+	* The vertical velocity one frame isn't part of the movement, it is applied to the position before the collisions tests.
+	* @param	dt				Delta time of the physics step.
+	*/
+	void computeAnticipatedMovements(float dt);
+
+	inline int getCount() const { return static_cast<int>(owners.size()); }
+
+	inline bool hasFlag(int index, uint8_t flag) const { return (flags[index] & flag) != 0; }
+	inline void setFlag(int index, uint8_t flag, bool value) { if (value) flags[index] |= flag; else flags[index] &= ~flag; }
+
+
+	//  simulation state, one entry per rigidbody
+	std::vector<RigidbodyComponent*> owners;
+	std::vector<Vector3> velocities;
+	std::vector<Vector3> gravityVelocities;
+	std::vector<Vector3> velocitiesOneFrame;
+	std::vector<Vector3> movements;
+	std::vector<Vector3> gravityMovements;
+	std::vector<float> stepHeights;
+	std::vector<float> masses;
+	std::vector<uint8_t> flags;
+	std::vector<std::vector<std::string>> testChannels;
+};
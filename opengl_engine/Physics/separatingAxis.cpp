@@ -0,0 +1,96 @@
+#include "separatingAxis.h"
+#include <Maths/Maths.h>
+
+#include <limits>
+
+
+SeparatingAxisSweep::SeparatingAxisSweep(const Box& boxStart, const Vector3& movement_) :
+	boxCenter(boxStart.getCenterPoint()), boxHalfExtents(boxStart.getHalfExtents()), movement(movement_),
+	enterTime(-std::numeric_limits<float>::max()), exitTime(std::numeric_limits<float>::max())
+{
+}
+
+bool SeparatingAxisSweep::testAxis(const Vector3& axis, float shapeMin, float shapeMax)
+{
+	if (separated) return false;
+	if (axis == Vector3::zero) return true;
+
+	const float box_radius = Maths::abs(axis.x) * boxHalfExtents.x + Maths::abs(axis.y) * boxHalfExtents.y + Maths::abs(axis.z) * boxHalfExtents.z;
+	const float box_center = Vector3::dot(axis, boxCenter);
+	const float speed = Vector3::dot(axis, movement);
+
+	//  the box doesn't move on this axis: it is separated for the whole movement or never
+	if (speed == 0.0f)
+	{
+		if (box_center - box_radius > shapeMax || box_center + box_radius < shapeMin)
+		{
+			separated = true;
+			return false;
+		}
+		return true;
+	}
+
+	//  moving towards the positive side of the axis, the box hits the min side of the shape
+	float axis_enter = (shapeMin - box_radius - box_center) / speed;
+	float axis_exit = (shapeMax + box_radius - box_center) / speed;
+	float axis_direction = -1.0f;
+	if (speed < 0.0f)
+	{
+		const float swap = axis_enter;
+		axis_enter = axis_exit;
+		axis_exit = swap;
+		axis_direction = 1.0f;
+	}
+
+	if (axis_enter > enterTime)
+	{
+		enterTime = axis_enter;
+		enterAxis = axis;
+		enterAxisDirection = axis_direction;
+	}
+	exitTime = Maths::min(exitTime, axis_exit);
+
+	if (enterTime > exitTime || enterTime > 1.0f || exitTime < 0.0f)
+	{
+		separated = true;
+		return false;
+	}
+	return true;
+}
+
+bool SeparatingAxisSweep::hasHit(bool forCollisionTest) const
+{
+	if (separated) return false;
+	if (movement == Vector3::zero) return true;
+
+	if (forCollisionTest && exitTime <= 0.0f) return false; //  only touching at the start
+
+	if (enterTime < 0.0f && enterAxisDirection != 0.0f)
+	{
+		//  already overlapping: only a hit if the box goes deeper into the shape
+		return Vector3::dot(movement, enterAxis) * enterAxisDirection < 0.0f;
+	}
+
+	return true;
+}
+
+Vector3 SeparatingAxisSweep::getHitNormal() const
+{
+	if (enterAxisDirection == 0.0f) return Vector3::zero;
+	return Vector3::normalize(enterAxis) * enterAxisDirection;
+}
+
+bool SeparatingAxisSweep::IsValidCrossAxis(const Vector3& axis, const Vector3& edge)
+{
+	//  almost parallel edges give an axis that only carries rounding errors
+	return axis.lengthSq() > edge.lengthSq() * 1.0e-6f;
+}
+
+void SeparatingAxisSweep::ProjectTriangle(const Vector3& axis, const Vector3& a, const Vector3& b, const Vector3& c, float& outMin, float& outMax)
+{
+	const float pa = Vector3::dot(axis, a);
+	const float pb = Vector3::dot(axis, b);
+	const float pc = Vector3::dot(axis, c);
+	outMin = Maths::min(pa, Maths::min(pb, pc));
+	outMax = Maths::max(pa, Maths::max(pb, pc));
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <Maths/Geometry/box.h>
+#include <Maths/vector3.h>
+
+
+/** Separating Axis Sweep
+* Swept separating axis test of a moving AABB against a convex shape (oriented box, triangle).
+* The shape gives its projection on each axis that can separate it from the box, the box is tested at the start of its movement
+* and along it, so that the same test gives the overlap (no movement) and the time of impact of a sweep.
+* Axes don't need to be normalized, the times don't depend on their length.
+*/
+class SeparatingAxisSweep
+{
+public:
+	/**
+	* @param	boxStart	Moving box at the start of its movement (world coordinates).
+	* @param	movement	Movement of the box, zero for an overlap test.
+	*/
+	SeparatingAxisSweep(const Box& boxStart, const Vector3& movement);
+
+	/**
+	* Test an axis, axes that are too small to be meaningful (parallel edges) are ignored.
+	* @param	axis		Axis to test.
+	* @param	shapeMin	Minimum of the projection of the shape on the axis.
+	* @param	shapeMax	Maximum of the projection of the shape on the axis.
+	* @return				False if the box and the shape are separated on this axis during the whole movement, the other axes don't need to be tested.
+	*/
+	bool testAxis(const Vector3& axis, float shapeMin, float shapeMax);
+
+	/**
+	* Result of the test once every axis has been tested.
+	* A box that already overlaps the shape only hits it if it moves towards it, so that it can get out of a shape it is stuck in.
+	* @param	forCollisionTest	Don't count a box that only touches the shape at the start of the movement (the box would be stuck on it).
+	* @return						Does the box overlap the shape during the movement?
+	*/
+	bool hasHit(bool forCollisionTest) const;
+
+	//  fraction of the movement at which the box starts to overlap the shape (negative if it already overlaps it at the start)
+	inline float getEnterTime() const { return enterTime; }
+
+	//  normal of the shape face the box hits, zero for an overlap test
+	Vector3 getHitNormal() const;
+
+	//  an edge-edge cross axis must be skipped if the edges are almost parallel
+	static bool IsValidCrossAxis(const Vector3& axis, const Vector3& edge);
+
+	static void ProjectTriangle(const Vector3& axis, const Vector3& a, const Vector3& b, const Vector3& c, float& outMin, float& outMax);
+
+private:
+	Vector3 boxCenter{ Vector3::zero };
+	Vector3 boxHalfExtents{ Vector3::zero };
+	Vector3 movement{ Vector3::zero };
+
+	float enterTime;
+	float exitTime;
+	Vector3 enterAxis{ Vector3::zero };
+	float enterAxisDirection{ 0.0f };
+	bool separated{ false };
+};
@@ -0,0 +1,172 @@
+#include "staticGrid.h"
+#include "broadphase.h"
+#include "collisionComponent.h"
+#include <Maths/Maths.h>
+#include <cmath>
+
+
+void StaticGrid::build(const std::vector<BroadphaseProxy>& proxies)
+{
+	clear();
+
+	//  level bounds and average size of the solid collisions
+	Vector3 level_min = Vector3::zero;
+	Vector3 level_max = Vector3::zero;
+	float size_sum = 0.0f;
+	int solids_count = 0;
+	for (auto& proxy : proxies)
+	{
+		if (proxy.collision->getCollisionType() == CollisionType::Trigger) continue;
+
+		const Vector3 size = proxy.boundsMax - proxy.boundsMin;
+		size_sum += (size.x + size.y + size.z) / 3.0f;
+
+		if (solids_count == 0)
+		{
+			level_min = proxy.boundsMin;
+			level_max = proxy.boundsMax;
+		}
+		else
+		{
+			level_min = Vector3{ Maths::min(level_min.x, proxy.boundsMin.x), Maths::min(level_min.y, proxy.boundsMin.y), Maths::min(level_min.z, proxy.boundsMin.z) };
+			level_max = Vector3{ Maths::max(level_max.x, proxy.boundsMax.x), Maths::max(level_max.y, proxy.boundsMax.y), Maths::max(level_max.z, proxy.boundsMax.z) };
+		}
+		solids_count++;
+	}
+
+	//  a cell about the size of an average collision keeps each collision in a few cells and each cell with a few collisions,
+	//  but it can't be bigger than the level itself
+	const Vector3 level_size = level_max - level_min;
+	const float level_largest = Maths::max(level_size.x, Maths::max(level_size.y, level_size.z));
+	cellSize = solids_count > 0 ? size_sum / static_cast<float>(solids_count) : 1.0f;
+	cellSize = Maths::clamp(cellSize, minCellSize, Maths::max(level_largest, minCellSize));
+	invCellSize = 1.0f / cellSize;
+
+	//  first pass: count the proxies of each cell
+	proxiesMinCells.assign(proxies.size(), CellCoords{});
+	std::vector<CellCoords> proxies_max_cells(proxies.size());
+	std::vector<char> proxies_in_cells(proxies.size(), 0);
+	for (int i = 0; i < proxies.size(); i++)
+	{
+		const BroadphaseProxy& proxy = proxies[i];
+		if (proxy.collision->getCollisionType() == CollisionType::Trigger)
+		{
+			triggersIndices.push_back(i);
+			continue;
+		}
+
+		const CellCoords min = getCellCoords(proxy.boundsMin);
+		const CellCoords max = getCellCoords(proxy.boundsMax);
+		const int64_t cells_covered = static_cast<int64_t>(max.x - min.x + 1) * (max.y - min.y + 1) * (max.z - min.z + 1);
+		if (cells_covered > maxCellsPerProxy)
+		{
+			oversizedIndices.push_back(i);
+			continue;
+		}
+
+		proxiesMinCells[i] = min;
+		proxies_max_cells[i] = max;
+		proxies_in_cells[i] = 1;
+		for (int x = min.x; x <= max.x; x++)
+			for (int y = min.y; y <= max.y; y++)
+				for (int z = min.z; z <= max.z; z++)
+					cells[GetCellKey(x, y, z)].count++;
+	}
+
+	//  give each cell its range in the packed indices
+	int offset = 0;
+	for (auto& cell : cells)
+	{
+		cell.second.start = offset;
+		offset += cell.second.count;
+		cell.second.count = 0;
+	}
+	cellsIndices.resize(offset);
+
+	//  second pass: fill the cells
+	for (int i = 0; i < proxies.size(); i++)
+	{
+		if (!proxies_in_cells[i]) continue;
+
+		const CellCoords& min = proxiesMinCells[i];
+		const CellCoords& max = proxies_max_cells[i];
+		for (int x = min.x; x <= max.x; x++)
+			for (int y = min.y; y <= max.y; y++)
+				for (int z = min.z; z <= max.z; z++)
+				{
+					CellRange& cell = cells[GetCellKey(x, y, z)];
+					cellsIndices[cell.start + cell.count] = i;
+					cell.count++;
+				}
+	}
+
+	built = true;
+}
+
+void StaticGrid::clear()
+{
+	built = false;
+	cells.clear();
+	cellsIndices.clear();
+	triggersIndices.clear();
+	oversizedIndices.clear();
+	proxiesMinCells.clear();
+}
+
+bool StaticGrid::gatherBox(const Vector3& boxMin, const Vector3& boxMax, FrameVector<int>& outIndices) const
+{
+	const CellCoords min = getCellCoords(boxMin);
+	const CellCoords max = getCellCoords(boxMax);
+
+	const int64_t cells_covered = static_cast<int64_t>(max.x - min.x + 1) * (max.y - min.y + 1) * (max.z - min.z + 1);
+	if (cells_covered > static_cast<int64_t>(cells.size())) return false;
+
+	for (int x = min.x; x <= max.x; x++)
+	{
+		for (int y = min.y; y <= max.y; y++)
+		{
+			for (int z = min.z; z <= max.z; z++)
+			{
+				const CellRange* cell = findCell(x, y, z);
+				if (!cell) continue;
+
+				for (int i = cell->start; i < cell->start + cell->count; i++)
+				{
+					//  a proxy that covers multiple cells is only gathered from the first of its cells that the box overlaps
+					const int index = cellsIndices[i];
+					const CellCoords& proxy_min = proxiesMinCells[index];
+					if (x != Maths::max(min.x, proxy_min.x) || y != Maths::max(min.y, proxy_min.y) || z != Maths::max(min.z, proxy_min.z)) continue;
+
+					outIndices.push_back(index);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+
+StaticGrid::CellCoords StaticGrid::getCellCoords(const Vector3& point) const
+{
+	CellCoords coords;
+	coords.x = static_cast<int>(std::floor(point.x * invCellSize));
+	coords.y = static_cast<int>(std::floor(point.y * invCellSize));
+	coords.z = static_cast<int>(std::floor(point.z * invCellSize));
+	return coords;
+}
+
+uint64_t StaticGrid::GetCellKey(int x, int y, int z)
+{
+	//  21 bits per axis, enough for a million cells in each direction around the origin
+	const uint64_t mask = (1ull << 21) - 1;
+	return ((static_cast<uint64_t>(x) & mask) << 42) | ((static_cast<uint64_t>(y) & mask) << 21) | (static_cast<uint64_t>(z) & mask);
+}
+
+const StaticGrid::CellRange* StaticGrid::findCell(int x, int y, int z) const
+{
+	auto iter = cells.find(GetCellKey(x, y, z));
+	if (iter == cells.end()) return nullptr;
+
+	return &iter->second;
+}
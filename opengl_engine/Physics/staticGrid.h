@@ -0,0 +1,194 @@
+#pragma once
+#include <Maths/vector3.h>
+#include <Utils/frameArena.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct BroadphaseProxy;
+
+
+/** Static Grid
+* Sparse hashed uniform grid over the static proxies of the broadphase, built once when the static collisions are baked (at scene load).
+* Only the non-empty cells are stored. The cell size is chosen from the level bounds and the average size of the static collisions.
+* Queries only touch the cells along their path: boxes read the cells they overlap, segments walk the cells with a 3D-DDA
+* and stop as soon as the next cell is further than the closest hit found.
+* Triggers and proxies that would cover too many cells are not put in the cells, they are returned by every query.
+*/
+class StaticGrid
+{
+public:
+	/**
+	* Build the grid over the given static proxies. The proxies indices are stored, so the grid must be built again if the vector changes.
+	* @param	proxies		Static proxies of the broadphase.
+	*/
+	void build(const std::vector<BroadphaseProxy>& proxies);
+
+	void clear();
+
+	inline bool isBuilt() const { return built; }
+	inline float getCellSize() const { return cellSize; }
+	inline size_t getCellsCount() const { return cells.size(); }
+
+
+	/**
+	* Retrieve the indices of the solid proxies stored in the cells that overlap a box, each proxy only once.
+	* @param	boxMin			Min point of the box (world coordinates).
+	* @param	boxMax			Max point of the box (world coordinates).
+	* @param	outIndices		Proxies indices. [OUT]
+	* @return					False if the box covers more cells than the grid has, in that case the caller should test all the proxies.
+	*/
+	bool gatherBox(const Vector3& boxMin, const Vector3& boxMax, FrameVector<int>& outIndices) const;
+
+	/**
+	* Walk the cells crossed by a segment inflated by half extents (3D-DDA), from the start to the end.
+	* @param	start			Start point of the segment (world coordinates).
+	* @param	end				End point of the segment (world coordinates).
+	* @param	halfExtents		Half extents of the box that is swept along the segment (zero for a line).
+	* @param	visitor			Called with the indices of the proxies of each new cell and the distance at which the segment enters it.
+	*							Must return false to stop the walk (usually when a hit closer than this distance has been found).
+	*							A proxy that covers multiple cells can be visited more than once.
+	*/
+	template<typename CellVisitor>
+	void walkSegment(const Vector3& start, const Vector3& end, const Vector3& halfExtents, CellVisitor visitor) const;
+
+	//  proxies that are not stored in the cells and must be tested by every query
+	inline const std::vector<int>& getTriggersIndices() const { return triggersIndices; }
+	inline const std::vector<int>& getOversizedIndices() const { return oversizedIndices; }
+
+private:
+	struct CellRange
+	{
+		int start{ 0 };
+		int count{ 0 };
+	};
+
+	struct CellCoords
+	{
+		int x{ 0 };
+		int y{ 0 };
+		int z{ 0 };
+	};
+
+	CellCoords getCellCoords(const Vector3& point) const;
+	static uint64_t GetCellKey(int x, int y, int z);
+	const CellRange* findCell(int x, int y, int z) const;
+
+	template<typename CellVisitor>
+	bool visitCells(const CellCoords& min, const CellCoords& max, float enterDistance, CellVisitor& visitor) const;
+
+	bool built{ false };
+	float cellSize{ 1.0f };
+	float invCellSize{ 1.0f };
+
+	std::unordered_map<uint64_t, CellRange> cells;
+	std::vector<int> cellsIndices; //  proxies indices of all the cells, packed cell after cell
+	std::vector<int> triggersIndices;
+	std::vector<int> oversizedIndices;
+	std::vector<CellCoords> proxiesMinCells;
+
+	const float minCellSize{ 0.5f };
+	const int maxCellsPerProxy{ 512 };
+};
+
+
+
+template<typename CellVisitor>
+bool StaticGrid::visitCells(const CellCoords& min, const CellCoords& max, float enterDistance, CellVisitor& visitor) const
+{
+	for (int x = min.x; x <= max.x; x++)
+	{
+		for (int y = min.y; y <= max.y; y++)
+		{
+			for (int z = min.z; z <= max.z; z++)
+			{
+				const CellRange* cell = findCell(x, y, z);
+				if (!cell) continue;
+
+				if (!visitor(&cellsIndices[cell->start], cell->count, enterDistance)) return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+template<typename CellVisitor>
+void StaticGrid::walkSegment(const Vector3& start, const Vector3& end, const Vector3& halfExtents, CellVisitor visitor) const
+{
+	if (!built) return;
+
+	//  cells around the segment cell that the swept box can reach
+	const int reach[3] =
+	{
+		halfExtents.x > 0.0f ? static_cast<int>(halfExtents.x * invCellSize) + 1 : 0,
+		halfExtents.y > 0.0f ? static_cast<int>(halfExtents.y * invCellSize) + 1 : 0,
+		halfExtents.z > 0.0f ? static_cast<int>(halfExtents.z * invCellSize) + 1 : 0
+	};
+
+	const Vector3 segment = end - start;
+	const float length = segment.length();
+
+	CellCoords cell = getCellCoords(start);
+	int coords[3] = { cell.x, cell.y, cell.z };
+
+	//  first cell: its whole neighbourhood
+	CellCoords first_min{ coords[0] - reach[0], coords[1] - reach[1], coords[2] - reach[2] };
+	CellCoords first_max{ coords[0] + reach[0], coords[1] + reach[1], coords[2] + reach[2] };
+	if (!visitCells(first_min, first_max, 0.0f, visitor)) return;
+	if (length <= 0.0f) return;
+
+	const float direction[3] = { segment.x / length, segment.y / length, segment.z / length };
+	const float origin[3] = { start.x, start.y, start.z };
+
+	int step[3];
+	float next_distance[3];
+	float delta_distance[3];
+	for (int axis = 0; axis < 3; axis++)
+	{
+		if (direction[axis] > 0.0f)
+		{
+			step[axis] = 1;
+			next_distance[axis] = ((coords[axis] + 1) * cellSize - origin[axis]) / direction[axis];
+			delta_distance[axis] = cellSize / direction[axis];
+		}
+		else if (direction[axis] < 0.0f)
+		{
+			step[axis] = -1;
+			next_distance[axis] = (coords[axis] * cellSize - origin[axis]) / direction[axis];
+			delta_distance[axis] = -cellSize / direction[axis];
+		}
+		else
+		{
+			step[axis] = 0;
+			next_distance[axis] = length + 1.0f;
+			delta_distance[axis] = 0.0f;
+		}
+	}
+
+	while (true)
+	{
+		//  step on the axis whose cell boundary is the closest
+		int axis = 0;
+		if (next_distance[1] < next_distance[axis]) axis = 1;
+		if (next_distance[2] < next_distance[axis]) axis = 2;
+
+		const float enter_distance = next_distance[axis];
+		if (enter_distance > length) return;
+
+		coords[axis] += step[axis];
+		next_distance[axis] += delta_distance[axis];
+
+		//  only the slab of cells that enters the neighbourhood is new
+		CellCoords slab_min{ coords[0] - reach[0], coords[1] - reach[1], coords[2] - reach[2] };
+		CellCoords slab_max{ coords[0] + reach[0], coords[1] + reach[1], coords[2] + reach[2] };
+		int* slab_min_coords[3] = { &slab_min.x, &slab_min.y, &slab_min.z };
+		int* slab_max_coords[3] = { &slab_max.x, &slab_max.y, &slab_max.z };
+		const int slab_coord = coords[axis] + step[axis] * reach[axis];
+		*slab_min_coords[axis] = slab_coord;
+		*slab_max_coords[axis] = slab_coord;
+
+		if (!visitCells(slab_min, slab_max, enter_distance, visitor)) return;
+	}
+}
@@ -0,0 +1,146 @@
+#include "triggerOverlaps.h"
+#include "broadphase.h"
+#include "physicsEventBuffer.h"
+#include "collisionComponent.h"
+#include "rigidbodyComponent.h"
+#include <algorithm>
+
+
+void TriggerOverlaps::addCrossedTriggers(RigidbodyComponent& body, const std::vector<const CollisionComponent*>& triggers)
+{
+	if (triggers.empty()) return;
+
+	std::vector<const CollisionComponent*>& crossed = crossedTriggers[&body];
+	for (auto trigger : triggers)
+	{
+		if (std::find(crossed.begin(), crossed.end(), trigger) == crossed.end())
+			crossed.push_back(trigger);
+	}
+}
+
+void TriggerOverlaps::update(const Broadphase& broadphase, const std::vector<RigidbodyComponent*>& rigidbodies, bool triggersMoved, PhysicsEventBuffer& outEvents)
+{
+	//  iterate on the rigidbodies vector rather than on the map, so that the events order doesn't depend on the pointers
+	for (auto body : rigidbodies)
+	{
+		if (!body->isAssociatedCollisionValid()) continue;
+
+		const CollisionComponent& body_collision = body->getAssociatedCollision();
+		const unsigned int body_version = body_collision.getTransformVersion();
+
+		auto overlaps_iter = bodiesOverlaps.find(body);
+		auto crossed_iter = crossedTriggers.find(body);
+		bool new_body = overlaps_iter == bodiesOverlaps.end();
+		BodyOverlaps& overlaps = new_body ? bodiesOverlaps[body] : overlaps_iter->second;
+
+		bool need_test = new_body || triggersMoved || overlaps.transformVersion != body_version || crossed_iter != crossedTriggers.end();
+		if (!need_test)
+		{
+			//  stationary pair, nothing to test
+			for (auto trigger : overlaps.triggers)
+			{
+				outEvents.recordTrigger(PhysicsEventType::TriggerStay, *body, trigger);
+			}
+			continue;
+		}
+
+		overlaps.transformVersion = body_version;
+
+		currentTriggers.clear();
+		broadphase.overlapTriggers(body_collision.getEncapsulatingBox(), body->getTestChannels(), currentTriggers, &body_collision);
+
+		//  exit and stay of the previous overlapping triggers
+		for (int i = 0; i < overlaps.triggers.size(); i++)
+		{
+			const CollisionComponent* trigger = overlaps.triggers[i];
+			if (std::find(currentTriggers.begin(), currentTriggers.end(), trigger) != currentTriggers.end())
+			{
+				outEvents.recordTrigger(PhysicsEventType::TriggerStay, *body, trigger);
+				continue;
+			}
+
+			outEvents.recordTrigger(PhysicsEventType::TriggerExit, *body, trigger);
+			std::iter_swap(overlaps.triggers.begin() + i, overlaps.triggers.end() - 1);
+			overlaps.triggers.pop_back();
+			i--;
+		}
+
+		//  enter of the new overlapping triggers
+		for (auto trigger : currentTriggers)
+		{
+			if (std::find(overlaps.triggers.begin(), overlaps.triggers.end(), trigger) != overlaps.triggers.end()) continue;
+
+			outEvents.recordTrigger(PhysicsEventType::TriggerEnter, *body, trigger);
+			overlaps.triggers.push_back(trigger);
+		}
+
+		//  triggers crossed during the sweep but not overlapped anymore: enter and exit on the same step
+		if (crossed_iter != crossedTriggers.end())
+		{
+			for (auto trigger : crossed_iter->second)
+			{
+				if (std::find(overlaps.triggers.begin(), overlaps.triggers.end(), trigger) != overlaps.triggers.end()) continue;
+
+				outEvents.recordTrigger(PhysicsEventType::TriggerEnter, *body, trigger);
+				outEvents.recordTrigger(PhysicsEventType::TriggerExit, *body, trigger);
+			}
+		}
+	}
+
+	crossedTriggers.clear();
+}
+
+bool TriggerOverlaps::checkTriggerMoved(const CollisionComponent* trigger)
+{
+	const unsigned int version = trigger->getTransformVersion();
+
+	auto iter = triggersVersions.find(trigger);
+	if (iter == triggersVersions.end())
+	{
+		triggersVersions.emplace(trigger, version);
+		return true;
+	}
+
+	if (iter->second == version) return false;
+
+	iter->second = version;
+	return true;
+}
+
+void TriggerOverlaps::removeRigidbody(const RigidbodyComponent* body)
+{
+	bodiesOverlaps.erase(body);
+	crossedTriggers.erase(body);
+}
+
+void TriggerOverlaps::removeTrigger(const CollisionComponent* trigger)
+{
+	triggersVersions.erase(trigger);
+
+	for (auto& body_overlaps : bodiesOverlaps)
+	{
+		std::vector<const CollisionComponent*>& triggers = body_overlaps.second.triggers;
+		triggers.erase(std::remove(triggers.begin(), triggers.end(), trigger), triggers.end());
+	}
+	for (auto& crossed : crossedTriggers)
+	{
+		crossed.second.erase(std::remove(crossed.second.begin(), crossed.second.end(), trigger), crossed.second.end());
+	}
+}
+
+void TriggerOverlaps::clear()
+{
+	bodiesOverlaps.clear();
+	crossedTriggers.clear();
+	triggersVersions.clear();
+}
+
+size_t TriggerOverlaps::getPairsCount() const
+{
+	size_t count = 0;
+	for (auto& body_overlaps : bodiesOverlaps)
+	{
+		count += body_overlaps.second.triggers.size();
+	}
+	return count;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+class Broadphase;
+class PhysicsEventBuffer;
+class CollisionComponent;
+class RigidbodyComponent;
+
+
+/** Trigger Overlaps
+* Keeps the set of (rigidbody, trigger) pairs that overlap, to broadcast true enter, stay and exit trigger events.
+* The set is updated incrementally: only the rigidbodies that moved since their last test are tested again,
+* the pairs of the stationary ones are kept as is (they only broadcast their stay event).
+*/
+class TriggerOverlaps
+{
+public:
+	/**
+	* Store a trigger that a rigidbody crossed during its sweep, so that a fast rigidbody doesn't miss a thin trigger.
+	* If the rigidbody doesn't overlap it anymore at the end of the step, it will still enter and exit it.
+	* @param	body		Rigidbody that crossed the triggers.
+	* @param	triggers	Triggers detected by the sweeps of the rigidbody.
+	*/
+	void addCrossedTriggers(RigidbodyComponent& body, const std::vector<const CollisionComponent*>& triggers);
+
+	/**
+	* Update the overlapping pairs and record the trigger events. Must be called once the rigidbodies moved.
+	* @param	broadphase		Broadphase used to find the triggers that overlap a rigidbody.
+	* @param	rigidbodies		Rigidbodies registered in the physics manager.
+	* @param	triggersMoved	Did a trigger move since the last update? If so, all the rigidbodies are tested again.
+	* @param	outEvents		Buffer where trigger events are recorded. [OUT]
+	*/
+	void update(const Broadphase& broadphase, const std::vector<RigidbodyComponent*>& rigidbodies, bool triggersMoved, PhysicsEventBuffer& outEvents);
+
+	/**
+	* Check if a trigger moved since the last update (or if it is a new trigger).
+	* @param	trigger		Trigger collision to check.
+	* @return				True if the trigger moved.
+	*/
+	bool checkTriggerMoved(const CollisionComponent* trigger);
+
+	//  remove the pairs of a rigidbody or a trigger that is removed from the physics (no exit event is broadcasted)
+	void removeRigidbody(const RigidbodyComponent* body);
+	void removeTrigger(const CollisionComponent* trigger);
+
+	void clear();
+
+	size_t getPairsCount() const;
+
+private:
+	struct BodyOverlaps
+	{
+		unsigned int transformVersion{ 0 };
+		std::vector<const CollisionComponent*> triggers;
+	};
+
+	std::unordered_map<const RigidbodyComponent*, BodyOverlaps> bodiesOverlaps;
+	std::unordered_map<const RigidbodyComponent*, std::vector<const CollisionComponent*>> crossedTriggers;
+	std::unordered_map<const CollisionComponent*, unsigned int> triggersVersions;
+
+	std::vector<const CollisionComponent*> currentTriggers; //  reused between the updates to avoid allocations
+};
@@ -13,12 +13,9 @@ void Cube::setBox(const Box& boxInfos)
 	computeBoxModelMatrix();
 }
 
-void Cube::drawCube(Material& debugMaterial, const Color& drawColor)
+void Cube::drawCube(DebugDrawList& outDrawList, const Color& drawColor) const
 {
-	debugMaterial.getShader().setMatrix4("model", boxModelMatrix.getAsFloatPtr());
-	debugMaterial.getShader().setVec3("color", drawColor);
-
-	cubeMesh->draw(true);
+	outDrawList.addMesh(cubeMesh, boxModelMatrix, drawColor, true);
 }
 
 void Cube::computeBoxModelMatrix()
@@ -2,7 +2,7 @@
 #include <Objects/transform.h>
 #include <Maths/Geometry/box.h>
 #include <Rendering/Model/mesh.h>
-#include <Rendering/material.h>
+#include <Rendering/Debug/debugDrawList.h>
 #include <Utils/Color.h>
 
 
@@ -16,7 +16,7 @@ public:
 
 	void setBox(const Box& boxInfos);
 
-	void drawCube(Material& debugMaterial, const Color& drawColor);
+	void drawCube(DebugDrawList& outDrawList, const Color& drawColor) const;
 
 private:
 	Box box;
@@ -0,0 +1,58 @@
+#include "debugDrawList.h"
+#include <Rendering/Model/mesh.h>
+#include <Rendering/material.h>
+#include <Assets/assetManager.h>
+
+
+void DebugDrawList::addMesh(Mesh* mesh, const Matrix4& model, const Color& color, bool asLines)
+{
+	if (!mesh) return;
+
+	DebugDrawCommand command;
+	command.mesh = mesh;
+	command.model = model;
+	command.color = color;
+	command.asLines = asLines;
+	commands.push_back(command);
+}
+
+void DebugDrawList::addLine(const Vector3& origin, const Vector3& offset, const Color& color)
+{
+	DebugDrawCommand command;
+	command.model = Matrix4::createTranslation(origin);
+	command.color = color;
+	command.lineOffset = offset;
+	commands.push_back(command);
+}
+
+void DebugDrawList::clear()
+{
+	commands.clear();
+}
+
+
+void DebugDrawList::draw(Material& debugMaterial) const
+{
+	Shader& debug_shader = debugMaterial.getShader();
+	VertexArray& line_va = AssetManager::GetVertexArray("debug_line");
+
+	for (auto& command : commands)
+	{
+		debug_shader.setMatrix4("model", command.model.getAsFloatPtr());
+		debug_shader.setVec3("color", command.color);
+
+		if (command.mesh)
+		{
+			command.mesh->draw(command.asLines);
+			continue;
+		}
+
+		debug_shader.setBool("renderLine", true);
+		debug_shader.setVec3("linePointOffset", command.lineOffset);
+
+		line_va.setActive();
+		glDrawArrays(GL_LINE_STRIP, 0, 2);
+
+		debug_shader.setBool("renderLine", false);
+	}
+}
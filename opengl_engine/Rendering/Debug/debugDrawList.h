@@ -0,0 +1,55 @@
+#pragma once
+#include <Maths/matrix4.h>
+#include <Maths/vector3.h>
+#include <Utils/Color.h>
+
+#include <vector>
+
+class Mesh;
+class Material;
+
+
+/** Debug Draw List
+* Debug shapes (collisions, raycasts) recorded by the game thread in the render snapshot of a frame, then drawn by the render thread.
+* A command only keeps the mesh asset and the values of the shape, so the shape can be destroyed before its frame is drawn.
+*/
+class DebugDrawList
+{
+public:
+	/**
+	* Record a mesh to draw with the debug material.
+	* @param	mesh		Mesh asset to draw (it must live as long as the assets).
+	* @param	model		Model matrix of the mesh.
+	* @param	color		Color of the mesh.
+	* @param	asLines		Draw the triangles as lines.
+	*/
+	void addMesh(Mesh* mesh, const Matrix4& model, const Color& color, bool asLines);
+
+	/**
+	* Record a line to draw with the debug material.
+	* @param	origin		Start of the line.
+	* @param	offset		Vector from the start to the end of the line.
+	* @param	color		Color of the line.
+	*/
+	void addLine(const Vector3& origin, const Vector3& offset, const Color& color);
+
+	//  remove the commands but keep their memory, for the next frame
+	void clear();
+
+	//  draw all the commands, on the render thread only (the debug material shader must be in use)
+	void draw(Material& debugMaterial) const;
+
+	inline int getCommandsCount() const { return static_cast<int>(commands.size()); }
+
+private:
+	struct DebugDrawCommand
+	{
+		Mesh* mesh{ nullptr }; //  null for a line
+		Matrix4 model{ Matrix4::identity };
+		Color color{ Color::white };
+		Vector3 lineOffset{ Vector3::zero };
+		bool asLines{ false };
+	};
+
+	std::vector<DebugDrawCommand> commands;
+};
@@ -1,10 +1,7 @@
 #include "line.h"
-#include <Maths/Matrix4.h>
-#include <Rendering/material.h>
-#include <Rendering/Model/vertexArray.h>
-#include <Assets/assetManager.h>
+#include <Rendering/Debug/debugDrawList.h>
 
-Line::Line() : lineVA(AssetManager::GetVertexArray("debug_line"))
+Line::Line()
 {
 }
 
@@ -18,16 +15,7 @@ void Line::setPoints(Vector3 pointA, Vector3 pointB)
 	pointOffset = pointB - pointA;
 }
 
-void Line::drawLine(Material& debugMaterial, const Color& drawColor)
+void Line::drawLine(DebugDrawList& outDrawList, const Color& drawColor) const
 {
-	Shader& debug_shader = debugMaterial.getShader();
-	debug_shader.setMatrix4("model", Matrix4::createTranslation(originPos).getAsFloatPtr());
-	debug_shader.setVec3("color", drawColor);
-	debug_shader.setBool("renderLine", true);
-	debug_shader.setVec3("linePointOffset", pointOffset);
-
-	lineVA.setActive();
-	glDrawArrays(GL_LINE_STRIP, 0, 2);
-
-	debug_shader.setBool("renderLine", false);
+	outDrawList.addLine(originPos, pointOffset, drawColor);
 }
\ No newline at end of file
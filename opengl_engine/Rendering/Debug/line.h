@@ -2,11 +2,10 @@
 #include <Maths/Vector3.h>
 #include <Utils/Color.h>
 
-class VertexArray;
-class Material;
+class DebugDrawList;
 
 /** Line
-* Creates a custom VAO that is released at the destruction of this object.
+* Debug line between two points, drawn with the line vertex array of the assets.
 */
 class Line
 {
@@ -18,11 +17,9 @@ public:
 
 	void setPoints(Vector3 pointA, Vector3 pointB);
 
-	void drawLine(Material& debugMaterial, const Color& drawColor);
+	void drawLine(DebugDrawList& outDrawList, const Color& drawColor) const;
 
 private:
-	VertexArray& lineVA;
-
 	Vector3 originPos{ Vector3::zero };
 	Vector3 pointOffset{ Vector3::zero };
 };
@@ -13,10 +13,7 @@ void Point::setPointPostition(Vector3 pointPosition)
 	setPosition(pointPosition);
 }
 
-void Point::drawPoint(Material& debugMaterial, const Color& drawColor)
+void Point::drawPoint(DebugDrawList& outDrawList, const Color& drawColor)
 {
-	debugMaterial.getShader().setMatrix4("model", getModelMatrix().getAsFloatPtr());
-	debugMaterial.getShader().setVec3("color", drawColor);
-
-	cubeMesh->draw(false);
+	outDrawList.addMesh(cubeMesh, getModelMatrix(), drawColor, false);
 }
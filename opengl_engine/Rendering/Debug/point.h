@@ -1,7 +1,7 @@
 #pragma once
 #include <Objects/transform.h>
 #include <Rendering/Model/mesh.h>
-#include <Rendering/material.h>
+#include <Rendering/Debug/debugDrawList.h>
 #include <Utils/Color.h>
 
 //  scale of the cube mesh
@@ -20,7 +20,7 @@ public:
 
 	void setPointPostition(Vector3 pointPosition);
 
-	void drawPoint(Material& debugMaterial, const Color& drawColor);
+	void drawPoint(DebugDrawList& outDrawList, const Color& drawColor);
 
 private:
 	Mesh* cubeMesh{ nullptr };
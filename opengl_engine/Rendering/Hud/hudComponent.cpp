@@ -3,18 +3,18 @@
 
 HudComponent::HudComponent()
 {
-	GameplayStatics::OnScrenResize.registerObserver(this, Bind_1(&HudComponent::onWindowResizeEvent));
+	GameplayStatics::GetScreenResizeEvents().onEvent.registerObserver(this, &HudComponent::onWindowResizeEvent);
 }
 
 HudComponent::HudComponent(const HudComponent& other) :
 	pivot(other.pivot), pos(other.pos), scale(other.scale), rotAngle(other.rotAngle), screenPos(other.screenPos), hudTransform(other.hudTransform)
 {
-	GameplayStatics::OnScrenResize.registerObserver(this, Bind_1(&HudComponent::onWindowResizeEvent));
+	GameplayStatics::GetScreenResizeEvents().onEvent.registerObserver(this, &HudComponent::onWindowResizeEvent);
 }
 
 HudComponent::~HudComponent()
 {
-	GameplayStatics::OnScrenResize.unregisterObserver(this);
+	GameplayStatics::GetScreenResizeEvents().onEvent.unregisterObserver(this);
 }
 
 
@@ -142,7 +142,7 @@ void HudComponent::computeMatrix()
 		Matrix4::createTranslation(screenPos); //  translate to the position of the hud element
 }
 
-void HudComponent::onWindowResizeEvent(const Vector2Int windowSize)
+void HudComponent::onWindowResizeEvent(const ScreenResizeEvent& resizeEvent)
 {
 	updatePosWithAnchor();
 }
@@ -3,6 +3,7 @@
 #include <Maths/Vector2.h>
 #include <Maths/Matrix4.h>
 #include <Events/observer.h>
+#include <Utils/slotMap.h>
 
 class HudComponent : public Observer
 {
@@ -34,6 +35,9 @@ public:
 	Vector2 getScreenPos() const;
 	Matrix4 getHudTransform() const;
 
+	//  for renderer (not copied with the component)
+	SlotHandle rendererHandle;
+
 protected:
 	/* Does the hud component need to compute the transformation matrix? (For exemple, texts doesn't need to.) This function must be overriden in every class that inherit hud. */
 	virtual bool needToComputeMatrix() const = 0;
@@ -54,6 +58,6 @@ private:
 	void updatePosWithAnchor();
 	void computeMatrix();
 
-	void onWindowResizeEvent(const Vector2Int windowSize);
+	void onWindowResizeEvent(const struct ScreenResizeEvent& resizeEvent);
 };
 
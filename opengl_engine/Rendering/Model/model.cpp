@@ -9,19 +9,6 @@ Model::~Model()
 {
 }
 
-void Model::draw(Material& materialInUsage)
-{
-	//  assume the shader is already in use (the rendering process should have done it)
-
-	for (auto& mesh_material : meshMaterials)
-	{
-		if (*mesh_material.material != materialInUsage) continue;
-
-		mesh_material.mesh.draw();
-	}
-}
-
-
 void Model::addMesh(Mesh& mesh, Material& material)
 {
 	meshMaterials.push_back(MeshMaterial{ mesh, &material });
@@ -22,8 +22,6 @@ public:
 	Model(const Model&) = delete;
 	Model& operator=(const Model&) = delete;
 
-	void draw(Material& materialInUsage);
-
 	/**
 	* Add a single mesh to a model with a material.
 	*/
@@ -44,6 +42,8 @@ public:
 	*/
 	void changeMaterial(int materialId, Material& newMaterial);
 
+	inline const std::vector<MeshMaterial>& getMeshMaterials() const { return meshMaterials; }
+
 private:
 	std::vector<MeshMaterial> meshMaterials;
 };
@@ -1,4 +1,5 @@
 #include "vertexArray.h"
+#include <ServiceLocator/locator.h>
 
 void VertexArray::LoadVAMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
 {
@@ -7,6 +8,7 @@ void VertexArray::LoadVAMesh(const std::vector<Vertex>& vertices, const std::vec
 	useEBO = indices.size() > 0;
 
 	if (vertices.size() == 0) return;
+	if (!Locator::getRenderer().IsRenderingContextValid()) return; //  no buffers without rendering context (headless engine)
 
 	//  setup vertex buffer object and vertex array object
 	glGenVertexArrays(1, &VAO);
@@ -42,6 +44,8 @@ void VertexArray::LoadVAMesh(const std::vector<Vertex>& vertices, const std::vec
 
 void VertexArray::LoadVAQuadHUD()
 {
+	if (!Locator::getRenderer().IsRenderingContextValid()) return; //  no buffers without rendering context (headless engine)
+
 	//  create vertices array for quad
 	GLfloat quad_vertices[] =
 	{
@@ -72,6 +76,8 @@ void VertexArray::LoadVAQuadHUD()
 
 void VertexArray::LoadVALine()
 {
+	if (!Locator::getRenderer().IsRenderingContextValid()) return; //  no buffers without rendering context (headless engine)
+
 	//  create vertices array for line
 	GLfloat line_vertices[] =
 	{
@@ -106,6 +112,8 @@ void VertexArray::setActive()
 
 void VertexArray::deleteObjects()
 {
+	if (VAO == 0) return; //  never created
+
 	glDeleteVertexArrays(1, &VAO);
 	glDeleteBuffers(1, &VBO);
 }
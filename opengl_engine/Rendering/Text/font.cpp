@@ -37,7 +37,10 @@ Font::Font(const std::string& fontPath, const int size, const CharacterLoading c
 	//  set size to load glyph
 	FT_Set_Pixel_Sizes(face, FontSize, FontSize);
 
-	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	//  without rendering context (headless engine) only the metrics of the characters are loaded, for the texts sizes
+	const bool has_rendering_context = Locator::getRenderer().IsRenderingContextValid();
+
+	if (has_rendering_context) glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
 
 	//  convert char load setting
@@ -54,12 +57,15 @@ Font::Font(const std::string& fontPath, const int size, const CharacterLoading c
 	}
 
 	//  generate the array of texture
-	glGenTextures(1, &CharTextureArray);
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D_ARRAY, CharTextureArray);
+	if (has_rendering_context)
+	{
+		glGenTextures(1, &CharTextureArray);
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, CharTextureArray);
 
-	//  setup the texture 3D (this is the array of textures), here the FontSize are for the size of the textures and the char_count for the size of the array
-	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8, FontSize, FontSize, char_count, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
+		//  setup the texture 3D (this is the array of textures), here the FontSize are for the size of the textures and the char_count for the size of the array
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8, FontSize, FontSize, char_count, 0, GL_RED, GL_UNSIGNED_BYTE, 0);
+	}
 
 	//  load characters
 	for (unsigned char c = 0; c < char_count; c++)
@@ -72,25 +78,28 @@ Font::Font(const std::string& fontPath, const int size, const CharacterLoading c
 			continue;
 		}
 
-		//  add a texture into the texture 3D (the array of texture)
-		glTexSubImage3D(
-			GL_TEXTURE_2D_ARRAY,
-			0,
-			0, 0, //  offset x & y
-			int(c), //  offset z (the index to set the texture in the array)
-			face->glyph->bitmap.width, //  size width
-			face->glyph->bitmap.rows, //  size height
-			1, //  size depth (leave at 1)
-			GL_RED,
-			GL_UNSIGNED_BYTE,
-			face->glyph->bitmap.buffer //  datas of the texture
-		);
-
-		//  set texture options
-		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		if (has_rendering_context)
+		{
+			//  add a texture into the texture 3D (the array of texture)
+			glTexSubImage3D(
+				GL_TEXTURE_2D_ARRAY,
+				0,
+				0, 0, //  offset x & y
+				int(c), //  offset z (the index to set the texture in the array)
+				face->glyph->bitmap.width, //  size width
+				face->glyph->bitmap.rows, //  size height
+				1, //  size depth (leave at 1)
+				GL_RED,
+				GL_UNSIGNED_BYTE,
+				face->glyph->bitmap.buffer //  datas of the texture
+			);
+
+			//  set texture options
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		}
 
 		//  store character for later use
 		FontCharacters.emplace(c,
@@ -104,7 +113,7 @@ Font::Font(const std::string& fontPath, const int size, const CharacterLoading c
 	}
 
 	//  unbind texture
-	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	if (has_rendering_context) glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
 	//  release freetype
 	FT_Done_Face(face);
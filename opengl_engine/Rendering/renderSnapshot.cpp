@@ -0,0 +1,26 @@
+#include "renderSnapshot.h"
+
+
+void RenderSnapshot::clear()
+{
+	hasCamera = false;
+	drawDebug = false;
+
+	shaders.clear();
+	materials.clear();
+
+	directionalLights.clear();
+	pointLights.clear();
+	spotLights.clear();
+
+	transforms.clear();
+	drawItems.clear();
+
+	debugDraws.clear();
+
+	texts.clear();
+	charsTransforms.clear();
+	charsIds.clear();
+
+	sprites.clear();
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <Maths/matrix4.h>
+#include <Maths/vector2Int.h>
+#include <Maths/vector3.h>
+#include <Utils/color.h>
+#include <Objects/Lights/directionalLight.h>
+#include <Objects/Lights/pointLight.h>
+#include <Objects/Lights/spotLight.h>
+#include <Rendering/Debug/debugDrawList.h>
+
+#include <cstdint>
+#include <vector>
+
+class Shader;
+class Material;
+class Mesh;
+class Font;
+class Texture;
+
+
+/** Render Snapshot
+* Everything the render thread needs to draw a frame, copied by the game thread once the frame is simulated: camera, lights, transforms
+* and draw items of the objects, laid out texts and sprites, debug shapes. The render thread never reads the objects of the game.
+* The resources (shaders, materials, meshes, textures, fonts) are only referenced, they are assets that live until the engine closes.
+* A snapshot is reused for the next frames, clearing it keeps the memory of its arrays.
+*/
+struct RenderSnapshot
+{
+	struct ShaderBatch
+	{
+		Shader* shader{ nullptr };
+		int firstMaterial{ 0 }; //  in the materials array
+		int materialsCount{ 0 };
+	};
+
+	struct ObjectTransform
+	{
+		Matrix4 model;
+		Matrix4 normal;
+		Vector3 scale;
+	};
+
+	struct DrawItem
+	{
+		Material* material{ nullptr };
+		Mesh* mesh{ nullptr };
+		int transform{ 0 }; //  in the transforms array
+		int order{ 0 }; //  draw order of the items that share a material
+	};
+
+	struct TextBatch
+	{
+		const Font* font{ nullptr };
+		Vector3 color;
+		int firstChar{ 0 }; //  in the chars arrays
+		int charsCount{ 0 };
+	};
+
+	struct SpriteItem
+	{
+		const Texture* texture{ nullptr };
+		Vector3 color;
+		Matrix4 transform;
+	};
+
+
+	uint64_t frameIndex{ 0 };
+
+	Color clearColor{ Color::black };
+	Vector2Int windowSize;
+
+	bool hasCamera{ false };
+	Matrix4 view;
+	Matrix4 projection;
+	Vector3 viewPosition;
+	Matrix4 hudProjection;
+
+	//  registered materials grouped by shader
+	std::vector<ShaderBatch> shaders;
+	std::vector<Material*> materials;
+
+	//  copies of the used lights, within the limits of the lit shader
+	std::vector<DirectionalLight> directionalLights;
+	std::vector<PointLight> pointLights;
+	std::vector<SpotLight> spotLights;
+
+	//  one item per mesh of the objects models, sorted by material
+	std::vector<ObjectTransform> transforms;
+	std::vector<DrawItem> drawItems;
+
+	bool drawDebug{ false };
+	DebugDrawList debugDraws;
+
+	std::vector<TextBatch> texts;
+	std::vector<Matrix4> charsTransforms;
+	std::vector<int> charsIds;
+
+	std::vector<SpriteItem> sprites;
+
+
+	void clear();
+};
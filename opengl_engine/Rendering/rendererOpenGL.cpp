@@ -1,144 +1,256 @@
 #include "rendererOpenGL.h"
 #include <Assets/assetManager.h>
 #include <ServiceLocator/locator.h>
+#include <GLFW/glfw3.h>
 #include <algorithm>
+#include <chrono>
 
 
-void RendererOpenGL::draw()
+void RendererOpenGL::submitFrame()
 {
-	//  clear with flat color
-	glClearColor(clearColor.r / 255.0f, clearColor.g / 255.0f, clearColor.b / 255.0f, clearColor.a / 255.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-	glEnable(GL_DEPTH_TEST);
+	//  without render thread, the frame is drawn on the game thread in the only snapshot
+	if (!renderThread.joinable())
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
 
-	
-	if (!currentCam) return;
+		RenderSnapshot& snapshot = *snapshots[0];
+		buildSnapshot(snapshot);
+		drawSnapshot(snapshot);
 
-	//  RENDERING 3D
-	// ===================
+		//  the swap waits for the vertical sync
+		const auto swap_start = std::chrono::high_resolution_clock::now();
+		glfwSwapBuffers(glWindow);
+		const auto swap_end = std::chrono::high_resolution_clock::now();
 
+		lastSubmitWaitTime = std::chrono::duration<float, std::milli>(swap_end - swap_start).count();
+		lastRenderTime.store(std::chrono::duration<float, std::milli>(swap_end - start).count(), std::memory_order_relaxed);
+		return;
+	}
 
-	Matrix4 view = currentCam->getViewMatrix();
-	Matrix4 projection = Matrix4::createPerspectiveFOV(Maths::toRadians(currentCam->getFov()), static_cast<float>(windowSize.x), static_cast<float>(windowSize.y), 0.1f, 100.0f);
+	//  the slot is free: the frame that used it before was drawn, since the last submit waited for the render thread to be within the latency
+	RenderSnapshot& snapshot = *snapshots[submittedFrames % snapshots.size()];
+	buildSnapshot(snapshot);
 
-	//  loop through all shaders
-	for (auto& materials_by_shaders : materials)
+	const auto wait_start = std::chrono::high_resolution_clock::now();
 	{
-		//  retrieve the shader
-		Shader* shader = materials_by_shaders.first;
+		std::unique_lock<std::mutex> lock(framesMutex);
+		framesCondition.wait(lock, [this]() { return submittedFrames - renderedFrames < static_cast<uint64_t>(frameLatency); });
+		submittedFrames++;
+	}
+	lastSubmitWaitTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - wait_start).count();
+	framesCondition.notify_all();
+}
 
-		if (!shader->isLoaded()) continue;
+void RendererOpenGL::runRenderThread()
+{
+	glfwMakeContextCurrent(glWindow);
 
-		//  activate the shader and set the primary uniforms
-		shader->use();
-		shader->setMatrix4("view", view.getAsFloatPtr());
-		shader->setMatrix4("projection", projection.getAsFloatPtr());
+	while (true)
+	{
+		RenderSnapshot* snapshot = nullptr;
+		{
+			std::unique_lock<std::mutex> lock(framesMutex);
+			framesCondition.wait(lock, [this]() { return stopRequested || submittedFrames > renderedFrames; });
+			if (submittedFrames == renderedFrames) break; //  stopped and every submitted frame is drawn
+
+			snapshot = snapshots[renderedFrames % snapshots.size()].get();
+		}
+
+		//  the resources uploaded during the simulation of the frame are ready before it is drawn
+		runPendingRenderJobs();
+
+		const auto start = std::chrono::high_resolution_clock::now();
+		drawSnapshot(*snapshot);
+		glfwSwapBuffers(glWindow);
+		lastRenderTime.store(std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count(), std::memory_order_relaxed);
 
-		ShaderType shader_type = shader->getShaderType();
-		switch (shader_type) //  feels a bit hardcoded, should be cool to find a better way to do this
 		{
-		case ShaderType::Lit:
-			//  use lights
-			for (auto light_t : lights)
-			{
-				LightType light_type = light_t.first;
+			std::lock_guard<std::mutex> lock(framesMutex);
+			renderedFrames++;
+		}
+		framesCondition.notify_all();
+	}
 
-				int light_type_used = 0;
-				for (auto light : light_t.second)
-				{
-					if (!light->isLoaded()) continue;
+	runPendingRenderJobs();
+	glfwMakeContextCurrent(nullptr);
+}
 
-					light->use(*shader, light_type_used);
+void RendererOpenGL::runPendingRenderJobs()
+{
+	{
+		std::lock_guard<std::mutex> lock(renderJobsMutex);
+		runningRenderJobs.swap(pendingRenderJobs);
+	}
 
-					light_type_used++;
-					if (light_type_used >= LIGHTS_LIMITS.at(light_type))
-					{
-						break;
-					}
-				}
+	for (auto& job : runningRenderJobs)
+	{
+		job();
+	}
+	runningRenderJobs.clear();
+}
 
-				switch (light_type)
-				{
-				case EPointLight:
-					shader->setInt("nbPointLights", light_type_used++);
-					break;
-				case ESpotLight:
-					shader->setInt("nbSpotLights", light_type_used++);
-					break;
-				}
-			}
+void RendererOpenGL::startRenderThread(int latency)
+{
+	if (renderThread.joinable()) return;
 
-			shader->setVec3("viewPos", currentCam->getPosition());
+	frameLatency = latency < 0 ? 0 : (latency > 2 ? 2 : latency);
+	if (frameLatency != latency)
+	{
+		Locator::getLog().LogMessage_Category("Renderer: The frame latency must be 0, 1 or 2, it is set to " + std::to_string(frameLatency) + ".", LogCategory::Warning);
+	}
 
-			break;
+	snapshots.clear();
+	for (int i = 0; i < frameLatency + 1; i++)
+	{
+		snapshots.emplace_back(new RenderSnapshot());
+	}
 
-		case ShaderType::Unlit:
-			//  nothing else to do
-			break;
-		}
-		
-		//  loop through all materials that use the shader
-		for (auto& material : materials_by_shaders.second)
+	if (frameLatency == 0) return;
+
+	submittedFrames = 0;
+	renderedFrames = 0;
+	stopRequested = false;
+	renderThread = std::thread(&RendererOpenGL::runRenderThread, this);
+}
+
+void RendererOpenGL::stopRenderThread()
+{
+	if (!renderThread.joinable()) return;
+
+	{
+		std::lock_guard<std::mutex> lock(framesMutex);
+		stopRequested = true;
+	}
+	framesCondition.notify_all();
+	renderThread.join();
+}
+
+
+
+void RendererOpenGL::buildSnapshot(RenderSnapshot& snapshot)
+{
+	snapshot.clear();
+	snapshot.frameIndex = submittedFrames;
+	snapshot.clearColor = clearColor;
+	snapshot.windowSize = windowSize;
+
+	if (!currentCam) return;
+
+	//  camera
+	snapshot.hasCamera = true;
+	snapshot.view = currentCam->getViewMatrix();
+	snapshot.projection = Matrix4::createPerspectiveFOV(Maths::toRadians(currentCam->getFov()), static_cast<float>(windowSize.x), static_cast<float>(windowSize.y), 0.1f, 100.0f);
+	snapshot.viewPosition = currentCam->getPosition();
+	snapshot.hudProjection = Matrix4::createSimpleViewProj(static_cast<float>(windowSize.x), static_cast<float>(windowSize.y));
+
+	//  materials by shader
+	for (auto& materials_by_shaders : materials)
+	{
+		if (!materials_by_shaders.first->isLoaded()) continue;
+
+		RenderSnapshot::ShaderBatch batch;
+		batch.shader = materials_by_shaders.first;
+		batch.firstMaterial = static_cast<int>(snapshot.materials.size());
+		batch.materialsCount = static_cast<int>(materials_by_shaders.second.size());
+		snapshot.materials.insert(snapshot.materials.end(), materials_by_shaders.second.begin(), materials_by_shaders.second.end());
+		snapshot.shaders.push_back(batch);
+	}
+
+	//  lights, copied so that the game can move or destroy them while the frame is drawn
+	for (auto& light_t : lights)
+	{
+		const LightType light_type = light_t.first;
+		const int light_limit = LIGHTS_LIMITS.at(light_type);
+
+		int light_type_used = 0;
+		for (auto light : light_t.second)
 		{
-			shader->setBool("beta_prevent_tex_scaling", false); //  should do a better thing for all beta parameters
+			if (!light->isLoaded()) continue;
 
-			material->use();
+			switch (light_type)
+			{
+			case EDirectionalLight:
+				snapshot.directionalLights.push_back(*static_cast<DirectionalLight*>(light));
+				break;
+			case EPointLight:
+				snapshot.pointLights.push_back(*static_cast<PointLight*>(light));
+				break;
+			case ESpotLight:
+				snapshot.spotLights.push_back(*static_cast<SpotLight*>(light));
+				break;
+			}
 
-			//  loop through all objects to draw all meshes that uses the material
-			for (auto& object : objects)
+			light_type_used++;
+			if (light_type_used >= light_limit)
 			{
-				object->draw(*material);
+				break;
 			}
 		}
 	}
 
-	if (drawDebugMode)
+	//  objects, one draw item per mesh of their models
+	for (auto& object : objects)
 	{
-		Material& debug_collision_mat = AssetManager::GetMaterial("debug_collisions");
-		Shader& debug_collision_shader = debug_collision_mat.getShader();
-		debug_collision_shader.use();
-		debug_collision_shader.setMatrix4("view", view.getAsFloatPtr());
-		debug_collision_shader.setMatrix4("projection", projection.getAsFloatPtr());
-
-		debug_collision_mat.use();
+		const int transform_index = static_cast<int>(snapshot.transforms.size());
+		snapshot.transforms.push_back(RenderSnapshot::ObjectTransform{ object->getModelMatrix(), object->getNormalMatrix(), object->getScale() });
 
-		Locator::getPhysics().DrawCollisionsDebug(debug_collision_mat);
+		for (auto model : object->getModels())
+		{
+			for (auto& mesh_material : model->getMeshMaterials())
+			{
+				RenderSnapshot::DrawItem item;
+				item.material = mesh_material.material;
+				item.mesh = &mesh_material.mesh;
+				item.transform = transform_index;
+				item.order = static_cast<int>(snapshot.drawItems.size());
+				snapshot.drawItems.push_back(item);
+			}
+		}
 	}
 
+	//  the render thread draws the items of a material in one range, in the order of the objects
+	std::sort(snapshot.drawItems.begin(), snapshot.drawItems.end(), [](const RenderSnapshot::DrawItem& a, const RenderSnapshot::DrawItem& b)
+		{
+			if (a.material != b.material) return std::less<Material*>()(a.material, b.material);
+			return a.order < b.order;
+		}
+	);
 
+	//  debug shapes of the physics
+	snapshot.drawDebug = drawDebugMode;
+	if (drawDebugMode)
+	{
+		Locator::getPhysics().DrawCollisionsDebug(snapshot.debugDraws);
+	}
 
-	//  RENDERING HUD
-	// ===================
-
-	glDisable(GL_DEPTH_TEST);
-
-	Matrix4 hud_projection = Matrix4::createSimpleViewProj(static_cast<float>(windowSize.x), static_cast<float>(windowSize.y));
+	//  hud
+	buildTextsSnapshot(snapshot);
 
-	//  prepare the shader used in text rendering
-	Shader& text_render_shader = AssetManager::GetShader("text_render");
-	text_render_shader.use();
-	text_render_shader.setMatrix4("projection", hud_projection.getAsFloatPtr());
+	for (auto& sprite : sprites)
+	{
+		if (!sprite->canDraw()) continue;
 
-	//  bind the char (and sprite) vertex array
-	AssetManager::GetVertexArray("hud_quad").setActive();
+		snapshot.sprites.push_back(RenderSnapshot::SpriteItem{ &sprite->getSpriteTexture(), sprite->getTintColor().toVector(), sprite->getHudTransform() });
+	}
+}
 
+void RendererOpenGL::buildTextsSnapshot(RenderSnapshot& snapshot)
+{
 	for (auto& text : texts)
 	{
 		//  check text enabled
 		if (!text->getEnabled()) continue;
 
-		//  set text color
-		text_render_shader.setVec3("textColor", text->getTintColor().toVector());
+		RenderSnapshot::TextBatch batch;
+		batch.font = &text->getTextFont();
+		batch.color = text->getTintColor().toVector();
+		batch.firstChar = static_cast<int>(snapshot.charsTransforms.size());
 
 		//  check if computing angle is needed or not
 		float text_angle = text->getRotAngle();
 		const bool compute_angle = text_angle != 0.0f;
 		text_angle = Maths::toRadians(text_angle);
 
-		//  prepare arrays of datas that will be sent to the shader
-		int char_map_ids[TEXT_CHARS_LIMIT]{ 0 };
-		Matrix4 char_transforms[TEXT_CHARS_LIMIT]{ Matrix4::identity };
-
 		//  retrieve datas of the text
 		float x = text->getScreenPos().x;
 		float y = text->getScreenPos().y;
@@ -152,32 +264,23 @@ void RendererOpenGL::draw()
 		text_pivot.y = 1.0f - text_pivot.y;
 		const Vector2 text_size = text->getSize();
 
-		//  get font and bind font texture array
-		const Font& text_font = text->getTextFont();
-		text_font.use();
+		const Font& text_font = *batch.font;
 		const int font_size = text_font.getFontSize();
 
 		//  allow the text pivot to be applied correctly  
 		y -= (float)(font_size) * text_scale.y;
 
 		//  iterate through all characters
-		std::string::const_iterator c;
-		int index = 0;
-		for (c = text_text.begin(); c != text_text.end(); c++)
+		for (const char c : text_text)
 		{
-			if (index >= TEXT_CHARS_LIMIT)
-			{
-				break;
-			}
-
-			FontCharacter ch = text_font.getCharacter(*c);
+			FontCharacter ch = text_font.getCharacter(c);
 
-			if (*c == '\n')
+			if (c == '\n')
 			{
 				y -= ((ch.Size.y)) * 1.6f * text_scale.y;
 				x = begin_x;
 			}
-			else if (*c == ' ')
+			else if (c == ' ')
 			{
 				x += (ch.Advance >> 6) * text_scale.x; // bitshift by 6 (2^6 = 64) to advance the space character size
 			}
@@ -189,41 +292,174 @@ void RendererOpenGL::draw()
 
 				if (compute_angle)
 				{
-					char_transforms[index] =
+					snapshot.charsTransforms.push_back(
 						Matrix4::createScale(Vector3(ch_scale, 1.0f)) *
 						Matrix4::createTranslation(ch_pos - text->getScreenPos() + (text_size * text_pivot)) *
 						Matrix4::createRotationZ(text_angle) *
-						Matrix4::createTranslation(text->getScreenPos());
+						Matrix4::createTranslation(text->getScreenPos()));
 				}
 				else
 				{
-					char_transforms[index] =
+					snapshot.charsTransforms.push_back(
 						Matrix4::createScale(Vector3(ch_scale, 1.0f)) *
-						Matrix4::createTranslation(ch_pos + (text_size * text_pivot));
+						Matrix4::createTranslation(ch_pos + (text_size * text_pivot)));
 				}
-				char_map_ids[index] = ch.TextureID;
+				snapshot.charsIds.push_back(ch.TextureID);
 
 				x += (ch.Advance >> 6) * text_scale.x; // bitshift by 6 (2^6 = 64) to advance the character size
+			}
+		}
+
+		batch.charsCount = static_cast<int>(snapshot.charsTransforms.size()) - batch.firstChar;
+		if (batch.charsCount > 0) snapshot.texts.push_back(batch);
+	}
+}
+
+
+
+void RendererOpenGL::drawSnapshot(const RenderSnapshot& snapshot)
+{
+	//  the viewport follows the window size of the frame
+	if (snapshot.windowSize.x != viewportSize.x || snapshot.windowSize.y != viewportSize.y)
+	{
+		glViewport(0, 0, snapshot.windowSize.x, snapshot.windowSize.y);
+		viewportSize = snapshot.windowSize;
+	}
+
+	//  clear with flat color
+	const Color& clear_color = snapshot.clearColor;
+	glClearColor(clear_color.r / 255.0f, clear_color.g / 255.0f, clear_color.b / 255.0f, clear_color.a / 255.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+
+	
+	if (!snapshot.hasCamera) return;
+
+	//  RENDERING 3D
+	// ===================
+
+
+	//  loop through all shaders
+	for (auto& shader_batch : snapshot.shaders)
+	{
+		//  retrieve the shader
+		Shader* shader = shader_batch.shader;
+
+		//  activate the shader and set the primary uniforms
+		shader->use();
+		shader->setMatrix4("view", snapshot.view.getAsFloatPtr());
+		shader->setMatrix4("projection", snapshot.projection.getAsFloatPtr());
+
+		ShaderType shader_type = shader->getShaderType();
+		switch (shader_type) //  feels a bit hardcoded, should be cool to find a better way to do this
+		{
+		case ShaderType::Lit:
+			//  use lights
+			for (int i = 0; i < static_cast<int>(snapshot.directionalLights.size()); i++)
+			{
+				snapshot.directionalLights[i].use(*shader, i);
+			}
+
+			for (int i = 0; i < static_cast<int>(snapshot.pointLights.size()); i++)
+			{
+				snapshot.pointLights[i].use(*shader, i);
+			}
+			shader->setInt("nbPointLights", static_cast<int>(snapshot.pointLights.size()));
+
+			for (int i = 0; i < static_cast<int>(snapshot.spotLights.size()); i++)
+			{
+				snapshot.spotLights[i].use(*shader, i);
+			}
+			shader->setInt("nbSpotLights", static_cast<int>(snapshot.spotLights.size()));
+
+			shader->setVec3("viewPos", snapshot.viewPosition);
+
+			break;
+
+		case ShaderType::Unlit:
+			//  nothing else to do
+			break;
+		}
+		
+		//  loop through all materials that use the shader
+		for (int m = shader_batch.firstMaterial; m < shader_batch.firstMaterial + shader_batch.materialsCount; m++)
+		{
+			Material* material = snapshot.materials[m];
+
+			shader->setBool("beta_prevent_tex_scaling", false); //  should do a better thing for all beta parameters
+
+			material->use();
 
-				index++;
-				if (index >= TEXT_CHARS_LIMIT)
+			//  draw all meshes that uses the material (the items are sorted by material)
+			RenderSnapshot::DrawItem material_item;
+			material_item.material = material;
+			auto items = std::equal_range(snapshot.drawItems.begin(), snapshot.drawItems.end(), material_item, [](const RenderSnapshot::DrawItem& a, const RenderSnapshot::DrawItem& b)
 				{
-					//  draw array of max TEXT_CHARS_LIMIT chars
-					text_render_shader.setMatrix4Array("textTransforms", char_transforms[0].getAsFloatPtr(), index);
-					text_render_shader.setIntArray("letterMap", &char_map_ids[0], index);
-					glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, index);
+					return std::less<Material*>()(a.material, b.material);
+				}
+			);
 
-					index = 0;
+			int current_transform = -1;
+			for (auto item = items.first; item != items.second; item++)
+			{
+				if (item->transform != current_transform)
+				{
+					const RenderSnapshot::ObjectTransform& transform = snapshot.transforms[item->transform];
+					shader->setMatrix4("model", transform.model.getAsFloatPtr());
+					shader->setMatrix4("normalMatrix", transform.normal.getAsFloatPtr());
+					shader->setVec3("scale", transform.scale);
+					current_transform = item->transform;
 				}
+
+				item->mesh->draw();
 			}
 		}
+	}
+
+	if (snapshot.drawDebug)
+	{
+		Material& debug_collision_mat = AssetManager::GetMaterial("debug_collisions");
+		Shader& debug_collision_shader = debug_collision_mat.getShader();
+		debug_collision_shader.use();
+		debug_collision_shader.setMatrix4("view", snapshot.view.getAsFloatPtr());
+		debug_collision_shader.setMatrix4("projection", snapshot.projection.getAsFloatPtr());
+
+		debug_collision_mat.use();
+
+		snapshot.debugDraws.draw(debug_collision_mat);
+	}
+
+
+
+	//  RENDERING HUD
+	// ===================
+
+	glDisable(GL_DEPTH_TEST);
+
+	//  prepare the shader used in text rendering
+	Shader& text_render_shader = AssetManager::GetShader("text_render");
+	text_render_shader.use();
+	text_render_shader.setMatrix4("projection", snapshot.hudProjection.getAsFloatPtr());
+
+	//  bind the char (and sprite) vertex array
+	AssetManager::GetVertexArray("hud_quad").setActive();
+
+	for (auto& text : snapshot.texts)
+	{
+		//  set text color
+		text_render_shader.setVec3("textColor", text.color);
+
+		//  bind font texture array
+		text.font->use();
 
-		//  draw array of remaining chars
-		if (index > 0)
+		//  draw arrays of max TEXT_CHARS_LIMIT chars
+		for (int first = 0; first < text.charsCount; first += TEXT_CHARS_LIMIT)
 		{
-			text_render_shader.setMatrix4Array("textTransforms", char_transforms[0].getAsFloatPtr(), index);
-			text_render_shader.setIntArray("letterMap", &char_map_ids[0], index);
-			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, index);
+			const int remaining = text.charsCount - first;
+			const int count = remaining < TEXT_CHARS_LIMIT ? remaining : TEXT_CHARS_LIMIT;
+			text_render_shader.setMatrix4Array("textTransforms", snapshot.charsTransforms[text.firstChar + first].getAsFloatPtr(), count);
+			text_render_shader.setIntArray("letterMap", &snapshot.charsIds[text.firstChar + first], count);
+			glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
 		}
 
 		//  unbind font texture array
@@ -236,22 +472,19 @@ void RendererOpenGL::draw()
 	//  prepare the shader used in sprite rendering
 	Shader& sprite_render_shader = AssetManager::GetShader("sprite_render");
 	sprite_render_shader.use();
-	sprite_render_shader.setMatrix4("projection", hud_projection.getAsFloatPtr());
+	sprite_render_shader.setMatrix4("projection", snapshot.hudProjection.getAsFloatPtr());
 
-	for (auto& sprite : sprites)
+	for (auto& sprite : snapshot.sprites)
 	{
-		//  check sprite enabled
-		if (!sprite->canDraw()) continue;
-
 		//  use sprite texture
 		glActiveTexture(GL_TEXTURE0);
-		sprite->getSpriteTexture().use();
+		sprite.texture->use();
 
 		//  set sprite color
-		sprite_render_shader.setVec3("spriteColor", sprite->getTintColor().toVector());
+		sprite_render_shader.setVec3("spriteColor", sprite.color);
 
 		//  set sprite transform
-		sprite_render_shader.setMatrix4("spriteTransform", sprite->getHudTransform().getAsFloatPtr());
+		sprite_render_shader.setMatrix4("spriteTransform", sprite.transform.getAsFloatPtr());
 
 		//  draw
 		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
@@ -265,6 +498,24 @@ void RendererOpenGL::draw()
 
 
 
+bool RendererOpenGL::IsRenderingContextValid()
+{
+	return true; //  the engine only creates this renderer once the window and its context exist
+}
+
+void RendererOpenGL::RunOnRenderThread(std::function<void()> job)
+{
+	//  without render thread, the game thread has the context
+	if (!renderThread.joinable())
+	{
+		job();
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(renderJobsMutex);
+	pendingRenderJobs.push_back(std::move(job));
+}
+
 void RendererOpenGL::SetCamera(Camera* camera)
 {
 	currentCam = camera;
@@ -308,7 +559,7 @@ void RendererOpenGL::RemoveMaterial(Material* material)
 
 void RendererOpenGL::AddLight(Light* light)
 {
-	lights[light->getLightType()].push_back(light);
+	light->rendererHandle = lights[light->getLightType()].insert(light);
 
 	if (lights[light->getLightType()].size() > LIGHTS_LIMITS.at(light->getLightType()))
 	{
@@ -318,79 +569,97 @@ void RendererOpenGL::AddLight(Light* light)
 
 void RendererOpenGL::RemoveLight(Light* light)
 {
-	auto iter = std::find(lights[light->getLightType()].begin(), lights[light->getLightType()].end(), light);
-	if (iter == lights[light->getLightType()].end())
+	SlotMap<Light*>& type_lights = lights[light->getLightType()];
+	Light** registered_light = type_lights.get(light->rendererHandle);
+	if (!registered_light || *registered_light != light)
 	{
 		Locator::getLog().LogMessage_Category("Renderer: Tried to remove a light that doesn't exist.", LogCategory::Error);
 		return;
 	}
 
-	std::iter_swap(iter, lights[light->getLightType()].end() - 1);
-	lights[light->getLightType()].pop_back();
+	type_lights.remove(light->rendererHandle);
+	light->rendererHandle = SlotHandle{};
 }
 
 
 void RendererOpenGL::AddObject(Object* object)
 {
-	objects.push_back(object);
+	object->rendererHandle = objects.insert(object);
 }
 
 void RendererOpenGL::RemoveObject(Object* object)
 {
-	auto iter = std::find(objects.begin(), objects.end(), object);
-	if (iter == objects.end())
+	Object** registered_object = objects.get(object->rendererHandle);
+	if (!registered_object || *registered_object != object)
 	{
 		Locator::getLog().LogMessage_Category("Renderer: Tried to remove an object that doesn't exist.", LogCategory::Error);
 		return;
 	}
 
-	std::iter_swap(iter, objects.end() - 1);
-	objects.pop_back();
+	objects.remove(object->rendererHandle);
+	object->rendererHandle = SlotHandle{};
 }
 
 
 void RendererOpenGL::AddText(TextRendererComponent* text)
 {
-	texts.push_back(text);
+	text->rendererHandle = texts.insert(text);
 }
 
 void RendererOpenGL::RemoveText(TextRendererComponent* text)
 {
-	auto iter = std::find(texts.begin(), texts.end(), text);
-	if (iter == texts.end())
+	TextRendererComponent** registered_text = texts.get(text->rendererHandle);
+	if (!registered_text || *registered_text != text)
 	{
 		Locator::getLog().LogMessage_Category("Renderer: Tried to remove a text that doesn't exist.", LogCategory::Error);
 		return;
 	}
 
-	std::iter_swap(iter, texts.end() - 1);
-	texts.pop_back();
+	texts.remove(text->rendererHandle);
+	text->rendererHandle = SlotHandle{};
 }
 
 void RendererOpenGL::AddSprite(SpriteRendererComponent* sprite)
 {
-	sprites.push_back(sprite);
+	sprite->rendererHandle = sprites.insert(sprite);
 }
 
 void RendererOpenGL::RemoveSprite(SpriteRendererComponent* sprite)
 {
-	auto iter = std::find(sprites.begin(), sprites.end(), sprite);
-	if (iter == sprites.end())
+	SpriteRendererComponent** registered_sprite = sprites.get(sprite->rendererHandle);
+	if (!registered_sprite || *registered_sprite != sprite)
 	{
 		Locator::getLog().LogMessage_Category("Renderer: Tried to remove a sprite that doesn't exist.", LogCategory::Error);
 		return;
 	}
 
-	std::iter_swap(iter, sprites.end() - 1);
-	sprites.pop_back();
+	sprites.remove(sprite->rendererHandle);
+	sprite->rendererHandle = SlotHandle{};
 }
 
 
 
-void RendererOpenGL::initializeRenderer(Color clearColor_, Vector2Int windowSize_)
+void RendererOpenGL::initializeRenderer(Color clearColor_, Vector2Int windowSize_, GLFWwindow* glWindow_)
 {
 	clearColor = clearColor_;
 	windowSize = windowSize_;
+	viewportSize = windowSize_;
+	glWindow = glWindow_;
+
+	//  until the render thread is started, the frames are drawn on the game thread
+	snapshots.emplace_back(new RenderSnapshot());
+}
+
+void RendererOpenGL::setSwapInterval(int interval)
+{
+	//  the swap interval belongs to the context, it is set by the thread that has it
+	if (renderThread.joinable())
+	{
+		Locator::getLog().LogMessage_Category("Renderer: The swap interval can't be changed while the render thread is running.", LogCategory::Warning);
+		return;
+	}
+
+	glfwSwapInterval(interval);
 }
 
 void RendererOpenGL::setWindowSize(Vector2Int windowSize_)
@@ -2,6 +2,7 @@
 #include <ServiceLocator/renderer.h>
 
 #include <Utils/color.h>
+#include <Utils/slotMap.h>
 #include <Maths/matrix4.h>
 #include <Maths/vector3.h>
 #include <Maths/vector2Int.h>
@@ -13,10 +14,18 @@
 #include <Rendering/material.h>
 #include <Rendering/Text/textRendererComponent.h>
 #include <Rendering/Hud/spriteRendererComponent.h>
+#include "renderSnapshot.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <unordered_map>
 
+struct GLFWwindow;
+
 
 //  would be cool if I find a better way to do this but it works for now
 const std::unordered_map<LightType, int> LIGHTS_LIMITS
@@ -31,10 +40,15 @@ const int TEXT_CHARS_LIMIT{ 200 };
 
 /**
 * The renderer service provider class.
+* The game thread registers the objects, lights, texts and sprites, and copies them in a render snapshot at the end of each frame.
+* The snapshots are drawn by a render thread that owns the OpenGL context, so it draws a frame while the game thread simulates the next one.
 */
 class RendererOpenGL : public Renderer
 {
 public:
+	bool IsRenderingContextValid() override;
+	void RunOnRenderThread(std::function<void()> job) override;
+
 	void SetCamera(Camera* camera) override;
 	const Camera& GetCamera() const override;
 
@@ -60,30 +74,79 @@ public:
 
 
 private:
-	std::unordered_map<LightType, std::vector<Light*>> lights;
-	std::vector<Object*> objects;
+	std::unordered_map<LightType, SlotMap<Light*>> lights;
+	SlotMap<Object*> objects;
 	std::unordered_map<Shader*, std::vector<Material*>> materials;
-	std::vector<TextRendererComponent*> texts;
-	std::vector<SpriteRendererComponent*> sprites;
+	SlotMap<TextRendererComponent*> texts;
+	SlotMap<SpriteRendererComponent*> sprites;
 
 	Color clearColor{ Color::black };
 
 	Camera* currentCam{ nullptr };
 	Vector2Int windowSize;
 
-	
+	//  render thread, the snapshot of a frame is in the slot of its index modulo the snapshots count (the frame latency + 1)
+	std::vector<std::unique_ptr<RenderSnapshot>> snapshots;
+	std::thread renderThread;
+	std::mutex framesMutex;
+	std::condition_variable framesCondition;
+	uint64_t submittedFrames{ 0 };
+	uint64_t renderedFrames{ 0 };
+	int frameLatency{ 0 };
+	bool stopRequested{ false };
+	GLFWwindow* glWindow{ nullptr };
+	Vector2Int viewportSize; //  only used by the thread that has the context
+	std::atomic<float> lastRenderTime{ 0.0f };
+	float lastSubmitWaitTime{ 0.0f }; //  only used by the game thread
+
+	//  jobs given to the render thread, run before it draws a frame
+	std::mutex renderJobsMutex;
+	std::vector<std::function<void()>> pendingRenderJobs;
+	std::vector<std::function<void()>> runningRenderJobs; //  only used by the render thread
+	void runPendingRenderJobs();
+
+	void buildSnapshot(RenderSnapshot& snapshot);
+	void buildTextsSnapshot(RenderSnapshot& snapshot);
+	void drawSnapshot(const RenderSnapshot& snapshot);
+	void runRenderThread();
 
 
 
 
 //  exclusive to engine which is the only class to access the full renderer
 public:
-	void initializeRenderer(Color clearColor_, Vector2Int windowSize_);
+	void initializeRenderer(Color clearColor_, Vector2Int windowSize_, GLFWwindow* glWindow_);
+
+	/**
+	* Start the render thread, it takes the OpenGL context of the window: the calling thread must have released it, and the assets must be loaded.
+	* @param	latency		Frames the game thread can submit before the render thread has drawn them (1 or 2), 0 draws the frames on the game thread.
+	*/
+	void startRenderThread(int latency);
 
-	void draw();
+	/**
+	* Draw the frames that are still submitted and stop the render thread, the OpenGL context is released for the calling thread.
+	*/
+	void stopRenderThread();
+
+	/**
+	* Copy the frame in a render snapshot and give it to the render thread, it waits if the render thread is late by the frame latency.
+	* Without render thread the snapshot is drawn at once.
+	*/
+	void submitFrame();
 
 	void setWindowSize(Vector2Int windowSize_);
 
+	/**
+	* Set the number of screen updates to wait for before swapping the buffers (0 doesn't wait for the vertical sync), before the render thread starts.
+	*/
+	void setSwapInterval(int interval);
+
+	//  time of the last frame drawn, in milliseconds (swap included)
+	inline float getLastRenderTime() const { return lastRenderTime.load(std::memory_order_relaxed); }
+
+	//  time the game thread waited in the last submit, for the render thread or for the swap without render thread, in milliseconds
+	inline float getLastSubmitWaitTime() const { return lastSubmitWaitTime; }
+
 	bool drawDebugMode{ false };
 };
 
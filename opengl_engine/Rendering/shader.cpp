@@ -70,6 +70,9 @@ void Shader::load(const std::string& vertexName, const std::string& fragmentName
 		Locator::getLog().LogMessage_Category("Shader: Failed to read shader files.", LogCategory::Error);
 	}
 
+	//  without rendering context (headless engine) the shader stays unloaded, the files are only read to check them
+	if (!Locator::getRenderer().IsRenderingContextValid()) return;
+
 	const char* v_shader_code = vertex_code.c_str();
 	const char* f_shader_code = fragment_code.c_str();
 
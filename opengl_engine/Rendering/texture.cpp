@@ -24,6 +24,17 @@ void Texture::load(const std::string& texturePath, bool flipVertical)
 {
 	std::string tex_path = RESOURCES_PATH + texturePath;
 
+	//  without rendering context (headless engine) only the size of the texture is kept, there is no texture object
+	if (!Locator::getRenderer().IsRenderingContextValid())
+	{
+		int nr_channels;
+		if (!stbi_info(tex_path.c_str(), &width, &height, &nr_channels))
+		{
+			Locator::getLog().LogMessage_Category("Texture: Failed to load texture at path " + tex_path + ".", LogCategory::Error);
+		}
+		return;
+	}
+
 	//  create texture
 	glGenTextures(1, &ID);
 	glBindTexture(GL_TEXTURE_2D, ID);
@@ -76,6 +87,8 @@ void Texture::use() const
 
 void Texture::setWrappingParameters(unsigned int sAxis, unsigned int tAxis)
 {
+	if (ID == 0) return; //  no texture object (headless engine)
+
 	use();
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, sAxis);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, tAxis);
@@ -83,6 +96,8 @@ void Texture::setWrappingParameters(unsigned int sAxis, unsigned int tAxis)
 
 void Texture::setFilteringParameters(unsigned int minifying, unsigned int magnifying)
 {
+	if (ID == 0) return; //  no texture object (headless engine)
+
 	use();
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minifying);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magnifying);
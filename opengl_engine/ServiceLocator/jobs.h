@@ -0,0 +1,193 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/** Job Function
+* Function of a job, the callable is stored inside the job function so that creating a job never allocates.
+* A job can capture up to STORAGE_SIZE bytes, bigger data must be captured by reference or pointer.
+*/
+class JobFunction
+{
+public:
+	static const size_t STORAGE_SIZE = 6 * sizeof(void*);
+
+	JobFunction() {}
+
+	template<typename Function, typename = typename std::enable_if<!std::is_same<typename std::decay<Function>::type, JobFunction>::value>::type>
+	JobFunction(Function&& function)
+	{
+		typedef typename std::decay<Function>::type Callable;
+		static_assert(sizeof(Callable) <= STORAGE_SIZE, "Job Function: the job captures too much, capture its data by reference instead.");
+		static_assert(alignof(Callable) <= alignof(std::max_align_t), "Job Function: the job captures an over-aligned type.");
+
+		new (storage) Callable(std::forward<Function>(function));
+		operations = GetOperations<Callable>();
+	}
+
+	JobFunction(JobFunction&& other) noexcept
+	{
+		moveFrom(other);
+	}
+
+	JobFunction& operator=(JobFunction&& other) noexcept
+	{
+		if (this != &other)
+		{
+			reset();
+			moveFrom(other);
+		}
+		return *this;
+	}
+
+	JobFunction(const JobFunction&) = delete;
+	JobFunction& operator=(const JobFunction&) = delete;
+
+	~JobFunction() { reset(); }
+
+	inline void operator()() { operations->invoke(storage); }
+	inline explicit operator bool() const { return operations != nullptr; }
+
+	/**
+	* Destroy the callable and its captures.
+	*/
+	void reset()
+	{
+		if (!operations) return;
+		operations->destroy(storage);
+		operations = nullptr;
+	}
+
+private:
+	struct Operations
+	{
+		void (*invoke)(void* callable);
+		void (*move)(void* destination, void* source); //  move constructs the destination and destroys the source
+		void (*destroy)(void* callable);
+	};
+
+	template<typename Callable> static void Invoke(void* callable) { (*static_cast<Callable*>(callable))(); }
+	template<typename Callable> static void Move(void* destination, void* source)
+	{
+		new (destination) Callable(std::move(*static_cast<Callable*>(source)));
+		static_cast<Callable*>(source)->~Callable();
+	}
+	template<typename Callable> static void Destroy(void* callable) { static_cast<Callable*>(callable)->~Callable(); }
+
+	template<typename Callable> static const Operations* GetOperations()
+	{
+		static const Operations callable_operations{ &Invoke<Callable>, &Move<Callable>, &Destroy<Callable> };
+		return &callable_operations;
+	}
+
+	void moveFrom(JobFunction& other)
+	{
+		if (!other.operations) return;
+		other.operations->move(storage, other.storage);
+		operations = other.operations;
+		other.operations = nullptr;
+	}
+
+	alignas(std::max_align_t) unsigned char storage[STORAGE_SIZE];
+	const Operations* operations{ nullptr };
+};
+
+
+/** Job Counter
+* Number of unfinished jobs that were given this counter, used to wait for a group of jobs or to run other jobs after them.
+* A counter must outlive all of its jobs and the jobs that run after it.
+*/
+class JobCounter
+{
+public:
+	JobCounter() {}
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	inline bool isDone() const { return pendingJobs.load(std::memory_order_acquire) == 0; }
+	inline int getPendingJobs() const { return pendingJobs.load(std::memory_order_acquire); }
+
+private:
+	friend class JobSystem;
+
+	struct Continuation
+	{
+		JobFunction job;
+		JobCounter* counter{ nullptr };
+	};
+
+	std::atomic<int> pendingJobs{ 0 };
+
+	//  jobs to run once the counter reaches zero
+	std::mutex mutex;
+	std::vector<Continuation> continuations;
+};
+
+
+/**
+* The Jobs Service class (the virtual class provided by the Locator).
+*/
+class Jobs
+{
+public:
+	virtual ~Jobs() {}
+
+	/**
+	* Run a job on any thread of the job system.
+	* @param	job			Function to call.
+	* @param	counter		(optionnal) Counter of the group of this job, incremented now and decremented once the job is done.
+	*/
+	virtual void Run(JobFunction job, JobCounter* counter = nullptr) = 0;
+
+	/**
+	* Run a job once all the jobs of a counter are done.
+	* @param	dependency	Counter to wait for.
+	* @param	job			Function to call.
+	* @param	counter		(optionnal) Counter of the group of this job, incremented now and decremented once the job is done.
+	*/
+	virtual void RunAfter(JobCounter& dependency, JobFunction job, JobCounter* counter = nullptr) = 0;
+
+	/**
+	* Run a job on the main thread (for OpenGL calls), when the main thread waits for a counter or processes its jobs.
+	* @param	job			Function to call.
+	* @param	counter		(optionnal) Counter of the group of this job, incremented now and decremented once the job is done.
+	*/
+	virtual void RunOnMainThread(JobFunction job, JobCounter* counter = nullptr) = 0;
+
+	/**
+	* Wait for all the jobs of a counter, the waiting thread runs other jobs meanwhile.
+	* @param	counter		Counter to wait for.
+	*/
+	virtual void Wait(JobCounter& counter) = 0;
+
+	/**
+	* Run a function for every index in [0, count) and wait for all of them to finish.
+	* The indices are split in ranges as the other threads become idle, a thread never gets less than minChunkSize indices.
+	* The function must not touch anything that isn't read-only or owned by its index.
+	* @param	count			Number of indices to run.
+	* @param	job				Function to call for each index.
+	* @param	minChunkSize	Minimum number of indices run by a job.
+	*/
+	virtual void ParallelFor(int count, const std::function<void(int)>& job, int minChunkSize = 1) = 0;
+
+	/**
+	* Run the main thread jobs that are waiting, called by the engine every frame.
+	*/
+	virtual void ProcessMainThreadJobs() = 0;
+
+	/**
+	* Get the number of threads that run the jobs (the workers and the main thread).
+	*/
+	virtual int GetThreadsCount() = 0;
+
+	/**
+	* Get the index of the calling thread in the job system: 0 for the main thread, -1 for a thread that isn't part of the job system.
+	*/
+	virtual int GetCurrentThreadIndex() = 0;
+};
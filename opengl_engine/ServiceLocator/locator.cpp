@@ -3,15 +3,18 @@
 #include "nullRenderer.h"
 #include "nullAudio.h"
 #include "nullLog.h"
+#include "nullJobs.h"
 
 Physics* Locator::physicsService;
 Renderer* Locator::rendererService;
 Audio* Locator::audioService;
 Log* Locator::logService;
+Jobs* Locator::jobsService;
 NullPhysics Locator::nullPhysicsService;
 NullRenderer Locator::nullRendererService;
 NullAudio Locator::nullAudioService;
 NullLog Locator::nullLogService;
+NullJobs Locator::nullJobsService;
 
 
 Physics& Locator::getPhysics()
@@ -90,10 +93,30 @@ Log& Locator::provideLog(Log* logService_)
 	}
 }
 
+Jobs& Locator::getJobs()
+{
+	return *jobsService;
+}
+
+Jobs& Locator::provideJobs(Jobs* jobsService_)
+{
+	if (jobsService_ == NULL)
+	{
+		jobsService = &nullJobsService;
+		return getJobs();
+	}
+	else
+	{
+		jobsService = jobsService_;
+		return getJobs();
+	}
+}
+
 void Locator::initialize()
 {
 	physicsService = &nullPhysicsService;
 	rendererService = &nullRendererService;
 	audioService = &nullAudioService;
 	logService = &nullLogService;
+	jobsService = &nullJobsService;
 }
@@ -3,11 +3,13 @@
 #include "renderer.h"
 #include "audio.h"
 #include "log.h"
+#include "jobs.h"
 
 class NullPhysics;
 class NullRenderer;
 class NullAudio;
 class NullLog;
+class NullJobs;
 
 class Locator
 {
@@ -24,6 +26,9 @@ public:
 	static Log& getLog();
 	static Log& provideLog(Log* logService_);
 
+	static Jobs& getJobs();
+	static Jobs& provideJobs(Jobs* jobsService_);
+
 private:
 	static Physics* physicsService;
 	static NullPhysics nullPhysicsService;
@@ -37,6 +42,9 @@ private:
 	static Log* logService;
 	static NullLog nullLogService;
 
+	static Jobs* jobsService;
+	static NullJobs nullJobsService;
+
 	friend class Engine;
 	static void initialize();
 };
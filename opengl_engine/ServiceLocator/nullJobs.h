@@ -0,0 +1,24 @@
+#pragma once
+#include <ServiceLocator/jobs.h>
+
+/**
+* The jobs null service provider class, runs every job right away on the calling thread.
+*/
+class NullJobs : public Jobs
+{
+public:
+	void Run(JobFunction job, JobCounter* counter = nullptr) override { job(); }
+	void RunAfter(JobCounter& dependency, JobFunction job, JobCounter* counter = nullptr) override { job(); }
+	void RunOnMainThread(JobFunction job, JobCounter* counter = nullptr) override { job(); }
+	void Wait(JobCounter& counter) override {}
+
+	void ParallelFor(int count, const std::function<void(int)>& job, int minChunkSize = 1) override
+	{
+		for (int i = 0; i < count; i++) job(i);
+	}
+
+	void ProcessMainThreadJobs() override {}
+
+	int GetThreadsCount() override { return 1; }
+	int GetCurrentThreadIndex() override { return 0; }
+};
@@ -12,10 +12,22 @@ public:
 
 	RigidbodyComponent& CreateRigidbodyComponent(RigidbodyComponent* rigidbodyComp) override { return *rigidbodyComp; }
 	void RemoveRigidbody(RigidbodyComponent* rigidbodyComp) override {}
+	RigidbodyStorage& GetRigidbodyStorage() override { return rigidbodyStorage; }
 
-	bool LineRaycast(const Vector3& start, const Vector3& end, const std::vector<std::string> testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true) override { return false; }
-	bool AABBRaycast(const Vector3& location, const Box& aabbBox, const std::vector<std::string> testChannels = {}, float drawDebugTime = 5.0f, bool createOnScene = true) override { return false; }
-	bool AABBSweepRaycast(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string> testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true, bool forCollisionTest = false) override { return false; }
+	bool LineRaycast(const Vector3& start, const Vector3& end, const std::vector<std::string>& testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true) override { return false; }
+	bool AABBRaycast(const Vector3& location, const Box& aabbBox, const std::vector<std::string>& testChannels = {}, float drawDebugTime = 5.0f, bool createOnScene = true) override { return false; }
+	bool AABBSweepRaycast(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string>& testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true, bool forCollisionTest = false) override { return false; }
+
+	int OverlapBox(const Box& aabbBox, std::vector<const CollisionComponent*>& outCollisions, const std::vector<std::string>& testChannels = {}) override { outCollisions.clear(); return 0; }
+	int OverlapSphere(const Vector3& center, float radius, std::vector<const CollisionComponent*>& outCollisions, const std::vector<std::string>& testChannels = {}) override { outCollisions.clear(); return 0; }
+	bool ClosestCollider(const Vector3& point, float maxDistance, ColliderDistanceInfos& outInfos, const std::vector<std::string>& testChannels = {}) override { return false; }
+	int KNearest(const Vector3& point, int count, float maxDistance, std::vector<ColliderDistanceInfos>& outInfos, const std::vector<std::string>& testChannels = {}) override { outInfos.clear(); return 0; }
+	int GetObjectCollisions(const Object& object, std::vector<const CollisionComponent*>& outCollisions) override { outCollisions.clear(); return 0; }
+
+	uint32_t CreateProjectile(const Vector3& position, const Vector3& velocity, float radius, float lifetime, const std::vector<std::string>& testChannels = {}) override { return 0; }
+	void RemoveProjectile(uint32_t projectileId) override {}
+	bool GetProjectilePosition(uint32_t projectileId, Vector3& outPosition) override { return false; }
+	Event<const std::vector<ProjectileHit>&>& GetProjectilesHitEvent() override { return onProjectilesHit; }
 
 	void ClearAllCollisions(bool closeGame) override {}
 
@@ -23,9 +35,25 @@ public:
 
 	void SetEnableInfoLogs(bool enable) override {}
 
+	void SetEnableMultithreading(bool enable) override {}
+
+	void SetEnableStaticGrid(bool enable) override {}
+
+	void SetEnableContactSolver(bool enable) override {}
+
+	int GetAwakeRigidbodiesCount() override { return 0; }
+	int GetAsleepRigidbodiesCount() override { return 0; }
+
+	void StartRecording() override {}
+	bool StopRecording(const std::string& filePath) override { return false; }
+	bool IsRecording() override { return false; }
+
 
 private:
 	void InitialisePhysics() override {}
 	void UpdatePhysics(float dt) override {}
-	void DrawCollisionsDebug(Material& debugMaterial) override {}
+	void DrawCollisionsDebug(DebugDrawList& outDrawList) override {}
+
+	Event<const std::vector<ProjectileHit>&> onProjectilesHit;
+	RigidbodyStorage rigidbodyStorage;
 };
\ No newline at end of file
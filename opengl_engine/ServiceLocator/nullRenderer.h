@@ -9,8 +9,11 @@
 class NullRenderer : public Renderer
 {
 public:
+	bool IsRenderingContextValid() override { return false; }
+	void RunOnRenderThread(std::function<void()> job) override { job(); }
+
 	void SetCamera(Camera* camera) override {}
-	const Camera& GetCamera() const override { return *new Camera(); } //  pretty sure this is very sus but theorically this function is never called so... alright I guess ?
+	const Camera& GetCamera() const override { static Camera null_camera; return null_camera; } //  the engine can run without renderer (headless), so this one can be called
 
 	void SetClearColor(Color clearColor) override {}
 	const Color GetClearColor() const override { return Color::black; }
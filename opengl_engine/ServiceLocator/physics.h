@@ -1,11 +1,15 @@
 #pragma once
 #include <Physics/raycast.h>
+#include <Physics/projectileSystem.h>
+#include <Physics/rigidbodyStorage.h>
+#include <Events/event.h>
 
 class CollisionComponent;
 class RigidbodyComponent;
+class Object;
 struct Vector3;
 class Box;
-class Material;
+class DebugDrawList;
 
 
 /**
@@ -43,6 +47,12 @@ public:
 	*/
 	virtual void RemoveRigidbody(RigidbodyComponent* rigidbodyComp) = 0;
 
+	/**
+	* Retrieve the storage of the rigidbodies simulation state. Rigidbody components add themselves to it when they are constructed.
+	* @return				The rigidbody storage of this physics service.
+	*/
+	virtual RigidbodyStorage& GetRigidbodyStorage() = 0;
+
 
 
 	/**
@@ -55,7 +65,7 @@ public:
 	* @param	createOnScene	Is the raycast registered on the scene (delete if scene change) or on the game (persist when changing scene).
 	* @return					True if at least one collision intersect the line raycast.
 	*/
-	virtual bool LineRaycast(const Vector3& start, const Vector3& end, const std::vector<std::string> testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true) = 0;
+	virtual bool LineRaycast(const Vector3& start, const Vector3& end, const std::vector<std::string>& testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true) = 0;
 
 	/**
 	* Creates an AABB box-shaped raycast at a location.
@@ -66,7 +76,7 @@ public:
 	* @param	createOnScene	Is the raycast registered on the scene (delete if scene change) or on the game (persist when changing scene).
 	* @return					True if at least one collision intersect the aabb box raycast.
 	*/
-	virtual bool AABBRaycast(const Vector3& location, const Box& aabbBox, const std::vector<std::string> testChannels = {}, float drawDebugTime = 5.0f, bool createOnScene = true) = 0;
+	virtual bool AABBRaycast(const Vector3& location, const Box& aabbBox, const std::vector<std::string>& testChannels = {}, float drawDebugTime = 5.0f, bool createOnScene = true) = 0;
 
 	/**
 	* Sweep an AABB box-shaped raycast between two points.
@@ -80,7 +90,91 @@ public:
 	* @param	forCollisionTest	Does this function is used by the collision test algorithm?
 	* @return						True if at least one collision intersect the sweeped aabb box raycast.
 	*/
-	virtual bool AABBSweepRaycast(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string> testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true, bool forCollisionTest = false) = 0;
+	virtual bool AABBSweepRaycast(const Vector3& start, const Vector3& end, const Box& aabbBox, const std::vector<std::string>& testChannels = {}, RaycastHitInfos& outHitInfos = RaycastHitInfos::defaultInfos, float drawDebugTime = 5.0f, bool createOnScene = true, bool forCollisionTest = false) = 0;
+
+
+	/**
+	* Find all the collisions that intersect an AABB box (triggers included). Uses the physics acceleration structures, no raycast is created.
+	* @param	aabbBox			Box to test (world coordinates).
+	* @param	outCollisions	Collisions found. The vector is cleared first, so it can be reused between queries to avoid allocations. [OUT]
+	* @param	testChannels	Collision channels the query will test.
+	* @return					Number of collisions found.
+	*/
+	virtual int OverlapBox(const Box& aabbBox, std::vector<const CollisionComponent*>& outCollisions, const std::vector<std::string>& testChannels = {}) = 0;
+
+	/**
+	* Find all the collisions that intersect a sphere (triggers included). Uses the physics acceleration structures, no raycast is created.
+	* @param	center			Center of the sphere (world coordinates).
+	* @param	radius			Radius of the sphere.
+	* @param	outCollisions	Collisions found. The vector is cleared first, so it can be reused between queries to avoid allocations. [OUT]
+	* @param	testChannels	Collision channels the query will test.
+	* @return					Number of collisions found.
+	*/
+	virtual int OverlapSphere(const Vector3& center, float radius, std::vector<const CollisionComponent*>& outCollisions, const std::vector<std::string>& testChannels = {}) = 0;
+
+	/**
+	* Find the collision that is the closest to a point (triggers included).
+	* @param	point			Query point (world coordinates).
+	* @param	maxDistance		Collisions further than this distance are ignored.
+	* @param	outInfos		Closest collision, its closest point and its distance. [OUT]
+	* @param	testChannels	Collision channels the query will test.
+	* @return					True if a collision has been found.
+	*/
+	virtual bool ClosestCollider(const Vector3& point, float maxDistance, ColliderDistanceInfos& outInfos, const std::vector<std::string>& testChannels = {}) = 0;
+
+	/**
+	* Find the k collisions that are the closest to a point (triggers included), sorted from the closest to the furthest.
+	* @param	point			Query point (world coordinates).
+	* @param	count			Maximum number of collisions to find (k).
+	* @param	maxDistance		Collisions further than this distance are ignored.
+	* @param	outInfos		Collisions found. The vector is cleared first, so it can be reused between queries to avoid allocations. [OUT]
+	* @param	testChannels	Collision channels the query will test.
+	* @return					Number of collisions found.
+	*/
+	virtual int KNearest(const Vector3& point, int count, float maxDistance, std::vector<ColliderDistanceInfos>& outInfos, const std::vector<std::string>& testChannels = {}) = 0;
+
+	/**
+	* Find all the registered collisions associated to an object (the collisions of its rigidbodies included).
+	* @param	object			Object the collisions are associated to.
+	* @param	outCollisions	Collisions found. The vector is cleared first, so it can be reused between queries to avoid allocations. [OUT]
+	* @return					Number of collisions found.
+	*/
+	virtual int GetObjectCollisions(const Object& object, std::vector<const CollisionComponent*>& outCollisions) = 0;
+
+
+	/**
+	* Create a projectile: a swept sphere (or point) that moves straight, without gravity nor collide and slide, and stops at the first solid collision it hits.
+	* Projectiles are much cheaper than rigidbodies, their hits are broadcasted together once per step (see GetProjectilesHitEvent).
+	* The hit collision also receives its onRaycastIntersect event with the projectile raycast type.
+	* Projectiles are always removed when the scene changes.
+	* @param	position		Start position of the projectile (world coordinates).
+	* @param	velocity		Constant velocity of the projectile.
+	* @param	radius			Radius of the projectile (0 for a point).
+	* @param	lifetime		Duration after which the projectile is removed if it didn't hit anything.
+	* @param	testChannels	Collision channels the projectile will test.
+	* @return					Id of the projectile.
+	*/
+	virtual uint32_t CreateProjectile(const Vector3& position, const Vector3& velocity, float radius, float lifetime, const std::vector<std::string>& testChannels = {}) = 0;
+
+	/**
+	* Remove a projectile. Does nothing if the projectile has already hit something or run out of time.
+	* @param	projectileId	Id of the projectile to remove.
+	*/
+	virtual void RemoveProjectile(uint32_t projectileId) = 0;
+
+	/**
+	* Retrieve the position of a projectile.
+	* @param	projectileId	Id of the projectile.
+	* @param	outPosition		Position of the projectile.
+	* @return					False if the projectile doesn't exist anymore (hit something or ran out of time).
+	*/
+	virtual bool GetProjectilePosition(uint32_t projectileId, Vector3& outPosition) = 0;
+
+	/**
+	* Retrieve the event broadcasted once per step with all the projectiles hits of the step.
+	* @return	Projectiles hit event.
+	*/
+	virtual Event<const std::vector<ProjectileHit>&>& GetProjectilesHitEvent() = 0;
 
 
 	/**
@@ -104,6 +198,59 @@ public:
 	*/
 	virtual void SetEnableInfoLogs(bool enable) = 0;
 
+	/**
+	* Set if the physics can solve the rigidbodies on multiple threads.
+	* Physics events are broadcasted on the main thread at the end of the step either way.
+	* @param	enable		Enable state of the multithreaded solve.
+	*/
+	virtual void SetEnableMultithreading(bool enable) = 0;
+
+	/**
+	* Set if the static collisions are indexed by a grid (built when they are baked, at scene load).
+	* Sweeps, rigidbodies and line raycasts then only test the static collisions along their path.
+	* @param	enable		Enable state of the static grid.
+	*/
+	virtual void SetEnableStaticGrid(bool enable) = 0;
+
+	/**
+	* Set if the penetrations left between the rigidbodies (and between the rigidbodies and the other collisions) are resolved after the collide and slide.
+	* @param	enable		Enable state of the contact solver.
+	*/
+	virtual void SetEnableContactSolver(bool enable) = 0;
+
+
+	/**
+	* Retrieve the number of physics activated rigidbodies that are currently simulated.
+	* @return	Awake rigidbodies count.
+	*/
+	virtual int GetAwakeRigidbodiesCount() = 0;
+
+	/**
+	* Retrieve the number of physics activated rigidbodies that are currently sleeping (resting, not simulated).
+	* @return	Asleep rigidbodies count.
+	*/
+	virtual int GetAsleepRigidbodiesCount() = 0;
+
+
+	/**
+	* Start to record the inputs of the physics (delta times, bodies creation and removal, what the gameplay changes on the bodies, projectiles and raycasts).
+	* The rigidbodies are all woken up, so that a replay starts from the same state.
+	*/
+	virtual void StartRecording() = 0;
+
+	/**
+	* Stop the recording and save it in a file, it can then be replayed headless (see PhysicsReplay).
+	* @param	filePath	Path of the file to save the recording in.
+	* @return				True if the recording has been saved.
+	*/
+	virtual bool StopRecording(const std::string& filePath) = 0;
+
+	/**
+	* Retrieve if the inputs of the physics are being recorded.
+	* @return	Recording state.
+	*/
+	virtual bool IsRecording() = 0;
+
 
 private:
 	friend class Engine;
@@ -111,5 +258,5 @@ private:
 	virtual void UpdatePhysics(float dt) = 0;
 
 	friend class RendererOpenGL;
-	virtual void DrawCollisionsDebug(Material& debugMaterial) = 0;
+	virtual void DrawCollisionsDebug(DebugDrawList& outDrawList) = 0;
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #pragma once
+#include <functional>
 
 class Camera;
 struct Color;
@@ -18,6 +19,20 @@ public:
 	virtual ~Renderer() {}
 
 
+	/**
+	* Check if the Renderer has a rendering context, the assets don't create their GPU objects without it (headless engine).
+	* @return		True if the rendering context is currently valid.
+	*/
+	virtual bool IsRenderingContextValid() = 0;
+
+	/**
+	* Run a job on the thread that owns the rendering context (for the GPU uploads made after the engine started), before the next frame is drawn.
+	* The job runs at once if the calling thread has the context, it is dropped if there is no rendering context.
+	* @param	job		Function that makes the OpenGL calls, what it uses must live until it has run.
+	*/
+	virtual void RunOnRenderThread(std::function<void()> job) = 0;
+
+
 	/**
 	* Set the new camera that will be used.
 	* @param	camera		The new camera to use.
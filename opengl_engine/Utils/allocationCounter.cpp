@@ -0,0 +1,116 @@
+#include "allocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+
+#ifdef ENGINE_COUNT_ALLOCATIONS
+
+namespace
+{
+	std::atomic<uint64_t> AllocationsCount{ 0 };
+	thread_local uint64_t ThreadAllocationsCount = 0;
+
+	void* CountedAllocate(size_t size)
+	{
+		AllocationsCount.fetch_add(1, std::memory_order_relaxed);
+		ThreadAllocationsCount++;
+
+		void* memory = std::malloc(size > 0 ? size : 1);
+		if (!memory) throw std::bad_alloc();
+		return memory;
+	}
+}
+
+
+bool AllocationCounter::IsEnabled()
+{
+	return true;
+}
+
+uint64_t AllocationCounter::GetAllocationsCount()
+{
+	return AllocationsCount.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::GetThreadAllocationsCount()
+{
+	return ThreadAllocationsCount;
+}
+
+
+// ===============================================
+//  ------------ Global new/delete -------------
+// ===============================================
+
+void* operator new(size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void* operator new[](size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	try { return CountedAllocate(size); }
+	catch (...) { return nullptr; }
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	try { return CountedAllocate(size); }
+	catch (...) { return nullptr; }
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t size) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, size_t size) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+#else
+
+bool AllocationCounter::IsEnabled()
+{
+	return false;
+}
+
+uint64_t AllocationCounter::GetAllocationsCount()
+{
+	return 0;
+}
+
+uint64_t AllocationCounter::GetThreadAllocationsCount()
+{
+	return 0;
+}
+
+#endif
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+
+
+/** Allocation Counter
+* Counts the heap allocations made through the global operator new (the engine replaces it to count them).
+* Used by the benchmarks and the debug view to check that the hot paths don't allocate.
+* The operator new is only replaced when the engine is compiled with ENGINE_COUNT_ALLOCATIONS (the debug configurations),
+* the counts stay at zero otherwise.
+*/
+class AllocationCounter
+{
+public:
+	//  whether the engine was compiled with the counting operator new
+	static bool IsEnabled();
+
+	//  allocations made by every thread since the start
+	static uint64_t GetAllocationsCount();
+
+	//  allocations made by the calling thread since its start, not disturbed by the other threads
+	static uint64_t GetThreadAllocationsCount();
+};
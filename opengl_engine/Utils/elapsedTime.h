@@ -0,0 +1,13 @@
+#pragma once
+#include <chrono>
+
+
+/**
+* Time elapsed since a point of the steady clock, for the timings of the benchmarks and the loadings.
+* @param	start		Point of the steady clock where the timing started.
+* @return				Elapsed time in milliseconds.
+*/
+inline double GetElapsedMilliseconds(const std::chrono::steady_clock::time_point& start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
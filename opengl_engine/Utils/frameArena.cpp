@@ -0,0 +1,109 @@
+#include "frameArena.h"
+#include <ServiceLocator/locator.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+
+namespace
+{
+	std::vector<std::unique_ptr<LinearArena>> ThreadsArenas[FrameArena::BUFFERS_COUNT]; //  by thread index of the job system
+
+	//  for the threads that aren't part of the job system, and before the initialization
+	LinearArena SharedArenas[FrameArena::BUFFERS_COUNT];
+	std::mutex SharedArenasMutex;
+
+	std::atomic<int> CurrentBuffer{ 0 };
+	uint64_t FrameIndex = 0;
+	size_t LastFrameUsedBytes = 0;
+}
+
+
+void FrameArena::Initialize(int threadsCount, size_t arenaSize)
+{
+	Release();
+
+	for (int buffer = 0; buffer < BUFFERS_COUNT; buffer++)
+	{
+		for (int i = 0; i < threadsCount; i++)
+		{
+			ThreadsArenas[buffer].emplace_back(new LinearArena(arenaSize));
+		}
+	}
+}
+
+void FrameArena::Release()
+{
+	for (int buffer = 0; buffer < BUFFERS_COUNT; buffer++)
+	{
+		ThreadsArenas[buffer].clear();
+	}
+}
+
+void FrameArena::EndFrame()
+{
+	const int buffer = CurrentBuffer.load(std::memory_order_relaxed);
+	const int next_buffer = (buffer + 1) % BUFFERS_COUNT;
+
+	std::lock_guard<std::mutex> lock(SharedArenasMutex);
+
+	size_t used_bytes = SharedArenas[buffer].getUsedBytes();
+	for (auto& arena : ThreadsArenas[buffer])
+	{
+		used_bytes += arena->getUsedBytes();
+	}
+	LastFrameUsedBytes = used_bytes;
+
+	//  the other buffer holds the data of the frame before, it is reused for the next frame
+	SharedArenas[next_buffer].reset();
+	for (auto& arena : ThreadsArenas[next_buffer])
+	{
+		arena->reset();
+	}
+
+	CurrentBuffer.store(next_buffer, std::memory_order_relaxed);
+	FrameIndex++;
+}
+
+void* FrameArena::Allocate(size_t size, size_t alignment)
+{
+	const int buffer = CurrentBuffer.load(std::memory_order_relaxed);
+	const int thread = Locator::getJobs().GetCurrentThreadIndex();
+
+	std::vector<std::unique_ptr<LinearArena>>& arenas = ThreadsArenas[buffer];
+	if (thread >= 0 && thread < static_cast<int>(arenas.size()))
+	{
+		return arenas[thread]->allocate(size, alignment);
+	}
+
+	std::lock_guard<std::mutex> lock(SharedArenasMutex);
+	return SharedArenas[buffer].allocate(size, alignment);
+}
+
+
+size_t FrameArena::GetLastFrameUsedBytes()
+{
+	return LastFrameUsedBytes;
+}
+
+size_t FrameArena::GetCapacity()
+{
+	std::lock_guard<std::mutex> lock(SharedArenasMutex);
+
+	size_t capacity = 0;
+	for (int buffer = 0; buffer < BUFFERS_COUNT; buffer++)
+	{
+		capacity += SharedArenas[buffer].getCapacity();
+		for (auto& arena : ThreadsArenas[buffer])
+		{
+			capacity += arena->getCapacity();
+		}
+	}
+	return capacity;
+}
+
+uint64_t FrameArena::GetFrameIndex()
+{
+	return FrameIndex;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "linearArena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+
+/** Frame Arena
+* Linear arenas for the transient data of a frame (temporary arrays of the physics, the renderer, the logs...), so that the hot paths don't go to the heap.
+* Each thread of the job system allocates in its own arena without any lock, the other threads share a locked one.
+* The arenas are double-buffered: what is allocated during a frame stays valid until the end of the next frame, then its memory is reused.
+* Nothing that lives longer than that must be allocated here (like a member vector or a job that isn't waited before the end of the frame).
+*/
+class FrameArena
+{
+public:
+	static const int BUFFERS_COUNT{ 2 };
+	static const size_t DEFAULT_ARENA_SIZE{ 256 * 1024 };
+
+	/**
+	* Create the arenas of the job system threads, called on the main thread once the jobs service is provided.
+	* @param	threadsCount	Number of threads of the job system (the main thread and the workers).
+	* @param	arenaSize		Starting size of each arena in bytes, an arena that needs more grows at the end of the frame.
+	*/
+	static void Initialize(int threadsCount, size_t arenaSize = DEFAULT_ARENA_SIZE);
+
+	/**
+	* Free the arenas of the threads, called on the main thread when no job is running.
+	*/
+	static void Release();
+
+	/**
+	* Switch to the other buffer of arenas and reset it, called by the engine on the main thread at the end of the frame when no job is running.
+	* The memory allocated during the frame before this one can't be used anymore.
+	*/
+	static void EndFrame();
+
+	/**
+	* Allocate uninitialized memory in the arena of the calling thread, valid until the end of the next frame. It is never freed by the caller.
+	* @param	size		Size of the memory in bytes.
+	* @param	alignment	Alignment of the memory, a power of two.
+	* @return				The memory.
+	*/
+	static void* Allocate(size_t size, size_t alignment);
+
+	//  uninitialized array of trivial values, every value must be written before being read
+	template<typename T>
+	static T* AllocateArray(int count)
+	{
+		static_assert(std::is_trivially_copyable<T>::value && std::is_trivially_destructible<T>::value, "Frame Arena: arrays can only be made of trivial values.");
+		return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	//  bytes allocated in all the arenas during the last frame
+	static size_t GetLastFrameUsedBytes();
+
+	//  bytes of all the arenas, of both buffers
+	static size_t GetCapacity();
+
+	static uint64_t GetFrameIndex();
+};
+
+
+/** Frame Allocator
+* STL allocator that allocates in the frame arena of the calling thread, for containers that are filled and dropped during a frame.
+* Deallocating does nothing, the memory is reused once the frame arena is reset.
+*/
+template<typename T>
+class FrameAllocator
+{
+public:
+	using value_type = T;
+
+	FrameAllocator() = default;
+
+	template<typename U>
+	FrameAllocator(const FrameAllocator<U>&) {}
+
+	inline T* allocate(size_t count) { return static_cast<T*>(FrameArena::Allocate(sizeof(T) * count, alignof(T))); }
+	inline void deallocate(T*, size_t) {}
+};
+
+template<typename T, typename U>
+inline bool operator==(const FrameAllocator<T>&, const FrameAllocator<U>&) { return true; }
+
+template<typename T, typename U>
+inline bool operator!=(const FrameAllocator<T>&, const FrameAllocator<U>&) { return false; }
+
+
+//  vector of the transient data of a frame, it must not be kept after the end of the next frame
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
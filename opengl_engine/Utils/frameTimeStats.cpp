@@ -0,0 +1,97 @@
+#include "frameTimeStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+
+const float FrameTimeStats::HISTOGRAM_EDGES[FrameTimeSummary::HISTOGRAM_BUCKETS - 1]{ 4.0f, 8.4f, 16.7f, 33.4f, 50.0f };
+
+
+namespace
+{
+	//  nearest rank percentile of sorted values
+	float Percentile(const std::vector<float>& sortedValues, float percentile)
+	{
+		const int rank = static_cast<int>(std::ceil(percentile * sortedValues.size()));
+		const int index = rank > 0 ? rank - 1 : 0;
+		return sortedValues[index];
+	}
+}
+
+
+std::string FrameTimeSummary::toStatsText() const
+{
+	char text[192];
+	std::snprintf(text, sizeof(text), "Frame times (%d frames): min %.2f / avg %.2f / p95 %.2f / p99 %.2f / max %.2f ms, cpu %.2f ms, wait %.2f ms",
+		framesCount, min, average, p95, p99, max, averageCpu, averageWait);
+	return text;
+}
+
+std::string FrameTimeSummary::toHistogramText() const
+{
+	std::string text = "Histogram:";
+	char bucket[48];
+	for (int i = 0; i < HISTOGRAM_BUCKETS; i++)
+	{
+		if (i < HISTOGRAM_BUCKETS - 1) std::snprintf(bucket, sizeof(bucket), " <%.1f ms: %d", FrameTimeStats::HISTOGRAM_EDGES[i], histogram[i]);
+		else std::snprintf(bucket, sizeof(bucket), " more: %d", histogram[i]);
+		text += bucket;
+	}
+	return text;
+}
+
+
+FrameTimeStats::FrameTimeStats(int framesCount_) :
+	frameTimes(framesCount_ > 0 ? framesCount_ : DEFAULT_FRAMES_COUNT, 0.0f), waitTimes(frameTimes.size(), 0.0f)
+{
+	sortedTimes.reserve(frameTimes.size());
+}
+
+void FrameTimeStats::addFrame(float frameTime, float waitTime)
+{
+	frameTimes[nextFrame] = frameTime;
+	waitTimes[nextFrame] = waitTime < frameTime ? waitTime : frameTime;
+
+	nextFrame = (nextFrame + 1) % static_cast<int>(frameTimes.size());
+	if (framesCount < static_cast<int>(frameTimes.size())) framesCount++;
+}
+
+FrameTimeSummary FrameTimeStats::computeSummary()
+{
+	FrameTimeSummary summary;
+	if (framesCount == 0) return summary;
+
+	//  the window is full or starts at 0, the order of the frames doesn't matter here
+	sortedTimes.assign(frameTimes.begin(), frameTimes.begin() + framesCount);
+	std::sort(sortedTimes.begin(), sortedTimes.end());
+
+	float total_time = 0.0f;
+	float total_wait = 0.0f;
+	for (int i = 0; i < framesCount; i++)
+	{
+		total_time += frameTimes[i];
+		total_wait += waitTimes[i];
+
+		int bucket = 0;
+		while (bucket < FrameTimeSummary::HISTOGRAM_BUCKETS - 1 && frameTimes[i] >= HISTOGRAM_EDGES[bucket]) bucket++;
+		summary.histogram[bucket]++;
+	}
+
+	summary.framesCount = framesCount;
+	summary.min = sortedTimes.front();
+	summary.max = sortedTimes.back();
+	summary.average = total_time / framesCount;
+	summary.p95 = Percentile(sortedTimes, 0.95f);
+	summary.p99 = Percentile(sortedTimes, 0.99f);
+	summary.averageWait = total_wait / framesCount;
+	summary.averageCpu = summary.average - summary.averageWait;
+
+	return summary;
+}
+
+void FrameTimeStats::clear()
+{
+	nextFrame = 0;
+	framesCount = 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <string>
+#include <vector>
+
+
+/** Frame Time Summary
+* Statistics of the frame times of a frame time stats window, in milliseconds.
+*/
+struct FrameTimeSummary
+{
+	static const int HISTOGRAM_BUCKETS{ 6 };
+
+	int framesCount{ 0 };
+	float min{ 0.0f };
+	float average{ 0.0f };
+	float p95{ 0.0f };
+	float p99{ 0.0f };
+	float max{ 0.0f };
+	float averageCpu{ 0.0f }; //  part of the frame spent working
+	float averageWait{ 0.0f }; //  part of the frame spent waiting for the render thread or the frame cap
+
+	int histogram[HISTOGRAM_BUCKETS]{ 0 }; //  frames count by bucket of the histogram edges
+
+	//  one line with the statistics and one line with the histogram
+	std::string toStatsText() const;
+	std::string toHistogramText() const;
+};
+
+
+/** Frame Time Stats
+* Rolling window of the last frame times, with their waiting part, to get the frame times distribution (the spikes that an average hides).
+*/
+class FrameTimeStats
+{
+public:
+	static const int DEFAULT_FRAMES_COUNT{ 240 };
+
+	explicit FrameTimeStats(int framesCount = DEFAULT_FRAMES_COUNT);
+
+	/**
+	* Add a frame to the window, the oldest frame is dropped when the window is full.
+	* @param	frameTime	Time of the whole frame in milliseconds.
+	* @param	waitTime	Time of the frame spent waiting in milliseconds.
+	*/
+	void addFrame(float frameTime, float waitTime);
+
+	//  compute the statistics of the frames of the window
+	FrameTimeSummary computeSummary();
+
+	void clear();
+
+	//  upper edges of the histogram buckets in milliseconds, the last bucket has the longer frames
+	static const float HISTOGRAM_EDGES[FrameTimeSummary::HISTOGRAM_BUCKETS - 1];
+
+private:
+	std::vector<float> frameTimes;
+	std::vector<float> waitTimes;
+	int nextFrame{ 0 };
+	int framesCount{ 0 };
+
+	std::vector<float> sortedTimes; //  reserved for the window, to compute the percentiles
+};
@@ -0,0 +1,89 @@
+#include "linearArena.h"
+
+#include <cstdint>
+
+
+LinearArena::LinearArena(size_t blockSize_) : blockSize(blockSize_)
+{
+	if (blockSize > 0) addBlock(blockSize);
+}
+
+LinearArena::~LinearArena()
+{
+	freeBlocks();
+}
+
+
+void* LinearArena::allocate(size_t size, size_t alignment)
+{
+	if (!blocks.empty())
+	{
+		const Block& block = blocks.back();
+		const uintptr_t address = reinterpret_cast<uintptr_t>(block.memory + offset);
+		const size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+		if (offset + padding + size <= block.size)
+		{
+			void* memory = block.memory + offset + padding;
+			offset += padding + size;
+			usedBytes += padding + size;
+			return memory;
+		}
+	}
+
+	//  the last block is full, the padding is reserved in the new one
+	addBlock(size + alignment);
+
+	const Block& block = blocks.back();
+	const uintptr_t address = reinterpret_cast<uintptr_t>(block.memory);
+	const size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+	offset = padding + size;
+	usedBytes += padding + size;
+	return block.memory + padding;
+}
+
+void LinearArena::reset()
+{
+	//  the arena needed more than one block since the last reset, they are replaced by a single one that would have held it all
+	if (blocks.size() > 1)
+	{
+		const size_t merged_size = getCapacity();
+		freeBlocks();
+		blockSize = merged_size;
+		addBlock(blockSize);
+	}
+
+	offset = 0;
+	usedBytes = 0;
+}
+
+size_t LinearArena::getCapacity() const
+{
+	size_t capacity = 0;
+	for (auto& block : blocks)
+	{
+		capacity += block.size;
+	}
+	return capacity;
+}
+
+
+void LinearArena::addBlock(size_t minSize)
+{
+	//  a chained block is as big as the whole arena, so that a busy frame only chains a few of them
+	const size_t capacity = getCapacity();
+	Block block;
+	block.size = minSize > blockSize ? minSize : blockSize;
+	if (block.size < capacity) block.size = capacity;
+	block.memory = new unsigned char[block.size];
+	blocks.push_back(block);
+	offset = 0;
+}
+
+void LinearArena::freeBlocks()
+{
+	for (auto& block : blocks)
+	{
+		delete[] block.memory;
+	}
+	blocks.clear();
+}
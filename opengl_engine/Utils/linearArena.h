@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+
+/** Linear Arena
+* Memory block where the allocations are made by moving an offset forward, they are never freed one by one: the whole arena is reset at once.
+* When the block is full the arena chains a new block, and the next reset merges the blocks into a single one big enough for what was allocated,
+* so an arena that is reset at a regular point (like the end of a frame) stops allocating once it has seen its biggest use.
+* An arena is not thread safe, each thread must use its own.
+*/
+class LinearArena
+{
+public:
+	explicit LinearArena(size_t blockSize = 0);
+	~LinearArena();
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+
+	/**
+	* Allocate uninitialized memory in the arena, valid until the next reset.
+	* @param	size		Size of the memory in bytes.
+	* @param	alignment	Alignment of the memory, a power of two.
+	* @return				The memory.
+	*/
+	void* allocate(size_t size, size_t alignment);
+
+	/**
+	* Free all the allocations at once, the blocks are merged if the arena had to grow.
+	*/
+	void reset();
+
+	//  bytes allocated since the last reset (alignment included)
+	inline size_t getUsedBytes() const { return usedBytes; }
+
+	//  bytes of all the blocks of the arena
+	size_t getCapacity() const;
+
+	//  number of blocks chained since the last reset, more than one means that the arena grows at the next reset
+	inline int getBlocksCount() const { return static_cast<int>(blocks.size()); }
+
+private:
+	struct Block
+	{
+		unsigned char* memory{ nullptr };
+		size_t size{ 0 };
+	};
+
+	void addBlock(size_t minSize);
+	void freeBlocks();
+
+	std::vector<Block> blocks;
+	size_t blockSize{ 0 };
+	size_t offset{ 0 }; //  in the last block
+	size_t usedBytes{ 0 };
+};
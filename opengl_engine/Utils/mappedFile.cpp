@@ -0,0 +1,105 @@
+#include "mappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filePath)
+{
+	close();
+
+	HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	//  a write-copy mapping: the pages that are written are copied for this process only
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	if (!mapping)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	if (!view)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle = file;
+	mappingHandle = mapping;
+	data = static_cast<unsigned char*>(view);
+	size = static_cast<size_t>(file_size.QuadPart);
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (data) UnmapViewOfFile(data);
+	if (mappingHandle) CloseHandle(static_cast<HANDLE>(mappingHandle));
+	if (fileHandle) CloseHandle(static_cast<HANDLE>(fileHandle));
+
+	data = nullptr;
+	size = 0;
+	mappingHandle = nullptr;
+	fileHandle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filePath)
+{
+	close();
+
+	const int file = ::open(filePath.c_str(), O_RDONLY);
+	if (file < 0) return false;
+
+	struct stat file_stat;
+	if (fstat(file, &file_stat) != 0 || file_stat.st_size <= 0)
+	{
+		::close(file);
+		return false;
+	}
+
+	//  a private mapping: the pages that are written are copied for this process only
+	void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+	::close(file); //  the mapping keeps its own reference to the file
+	if (view == MAP_FAILED) return false;
+
+	data = static_cast<unsigned char*>(view);
+	size = static_cast<size_t>(file_stat.st_size);
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (data) munmap(data, size);
+
+	data = nullptr;
+	size = 0;
+}
+
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+
+/** Mapped File
+* A file mapped in memory copy-on-write: its pages are read from the disk the first time they are touched, and writing in them only changes
+* this process copy (the file itself is never modified). Used to load cooked data in place, without reading it in a buffer first.
+*/
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	* Map a whole file, the file mapped before is closed.
+	* @param	filePath	Path of the file to map.
+	* @return				False if the file can't be opened or is empty.
+	*/
+	bool open(const std::string& filePath);
+
+	void close();
+
+	inline bool isOpen() const { return data != nullptr; }
+	inline unsigned char* getData() const { return data; }
+	inline size_t getSize() const { return size; }
+
+private:
+	unsigned char* data{ nullptr };
+	size_t size{ 0 };
+
+#ifdef _WIN32
+	void* fileHandle{ nullptr };
+	void* mappingHandle{ nullptr };
+#endif
+};
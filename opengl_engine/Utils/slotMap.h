@@ -0,0 +1,170 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+
+/** Slot Handle
+* Reference to a value of a slot map: the slot of the value and the generation of this slot when the value was added.
+* Once the value is removed the slot generation changes, so the handle becomes stale instead of pointing to another value.
+*/
+struct SlotHandle
+{
+	uint32_t index{ 0xFFFFFFFF };
+	uint32_t generation{ 0 };
+
+	inline bool isNull() const { return index == 0xFFFFFFFF; }
+
+	inline bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+	inline bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+
+/** Slot Map
+* Dense array of values that are added and removed through handles in constant time.
+* The values stay contiguous for the iteration: removing a value moves the last one in its place (the order is not kept).
+*/
+template<typename T>
+class SlotMap
+{
+public:
+	SlotHandle insert(const T& value);
+
+	//  false if the handle is stale or null
+	bool remove(SlotHandle handle);
+
+	//  remove every value a predicate returns true for, the handles of the other values stay valid
+	template<typename Predicate>
+	void removeIf(Predicate predicate);
+
+	void clear();
+
+	bool contains(SlotHandle handle) const;
+
+	//  nullptr if the handle is stale or null
+	T* get(SlotHandle handle);
+	const T* get(SlotHandle handle) const;
+
+	//  handle of the value at an index of the dense array
+	SlotHandle getHandle(int denseIndex) const;
+
+	inline int size() const { return static_cast<int>(values.size()); }
+	inline bool empty() const { return values.empty(); }
+
+	inline T& operator[](int denseIndex) { return values[denseIndex]; }
+	inline const T& operator[](int denseIndex) const { return values[denseIndex]; }
+
+	inline const std::vector<T>& getValues() const { return values; }
+
+	inline typename std::vector<T>::iterator begin() { return values.begin(); }
+	inline typename std::vector<T>::iterator end() { return values.end(); }
+	inline typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+	inline typename std::vector<T>::const_iterator end() const { return values.end(); }
+
+private:
+	struct Slot
+	{
+		uint32_t denseIndex{ 0 };
+		uint32_t generation{ 0 };
+	};
+
+	std::vector<T> values;
+	std::vector<uint32_t> valuesSlots; //  slot of each value
+	std::vector<Slot> slots;
+	std::vector<uint32_t> freeSlots;
+};
+
+
+
+template<typename T>
+SlotHandle SlotMap<T>::insert(const T& value)
+{
+	uint32_t slot_index;
+	if (!freeSlots.empty())
+	{
+		slot_index = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else
+	{
+		slot_index = static_cast<uint32_t>(slots.size());
+		slots.emplace_back();
+	}
+
+	slots[slot_index].denseIndex = static_cast<uint32_t>(values.size());
+	values.push_back(value);
+	valuesSlots.push_back(slot_index);
+
+	return SlotHandle{ slot_index, slots[slot_index].generation };
+}
+
+template<typename T>
+bool SlotMap<T>::remove(SlotHandle handle)
+{
+	if (!contains(handle)) return false;
+
+	Slot& slot = slots[handle.index];
+	const uint32_t dense_index = slot.denseIndex;
+	const uint32_t last_index = static_cast<uint32_t>(values.size() - 1);
+
+	if (dense_index != last_index)
+	{
+		values[dense_index] = values[last_index];
+		valuesSlots[dense_index] = valuesSlots[last_index];
+		slots[valuesSlots[dense_index]].denseIndex = dense_index;
+	}
+	values.pop_back();
+	valuesSlots.pop_back();
+
+	slot.generation++;
+	freeSlots.push_back(handle.index);
+	return true;
+}
+
+template<typename T>
+template<typename Predicate>
+void SlotMap<T>::removeIf(Predicate predicate)
+{
+	//  backward, so the value moved in the place of a removed one has already been tested
+	for (int i = size() - 1; i >= 0; i--)
+	{
+		if (predicate(values[i])) remove(getHandle(i));
+	}
+}
+
+template<typename T>
+void SlotMap<T>::clear()
+{
+	for (uint32_t slot_index : valuesSlots)
+	{
+		slots[slot_index].generation++;
+		freeSlots.push_back(slot_index);
+	}
+	values.clear();
+	valuesSlots.clear();
+}
+
+template<typename T>
+bool SlotMap<T>::contains(SlotHandle handle) const
+{
+	//  the generation of a slot changes when its value is removed, so a free slot never matches a handle
+	return handle.index < slots.size() && slots[handle.index].generation == handle.generation;
+}
+
+template<typename T>
+T* SlotMap<T>::get(SlotHandle handle)
+{
+	return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+}
+
+template<typename T>
+const T* SlotMap<T>::get(SlotHandle handle) const
+{
+	return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+}
+
+template<typename T>
+SlotHandle SlotMap<T>::getHandle(int denseIndex) const
+{
+	const uint32_t slot_index = valuesSlots[denseIndex];
+	return SlotHandle{ slot_index, slots[slot_index].generation };
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include <type_traits>
+
+
+/** Small Vector
+* Contiguous array that stores its first N values inline and only allocates when it grows past them.
+* Made for the small lists that are read far more often than they change (like the observers of an event), so the values must be trivially copyable.
+* Erasing keeps the order of the other values.
+*/
+template<typename T, int N>
+class SmallVector
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Small Vector: the values must be trivially copyable.");
+	static_assert(N > 0, "Small Vector: at least one value must be stored inline.");
+
+public:
+	SmallVector() {}
+	SmallVector(const SmallVector& other);
+	SmallVector& operator=(const SmallVector& other);
+	~SmallVector();
+
+	void push_back(const T& value);
+
+	//  erase the value at an index, the next values are moved back
+	void eraseAt(int index);
+
+	//  erase every value a predicate returns true for, the order of the other values is kept
+	template<typename Predicate>
+	void removeIf(Predicate predicate);
+
+	//  the allocated values are kept for the next values
+	inline void clear() { count = 0; }
+
+	inline int size() const { return count; }
+	inline bool empty() const { return count == 0; }
+	inline int getCapacity() const { return capacity; }
+	inline bool isInline() const { return values == inlineValues; }
+
+	inline T& operator[](int index) { return values[index]; }
+	inline const T& operator[](int index) const { return values[index]; }
+
+	inline T* begin() { return values; }
+	inline T* end() { return values + count; }
+	inline const T* begin() const { return values; }
+	inline const T* end() const { return values + count; }
+
+private:
+	void reserve(int newCapacity);
+
+	T inlineValues[N];
+	T* values{ inlineValues };
+	int count{ 0 };
+	int capacity{ N };
+};
+
+
+
+template<typename T, int N>
+SmallVector<T, N>::SmallVector(const SmallVector& other)
+{
+	*this = other;
+}
+
+template<typename T, int N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector& other)
+{
+	if (this == &other) return *this;
+
+	count = 0;
+	reserve(other.count);
+	for (int i = 0; i < other.count; i++)
+	{
+		values[i] = other.values[i];
+	}
+	count = other.count;
+	return *this;
+}
+
+template<typename T, int N>
+SmallVector<T, N>::~SmallVector()
+{
+	if (!isInline()) delete[] values;
+}
+
+template<typename T, int N>
+void SmallVector<T, N>::push_back(const T& value)
+{
+	//  copied first, the value can be in this vector
+	const T new_value = value;
+	if (count == capacity) reserve(capacity * 2);
+
+	values[count] = new_value;
+	count++;
+}
+
+template<typename T, int N>
+void SmallVector<T, N>::eraseAt(int index)
+{
+	for (int i = index + 1; i < count; i++)
+	{
+		values[i - 1] = values[i];
+	}
+	count--;
+}
+
+template<typename T, int N>
+template<typename Predicate>
+void SmallVector<T, N>::removeIf(Predicate predicate)
+{
+	int kept_count = 0;
+	for (int i = 0; i < count; i++)
+	{
+		if (predicate(values[i])) continue;
+
+		values[kept_count] = values[i];
+		kept_count++;
+	}
+	count = kept_count;
+}
+
+template<typename T, int N>
+void SmallVector<T, N>::reserve(int newCapacity)
+{
+	if (newCapacity <= capacity) return;
+
+	T* new_values = new T[newCapacity];
+	for (int i = 0; i < count; i++)
+	{
+		new_values[i] = values[i];
+	}
+
+	if (!isInline()) delete[] values;
+	values = new_values;
+	capacity = newCapacity;
+}
@@ -69,6 +69,8 @@ void ExpositionGame::loadGameAssets()
 
 void ExpositionGame::loadGame()
 {
+	if (!getStartLevel().empty()) Locator::getLog().LogMessage_Category("Exposition: The game only has one scene, the start level '" + getStartLevel() + "' is ignored.", LogCategory::Warning);
+
 	loadScene(&expositionScene);
 }
 
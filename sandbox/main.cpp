@@ -2,9 +2,9 @@
 #include "expositionGame.h"
 
 
-int main()
+int main(int argc, char* argv[])
 {
-	Engine engine;
+	Engine engine(EngineSettings::FromCommandLine(argc, argv));
 	bool is_engine_init = engine.initialize();
 
 	if (!is_engine_init) return -1;